@@ -63,9 +63,91 @@
 #define MAX(X, Y) 						(((X) > (Y)) ? (X) : (Y))
 
 /*============= D A T A =============*/
-static int8_t pTemp[TEMP_BUFFER_SIZE]__attribute__((section(".L1.noload"), aligned(8)));		/*scratch buffer used inside kernels*/
-static int8_t pTempL3[TEMP_BUFFER_SIZE_L3]__attribute__((section(".L3.noload"), aligned(8)));		/*scratch buffer used inside kernels*/
-static int64_t nQFormatBuffer[ARRAY_INPUT_SIZE]__attribute__((section(".L3.noload"), aligned(8)));
+/*Shared static scratch of the kernels called without context, defined once in adi_sharcfx_common.cpp*/
+extern int8_t pTemp[TEMP_BUFFER_SIZE];						/*scratch buffer used inside kernels, L1*/
+extern int8_t pTempL3[TEMP_BUFFER_SIZE_L3];					/*scratch buffer used inside kernels, L3*/
+extern int64_t nQFormatBuffer[ARRAY_INPUT_SIZE];			/*scratch buffer used inside kernels, L3*/
+
+/*Copy engine staging tiles into L1. pfStart starts a copy, pfWait blocks until all started copies are complete*/
+typedef struct
+{
+    void (*pfStart)(void *pDst, const void *pSrc, int32_t nBytes, void *pEngineData);
+    void (*pfWait)(void *pEngineData);
+    void *pEngineData;
+} ADI_SHARCFX_COPY_ENGINE;
+
+/*Scratch and copy engine of one execution context. Kernels called through their _ctx entry points with a context use only its scratch, so
+models running on different threads or cores with their own contexts do not share any buffer. Kernels need at most
+TEMP_BUFFER_SIZE bytes of pScratch and TEMP_BUFFER_SIZE_L3 bytes of pScratchL3, both 8 byte aligned. Contexts running
+concurrently each need their own copy engine, or an engine that is safe to share*/
+typedef struct
+{
+    int8_t *pScratch;           /*fast scratch, usually in L1, in place of pTemp*/
+    int32_t nScratchSize;       /*size of pScratch in bytes*/
+    int8_t *pScratchL3;         /*large scratch in place of pTempL3, the depthconv buffer and nQFormatBuffer*/
+    int32_t nScratchL3Size;     /*size of pScratchL3 in bytes*/
+    ADI_SHARCFX_COPY_ENGINE *pCopyEngine;   /*copy engine of the tiled kernels, NULL for the engine of adi_sharcfx_set_copy_engine*/
+} ADI_SHARCFX_CONTEXT;
+
 /*============= F U N C T I O N P R O T O T Y P E S =============*/
 
+/*UTILITY FUNCTION*/
+//Fast scratch of a context, the shared static scratch without context
+static inline int8_t* get_scratch(const ADI_SHARCFX_CONTEXT *pContext)
+{
+    return pContext ? pContext->pScratch : pTemp;
+}
+
+static inline int32_t get_scratch_size(const ADI_SHARCFX_CONTEXT *pContext)
+{
+    return pContext ? pContext->nScratchSize : TEMP_BUFFER_SIZE;
+}
+
+/*UTILITY FUNCTION*/
+//Large scratch of a context and its size, pDefault and nDefaultSize (the kernel's static L3 buffer) without context
+static inline int8_t* get_scratch_l3(const ADI_SHARCFX_CONTEXT *pContext,
+                                     int8_t *pDefault)
+{
+    return pContext ? pContext->pScratchL3 : pDefault;
+}
+
+static inline int32_t get_scratch_l3_size(const ADI_SHARCFX_CONTEXT *pContext,
+                                          int32_t nDefaultSize)
+{
+    return pContext ? pContext->nScratchL3Size : nDefaultSize;
+}
+
+/*UTILITY FUNCTION*/
+//Copy engine of a context, NULL (the engine of adi_sharcfx_set_copy_engine) without context
+static inline ADI_SHARCFX_COPY_ENGINE* get_copy_engine(const ADI_SHARCFX_CONTEXT *pContext)
+{
+    return pContext ? pContext->pCopyEngine : NULL;
+}
+
+/*UTILITY FUNCTION*/
+//Range [*pTapStart, *pTapEnd) of kernel taps that fall inside the input along one axis, for a window whose first tap reads
+//input position nInStart (negative inside the leading padding). Taps outside the range would read padding, which is the
+//input zeropoint and contributes nothing once the input offset is added, so the convolutions skip them instead of
+//convolving a padded copy of the input.
+static inline void get_valid_tap_range(int32_t nInStart,
+                                       int32_t nInSize,
+                                       int32_t nKernelSize,
+                                       int32_t nDilation,
+                                       int32_t *pTapStart,
+                                       int32_t *pTapEnd)
+{
+    int32_t nStart = 0;
+    int32_t nEnd = nKernelSize;
+    if (nInStart < 0)
+    {
+        nStart = (-nInStart + nDilation - 1) / nDilation;
+    }
+    if (nInStart + (nKernelSize - 1) * nDilation >= nInSize)
+    {
+        nEnd = MAX(nInSize - nInStart + nDilation - 1, 0) / nDilation;
+    }
+    *pTapStart = MIN(nStart, nKernelSize);
+    *pTapEnd = MAX(nEnd, *pTapStart);
+}
+
 #endif /* __ADI_SHARCFX_COMMON_H__ */
@@ -3,9 +3,9 @@
 *
 * @file: adi_sharcfx_activations.cpp
 *
-* @brief: Contains optimized Relu, Tanh and Logistic functions
+* @brief: Contains optimized Relu, Hard swish, Leaky Relu, PRelu, Tanh and Logistic functions
 *
-* @details: Contains the optimized Relu and Logistic activation functions for int8 input data and optimized Logictic and Tanh activation functions for int16 input data
+* @details: Contains the optimized Relu, Hard swish, Leaky Relu, PRelu and Logistic activation functions for int8 input data and optimized Logictic and Tanh activation functions for int16 input data
 *
 *******************************************************************************
  Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
@@ -18,6 +18,51 @@
 /*============= I N C L U D E S =============*/
 #include "adi_sharcfx_nn.h"
 
+/*============= D E F I N E S =============*/
+#define SIGMOID_TABLE_SIZE      256     /*# of entries of the sigmoid table used by the int16 tanh and logistic*/
+
+/*============= D A T A =============*/
+//sigmoid(i/24) in Q0.16 as used by the TFLite int16 tanh and logistic reference kernels, stored minus 32768 so that the
+//entries fit signed 16bit lanes
+static const int16_t nSigmoidTable[SIGMOID_TABLE_SIZE] = {
+    0, 683, 1365, 2045, 2724, 3401, 4075, 4745, 5411, 6073, 6730, 7381, 8025, 8664, 9295, 9919,
+    10535, 11143, 11743, 12333, 12914, 13486, 14048, 14601, 15143, 15674, 16196, 16706, 17206, 17695, 18173, 18640,
+    19097, 19542, 19976, 20400, 20813, 21214, 21606, 21986, 22356, 22716, 23066, 23405, 23734, 24054, 24364, 24665,
+    24956, 25238, 25511, 25776, 26032, 26280, 26519, 26751, 26975, 27191, 27400, 27602, 27797, 27985, 28166, 28341,
+    28510, 28673, 28830, 28982, 29128, 29268, 29404, 29534, 29660, 29781, 29898, 30010, 30118, 30222, 30322, 30418,
+    30511, 30600, 30685, 30768, 30847, 30923, 30996, 31067, 31135, 31200, 31262, 31322, 31380, 31435, 31489, 31540,
+    31589, 31637, 31682, 31726, 31767, 31808, 31846, 31883, 31919, 31953, 31986, 32018, 32048, 32077, 32105, 32132,
+    32157, 32182, 32206, 32229, 32250, 32271, 32292, 32311, 32329, 32347, 32364, 32381, 32396, 32411, 32426, 32440,
+    32453, 32466, 32478, 32490, 32501, 32512, 32523, 32532, 32542, 32551, 32560, 32569, 32577, 32584, 32592, 32599,
+    32606, 32613, 32619, 32625, 32631, 32636, 32642, 32647, 32652, 32657, 32661, 32665, 32670, 32674, 32677, 32681,
+    32685, 32688, 32691, 32694, 32697, 32700, 32703, 32706, 32708, 32711, 32713, 32715, 32717, 32720, 32721, 32723,
+    32725, 32727, 32729, 32730, 32732, 32733, 32735, 32736, 32737, 32739, 32740, 32741, 32742, 32743, 32744, 32745,
+    32746, 32747, 32748, 32749, 32749, 32750, 32751, 32752, 32752, 32753, 32754, 32754, 32755, 32755, 32756, 32756,
+    32757, 32757, 32758, 32758, 32758, 32759, 32759, 32760, 32760, 32760, 32761, 32761, 32761, 32761, 32762, 32762,
+    32762, 32762, 32763, 32763, 32763, 32763, 32763, 32764, 32764, 32764, 32764, 32764, 32764, 32765, 32765, 32765,
+    32765, 32765, 32765, 32765, 32765, 32766, 32766, 32766, 32766, 32766, 32766, 32766, 32766, 32766, 32766, 32766
+};
+
+//difference to the next table entry, the slope used for interpolation
+static const int16_t nSigmoidTableDelta[SIGMOID_TABLE_SIZE] = {
+    683, 682, 680, 679, 677, 674, 670, 666, 662, 657, 651, 644, 639, 631, 624, 616,
+    608, 600, 590, 581, 572, 562, 553, 542, 531, 522, 510, 500, 489, 478, 467, 457,
+    445, 434, 424, 413, 401, 392, 380, 370, 360, 350, 339, 329, 320, 310, 301, 291,
+    282, 273, 265, 256, 248, 239, 232, 224, 216, 209, 202, 195, 188, 181, 175, 169,
+    163, 157, 152, 146, 140, 136, 130, 126, 121, 117, 112, 108, 104, 100, 96, 93,
+    89, 85, 83, 79, 76, 73, 71, 68, 65, 62, 60, 58, 55, 54, 51, 49,
+    48, 45, 44, 41, 41, 38, 37, 36, 34, 33, 32, 30, 29, 28, 27, 25,
+    25, 24, 23, 21, 21, 21, 19, 18, 18, 17, 17, 15, 15, 15, 14, 13,
+    13, 12, 12, 11, 11, 11, 9, 10, 9, 9, 9, 8, 7, 8, 7, 7,
+    7, 6, 6, 6, 5, 6, 5, 5, 5, 4, 4, 5, 4, 3, 4, 4,
+    3, 3, 3, 3, 3, 3, 3, 2, 3, 2, 2, 2, 3, 1, 2, 2,
+    2, 2, 1, 2, 1, 2, 1, 1, 2, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 0, 1, 0, 1, 0, 1,
+    0, 1, 0, 0, 1, 0, 1, 0, 0, 1, 0, 0, 0, 1, 0, 0,
+    0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 1, 0, 0, 0,
+    0, 0, 0, 0, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
 /*============= C O D E =============*/
 
 /**
@@ -190,19 +235,66 @@ void vectanh_16b_Q0_15( const int16_t * pInput, int16_t* pOutput, int nSize )
 } /* vectanh_16b_Q0_15() */
 
 
+/*UTILITY FUNCTION*/
+//Load the table (or its deltas) into 2*PDX_M lane vectors for the select based lookup
+inline void sigmoid_table_load(const int16_t *pTable, xb_vec2Mx16 *pVectors)
+{
+    xb_vec2Mx16 *tp = (xb_vec2Mx16 *)pTable;
+    valign ta = PDX_LA_2MX16_PP(tp);
+    for (int32_t i = 0; i < SIGMOID_TABLE_SIZE/(2*PDX_M); i++)
+    {
+        PDX_LA_2MX16_XP(pVectors[i], ta, tp, 2*PDX_M*sizeof(int16_t));
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Interpolate sigmoid(|x|) for 2*PDX_M lanes in the same way as the TFLite int16 reference kernels.
+//vAbs holds |x| with nFracBits bits per table step. Returns (ua<<nFracBits) + frac*(ub-ua) minus 32768<<nFracBits,
+//or nSaturated where |x| is at or past the last table step.
+//The table lookup is done with PDX_SEL_2MX16 over each pair of table vectors, the pair is selected per lane by the index
+inline xb_vec2Mx40 sigmoid_table_interpolate(xb_vec2Mx40 vAbs,
+                                             int32_t nFracBits,
+                                             const xb_vec2Mx16 *pTable,
+                                             const xb_vec2Mx16 *pDelta,
+                                             int32_t nSaturated)
+{
+    xb_vec2Mx40 vLastStep = (xb_vec2Mx40)(SIGMOID_TABLE_SIZE - 2);
+    xb_vec2Mx40 vStep = PDX_SRA_2MX40(vAbs, nFracBits);
+    xb_vec2Mx40 vFrac = vAbs - PDX_SLS_2MX40(vStep, nFracBits);
+    vbool2M saturated = PDX_GT_2MX40(vStep, vLastStep);
+    vStep = PDX_MOV_2MX40_T(vLastStep, vStep, saturated);       //keep the index inside the table
+
+    xb_vec2Mx16 vIndex = PDX_PACKSIV_2MX40(vStep, 0);
+    xb_vec2Mx16 vFrac16 = PDX_PACKSIV_2MX40(vFrac, 0);
+    xb_vec2Mx16 vSel = PDX_AND_2MX16(vIndex, (xb_vec2Mx16)(4*PDX_M - 1));
+    xb_vec2Mx16 vBase = PDX_SEL_2MX16(pTable[1], pTable[0], vSel);
+    xb_vec2Mx16 vSlope = PDX_SEL_2MX16(pDelta[1], pDelta[0], vSel);
+    for (int32_t r = 1; r < SIGMOID_TABLE_SIZE/(4*PDX_M); r++)
+    {
+        vbool2M region = PDX_LT_2MX16((xb_vec2Mx16)(r*4*PDX_M - 1), vIndex);
+        vBase = PDX_MOV_2MX16_T(PDX_SEL_2MX16(pTable[2*r + 1], pTable[2*r], vSel), vBase, region);
+        vSlope = PDX_MOV_2MX16_T(PDX_SEL_2MX16(pDelta[2*r + 1], pDelta[2*r], vSel), vSlope, region);
+    }
+
+    xb_vec2Mx40 w = PDX_MULW_2MX16(vBase, (xb_vec2Mx16)(1<<nFracBits));
+    PDX_MULAW_2MX16(w, vFrac16, vSlope);
+    return PDX_MOV_2MX40_T((xb_vec2Mx40)nSaturated, w, saturated);
+}
+
 /**
 *******************************************************************************
 * Function: adi_sharcfx_tanh_int16
 * @brief optimized implementation of tanh activation function
 *
-* @details optimized implementation of tanh activation function for int16 data. The function returns the hyperbolic Tan of x. 16-bit fixed-point function
-* accepts input in Q3.12 and form output in Q0.15 format.
+* @details optimized implementation of tanh activation function for int16 data. Uses tanh(x) = 2*sigmoid(2x) - 1 with the
+* 256 entry sigmoid table and linear interpolation of the TFLite int16 reference kernel, with the same rounding,
+* for 2*PDX_M lanes per iteration.
 *
 * Parameters:
-* @param [in] nInputMultiplier - multiplier, corresponds to TFLM quantization scheme
+* @param [in] nInputMultiplier - multiplier, corresponds to TFLM quantization scheme (0 for power of two input scales)
 * @param [in] nInputLeftShift - shift, corresponds to TFLM quantization scheme
 * @param [in] nLength - input size
-* @param [in] pInputData - input buffer (Q3.12)
+* @param [in] pInputData - input buffer
 *
 * @param [out] pOutputData - output buffer(Q0.15)
 *
@@ -216,72 +308,57 @@ void adi_sharcfx_tanh_int16(int32_t nInputMultiplier,
                             const int16_t* pInputData, 
                             int16_t* pOutputData)
 {
-    int16_t* pInput_in_q3_12 = (int16_t*)nQFormatBuffer;
-    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pInputData;
-    xb_vec2Mx16 *          outp;
-    outp=(      xb_vec2Mx16 *)pInput_in_q3_12;
-    xb_vec2Mx16 vin;
-    valign ina,outa; // define align vector
-    ina=PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
-    outa = PDX_Z_ALIGN();
-    int32_t nPixLeft = nLength;
-    //scaling input to fit into Q3.12.
+    xb_vec2Mx16 vTable[SIGMOID_TABLE_SIZE/(2*PDX_M)];
+    xb_vec2Mx16 vDelta[SIGMOID_TABLE_SIZE/(2*PDX_M)];
+    sigmoid_table_load(nSigmoidTable, vTable);
+    sigmoid_table_load(nSigmoidTableDelta, vDelta);
+
+    //power of two scales: the 3/4 range expansion is applied with the multiplier
     if (nInputMultiplier == 0)
     {
-        for (int i = 0; i < nLength; i += (PDX_2M))
-        {
-            xb_vec2Mx16 vTempInput ;
-            PDX_LA_2MX16_XP (vin, ina, inp, PDX_4M); // load aligned, extend
-            vTempInput = PDX_SLS_2MX16(vin, nInputLeftShift);
-            PDX_SAV_2MX16_XP(vTempInput,outa,outp, PDX_4M);
-            PDX_SAPOS_2MX16_FP( outa, outp );
-            nPixLeft -=PDX_2M;
-        }
-        if(nPixLeft>0)
-        {
-            xb_vec2Mx16 vTempInput ;
-            PDX_LA_2MX16_XP (vin, ina, inp, 0); // load aligned, extend
-            vTempInput = PDX_SLS_2MX16(vin, nInputLeftShift);
-            PDX_SAV_2MX16_XP(vTempInput,outa,outp, nPixLeft*2);
-            PDX_SAPOS_2MX16_FP( outa, outp );
-        }
-    }
-    else
-    {
-        xb_vec2Mx40 vTempOut;
-        int32_t nTempRound = nInputLeftShift > 0 ? (1<<(nInputLeftShift-1)) : 0;
-        for (int i = 0; i < nLength; i += PDX_2M)
-        {
-            PDX_LA_2MX16_XP (vin, ina, inp, PDX_4M); // load aligned, extend
-            vTempOut = PDX_MULW_2MX16(vin,nInputMultiplier);
-            vTempOut = PDX_ADD_2MX40(vTempOut,nTempRound);  //rounding multiplied scaled input with round data nTempRound for 16 bit data;
-            vTempOut = PDX_SRA_2MX40 (vTempOut,nInputLeftShift);
-            PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(vTempOut,0),outa,outp, PDX_4M);
-            PDX_SAPOS_2MX16_FP( outa, outp );
-            nPixLeft -=PDX_2M;
-        }
-        if(nPixLeft>0)
-        {
-            PDX_LA_2MX16_XP (vin, ina, inp, 0); // load aligned, extend
-            vTempOut = PDX_MULW_2MX16(vin,nInputMultiplier);
-            vTempOut = PDX_ADD_2MX40(vTempOut,nTempRound);  //rounding multiplied scaled input with round data nTempRound for 16 bit data;
-            vTempOut = PDX_SRA_2MX40 (vTempOut,nInputLeftShift);
-            PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(vTempOut,0),outa,outp, nPixLeft*2);
-            PDX_SAPOS_2MX16_FP( outa, outp );
-        }
-
+        nInputMultiplier = 3 << nInputLeftShift;
+        nInputLeftShift = 0;
     }
+    int32_t nTempRound = nInputLeftShift > 0 ? (1<<(nInputLeftShift-1)) : 0;
+    xb_vec2Mx16 vMult = nInputMultiplier;
+    xb_vec2Mx40 vZero = 0;
 
-    vectanh_16b_Q0_15(pInput_in_q3_12, pOutputData, nLength );
+    xb_vec2Mx16 vin;
+    xb_vec2Mx40 vInput, vAbs, vResult;
+    vbool2M negative;
+    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pInputData;
+    valign ina = PDX_LA_2MX16_PP(inp);
+    xb_vec2Mx16 *outp = (xb_vec2Mx16 *)pOutputData;
+    valign outa = PDX_Z_ALIGN();
+    int32_t nBytesLeft = nLength*sizeof(int16_t);
 
+    for (int32_t i = 0; i < nLength; i += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vin, ina, inp, nBytesLeft);
+        vInput = PDX_MULW_2MX16(vin, vMult);
+        vInput = PDX_ADD_2MX40(vInput, nTempRound);
+        vInput = PDX_SRA_2MX40(vInput, nInputLeftShift);
+        negative = PDX_LT_2MX40(vInput, vZero);
+        vAbs = PDX_MOV_2MX40_T(vZero - vInput, vInput, negative);
+
+        //8 fraction bits per table step, saturates to 0xFFFF<<8
+        vResult = sigmoid_table_interpolate(vAbs, 8, vTable, vDelta, (0xFFFF<<8) - (1<<23));
+        //2*sigmoid - 1 with the reference rounding, the -1 is the table offset
+        vResult = PDX_MOV_2MX40_T((1<<7) - 1 - vResult, vResult + (1<<7), negative);
+        vResult = PDX_SRA_2MX40(vResult, 8);
+        PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(vResult, 0), outa, outp, nBytesLeft);
+        nBytesLeft -= PDX_4M;
+    }
+    PDX_SAPOS_2MX16_FP(outa, outp);
 }
 /**
 *******************************************************************************
-* Function: adi_sharcfx_logistic_int8
+* Function: adi_sharcfx_logistic_int8_ctx
 * @brief optimized implementation of logistic/sigmoid activation function
 *
 * @details optimized implementation of tanh activation function for int8 data. The function returns the Logistic (1/(1+exp(-x))) of x. 8-bit
 * fixed-point function accepts input in Q3.4 and form output in Q0.7 format.
+* The Q3.4 input is kept in the large scratch, rounded up to whole vectors; -1 is returned if it does not fit.
 *
 * Parameters:
 * @param [in] nInputZeroPoint - zero point, corresponds to TFLM quantization scheme
@@ -289,25 +366,33 @@ void adi_sharcfx_tanh_int16(int32_t nInputMultiplier,
 * @param [in] nInputLeftShift - shift, corresponds to TFLM quantization scheme
 * @param [in] nInputSize - input size
 * @param [in] pInputData - input buffer (Q3.4)
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
 *
 * @param [out] pOutputData - output buffer(Q0.7)
 *
-* @return None
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
 *
 *******************************************************************************
-*/ 
-void adi_sharcfx_logistic_int8(int32_t nInputZeroPoint, 
-                               int32_t nInputMultiplier, 
-                               int32_t nInputLeftShift, 
-                               int32_t nInputSize, 
-                               const int8_t* pInputData, 
-                               int8_t* pOutputData)
+*/
+int32_t adi_sharcfx_logistic_int8_ctx(int32_t nInputZeroPoint, 
+                                      int32_t nInputMultiplier, 
+                                      int32_t nInputLeftShift, 
+                                      int32_t nInputSize, 
+                                      const int8_t* pInputData, 
+                                      int8_t* pOutputData,
+                                      const ADI_SHARCFX_CONTEXT* pContext)
 {
     // Integer bits must be in sync with Prepare() function.
     static constexpr int32_t kOutputZeroPoint = -128;
 
+    //the Q3.4 input is written in whole vectors
+    if (((nInputSize + 4*PDX_M - 1)/(4*PDX_M))*4*PDX_M > get_scratch_l3_size(pContext, (int32_t)sizeof(nQFormatBuffer)))
+    {
+        return -1;
+    }
+
     //scaling input to fit into Q3.4
-    int8_t* pInput_in_q3_4 = (int8_t*)nQFormatBuffer;
+    int8_t* pInput_in_q3_4 = get_scratch_l3(pContext, (int8_t*)nQFormatBuffer);
     nInputLeftShift = 4-(27 - nInputLeftShift);
     nInputMultiplier = nInputMultiplier>>24;
     xb_vec4Mx8 vInZP = PDX_REP_4MX8((xb_vec4Mx8)nInputZeroPoint,0);
@@ -336,7 +421,7 @@ void adi_sharcfx_logistic_int8(int32_t nInputZeroPoint,
     vecsigmoid_8b((int8_t *)pInput_in_q3_4, pOutputData, nInputSize );
 
     //scaling output and applying sign
-    int16_t* output_in_q7_8 = (int16_t*)nQFormatBuffer;
+    int16_t* output_in_q7_8 = (int16_t*)get_scratch_l3(pContext, (int8_t*)nQFormatBuffer);
     xb_vec2Mx16 vOutZP = PDX_REP_2MX16((xb_vec2Mx16)kOutputZeroPoint,0);
     xb_vec2Mx8 *out = (xb_vec2Mx8 *)pOutputData;
     xb_vec2Mx16 vout;
@@ -353,6 +438,28 @@ void adi_sharcfx_logistic_int8(int32_t nInputZeroPoint,
         PDX_SAV16_2MX8_XP(vout,outaSig,outpSig, PDX_4M);
         PDX_SAPOS_2MX8_FP( outaSig, outpSig );
     }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_logistic_int8
+* @brief adi_sharcfx_logistic_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_logistic_int8_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_logistic_int8(int32_t nInputZeroPoint, 
+                                  int32_t nInputMultiplier, 
+                                  int32_t nInputLeftShift, 
+                                  int32_t nInputSize, 
+                                  const int8_t* pInputData, 
+                                  int8_t* pOutputData)
+{
+    return adi_sharcfx_logistic_int8_ctx(nInputZeroPoint, nInputMultiplier, nInputLeftShift, nInputSize, pInputData,
+                                         pOutputData, NULL);
 }
 
 
@@ -426,14 +533,15 @@ void vecsigmoid_16b_Q0_15( const int16_t * pInput, int16_t * pOutput, int nSize
 * Function: adi_sharcfx_logistic_int16
 * @brief optimized implementation of logistic/sigmoid activation function
 *
-* @details optimized implementation of tanh activation function for int16 data. The function returns the sigmoid (1/(1+exp(-x))) of x. 16-bit fixed-point
-* function accepts input in Q3.12 and form output in Q0.15 format.
+* @details optimized implementation of logistic activation function for int16 data. The function returns the sigmoid
+* (1/(1+exp(-x))) of x using the 256 entry sigmoid table and linear interpolation of the TFLite int16 reference kernel,
+* with the same rounding, for 2*PDX_M lanes per iteration.
 *
 * Parameters:
-* @param [in] nInputMultiplier - multiplier, corresponds to TFLM quantization scheme
+* @param [in] nInputMultiplier - multiplier, corresponds to TFLM quantization scheme (0 for power of two input scales)
 * @param [in] nInputLeftShift - shift, corresponds to TFLM quantization scheme
 * @param [in] nInputSize - input size
-* @param [in] pInputData - input buffer (Q3.12)
+* @param [in] pInputData - input buffer
 *
 * @param [out] pOutputData - output buffer(Q0.15)
 *
@@ -447,60 +555,372 @@ void adi_sharcfx_logistic_int16(int32_t nInputMultiplier,
                                 const int16_t* pInputData,
                                 int16_t* pOutputData)
 {
-    int16_t* pInput_in_q3_12 = (int16_t*)nQFormatBuffer;
-    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pInputData;
-    xb_vec2Mx16 *outp = (xb_vec2Mx16 *)pInput_in_q3_12;
-    valign ina,outa; // define align vector
-    ina=PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
-    outa = PDX_Z_ALIGN();
+    xb_vec2Mx16 vTable[SIGMOID_TABLE_SIZE/(2*PDX_M)];
+    xb_vec2Mx16 vDelta[SIGMOID_TABLE_SIZE/(2*PDX_M)];
+    sigmoid_table_load(nSigmoidTable, vTable);
+    sigmoid_table_load(nSigmoidTableDelta, vDelta);
 
-    xb_vec2Mx16 vin;
-    int32_t nPixLeft = nInputSize;
-    int32_t nTempRound = nInputLeftShift > 0 ? (1<<(nInputLeftShift-1)) : 0;
-    //scaling input to fit into Q3.12.
+    //power of two scales: the 3/4 range expansion is applied with the multiplier
     if (nInputMultiplier == 0)
     {
-        for (int i = 0; i < nInputSize; i += (PDX_2M))
+        nInputMultiplier = 3 << nInputLeftShift;
+        nInputLeftShift = 0;
+    }
+    int32_t nTempRound = nInputLeftShift > 0 ? (1<<(nInputLeftShift-1)) : 0;
+    xb_vec2Mx16 vMult = nInputMultiplier;
+    xb_vec2Mx40 vZero = 0;
+
+    xb_vec2Mx16 vin;
+    xb_vec2Mx40 vInput, vAbs, vResult;
+    vbool2M negative;
+    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pInputData;
+    valign ina = PDX_LA_2MX16_PP(inp);
+    xb_vec2Mx16 *outp = (xb_vec2Mx16 *)pOutputData;
+    valign outa = PDX_Z_ALIGN();
+    int32_t nBytesLeft = nInputSize*sizeof(int16_t);
+
+    for (int32_t i = 0; i < nInputSize; i += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vin, ina, inp, nBytesLeft);
+        vInput = PDX_MULW_2MX16(vin, vMult);
+        vInput = PDX_ADD_2MX40(vInput, nTempRound);
+        vInput = PDX_SRA_2MX40(vInput, nInputLeftShift);
+        negative = PDX_LT_2MX40(vInput, vZero);
+        vAbs = PDX_MOV_2MX40_T(vZero - vInput, vInput, negative);
+
+        //9 fraction bits per table step, saturates to 0x7FFF<<10
+        vResult = sigmoid_table_interpolate(vAbs, 9, vTable, vDelta, (0x7FFF<<10) - (1<<24));
+        //sigmoid(-x) = 1 - sigmoid(x) with the reference rounding, adding back the table offset
+        vResult = PDX_MOV_2MX40_T((1<<24) + (1<<9) - 1 - vResult, vResult + (1<<24) + (1<<9), negative);
+        vResult = PDX_SRA_2MX40(vResult, 10);
+        PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(vResult, 0), outa, outp, nBytesLeft);
+        nBytesLeft -= PDX_4M;
+    }
+    PDX_SAPOS_2MX16_FP(outa, outp);
+}
+
+/*UTILITY FUNCTION*/
+//TFLite SaturatingRoundingDoublingHighMul for 16bit lanes: (a*b + 2^14)>>15 with saturation,
+//the arithmetic shift rounds half towards positive infinity, as the reference nudge with truncating division does
+inline xb_vec2Mx16 activation_srdhm_int16(xb_vec2Mx16 a, xb_vec2Mx16 b)
+{
+    xb_vec2Mx40 w = PDX_MULW_2MX16(a, b);
+    w = PDX_ADD_2MX40(w, 1<<14);
+    return PDX_PACKSIV_2MX40(w, 15);
+}
+
+/*UTILITY FUNCTION*/
+//TFLite RoundingDivideByPOT for 16bit lanes: round half away from zero of x/2^nExponent
+inline xb_vec2Mx16 activation_rdbpot_int16(xb_vec2Mx16 x, int32_t nExponent)
+{
+    if (nExponent <= 0)
+    {
+        return x;
+    }
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx40 w = PDX_MULW_2MX16(x, vOne);
+    PDX_MULAW_2MX16(w, PDX_SRAI_2MX16(x, 15), vOne);      //-1 for negative lanes
+    w = PDX_ADD_2MX40(w, 1<<(nExponent-1));
+    w = PDX_SRA_2MX40(w, nExponent);
+    return PDX_PACKSIV_2MX40(w, 0);
+}
+
+/*UTILITY FUNCTION*/
+//TFLite SaturatingLeftShift for 16bit lanes
+inline xb_vec2Mx16 activation_sat_shl_int16(xb_vec2Mx16 x, int32_t nShift)
+{
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx40 w = PDX_MULW_2MX16(x, vOne);
+    w = PDX_SLS_2MX40(w, nShift);
+    return PDX_PACKSIV_2MX40(w, 0);
+}
+
+/*UTILITY FUNCTION*/
+//TFLite MultiplyByQuantizedMultiplier for 32bit lanes: SaturatingRoundingDoublingHighMul with the left shift applied,
+//followed by RoundingDivideByPOT for a right shift
+inline xb_vecMx32 activation_mbqm(xb_vecMx32 x, int32_t nQuantizedMultiplier, int32_t nQuantizedShift)
+{
+    xb_vecMx32 vMult = nQuantizedMultiplier;
+    xb_vecMx32 vLeftShift = MAX(nQuantizedShift, 0) + 1;     //+1 as PDX_PACKQSRV_MX80 divides by 2^32
+    int32_t nRightShift = MAX(-nQuantizedShift, 0);
+    xb_vecMx80 quant_acc;
+    xb_vecMx32 result;
+
+    quant_acc = vMult * x;
+    quant_acc = PDX_SLS_MX80(quant_acc, vLeftShift);
+    result = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);
+    if (nRightShift > 0)
+    {
+        xb_vecMx32 vRound = 1<<(nRightShift-1);
+        xb_vecMx32 vSign = PDX_SLS_MX32(result, (xb_vecMx32)(-31));      //-1 for negative lanes
+        result = result + vRound + vSign;
+        result = PDX_SLS_MX32(result, (xb_vecMx32)(-nRightShift));
+    }
+    return result;
+}
+
+/*UTILITY FUNCTION*/
+//Select the identity or the alpha branch per lane on the sign of the offset input, add the zeropoint and store as 8bit
+inline void activation_select_and_store(xb_vecMx32 vInput,
+                                        xb_vecMx32 vPositive,
+                                        xb_vecMx32 vNegative,
+                                        xb_vecMx32 vOutZP,
+                                        int32_t nCount,
+                                        xb_vecMx8* &outp,
+                                        valign &outa)
+{
+    xb_vecMx32 vZero = 0;
+    xb_vecMx32 vmin = INT_8BIT_MIN;
+    xb_vecMx32 vmax = INT_8BIT_MAX;
+    vboolM negative = PDX_LT_MX32(vInput, vZero);
+    xb_vecMx32 result = PDX_MOV_MX32_T(vNegative, vPositive, negative);
+    result += vOutZP;
+    result = PDX_MIN_MX32(result, vmax);
+    result = PDX_MAX_MX32(result, vmin);
+    PDX_SAV32_MX8_XP(result, outa, outp, nCount);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_hard_swish_int8
+* @brief optimized implementation of hard swish activation function
+*
+* @details optimized implementation of hard swish (x*relu6(x+3)/6) activation function for int8 data.
+* Follows the 16bit fixed point sequence of the TFLite reference kernel step by step, so the output is bit exact.
+*
+* Parameters:
+* @param [in] pInput - input buffer
+* @param [in] nSize - # of elements
+* @param [in] nInputZeroPoint - input zeropoint
+* @param [in] nOutputZeroPoint - output zeropoint
+* @param [in] nReluishMultiplier - 16bit fixed point reluish multiplier, corresponds to TFLM HardSwishParams
+* @param [in] nReluishShift - reluish multiplier exponent, corresponds to TFLM HardSwishParams
+* @param [in] nOutputMultiplier - 16bit fixed point output multiplier, corresponds to TFLM HardSwishParams
+* @param [in] nOutputShift - output multiplier exponent (<= 0), corresponds to TFLM HardSwishParams
+*
+* @param [out] pOutput - output buffer
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_hard_swish_int8(const int8_t* pInput,
+                                 int8_t* pOutput,
+                                 int32_t nSize,
+                                 int32_t nInputZeroPoint,
+                                 int32_t nOutputZeroPoint,
+                                 int16_t nReluishMultiplier,
+                                 int32_t nReluishShift,
+                                 int16_t nOutputMultiplier,
+                                 int32_t nOutputShift)
+{
+    xb_vec2Mx16 vInZP = nInputZeroPoint;
+    xb_vec2Mx16 vOutZP = nOutputZeroPoint;
+    xb_vec2Mx16 vReluishMult = nReluishMultiplier;
+    xb_vec2Mx16 vOutputMult = nOutputMultiplier;
+    xb_vec2Mx16 vmin = INT_8BIT_MIN;
+    xb_vec2Mx16 vmax = INT_8BIT_MAX;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx16 vin, vHiRes, vPreShift, vReluish, result;
+    xb_vec2Mx40 w;
+    vbool2M negative;
+
+    xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pInput;
+    valign ina = PDX_LA_2MX8_PP(inp);
+    xb_vec2Mx8 *outp = (xb_vec2Mx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t n = 0; n < nSize; n += 2*PDX_M)
+    {
+        PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+        vin -= vInZP;
+        vHiRes = PDX_SLLI_2MX16(vin, 7);                        //input on the hires input scale
+        vPreShift = activation_srdhm_int16(vHiRes, vOutputMult);
+
+        //reluish value: (x+3)/6 mapped to [-1,1] in Q0.15
+        vReluish = vHiRes;
+        if (nReluishShift > 0)
         {
-            xb_vec2Mx16 vTempInput ;
-            PDX_LA_2MX16_XP (vin, ina, inp, PDX_4M); // load aligned, extend
-            vTempInput = PDX_SLS_2MX16(vin, nInputLeftShift);
-            PDX_SAV_2MX16_XP(vTempInput,outa,outp, PDX_4M);
-            PDX_SAPOS_2MX16_FP( outa, outp );
-            nPixLeft -=PDX_2M;
+            vReluish = activation_sat_shl_int16(vReluish, nReluishShift - 1);
         }
-        if(nPixLeft>0)
+        vReluish = activation_srdhm_int16(vReluish, vReluishMult);
+        if (nReluishShift > 0)
         {
-            xb_vec2Mx16 vTempInput ;
-            PDX_LA_2MX16_XP (vin, ina, inp, 0); // load aligned, extend
-            vTempInput = PDX_SLS_2MX16(vin, nInputLeftShift);
-            PDX_SAV_2MX16_XP(vTempInput,outa,outp, nPixLeft*2);
-            PDX_SAPOS_2MX16_FP( outa, outp );
+            vReluish = activation_sat_shl_int16(vReluish, 1);
         }
+        vReluish = activation_rdbpot_int16(vReluish, -nReluishShift);
+        //(reluish + 2^15)>>1 maps [-1,1] to [0,1]
+        w = PDX_MULW_2MX16(vReluish, vOne);
+        w = PDX_ADD_2MX40(w, 1<<15);
+        vReluish = PDX_PACKSIV_2MX40(w, 1);
+
+        //SaturatingDoublingHighMul: a*b/2^15 truncated towards zero
+        w = PDX_MULW_2MX16(vReluish, vPreShift);
+        negative = PDX_LT_2MX40(w, 0);
+        w = PDX_MOV_2MX40_T(PDX_ADD_2MX40(w, (1<<15) - 1), w, negative);
+        result = PDX_PACKSIV_2MX40(w, 15);
+
+        result = activation_rdbpot_int16(result, -nOutputShift);
+        result += vOutZP;
+        result = PDX_MIN_2MX16(result, vmax);
+        result = PDX_MAX_2MX16(result, vmin);
+        PDX_SAV16_2MX8_XP(result, outa, outp, MIN(2*PDX_M, nSize - n));
     }
-    else
+    PDX_SAPOS_2MX8_FP(outa, outp);//flush
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_leaky_relu_int8
+* @brief optimized implementation of leaky Relu activation function
+*
+* @details optimized implementation of leaky Relu activation function for int8 data. Both the identity and the alpha
+* requantization are computed for 2*PDX_M lanes and selected on the sign of the offset input, with TFLite rounding.
+*
+* Parameters:
+* @param [in] pInput - input buffer
+* @param [in] nSize - # of elements
+* @param [in] nInputZeroPoint - input zeropoint
+* @param [in] nOutputZeroPoint - output zeropoint
+* @param [in] nMultiplierAlpha - multiplier for negative inputs, corresponds to TFLM LeakyReluParams
+* @param [in] nShiftAlpha - shift for negative inputs, corresponds to TFLM LeakyReluParams
+* @param [in] nMultiplierIdentity - multiplier for positive inputs, corresponds to TFLM LeakyReluParams
+* @param [in] nShiftIdentity - shift for positive inputs, corresponds to TFLM LeakyReluParams
+*
+* @param [out] pOutput - output buffer
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_leaky_relu_int8(const int8_t* pInput,
+                                 int8_t* pOutput,
+                                 int32_t nSize,
+                                 int32_t nInputZeroPoint,
+                                 int32_t nOutputZeroPoint,
+                                 int32_t nMultiplierAlpha,
+                                 int32_t nShiftAlpha,
+                                 int32_t nMultiplierIdentity,
+                                 int32_t nShiftIdentity)
+{
+    xb_vec2Mx16 vInZP = nInputZeroPoint;
+    xb_vecMx32 vOutZP = nOutputZeroPoint;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx16 vin;
+    xb_vec2Mx40 acc;
+    xb_vecMx32 first8, last8;
+
+    xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pInput;
+    valign ina = PDX_LA_2MX8_PP(inp);
+    xb_vecMx8 *outp = (xb_vecMx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t n = 0; n < nSize; n += 2*PDX_M)
     {
-        xb_vec2Mx40 vTempOut;
-        for (int i = 0; i < nInputSize; i += PDX_2M)
+        PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+        vin -= vInZP;
+        acc = PDX_MULW_2MX16(vin, vOne);
+        PDX_CVT32D_2MX40(last8, first8, acc);
+
+        activation_select_and_store(first8,
+                                    activation_mbqm(first8, nMultiplierIdentity, nShiftIdentity),
+                                    activation_mbqm(first8, nMultiplierAlpha, nShiftAlpha),
+                                    vOutZP, MIN(PDX_M, nSize - n), outp, outa);
+        if (nSize - n > PDX_M)
         {
-            PDX_LA_2MX16_XP (vin, ina, inp, PDX_4M); // load aligned, extend
-            vTempOut = PDX_MULW_2MX16(vin,nInputMultiplier);
-            vTempOut = PDX_ADD_2MX40(vTempOut,nTempRound);
-            vTempOut = PDX_SRA_2MX40(vTempOut,nInputLeftShift);
-            PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(vTempOut,0),outa,outp, PDX_4M);
-            PDX_SAPOS_2MX16_FP( outa, outp );
-            nPixLeft -=PDX_2M;
+            activation_select_and_store(last8,
+                                        activation_mbqm(last8, nMultiplierIdentity, nShiftIdentity),
+                                        activation_mbqm(last8, nMultiplierAlpha, nShiftAlpha),
+                                        vOutZP, MIN(PDX_M, nSize - n - PDX_M), outp, outa);
         }
-        if(nPixLeft>0)
+    }
+    PDX_SAPOS_MX8_FP(outa, outp);//flush
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_prelu_int8
+* @brief optimized implementation of PRelu activation function
+*
+* @details optimized implementation of PRelu activation function for int8 data with a per channel alpha broadcast over
+* the channel interleaved input. Negative inputs are multiplied by the offset alpha in 16bit lanes before requantization,
+* both branches use TFLite rounding and are selected on the sign of the offset input.
+*
+* Parameters:
+* @param [in] pInput - input buffer, [size/channels][channels]
+* @param [in] pAlpha - alpha per channel, [channels]
+* @param [in] nSize - # of elements
+* @param [in] nChannels - # of channels (alpha length)
+* @param [in] nInputOffset - input offset (negated input zeropoint)
+* @param [in] nAlphaOffset - alpha offset (negated alpha zeropoint)
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] nMultiplier1 - multiplier for positive inputs, corresponds to TFLM PreluParams
+* @param [in] nShift1 - shift for positive inputs, corresponds to TFLM PreluParams
+* @param [in] nMultiplier2 - multiplier for input*alpha, corresponds to TFLM PreluParams
+* @param [in] nShift2 - shift for input*alpha, corresponds to TFLM PreluParams
+*
+* @param [out] pOutput - output buffer
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_prelu_int8(const int8_t* pInput,
+                            const int8_t* pAlpha,
+                            int8_t* pOutput,
+                            int32_t nSize,
+                            int32_t nChannels,
+                            int32_t nInputOffset,
+                            int32_t nAlphaOffset,
+                            int32_t nOutputOffset,
+                            int32_t nMultiplier1,
+                            int32_t nShift1,
+                            int32_t nMultiplier2,
+                            int32_t nShift2)
+{
+    xb_vec2Mx16 vInZP = nInputOffset;
+    xb_vec2Mx16 vAlphaZP = nAlphaOffset;
+    xb_vecMx32 vOutZP = nOutputOffset;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx16 vin, valpha;
+    xb_vec2Mx40 acc;
+    xb_vecMx32 first8, last8, first8_alpha, last8_alpha;
+
+    xb_vecMx8 *outp = (xb_vecMx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t nPixel = 0; nPixel < nSize; nPixel += nChannels)
+    {
+        xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pInput + nPixel);
+        valign ina = PDX_LA_2MX8_PP(inp);
+        xb_vec2Mx8 *alp = (xb_vec2Mx8 *)pAlpha;
+        valign ala = PDX_LA_2MX8_PP(alp);
+
+        for (int32_t nChannel = 0; nChannel < nChannels; nChannel += 2*PDX_M)
         {
-            PDX_LA_2MX16_XP (vin, ina, inp, 0); // load aligned, extend
-            vTempOut = PDX_MULW_2MX16(vin,nInputMultiplier);
-            vTempOut = PDX_ADD_2MX40(vTempOut,nTempRound);  //rounding multiplied scaled input with round data nTempRound for 16 bit data;
-            vTempOut = PDX_SRA_2MX40 (vTempOut,nInputLeftShift);
-            PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(vTempOut,0),outa,outp, nPixLeft*2);
-            PDX_SAPOS_2MX16_FP( outa, outp );
+            int32_t nLeft = nChannels - nChannel;
+            PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+            PDX_LA16_2MX8_XP(valpha, ala, alp, 2*PDX_M);
+            vin += vInZP;
+            valpha += vAlphaZP;
+
+            acc = PDX_MULW_2MX16(vin, vOne);
+            PDX_CVT32D_2MX40(last8, first8, acc);
+            acc = PDX_MULW_2MX16(vin, valpha);
+            PDX_CVT32D_2MX40(last8_alpha, first8_alpha, acc);
+
+            activation_select_and_store(first8,
+                                        activation_mbqm(first8, nMultiplier1, nShift1),
+                                        activation_mbqm(first8_alpha, nMultiplier2, nShift2),
+                                        vOutZP, MIN(PDX_M, nLeft), outp, outa);
+            if (nLeft > PDX_M)
+            {
+                activation_select_and_store(last8,
+                                            activation_mbqm(last8, nMultiplier1, nShift1),
+                                            activation_mbqm(last8_alpha, nMultiplier2, nShift2),
+                                            vOutZP, MIN(PDX_M, nLeft - PDX_M), outp, outa);
+            }
         }
     }
-
-    vecsigmoid_16b_Q0_15(pInput_in_q3_12, pOutputData , nInputSize);
+    PDX_SAPOS_MX8_FP(outa, outp);//flush
 }
@@ -0,0 +1,489 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_batch_matmul.cpp
+*
+* @brief: contains optimized version of batch matrix multiplication
+*
+* @details: contains optimized batch matrix multiplication of two activation tensors for 8bit and 16bit integer input
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Requantize a 40bit sum with the per tensor multiplier and shift, saturating the sum to 32bit first
+inline int32_t batch_matmul_requantize(xb_int40 sat_sum,
+                                       int32_t nQuantizedMultiplier,
+                                       int32_t nQuantizedShift)
+{
+    xb_int32 temp;
+    xb_int80 product;
+
+    sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+    sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+    temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+    product = PDX_MULW_32(temp, (xb_int32)nQuantizedMultiplier);    //product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+    product = PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+    temp = PDX_PACKQSRV_80(product,ROUNDING_MODE);                  //same rounding as quantize_and_store_channels of the panel path
+    return (int32_t)temp;
+}
+
+/*UTILITY FUNCTION*/
+//Dot product of two 16bit rows. Products are not doubled, variable length loads zero the lanes past nDepth
+inline xb_vec2Mx40 batch_matmul_int16_dot(const int16_t *pLhs,
+                                          const int16_t *pRhs,
+                                          int32_t nDepth)
+{
+    xb_vec2Mx16 vLhs, vRhs;
+    xb_vec2Mx40 acc = 0;
+    xb_vec2Mx16 *lp = (xb_vec2Mx16 *)pLhs;
+    xb_vec2Mx16 *rp = (xb_vec2Mx16 *)pRhs;
+    valign la = PDX_LA_2MX16_PP(lp);
+    valign ra = PDX_LA_2MX16_PP(rp);
+    int32_t nBytesLeft = nDepth*sizeof(int16_t);
+
+    for (int32_t n = 0; n < nDepth; n += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vLhs, la, lp, nBytesLeft);
+        PDX_LAV_2MX16_XP(vRhs, ra, rp, nBytesLeft);
+        nBytesLeft -= PDX_4M;
+        PDX_MULAW_2MX16(acc, vLhs, vRhs);
+    }
+    return acc;
+}
+
+/*UTILITY FUNCTION*/
+//Copy 2*PDX_M columns of a [depth][cols] RHS into a contiguous [depth][2*PDX_M] 16bit panel with the offset added.
+//Full panels are copied one sign extended vector per depth row. Columns past nPanelCols of the last panel are zeroed
+//so the full panel width can be multiplied, that panel is copied element wise to not read past the RHS
+inline void batch_matmul_load_panel_int8(const int8_t *pRhs,
+                                         int16_t *pPanel,
+                                         int32_t nDepth,
+                                         int32_t nCols,
+                                         int32_t nPanelCols,
+                                         int32_t nRhsOffset)
+{
+    if (nPanelCols == 2*PDX_M)
+    {
+        xb_vec2Mx16 vRhsZP = nRhsOffset;
+        xb_vec2Mx16 vin;
+        xb_vec2Mx16 *outp = (xb_vec2Mx16 *)pPanel;
+        valign outa = PDX_Z_ALIGN();
+        for (int32_t k = 0; k < nDepth; k++)
+        {
+            xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pRhs + k*nCols);
+            valign ina = PDX_LA_2MX8_PP(inp);
+            PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+            PDX_SAV_2MX16_XP(PDX_ADD_2MX16(vin, vRhsZP), outa, outp, 2*PDX_M*sizeof(int16_t));
+        }
+        PDX_SAPOS_2MX16_FP(outa, outp);
+        return;
+    }
+
+    for (int32_t k = 0; k < nDepth; k++)
+    {
+        int32_t c;
+        for (c = 0; c < nPanelCols; c++)
+        {
+            *pPanel++ = (int16_t)(pRhs[k*nCols + c] + nRhsOffset);
+        }
+        for (; c < 2*PDX_M; c++)
+        {
+            *pPanel++ = 0;
+        }
+    }
+}
+
+/*UTILITY FUNCTION*/
+//16bit variant of batch_matmul_load_panel_int8, 16bit tensors are symmetric so no offset is added.
+//The variable length load reads only nPanelCols columns and zeroes the other lanes
+inline void batch_matmul_load_panel_int16(const int16_t *pRhs,
+                                          int16_t *pPanel,
+                                          int32_t nDepth,
+                                          int32_t nCols,
+                                          int32_t nPanelCols)
+{
+    xb_vec2Mx16 vin;
+    xb_vec2Mx16 *outp = (xb_vec2Mx16 *)pPanel;
+    valign outa = PDX_Z_ALIGN();
+    for (int32_t k = 0; k < nDepth; k++)
+    {
+        xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pRhs + k*nCols);
+        valign ina = PDX_LA_2MX16_PP(inp);
+        PDX_LAV_2MX16_XP(vin, ina, inp, nPanelCols*sizeof(int16_t));
+        PDX_SAV_2MX16_XP(vin, outa, outp, 2*PDX_M*sizeof(int16_t));
+    }
+    PDX_SAPOS_2MX16_FP(outa, outp);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_batch_matmul_int8_ctx
+* @brief optimized batch matrix multiplication function
+*
+* @details optimized batch matrix multiplication for 8-bit integer input where both operands are activations,
+* e.g. Q*K^T and attention*V. Output = LHS x RHS per batch with per tensor requantization.
+* With nTransposeRhs = 0 the RHS is [depth][cols] and is processed in panels of 2*PDX_M columns copied to a
+* contiguous 16bit buffer in L1, each LHS element is broadcast against one panel row. A panel larger than the fast scratch
+* goes to the large scratch, and the output is left untouched if it does not fit there either.
+* With nTransposeRhs = 1 the RHS is [cols][depth], rows are copied to L1 in blocks and every output is a row dot product.
+* A batch stride of 0 broadcasts one operand matrix to all batches. The batch loop is inside the panel/block loop, so a
+* broadcast RHS is copied to L1 once per panel or block instead of once per batch.
+*
+* Parameters:
+* @param [in] pLhsBuffer - left operand, [batch][rows][depth], or [rows][depth] when broadcast
+* @param [in] pRhsBuffer - right operand, [batch][depth][cols] or [batch][cols][depth] when transposed, no batch dim when broadcast
+* @param [in] nBatches - batch size
+* @param [in] nRows - # of rows of the left operand and of the output
+* @param [in] nDepth - inner dimension
+* @param [in] nCols - # of columns of the output
+* @param [in] nTransposeRhs - 1 if the right operand is stored transposed
+* @param [in] nLhsBatchStride - # of elements between left operand batches, rows*depth or 0 to broadcast
+* @param [in] nRhsBatchStride - # of elements between right operand batches, depth*cols or 0 to broadcast
+* @param [in] nLhsOffset - left operand offset (negated zeropoint)
+* @param [in] nRhsOffset - right operand offset (negated zeropoint)
+* @param [in] nQuantizedMultiplier - output multiplier
+* @param [in] nQuantizedShift - output shift
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data, [batch][rows][cols]
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_batch_matmul_int8_ctx(const int8_t* pLhsBuffer,
+                                          const int8_t* pRhsBuffer,
+                                          int8_t* pOutputBuffer,
+                                          int32_t nBatches,
+                                          int32_t nRows,
+                                          int32_t nDepth,
+                                          int32_t nCols,
+                                          int32_t nTransposeRhs,
+                                          int32_t nLhsBatchStride,
+                                          int32_t nRhsBatchStride,
+                                          int32_t nLhsOffset,
+                                          int32_t nRhsOffset,
+                                          int32_t nQuantizedMultiplier,
+                                          int32_t nQuantizedShift,
+                                          int32_t nOutputOffset,
+                                          const ADI_SHARCFX_CONTEXT* pContext)
+{
+    xb_vec2Mx40 acc;
+
+    if (nTransposeRhs)
+    {
+        xb_vec2Mx16 vLhsZP = nLhsOffset;
+        xb_vec2Mx16 vRhsZP = nRhsOffset;
+
+        //# of RHS rows kept in L1 at a time
+        int32_t nBlockRows = MIN(nCols, get_scratch_size(pContext) / MAX(nDepth, 1));
+
+        for (int32_t nColStart = 0; nColStart < nCols; nColStart += MAX(nBlockRows, 1))
+        {
+            int32_t nBlock = MIN(MAX(nBlockRows, 1), nCols - nColStart);
+            for (int32_t b = 0; b < nBatches; b++)
+            {
+                const int8_t *pLhs = pLhsBuffer + b*nLhsBatchStride;
+                const int8_t *pRhsBlock = pRhsBuffer + b*nRhsBatchStride + nColStart*nDepth;
+                int8_t *pOut = pOutputBuffer + b*nRows*nCols;
+                if (nBlockRows > 0)
+                {
+                    //a broadcast RHS block stays in L1 for all batches
+                    if (b == 0 || nRhsBatchStride != 0)
+                    {
+                        memcpy(get_scratch(pContext), pRhsBlock, nBlock*nDepth);
+                    }
+                    pRhsBlock = get_scratch(pContext);
+                }
+
+                for (int32_t m = 0; m < nRows; m++)
+                {
+                    for (int32_t n = 0; n < nBlock; n++)
+                    {
+                        acc = fully_connected_int8_mac(pLhs + m*nDepth, pRhsBlock + n*nDepth, nDepth, vLhsZP, vRhsZP);
+                        int32_t nOut = batch_matmul_requantize(PDX_RADD_2MX40(acc), nQuantizedMultiplier, nQuantizedShift);
+                        nOut += nOutputOffset;
+                        nOut = MIN(nOut, INT_8BIT_MAX);
+                        nOut = MAX(nOut, INT_8BIT_MIN);
+                        pOut[m*nCols + nColStart + n] = (int8_t)nOut;
+                    }
+                }
+            }
+        }
+        return 0;
+    }
+
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+    }
+    xb_vecMx32 vOutZP = nOutputOffset;
+    xb_vecMx32 vmin = INT_8BIT_MIN;
+    xb_vecMx32 vmax = INT_8BIT_MAX;
+
+    //panel of 2*PDX_M 16bit columns, in L1 when it fits
+    int16_t *pPanel = (int16_t *)get_scratch(pContext);
+    int32_t nPanelBytes = (int32_t)(nDepth*2*PDX_M*sizeof(int16_t));
+    if (nPanelBytes > get_scratch_size(pContext))
+    {
+        //the panel fits neither scratch
+        if (nPanelBytes > get_scratch_l3_size(pContext, TEMP_BUFFER_SIZE_L3))
+        {
+            return -1;
+        }
+        pPanel = (int16_t *)get_scratch_l3(pContext, pTempL3);
+    }
+
+    for (int32_t nColStart = 0; nColStart < nCols; nColStart += 2*PDX_M)
+    {
+        int32_t nPanelCols = MIN(2*PDX_M, nCols - nColStart);
+        for (int32_t b = 0; b < nBatches; b++)
+        {
+            const int8_t *pLhs = pLhsBuffer + b*nLhsBatchStride;
+            int8_t *pOut = pOutputBuffer + b*nRows*nCols;
+            //a broadcast RHS panel is loaded once for all batches
+            if (b == 0 || nRhsBatchStride != 0)
+            {
+                batch_matmul_load_panel_int8(pRhsBuffer + b*nRhsBatchStride + nColStart, pPanel, nDepth, nCols,
+                                             nPanelCols, nRhsOffset);
+            }
+
+            for (int32_t m = 0; m < nRows; m++)
+            {
+                const int8_t *pLhsRow = pLhs + m*nDepth;
+                xb_vec2Mx16 *wtp = (xb_vec2Mx16 *)pPanel;
+                valign wta = PDX_LA_2MX16_PP(wtp);
+                xb_vec2Mx16 vin, vwt;
+                acc = 0;
+                for (int32_t k = 0; k < nDepth; k++)
+                {
+                    vin = (int16_t)(pLhsRow[k] + nLhsOffset);    //broadcast LHS element
+                    PDX_LA_2MX16_XP(vwt, wta, wtp, 2*PDX_M*sizeof(int16_t));
+                    PDX_MULAQW_2MX16(acc, vwt, vin);
+                }
+
+                xb_vecMx8 *outp = (xb_vecMx8 *)(pOut + m*nCols + nColStart);
+                valign outa = PDX_Z_ALIGN();
+                quantize_and_store_channels(acc, NULL, pMult, pShift, nPanelCols, vOutZP, vmin, vmax, outp, outa);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_batch_matmul_int8
+* @brief adi_sharcfx_batch_matmul_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_batch_matmul_int8_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_batch_matmul_int8(const int8_t* pLhsBuffer,
+                                      const int8_t* pRhsBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nBatches,
+                                      int32_t nRows,
+                                      int32_t nDepth,
+                                      int32_t nCols,
+                                      int32_t nTransposeRhs,
+                                      int32_t nLhsBatchStride,
+                                      int32_t nRhsBatchStride,
+                                      int32_t nLhsOffset,
+                                      int32_t nRhsOffset,
+                                      int32_t nQuantizedMultiplier,
+                                      int32_t nQuantizedShift,
+                                      int32_t nOutputOffset)
+{
+    return adi_sharcfx_batch_matmul_int8_ctx(pLhsBuffer, pRhsBuffer, pOutputBuffer, nBatches, nRows, nDepth, nCols,
+                                             nTransposeRhs, nLhsBatchStride, nRhsBatchStride, nLhsOffset, nRhsOffset,
+                                             nQuantizedMultiplier, nQuantizedShift, nOutputOffset, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_batch_matmul_int16_ctx
+* @brief optimized batch matrix multiplication function
+*
+* @details optimized batch matrix multiplication for 16-bit integer input where both operands are activations.
+* Same layouts, batch broadcasting and scratch checks as adi_sharcfx_batch_matmul_int8. 16bit tensors are symmetric, products are accumulated undoubled
+* with PDX_MULAW_2MX16 for headroom and the shift is increased by 1 at requantization.
+*
+* Parameters:
+* @param [in] pLhsBuffer - left operand, [batch][rows][depth], or [rows][depth] when broadcast
+* @param [in] pRhsBuffer - right operand, [batch][depth][cols] or [batch][cols][depth] when transposed, no batch dim when broadcast
+* @param [in] nBatches - batch size
+* @param [in] nRows - # of rows of the left operand and of the output
+* @param [in] nDepth - inner dimension
+* @param [in] nCols - # of columns of the output
+* @param [in] nTransposeRhs - 1 if the right operand is stored transposed
+* @param [in] nLhsBatchStride - # of elements between left operand batches, rows*depth or 0 to broadcast
+* @param [in] nRhsBatchStride - # of elements between right operand batches, depth*cols or 0 to broadcast
+* @param [in] nQuantizedMultiplier - output multiplier
+* @param [in] nQuantizedShift - output shift
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data, [batch][rows][cols]
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_batch_matmul_int16_ctx(const int16_t* pLhsBuffer,
+                                           const int16_t* pRhsBuffer,
+                                           int16_t* pOutputBuffer,
+                                           int32_t nBatches,
+                                           int32_t nRows,
+                                           int32_t nDepth,
+                                           int32_t nCols,
+                                           int32_t nTransposeRhs,
+                                           int32_t nLhsBatchStride,
+                                           int32_t nRhsBatchStride,
+                                           int32_t nQuantizedMultiplier,
+                                           int32_t nQuantizedShift,
+                                           const ADI_SHARCFX_CONTEXT* pContext)
+{
+    xb_vec2Mx40 acc;
+
+    if (nTransposeRhs)
+    {
+        //# of RHS rows kept in L1 at a time
+        int32_t nBlockRows = MIN(nCols, (int32_t)(get_scratch_size(pContext) / (MAX(nDepth, 1)*sizeof(int16_t))));
+
+        for (int32_t nColStart = 0; nColStart < nCols; nColStart += MAX(nBlockRows, 1))
+        {
+            int32_t nBlock = MIN(MAX(nBlockRows, 1), nCols - nColStart);
+            for (int32_t b = 0; b < nBatches; b++)
+            {
+                const int16_t *pLhs = pLhsBuffer + b*nLhsBatchStride;
+                const int16_t *pRhsBlock = pRhsBuffer + b*nRhsBatchStride + nColStart*nDepth;
+                int16_t *pOut = pOutputBuffer + b*nRows*nCols;
+                if (nBlockRows > 0)
+                {
+                    //a broadcast RHS block stays in L1 for all batches
+                    if (b == 0 || nRhsBatchStride != 0)
+                    {
+                        memcpy(get_scratch(pContext), pRhsBlock, nBlock*nDepth*sizeof(int16_t));
+                    }
+                    pRhsBlock = (const int16_t *)get_scratch(pContext);
+                }
+
+                for (int32_t m = 0; m < nRows; m++)
+                {
+                    for (int32_t n = 0; n < nBlock; n++)
+                    {
+                        acc = batch_matmul_int16_dot(pLhs + m*nDepth, pRhsBlock + n*nDepth, nDepth);
+                        //products are not doubled, shift one more to match PDX_PACKQSRV_80
+                        int32_t nOut = batch_matmul_requantize(PDX_RADD_2MX40(acc), nQuantizedMultiplier, nQuantizedShift + 1);
+                        nOut = MIN(nOut, INT_16BIT_MAX);
+                        nOut = MAX(nOut, INT_16BIT_MIN);
+                        pOut[m*nCols + nColStart + n] = (int16_t)nOut;
+                    }
+                }
+            }
+        }
+        return 0;
+    }
+
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+    }
+    xb_vecMx32 vmin = INT_16BIT_MIN;
+    xb_vecMx32 vmax = INT_16BIT_MAX;
+
+    //panel of 2*PDX_M 16bit columns, in L1 when it fits
+    int16_t *pPanel = (int16_t *)get_scratch(pContext);
+    int32_t nPanelBytes = (int32_t)(nDepth*2*PDX_M*sizeof(int16_t));
+    if (nPanelBytes > get_scratch_size(pContext))
+    {
+        //the panel fits neither scratch
+        if (nPanelBytes > get_scratch_l3_size(pContext, TEMP_BUFFER_SIZE_L3))
+        {
+            return -1;
+        }
+        pPanel = (int16_t *)get_scratch_l3(pContext, pTempL3);
+    }
+
+    for (int32_t nColStart = 0; nColStart < nCols; nColStart += 2*PDX_M)
+    {
+        int32_t nPanelCols = MIN(2*PDX_M, nCols - nColStart);
+        for (int32_t b = 0; b < nBatches; b++)
+        {
+            const int16_t *pLhs = pLhsBuffer + b*nLhsBatchStride;
+            int16_t *pOut = pOutputBuffer + b*nRows*nCols;
+            //a broadcast RHS panel is loaded once for all batches
+            if (b == 0 || nRhsBatchStride != 0)
+            {
+                batch_matmul_load_panel_int16(pRhsBuffer + b*nRhsBatchStride + nColStart, pPanel, nDepth, nCols, nPanelCols);
+            }
+
+            for (int32_t m = 0; m < nRows; m++)
+            {
+                const int16_t *pLhsRow = pLhs + m*nDepth;
+                xb_vec2Mx16 *wtp = (xb_vec2Mx16 *)pPanel;
+                valign wta = PDX_LA_2MX16_PP(wtp);
+                xb_vec2Mx16 vin, vwt;
+                acc = 0;
+                for (int32_t k = 0; k < nDepth; k++)
+                {
+                    vin = pLhsRow[k];      //broadcast LHS element
+                    PDX_LA_2MX16_XP(vwt, wta, wtp, 2*PDX_M*sizeof(int16_t));
+                    PDX_MULAW_2MX16(acc, vin, vwt);
+                }
+
+                xb_vecMx16 *outp = (xb_vecMx16 *)(pOut + m*nCols + nColStart);
+                valign outa = PDX_Z_ALIGN();
+                quantize_and_store_channels_int16(acc, NULL, pMult, pShift, nPanelCols, vmin, vmax, outp, outa);
+            }
+        }
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_batch_matmul_int16
+* @brief adi_sharcfx_batch_matmul_int16_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_batch_matmul_int16_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_batch_matmul_int16(const int16_t* pLhsBuffer,
+                                       const int16_t* pRhsBuffer,
+                                       int16_t* pOutputBuffer,
+                                       int32_t nBatches,
+                                       int32_t nRows,
+                                       int32_t nDepth,
+                                       int32_t nCols,
+                                       int32_t nTransposeRhs,
+                                       int32_t nLhsBatchStride,
+                                       int32_t nRhsBatchStride,
+                                       int32_t nQuantizedMultiplier,
+                                       int32_t nQuantizedShift)
+{
+    return adi_sharcfx_batch_matmul_int16_ctx(pLhsBuffer, pRhsBuffer, pOutputBuffer, nBatches, nRows, nDepth, nCols,
+                                              nTransposeRhs, nLhsBatchStride, nRhsBatchStride, nQuantizedMultiplier, nQuantizedShift,
+                                              NULL);
+}
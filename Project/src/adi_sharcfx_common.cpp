@@ -0,0 +1,25 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_common.cpp
+*
+* @brief: contains the shared static scratch buffers
+*
+* @details: contains the single definition of the static scratch buffers declared in adi_sharcfx_common.h, used by the kernels
+* called without context
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_common.h"
+
+/*============= D A T A =============*/
+int8_t pTemp[TEMP_BUFFER_SIZE]__attribute__((section(".L1.noload"), aligned(8)));		/*scratch buffer used inside kernels*/
+int8_t pTempL3[TEMP_BUFFER_SIZE_L3]__attribute__((section(".L3.noload"), aligned(8)));		/*scratch buffer used inside kernels*/
+int64_t nQFormatBuffer[ARRAY_INPUT_SIZE]__attribute__((section(".L3.noload"), aligned(8)));
@@ -16,7 +16,7 @@
 */
 
 /*============= I N C L U D E S =============*/
-#include "adi_sharcfx_nn.h"
+#include "adi_sharcfx_internal.h"
 
 /*============= F U N C T I O N P R O T O T Y P E S =============*/
 inline int8_t quantize_and_store(xb_vec2Mx40 acc,
@@ -26,6 +26,30 @@ inline int8_t quantize_and_store(xb_vec2Mx40 acc,
                                  int32_t nFil,
                                  int32_t pOutZeroPoint);
 
+inline void conv2d_int16_core(const int16_t *pInputBuffer,
+                              const int8_t *pWeightsTransformed,
+                              const int32_t *pBiasHigh,
+                              const int32_t *pBiasLow,
+                              int16_t *pOutputBuffer,
+                              int32_t nInputHeight,
+                              int32_t nInputWidth,
+                              int32_t nInChannels,
+                              int32_t nOutChannels,
+                              int32_t nKernelHeight,
+                              int32_t nKernelWidth,
+                              int32_t stride_height,
+                              int32_t stride_width,
+                              int32_t nDilationHeight,
+                              int32_t nDilationWidth,
+                              int32_t nPadTop,
+                              int32_t nPadLeft,
+                              int32_t nOutHeight,
+                              int32_t nOutWidth,
+                              const int32_t *pQuantizedMultiplier,
+                              const int32_t *pQuantizedShift,
+                              int32_t nActMin,
+                              int32_t nActMax);
+
 /*============= C O D E =============*/
 
 /**
@@ -216,13 +240,233 @@ void adi_sharcfx_conv2d_kernel1x1_int8(const int8_t* pInputBuffer,
 	return;
 }
 
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel1x1_pixels_int8
+* @brief pixel range 1x1 conv2d function
+*
+* @details adi_sharcfx_conv2d_kernel1x1_int8 restricted to output pixels [nPixelStart, nPixelEnd) of a single batch. A 1x1
+* convolution is pointwise, so the range is the kernel on the pixels of the range and needs no scratch. Output rows
+* [r0, r1) of an image of width W are the pixels [r0*W, r1*W). Calls on disjoint ranges can run concurrently, e.g. one
+* per core, and together produce the output of adi_sharcfx_conv2d_kernel1x1_int8.
+*
+* Parameters:
+* @param [in] nPixelStart - first output pixel
+* @param [in] nPixelEnd - one past the last output pixel
+*
+* see adi_sharcfx_conv2d_kernel1x1_int8 for the other parameters
+*
+* @param [out] pOutputBuffer - output data, only the pixels of the range are written
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel1x1_pixels_int8(const int8_t* pInputBuffer,
+                                              const int8_t* pWeightsBuffer,
+                                              const int32_t* pBiasBuffer,
+                                              int8_t* pOutputBuffer,
+                                              int32_t nInChannels,
+                                              int32_t nOutChannels,
+                                              int32_t *nQuantizedMultiplier,
+                                              int32_t *nQuantizedShift,
+                                              int32_t nInZeroPoint,
+                                              int32_t nOutZeroPoint,
+                                              int32_t nPixelStart,
+                                              int32_t nPixelEnd)
+{
+	adi_sharcfx_conv2d_kernel1x1_int8(pInputBuffer + nPixelStart*nInChannels, pWeightsBuffer, pBiasBuffer,
+									  pOutputBuffer + nPixelStart*nOutChannels, 1, nInChannels, nOutChannels,
+									  nPixelEnd - nPixelStart, nQuantizedMultiplier, nQuantizedShift,
+									  nInZeroPoint, nOutZeroPoint);
+}
+
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel1x1_int4
+* @brief 1x1 conv2d function with int4 weights
+*
+* @details 1x1 2D convolution in interleaved format for 8-bit integer input and symmetric int4 weights packed with
+* adi_sharcfx_pack_int4. The nibbles are unpacked in registers, so the weights take half the memory and bandwidth of
+* adi_sharcfx_conv2d_kernel1x1_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pPackedWeights - packed weights, nOutChannels rows of ADI_SHARCFX_INT4_ROW_BYTES(nInChannels) bytes
+* @param [in] pBiasBuffer - input bias buffer, may be NULL
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nSize - # of pixels per batch
+* @param [in] pQuantizedMultiplier - per channel multiplier
+* @param [in] pQuantizedShift - per channel shift
+* @param [in] nInputOffset - input offset
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] nActMin - activation min
+* @param [in] nActMax - activation max
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel1x1_int4(const int8_t* pInputBuffer,
+                                       const int8_t* pPackedWeights,
+                                       const int32_t* pBiasBuffer,
+                                       int8_t* pOutputBuffer,
+                                       int32_t nBatches,
+                                       int32_t nInChannels,
+                                       int32_t nOutChannels,
+                                       int32_t nSize,
+                                       const int32_t *pQuantizedMultiplier,
+                                       const int32_t *pQuantizedShift,
+                                       int32_t nInputOffset,
+                                       int32_t nOutputOffset,
+                                       int32_t nActMin,
+                                       int32_t nActMax)
+{
+	int8_t* __restrict outp = (int8_t*) pOutputBuffer;
+	int32_t nRowBytes = ADI_SHARCFX_INT4_ROW_BYTES(nInChannels);
+
+	const immediate Lane=0;
+	//Defining the input offset, int4 weights are symmetric
+	xb_vec2Mx16 vInZP = PDX_REP_2MX16((xb_vec2Mx16)nInputOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
+
+	xb_int32 temp;
+	xb_int40 sat_sum;
+	xb_int80 product;
+	xb_vec2Mx40 acc = 0;
+
+	//every pixel of every batch is a fully connected layer over the input channels
+	for(int32_t nCol=0; nCol < nBatches*nSize; nCol++)
+	{
+		//do all output channels for a single pixel
+		for (int32_t nChannelCnt = 0; nChannelCnt < nOutChannels; nChannelCnt++)
+		{
+			acc = fully_connected_int4_mac(pInputBuffer + nCol*nInChannels,
+			                               pPackedWeights + nChannelCnt*nRowBytes,
+			                               nInChannels, vInZP);
+
+			sat_sum = PDX_RADD_2MX40(acc);									//PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+			//adding bias<<1 to compensate for sign bit during multiplication
+			if(pBiasBuffer)
+			{
+				sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
+			}
+			sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+			sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+			temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));	//convert 40bit var into 32bit to perform multiplication
+
+			product = PDX_MULW_32(temp, (uint32_t)pQuantizedMultiplier[nChannelCnt]);	//multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+			product =  PDX_SLA_80(product, (xb_int32)pQuantizedShift[nChannelCnt]);		//shift result by quantization multiplier
+			temp = PDX_PACKQSRV_80(product,2);								//packs 80bit product into 32bit var with saturation and rounding
+			temp+= (xb_int32)nOutputOffset;									//add output offset
+			temp = MIN(temp, (xb_int32)nActMax);
+			temp = MAX(temp, (xb_int32)nActMin);//activation and 8bit saturation check to store result
+			*outp++ =(int8_t)((int32_t)temp);								//store result as 8-bit data
+		}
+	}
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel1x1_sparse_int8
+* @brief block sparse 1x1 conv2d function
+*
+* @details 1x1 2D convolution in interleaved format for 8-bit integer input and symmetric weights packed with
+* adi_sharcfx_pack_block_sparse. Only the nonzero weight blocks are loaded and multiplied, so the run time scales with the
+* block density. No input is read past the nInChannels of the last pixel.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pSparse - packed weights, nOutChannels rows
+* @param [in] pBiasBuffer - input bias buffer, may be NULL
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nSize - # of pixels per batch
+* @param [in] pQuantizedMultiplier - per channel multiplier
+* @param [in] pQuantizedShift - per channel shift
+* @param [in] nInputOffset - input offset
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] nActMin - activation min
+* @param [in] nActMax - activation max
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel1x1_sparse_int8(const int8_t* pInputBuffer,
+                                              const ADI_SHARCFX_SPARSE_WEIGHTS* pSparse,
+                                              const int32_t* pBiasBuffer,
+                                              int8_t* pOutputBuffer,
+                                              int32_t nBatches,
+                                              int32_t nInChannels,
+                                              int32_t nOutChannels,
+                                              int32_t nSize,
+                                              const int32_t *pQuantizedMultiplier,
+                                              const int32_t *pQuantizedShift,
+                                              int32_t nInputOffset,
+                                              int32_t nOutputOffset,
+                                              int32_t nActMin,
+                                              int32_t nActMax)
+{
+	int8_t* __restrict outp = (int8_t*) pOutputBuffer;
+
+	const immediate Lane=0;
+	//Defining the input offset, sparse weights are symmetric
+	xb_vec2Mx16 vInZP = PDX_REP_2MX16((xb_vec2Mx16)nInputOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
+
+	xb_int32 temp;
+	xb_int40 sat_sum;
+	xb_int80 product;
+	xb_vec2Mx40 acc = 0;
+
+	//every pixel of every batch is a fully connected layer over the input channels
+	for(int32_t nCol=0; nCol < nBatches*nSize; nCol++)
+	{
+		//do all output channels for a single pixel
+		for (int32_t nChannelCnt = 0; nChannelCnt < nOutChannels; nChannelCnt++)
+		{
+			int32_t nFirst = pSparse->pBlockPtr[nChannelCnt];
+			acc = fully_connected_sparse_mac(pInputBuffer + nCol*nInChannels,
+			                                 pSparse->pBlockIdx + nFirst,
+			                                 pSparse->pValues + nFirst*ADI_SHARCFX_SPARSE_BLOCK,
+			                                 pSparse->pBlockPtr[nChannelCnt + 1] - nFirst, nInChannels, vInZP);
+
+			sat_sum = PDX_RADD_2MX40(acc);									//PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+			//adding bias<<1 to compensate for sign bit during multiplication
+			if(pBiasBuffer)
+			{
+				sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
+			}
+			sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+			sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+			temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));	//convert 40bit var into 32bit to perform multiplication
+
+			product = PDX_MULW_32(temp, (uint32_t)pQuantizedMultiplier[nChannelCnt]);	//multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+			product =  PDX_SLA_80(product, (xb_int32)pQuantizedShift[nChannelCnt]);		//shift result by quantization multiplier
+			temp = PDX_PACKQSRV_80(product,2);								//packs 80bit product into 32bit var with saturation and rounding
+			temp+= (xb_int32)nOutputOffset;									//add output offset
+			temp = MIN(temp, (xb_int32)nActMax);
+			temp = MAX(temp, (xb_int32)nActMin);//activation and 8bit saturation check to store result
+			*outp++ =(int8_t)((int32_t)temp);								//store result as 8-bit data
+		}
+	}
+}
 
 /**
 *******************************************************************************
 * Function: adi_sharcfx_conv2d_kernel1x1_noninterleaved_int16
 * @brief optimized conv2d function
 *
-* @details 1x1 2D convolution in non-interleaved format using 16bit Eagle intrinsics
+* @details 1x1 2D convolution in non-interleaved format for 16-bit integer input and output using 16bit Eagle intrinsics.
+* Products are accumulated without doubling in 40 bit so the full 32 bit accumulator range is kept before requantization.
 *
 * Parameters:
 * @param [in] pInputBuffer - input data
@@ -243,8 +487,8 @@ void adi_sharcfx_conv2d_kernel1x1_int8(const int8_t* pInputBuffer,
 *
 *******************************************************************************
 */
-void adi_sharcfx_conv2d_kernel1x1_noninterleaved_int16(const int8_t  *pInputBuffer,
-                              int8_t        *pOutputBuffer,
+void adi_sharcfx_conv2d_kernel1x1_noninterleaved_int16(const int16_t *pInputBuffer,
+                              int16_t       *pOutputBuffer,
                               const int8_t  *pWeightsBuffer,
                               const int32_t *pBiasBuffer,
                               int32_t       nOutWidth,
@@ -256,217 +500,104 @@ void adi_sharcfx_conv2d_kernel1x1_noninterleaved_int16(const int8_t  *pInputBuff
                               int32_t       pOutZeroPoint)
 {
 	//TODO:Separate out width and height
-	const int8_t *pInputBuffer_copy = pInputBuffer;
+	const int16_t *pInputBuffer_copy = pInputBuffer;
 	const int nSize = (nOutWidth * nOutWidth);
-	const immediate Lane = 0;
 	const immediate round_mode = ROUNDING_MODE;
 
 	int nBytesToWrite = 0;
 	xb_vec2Mx16 vwt, vin;
-	xb_vec2Mx40 vsum;//Accumulator
 
 	valign ax, az;//align input and output
 
-#ifdef USE_EXTRA_PRECISION
-	xb_vecMx8* __restrict pz = (xb_vecMx8 *)pOutputBuffer;
+	xb_vecMx16* __restrict pz = (xb_vecMx16 *)pOutputBuffer;
 	xb_vecMx32  vOutZP = pOutZeroPoint;
 	//load constants for range
-	xb_vecMx32 vmin = ACT_MIN;
-	xb_vecMx32 vmax = ACT_MAX;
+	xb_vecMx32 vmin = INT_16BIT_MIN;
+	xb_vecMx32 vmax = INT_16BIT_MAX;
 	xb_vec2Mx40 vmax32bit = (xb_vec2Mx40)INT_32BIT_MAX;//Replicates the lane of data specified, across all lanes of a vector register
 	xb_vec2Mx40 vmin32bit = (xb_vec2Mx40)INT_32BIT_MIN;//Replicates the lane of data specified, across all lanes of a vector register
 	vbool2M greater_than32bit, lesser_than32bit;
 	xb_vecMx32 first8, last8;
 
-#else
-	xb_vec2Mx8* __restrict pz = (xb_vec2Mx8 *)pOutputBuffer;
-	xb_vec2Mx16  vOutZP = pOutZeroPoint;
-	xb_vec2Mx16 vmin = -128;
-	xb_vec2Mx16 vmax = 127;
-#endif
-
-
 	az = PDX_Z_ALIGN(); // initialize the alignment register to zero
 
 	//zeropts and range are global across all channels
 	xb_vec2Mx16 vInZP = pInZeroPoint;
 
-
 	for(int32_t nChannel = 0; nChannel < nOutChannels; nChannel++)//per out channel
 	{
 		pInputBuffer = pInputBuffer_copy;//reset back to beginning of buffer for next channel
 
-#ifdef USE_EXTRA_PRECISION
-		xb_vecMx32 mult_acc_40 = pQuantizedMultiplier[nChannel];
+		xb_vecMx32 mult_acc_40 = (int32_t)pQuantizedMultiplier[nChannel];
 		xb_vecMx80 outacc;
 
-		//Load pQuantizedShift for channel
-		xb_vecMx32 shift = pQuantizedShift[nChannel];
-#else
-		//Quant multiplier and shift per output channel, we know this will fit in int16
-		uint16_t ReducedShift = (uint16_t)((pQuantizedMultiplier[nChannel] + (1 << 15)) >> 16);//Qmult is  (val) << 31, reduce this by 16 here to fit in int16
-		//balance Qmult shift remaining is 15 but we include the +1 shift for PDX_MULAQW_2MX16 too here
-		//this shift of 16 is accounted for during PDX_PACKQSRV_2MX40
-		xb_vec2Mx16 mult_acc = ReducedShift;
-
-		//Load pQuantizedShift for channel
-		xb_vec2Mx40 shift = pQuantizedShift[nChannel];
-#endif
-
-		//add zp * wt to bias
-		int32_t zp_wt_sum;
-		int16_t wt_sum = 0;
-		const int8_t *pCurrWeights = pWeightsBuffer;//back to beginning
-		for(int32_t j=0; j < nInChannels; j++)
-		{
-			//weights are 8 bit so we have enough headroom
-			int16_t nCurrWt = (int16_t)(*pCurrWeights++);
-			wt_sum += nCurrWt;
-		}
+		//Load pQuantizedShift for channel, +1 as the accumulation below does not double the products
+		xb_vecMx32 shift = pQuantizedShift[nChannel] + 1;
 
-		//PDX_MULAQW_2MX16 will add a *2, so shift this sum also by 2
-		zp_wt_sum = (pInZeroPoint) * wt_sum;//8 bit * 16 bit should fit within 32 bit
-		zp_wt_sum += pBiasBuffer[nChannel];//bias specific to output channel
-		zp_wt_sum <<= 1;
-
-#ifdef USE_EXTRA_PRECISION
-		xb_vecMx80 add_acc_80 = (xb_vecMx32)pQuantizedMultiplier[nChannel] * (xb_vecMx32)zp_wt_sum;
-#else
-		int64_t vconst_add = (int32_t)ReducedShift * (int32_t)zp_wt_sum;
-		//saturate to fit within 40bits
-		vconst_add = MAX(vconst_add,(int64_t)0xFFFFFF8000000000);
-		vconst_add = MIN(vconst_add,(int64_t)0x7FFFFFFFFF);
-		xb_vec2Mx40 add_acc = vconst_add;//PDX_REP_2MX40((xb_vec2Mx40)vconst_add,Lane);
-#endif
+		//bias specific to output channel, applied in the 80 bit domain
+		xb_vecMx80 add_acc_80 = mult_acc_40 * (xb_vecMx32)pBiasBuffer[nChannel];
 
 		int nBytesLeft = nSize;
 		for(int32_t nCol=0; nCol < nSize; nCol += 2*PDX_M)//per pixel, do 16(2*PDX_M) at a time
 		{
-
 			xb_vec2Mx40 acc = 0;
 
 			const int8_t *pCurrWeights = pWeightsBuffer;//back to beginning
-			const xb_vec2Mx8 *px = (const xb_vec2Mx8 *)pInputBuffer;
+			const xb_vec2Mx16 *px = (const xb_vec2Mx16 *)pInputBuffer;
 
-			//devNote-Out data despite being in 16 bit is effectively 8 bit
-			//so we have a headroom of 40 - 8+8 = 24 bit headroom
-			//we can do 2^23 macs before this will overflow so we can be assured
-			//that even if acc doesnt saturate here we should be fine
+			//16 bit input * 8 bit weight leaves 40 - 24 = 16 bit headroom in the accumulator
 			for(int32_t j=0; j < nInChannels; j++)
 			{
 				PDX_LSR16_8_IP(vwt,pCurrWeights,1);
 
-				ax = PDX_LA_2MX8_PP (px); // prime, NOP if a[] is aligned
-				//Load 8 bit input sign extended to 16 bit
-				PDX_LA16_2MX8_XP(vin, ax, px, nSize); // load aligned, extend, increment to next channel
-
+				ax = PDX_LA_2MX16_PP (px); // prime, NOP if a[] is aligned
+				//Load 16 bit input, increment to next channel
+				PDX_LA_2MX16_XP(vin, ax, px, nSize*sizeof(int16_t));
+				vin += vInZP;
 
 				//multiply and accumulate to 40 bit register
-				//this will effectively do acc += vwt*vin*2;
-				PDX_MULAQW_2MX16(acc,vwt,vin);
+				//this will do acc += vwt*vin;
+				PDX_MULAW_2MX16(acc,vwt,vin);
 			}
-#ifdef USE_EXTRA_PRECISION
-			//16 40 bit -> 8 80 bits
-
-			//keep 32 bit and do 80 bit multiplication
-			//copy from acc to narrow register vector
 
 			//Saturate each lane in acc before converting to 32bit
-			//sets to true if first op greater than second op
-			greater_than32bit =  PDX_GT_2MX40(acc, vmax32bit);//Get bool reg for registers greater than 32bit value
-			//sets to true if first op less than second op
-			lesser_than32bit =  PDX_LT_2MX40(acc, vmin32bit);//Get bool reg for registers greater than 32bit value
-
-			//if bool is TRUE, first op is selected or else second op is selected
+			greater_than32bit =  PDX_GT_2MX40(acc, vmax32bit);
+			lesser_than32bit =  PDX_LT_2MX40(acc, vmin32bit);
 			acc = PDX_MOV_2MX40_T(vmax32bit, acc, greater_than32bit);
 			acc = PDX_MOV_2MX40_T(vmin32bit, acc, lesser_than32bit);
 
-			//there is no saturation in this conversion, hence to avoid conversion the 32 bit overflow check.
 			//16-way 40-bit wide vector signed Integer convert operation, converting to 16-way (pair) 32-bit
 			PDX_CVT32D_2MX40(last8, first8, acc);
 
 			//first8
 			outacc = mult_acc_40 * first8;//8-way 32bit mac
 			outacc += add_acc_80;
-
-			//shift and round
 			outacc = PDX_SLS_MX80(outacc,shift);//saturating left shift, right shift if negative
-			//round and shift and saturate
-			//convert from 8 80bit -> 8 8bit
-
 			xb_vecMx32 conv_out = PDX_PACKQSRV_MX80(outacc, round_mode);//shift by 32 bit 80->32
-
-			//add output zero point
 			conv_out += vOutZP;
-			//Saturate to 8 bit range output_activation_min to 127
+			//Saturate to 16 bit range
 			conv_out = PDX_MIN_MX32(conv_out,vmax);
 			conv_out = PDX_MAX_MX32(conv_out,vmin);
 			nBytesToWrite = nBytesLeft - PDX_M > 0 ? PDX_M : nBytesLeft;
 			nBytesLeft -= PDX_M;
-			PDX_SAV32_MX8_XP(conv_out, az, pz, nBytesToWrite);//8-way 8-bit signed Aligning vector register variable-length store intrinsic, converting
-			//to 8-way 8-bit signed, forward post-increment addressing mode
-			PDX_SAPOS_MX8_FP(az,pz);//flush
+			PDX_SAV32_MX16_XP(conv_out, az, pz, nBytesToWrite*sizeof(int16_t));//8-way 16-bit signed Aligning vector register variable-length store intrinsic
+			PDX_SAPOS_MX16_FP(az,pz);//flush
 
-			//last16
+			//last8
 			if(nBytesLeft>0){
-				//first8
 				outacc = mult_acc_40 * last8;//8-way 32bit mac
 				outacc += add_acc_80;
-
-				//shift and round
 				outacc = PDX_SLS_MX80(outacc,shift);//saturating left shift, right shift if negative
-				//round and shift and saturate
-				//convert from 8 80bit -> 8 8bit
-
-				xb_vecMx32 conv_out = PDX_PACKQSRV_MX80(outacc, round_mode);//shift by 32 bit 80->32
-
-				//add output zero point
+				conv_out = PDX_PACKQSRV_MX80(outacc, round_mode);//shift by 32 bit 80->32
 				conv_out += vOutZP;
-				//Saturate to 8 bit range output_activation_min to 127
 				conv_out = PDX_MIN_MX32(conv_out,vmax);
 				conv_out = PDX_MAX_MX32(conv_out,vmin);
 				nBytesToWrite = nBytesLeft - PDX_M > 0 ? PDX_M : nBytesLeft;
 				nBytesLeft -= PDX_M;
-				PDX_SAV32_MX8_XP(conv_out, az, pz, nBytesToWrite);//8-way 8-bit signed Aligning vector register variable-length store intrinsic, converting
-				//to 8-way 8-bit signed, forward post-increment addressing mode
-				PDX_SAPOS_MX8_FP(az,pz);//flush
+				PDX_SAV32_MX16_XP(conv_out, az, pz, nBytesToWrite*sizeof(int16_t));
+				PDX_SAPOS_MX16_FP(az,pz);//flush
 			}
 			pInputBuffer += 2*PDX_M;//move onto next set of 16 pixels
-
-#else
-			//16 40 bit -> 16 bit and then again 40 bits mac
-
-			//convert this to 16 bit for 16 bit multiplication with pQuantizedMultiplier
-			//if this is beyond range of 16bit it will saturate
-			//if we shift this by 16 here per storing, there is a chance of this becoming zero for low values
-
-			xb_vec2Mx16 conv_out = PDX_PACKSIV_2MX40  (acc, 0);
-
-			//multiply with 16 bit ReducedShift in 40 bit register
-			acc = mult_acc * conv_out;
-			acc += add_acc;//add (bias + sum(wt)*zp) * reduced shift * 2
-			acc = PDX_SLS_2MX40(acc,shift);//saturating left shift, right shift if negative
-
-			//round and shift and saturate
-			conv_out = PDX_PACKQSRV_2MX40  (acc, round_mode);//shifts by 16 bits and symmetric rounding with saturation
-
-			//add output zero point
-			conv_out += vOutZP;
-
-			//Saturate to 8 bit range -128 to 127
-			conv_out = PDX_MIN_2MX16(conv_out,vmax);
-			conv_out = PDX_MAX_2MX16(conv_out,vmin);
-
-			nBytesToWrite = nBytesLeft - 2*PDX_M > 0 ? 2*PDX_M : nBytesLeft;
-
-		    PDX_SAV16_2MX8_XP(conv_out, az, pz,nBytesToWrite);//16-way 16-bit signed Aligning vector register variable-length store intrinsic, converting
-		    //to 16-way 8-bit signed, forward post-increment addressing mode
-
-		    PDX_SAPOS_2MX8_FP(az,pz);//flush
-
-			nBytesLeft -= 2*PDX_M;
-			pInputBuffer += 2*PDX_M;//move onto next set of 16 pixels
-#endif
 		}
 		pWeightsBuffer += nInChannels;//interleaved, move to next channel
 	}
@@ -1883,198 +2014,266 @@ inline int8_t quantize_and_store(
 	return (int8_t)((int32_t)temp);
 }
 
-
-/*UTILITY FUCNTION*/
-//Pad image with zeros as per the number or height and width
-
-void pad_image_intrinsic (
-    int8_t* pInputBuffer,
-    int8_t* pOutputBuffer,
-	int32_t nInHeight,
-	int32_t nInWidth,
-	int32_t nInChannels,
-	int32_t nZeroPoint,
-	int32_t nPadHeight,
-	int32_t nPadWidth)
+/*UTILITY FUNCTION*/
+//Requantize the 2*PDX_M per channel accumulators in acc with the per channel bias, multiplier and shift
+//starting at the given pointers and store the first nChannels(<=2*PDX_M) results as 8bit outputs
+void quantize_and_store_channels(
+				xb_vec2Mx40 acc,
+				const int32_t *pBiasBuffer,
+				const int32_t *pQuantizedMultiplier,
+				const int32_t *pQuantizedShift,
+				int32_t nChannels,
+				xb_vecMx32 vOutZP,
+				xb_vecMx32 vmin,
+				xb_vecMx32 vmax,
+				xb_vecMx8* &outp,
+				valign &outa)
 {
-    int8_t* pIn_buffer = pInputBuffer;
-    int8_t* pPadded_buffer = pOutputBuffer;
-
-    int32_t nPadWidth_L = nPadWidth >> 1;  // Left Padding
-    int32_t nPadWidth_R = nPadWidth - nPadWidth_L;
-    int32_t nPadHeight_T = nPadHeight >> 1;  // Top padding
-    int32_t nPadHeight_B = nPadHeight - nPadHeight_T;
-
-    int32_t newHeight = nInHeight + nPadHeight;
-    int32_t newWidth = nInWidth + nPadWidth;
-
-    int32_t row, col;
-
-    xb_vec2Mx16 v_load;
-	xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pIn_buffer;
-	xb_vec2Mx16 *store_ptr = (xb_vec2Mx16 *)pPadded_buffer;
-	int32_t load_loop_count = (nInWidth*nInChannels)/(4*PDX_M);
-	int32_t load_remaining = (nInWidth*nInChannels)%(4*PDX_M);
-	valign load_align, store_align; // define align vector
-	store_align= PDX_Z_ALIGN(); // prime, NOP if a[] is aligned
-
-
-    // Fill top padding
-    for (row = 0; row < nPadHeight_T; row++) {
-            memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels * newWidth);
-            pPadded_buffer += nInChannels * newWidth;
-    }
-
-    // Fill middle rows
-    for (row = 0; row < nInHeight; row++) {
-        // Fill left padding
-        for (col = 0; col < nPadWidth_L; col++) {
-            memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels);
-            pPadded_buffer += nInChannels;
-        }
-
-        //Load store
-        inp = (xb_vec2Mx16 *)(pIn_buffer);
-
-		load_align= PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
-		store_ptr = (xb_vec2Mx16 *)(pPadded_buffer);
+	xb_vecMx32 first8, last8;
+	xb_vecMx32 mult_l, mult_h;
+	xb_vecMx32 shift_l, shift_h;
+	xb_vecMx32 vbias_l, vbias_h;
+	xb_vecMx32 conv_out;
+	xb_vecMx80 quant_acc;
+
+	//read in mult factors and shift for the channels
+	xb_vecMx32 *vMult = (xb_vecMx32 *)pQuantizedMultiplier;
+	valign wMulta = PDX_LA_MX32_PP(vMult);
+	xb_vecMx32 *vShift = (xb_vecMx32 *)pQuantizedShift;
+	valign wShifta = PDX_LA_MX32_PP(vShift);
+
+	//read 8 way 32 bit signed
+	PDX_LA_MX32_XP (mult_l, wMulta, vMult, 4*PDX_M);
+	PDX_LA_MX32_XP (mult_h, wMulta, vMult, 0);
+	PDX_LA_MX32_XP (shift_l, wShifta, vShift, 4*PDX_M);
+	PDX_LA_MX32_XP (shift_h, wShifta, vShift, 0);
+
+	PDX_CVT32D_2MX40(last8, first8, acc);	//Converting 40bit results to 32bit to prevent loss of accuracy from packing of 40bit -> 16bit
+	if (pBiasBuffer)
+	{
+		xb_vecMx32 *vBias = (xb_vecMx32 *)pBiasBuffer;
+		valign wBiasa = PDX_LA_MX32_PP(vBias);
+		PDX_LA_MX32_XP (vbias_l, wBiasa, vBias, 4*PDX_M);
+		PDX_LA_MX32_XP (vbias_h, wBiasa, vBias, 0);
+		first8 += PDX_SLS_MX32(vbias_l,1);//*2 to match with acc
+		last8 += PDX_SLS_MX32(vbias_h,1);//*2 to match with acc
+	}
 
-        for(int load_counter = 0; load_counter < load_loop_count; load_counter++){
-			PDX_LAV_2MX16_XP (v_load, load_align, inp, 4*PDX_M);
-			PDX_SA_2MX16_IP(v_load, store_align, store_ptr);
-        }
+	//first8
+	quant_acc = mult_l * first8;	//Multiplying 2 32-bit vectors and storing result in 80bit vector
+	quant_acc = PDX_SLS_MX80(quant_acc,shift_l);//saturating left shift, right shift if negative
+	conv_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);	//pack 80bit result to 32bit with rounding and saturation.
+	conv_out += vOutZP;
+	conv_out = PDX_MIN_MX32(conv_out,vmax);
+	conv_out = PDX_MAX_MX32(conv_out,vmin);
+	PDX_SAV32_MX8_XP(conv_out, outa, outp, MIN(nChannels,PDX_M));//8-way 8-bit signed Aligning vector register variable-length store intrinsic, converting
+	PDX_SAPOS_MX8_FP(outa,outp);//flush
+
+	if (nChannels > PDX_M)
+	{
+		//last8
+		quant_acc = mult_h * last8;	//Multiplying 2 32-bit vectors and storing result in 80bit vector
+		quant_acc = PDX_SLS_MX80(quant_acc,shift_h);//saturating left shift, right shift if negative
+		conv_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);	//pack 80bit result to 32bit with rounding and saturation.
+		conv_out += vOutZP;
+		conv_out = PDX_MIN_MX32(conv_out,vmax);
+		conv_out = PDX_MAX_MX32(conv_out,vmin);
+		PDX_SAV32_MX8_XP(conv_out, outa, outp, nChannels - PDX_M);
+		PDX_SAPOS_MX8_FP(outa,outp);//flush
+	}
+}
 
-        pPadded_buffer += load_loop_count*4*PDX_M;
-		pIn_buffer += load_loop_count*4*PDX_M;
+/*UTILITY FUNCTION*/
+//16x8 variant of quantize_and_store_channels. acc holds undoubled products (PDX_MULAW_2MX16), so the shift is increased by 1
+//to match PDX_PACKQSRV_MX80. The bias is applied after multiplication in 80 bit so acc + bias cannot overflow 32 bit
+void quantize_and_store_channels_int16(
+				xb_vec2Mx40 acc,
+				const int32_t *pBiasBuffer,
+				const int32_t *pQuantizedMultiplier,
+				const int32_t *pQuantizedShift,
+				int32_t nChannels,
+				xb_vecMx32 vmin,
+				xb_vecMx32 vmax,
+				xb_vecMx16* &outp,
+				valign &outa)
+{
+	xb_vecMx32 first8, last8;
+	xb_vecMx32 mult_l, mult_h;
+	xb_vecMx32 shift_l, shift_h;
+	xb_vecMx32 vbias_l, vbias_h;
+	xb_vecMx32 conv_out;
+	xb_vecMx80 quant_acc;
+	xb_vecMx32 vOne = 1;
+	xb_vec2Mx40 vmax32bit = (xb_vec2Mx40)INT_32BIT_MAX;
+	xb_vec2Mx40 vmin32bit = (xb_vec2Mx40)INT_32BIT_MIN;
+	vbool2M greater_than32bit, lesser_than32bit;
 
-		PDX_SAPOS_2MX16_FP(store_align, store_ptr);
-		for(int rem = 0; rem < load_remaining; rem++){
-			*(pPadded_buffer++) =*(pIn_buffer++);
+	//read in mult factors and shift for the channels
+	xb_vecMx32 *vMult = (xb_vecMx32 *)pQuantizedMultiplier;
+	valign wMulta = PDX_LA_MX32_PP(vMult);
+	xb_vecMx32 *vShift = (xb_vecMx32 *)pQuantizedShift;
+	valign wShifta = PDX_LA_MX32_PP(vShift);
+
+	PDX_LA_MX32_XP (mult_l, wMulta, vMult, 4*PDX_M);
+	PDX_LA_MX32_XP (mult_h, wMulta, vMult, 0);
+	PDX_LA_MX32_XP (shift_l, wShifta, vShift, 4*PDX_M);
+	PDX_LA_MX32_XP (shift_h, wShifta, vShift, 0);
+	shift_l += vOne;
+	shift_h += vOne;
+
+	//Saturate each lane in acc before converting to 32bit
+	greater_than32bit = PDX_GT_2MX40(acc, vmax32bit);
+	lesser_than32bit = PDX_LT_2MX40(acc, vmin32bit);
+	acc = PDX_MOV_2MX40_T(vmax32bit, acc, greater_than32bit);
+	acc = PDX_MOV_2MX40_T(vmin32bit, acc, lesser_than32bit);
+	PDX_CVT32D_2MX40(last8, first8, acc);
+
+	quant_acc = mult_l * first8;	//Multiplying 2 32-bit vectors and storing result in 80bit vector
+	if (pBiasBuffer)
+	{
+		xb_vecMx32 *vBias = (xb_vecMx32 *)pBiasBuffer;
+		valign wBiasa = PDX_LA_MX32_PP(vBias);
+		PDX_LA_MX32_XP (vbias_l, wBiasa, vBias, 4*PDX_M);
+		PDX_LA_MX32_XP (vbias_h, wBiasa, vBias, 0);
+		quant_acc += mult_l * vbias_l;
+	}
+	quant_acc = PDX_SLS_MX80(quant_acc,shift_l);//saturating left shift, right shift if negative
+	conv_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);	//pack 80bit result to 32bit with rounding and saturation.
+	conv_out = PDX_MIN_MX32(conv_out,vmax);
+	conv_out = PDX_MAX_MX32(conv_out,vmin);
+	PDX_SAV32_MX16_XP(conv_out, outa, outp, MIN(nChannels,PDX_M)*sizeof(int16_t));
+	PDX_SAPOS_MX16_FP(outa,outp);//flush
+
+	if (nChannels > PDX_M)
+	{
+		quant_acc = mult_h * last8;
+		if (pBiasBuffer)
+		{
+			quant_acc += mult_h * vbias_h;
 		}
-
-        // Fill right padding
-        for (col = 0; col < nPadWidth_R; col++) {
-            memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels);
-            pPadded_buffer += nInChannels;
-        }
-    }
-
-    // Fill bottom padding
-    for (row = 0; row < nPadHeight_B; row++) {
-    			memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels * newWidth);
-    	        pPadded_buffer += nInChannels * newWidth;
-    }
+		quant_acc = PDX_SLS_MX80(quant_acc,shift_h);
+		conv_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);
+		conv_out = PDX_MIN_MX32(conv_out,vmax);
+		conv_out = PDX_MAX_MX32(conv_out,vmin);
+		PDX_SAV32_MX16_XP(conv_out, outa, outp, (nChannels - PDX_M)*sizeof(int16_t));
+		PDX_SAPOS_MX16_FP(outa,outp);//flush
+	}
 }
 
-void pad_image_optimized (
-    int8_t* pInputBuffer,
-    int8_t* pOutputBuffer,
-	int32_t nInHeight,
-	int32_t nInWidth,
-	int32_t nInChannels,
-	int32_t nZeroPoint,
-	int32_t nPadHeight,
-	int32_t nPadWidth)
+/*UTILITY FUNCTION*/
+//Requantization of the 16x8 kernels following the TFLite reference for a 64bit accumulator: the bias is added in 64 bit and
+//the sum is multiplied by the multiplier reduced to 16 bit, (mult + 2^15) >> 16, and shifted right by 15 - shift with
+//rounding. acc holds undoubled products (PDX_MULAW_2MX16). acc and the bias are split at bit 16 so both halves multiply the
+//reduced multiplier exactly in the 80bit lanes, no 32bit saturation is applied
+void quantize_and_store_channels_16x8(
+				xb_vec2Mx40 acc,
+				const int32_t *pBiasHigh,
+				const int32_t *pBiasLow,
+				const int32_t *pQuantizedMultiplier,
+				const int32_t *pQuantizedShift,
+				int32_t nChannels,
+				xb_vecMx32 vmin,
+				xb_vecMx32 vmax,
+				xb_vecMx16* &outp,
+				valign &outa)
 {
-    int8_t* pIn_buffer = pInputBuffer;
-    int8_t* pPadded_buffer = pOutputBuffer;
-
-    int32_t nPadWidth_L = nPadWidth >> 1;  // Left Padding
-    int32_t nPadWidth_R = nPadWidth - nPadWidth_L;
-    int32_t nPadHeight_T = nPadHeight >> 1;  // Top padding
-    int32_t nPadHeight_B = nPadHeight - nPadHeight_T;
-
-    int32_t newHeight = nInHeight + nPadHeight;
-    int32_t newWidth = nInWidth + nPadWidth;
-
-    int32_t row, col;
-
-    // Fill top padding
-    for (row = 0; row < nPadHeight_T; row++) {
-            memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels * newWidth);
-            pPadded_buffer += nInChannels * newWidth;
-    }
-
-    // Fill middle rows
-    for (row = 0; row < nInHeight; row++) {
-        // Fill left padding
-        for (col = 0; col < nPadWidth_L; col++) {
-            memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels);
-            pPadded_buffer += nInChannels;
-        }
-
-        // Copy input buffer
-		//we can try loop unrolling
-        for(int i=0; i<nInChannels * nInWidth; i++){
-				*(pPadded_buffer++) =*(pIn_buffer++);
-			}
-
-        // Fill right padding
-        for (col = 0; col < nPadWidth_R; col++) {
-            memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels);
-            pPadded_buffer += nInChannels;
-        }
-    }
+	xb_vecMx32 high_l, high_h, low_l, low_h;
+	xb_vecMx32 mult_l, mult_h;
+	xb_vecMx32 shift_l, shift_h;
+	xb_vecMx32 vbias_l, vbias_h;
+	xb_vecMx32 conv_out;
+	xb_vecMx80 quant_acc;
+	xb_vecMx32 vMultMax = 0x7FFEFFFF;	//multipliers at or above 0x7FFF0000 reduce to 0x7FFF
+	xb_vecMx32 vHalf = 1 << 15;
+	xb_vecMx32 vShiftAdj = 17;			//PDX_PACKQSRV_MX80 shifts right by 32, the reference by 15 - shift
+
+	//read in mult factors and shift for the channels
+	xb_vecMx32 *vMult = (xb_vecMx32 *)pQuantizedMultiplier;
+	valign wMulta = PDX_LA_MX32_PP(vMult);
+	xb_vecMx32 *vShift = (xb_vecMx32 *)pQuantizedShift;
+	valign wShifta = PDX_LA_MX32_PP(vShift);
+
+	PDX_LA_MX32_XP (mult_l, wMulta, vMult, 4*PDX_M);
+	PDX_LA_MX32_XP (mult_h, wMulta, vMult, 0);
+	PDX_LA_MX32_XP (shift_l, wShifta, vShift, 4*PDX_M);
+	PDX_LA_MX32_XP (shift_h, wShifta, vShift, 0);
+	mult_l = PDX_SLS_MX32(PDX_MIN_MX32(mult_l, vMultMax) + vHalf, -16);
+	mult_h = PDX_SLS_MX32(PDX_MIN_MX32(mult_h, vMultMax) + vHalf, -16);
+	shift_l += vShiftAdj;
+	shift_h += vShiftAdj;
+
+	//acc = high*2^16 + low with low in [0, 2^16)
+	xb_vec2Mx40 vHigh = PDX_SRA_2MX40(acc, 16);
+	xb_vec2Mx40 vLow = acc - PDX_SLS_2MX40(vHigh, 16);
+	PDX_CVT32D_2MX40(high_h, high_l, vHigh);
+	PDX_CVT32D_2MX40(low_h, low_l, vLow);
+	if (pBiasHigh)
+	{
+		xb_vecMx32 *vBias = (xb_vecMx32 *)pBiasLow;
+		valign wBiasa = PDX_LA_MX32_PP(vBias);
+		PDX_LA_MX32_XP (vbias_l, wBiasa, vBias, 4*PDX_M);
+		PDX_LA_MX32_XP (vbias_h, wBiasa, vBias, 0);
+		low_l += vbias_l;	//both halves below 2^16, no overflow
+		low_h += vbias_h;
+	}
 
-    // Fill bottom padding
-    for (row = 0; row < nPadHeight_B; row++) {
-    			memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t) * nInChannels * newWidth);
-    	        pPadded_buffer += nInChannels * newWidth;
-    }
+	quant_acc = mult_l * high_l;	//Multiplying 2 32-bit vectors and storing result in 80bit vector
+	if (pBiasHigh)
+	{
+		xb_vecMx32 *vBias = (xb_vecMx32 *)pBiasHigh;
+		valign wBiasa = PDX_LA_MX32_PP(vBias);
+		PDX_LA_MX32_XP (vbias_l, wBiasa, vBias, 4*PDX_M);
+		PDX_LA_MX32_XP (vbias_h, wBiasa, vBias, 0);
+		quant_acc += mult_l * vbias_l;
+	}
+	quant_acc = PDX_SLS_MX80(quant_acc, (xb_vecMx32)16);
+	quant_acc += mult_l * low_l;
+	quant_acc = PDX_SLS_MX80(quant_acc,shift_l);//saturating left shift, right shift if negative
+	conv_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);	//pack 80bit result to 32bit with rounding and saturation.
+	conv_out = PDX_MIN_MX32(conv_out,vmax);
+	conv_out = PDX_MAX_MX32(conv_out,vmin);
+	PDX_SAV32_MX16_XP(conv_out, outa, outp, MIN(nChannels,PDX_M)*sizeof(int16_t));
+	PDX_SAPOS_MX16_FP(outa,outp);//flush
+
+	if (nChannels > PDX_M)
+	{
+		quant_acc = mult_h * high_h;
+		if (pBiasHigh)
+		{
+			quant_acc += mult_h * vbias_h;
+		}
+		quant_acc = PDX_SLS_MX80(quant_acc, (xb_vecMx32)16);
+		quant_acc += mult_h * low_h;
+		quant_acc = PDX_SLS_MX80(quant_acc,shift_h);
+		conv_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);
+		conv_out = PDX_MIN_MX32(conv_out,vmax);
+		conv_out = PDX_MAX_MX32(conv_out,vmin);
+		PDX_SAV32_MX16_XP(conv_out, outa, outp, (nChannels - PDX_M)*sizeof(int16_t));
+		PDX_SAPOS_MX16_FP(outa,outp);//flush
+	}
 }
 
-void pad_image (
-		int8_t* pInputBuffer,
-		int8_t* pOutputBuffer,
-		int32_t nInHeight,
-		int32_t nInWidth,
-		int32_t nInChannels,
-		int32_t nZeroPoint,
-		int32_t nPadHeight,
-		int32_t nPadWidth)
+/*UTILITY FUNCTION*/
+//Split the 64bit bias of the 16x8 kernels at bit 16 for quantize_and_store_channels_16x8: bias = high*2^16 + low with
+//low in [0, 2^16). high is saturated to 32bit, which keeps biases up to 47 bits exact
+void split_bias_int64(
+				const int64_t *pBiasBuffer,
+				int32_t *pBiasHigh,
+				int32_t *pBiasLow,
+				int32_t nChannels)
 {
-	int8_t* pIn_buffer = (int8_t*) pInputBuffer;
-	int8_t* pPadded_buffer = (int8_t*) pOutputBuffer;
-
-	int32_t nPadWidth_L, nPadWidth_R, nPadHeight_T, nPadHeight_B;
-	nPadWidth_L =(int32_t) (nPadWidth>>1);				//Left Padding
-	nPadWidth_R = nPadWidth - nPadWidth_L;
-
-	nPadHeight_T =(int32_t) (nPadHeight>>1);			//Top padding
-	nPadHeight_B = nPadHeight - nPadHeight_T;
-
-	int32_t newHeight = nInHeight+nPadHeight;
-	int32_t newWidth = nInWidth+nPadWidth;
-
-	for(int32_t nRow = 0; nRow< newHeight; nRow++){
-		for(int32_t nCol = 0; nCol< newWidth; nCol++){
-			if (nCol<nPadWidth_L){//Left padding if present
-				memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t)*nInChannels);
-				pPadded_buffer+=nInChannels;
-			}
-			if (nCol>=nPadWidth_L && nCol<nInWidth+nPadWidth_L){
-				if (nRow<nPadHeight_T){//Top padding if present
-					memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t)*nInChannels);
-					pPadded_buffer+=nInChannels;
-				}
-				if (nRow>=nInHeight+nPadHeight_T){//Bottom padding if present
-					memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t)*nInChannels);
-					pPadded_buffer+=nInChannels;
-				}
-				if (nRow>=nPadHeight_T && nRow<nInHeight+nPadHeight_T){//No padding
-					memcpy(pPadded_buffer, pIn_buffer, sizeof(int8_t)*nInChannels);
-					pPadded_buffer+=nInChannels;
-					pIn_buffer +=nInChannels;
-				}
-			}
-			if (nCol>=(nInWidth+nPadWidth_L)){//Check for right padding
-				memset(pPadded_buffer, -nZeroPoint, sizeof(int8_t)*nInChannels);
-				pPadded_buffer+=nInChannels;
-			}
-		}
+	for (int32_t nChannel = 0; nChannel < nChannels; nChannel++)
+	{
+		int64_t nBias = pBiasBuffer[nChannel];
+		int64_t nHigh = nBias >> 16;
+		nHigh = MIN(nHigh, (int64_t)0x7FFFFFFF);
+		nHigh = MAX(nHigh, -(int64_t)0x80000000);
+		pBiasHigh[nChannel] = (int32_t)nHigh;
+		pBiasLow[nChannel] = (int32_t)(nBias & 0xFFFF);
 	}
 }
 
+
 /*UTILITY FUCNTION*/
 //Copy the input output kernel number of times for convolution
 void get_padded_input(
@@ -2171,46 +2370,13 @@ void get_padded_input_byte(
     }
 }
 
-/**
-*******************************************************************************
-* Function: adi_sharcfx_conv2d_dilation1x1_int8
-* @brief optimized conv2d function
-*
-* @details optimized conv2d function for 8-bit integer input. 2D convolution in interleaved format using 16bit Eagle intrinsics. Assumes dialation 1x1
-*
-* Parameters:
-* @param [in] pInputBuffer - input data
-* @param [in] pWeightsBuffer - input weights buffer
-* @param [in] pBiasBuffer - input bias buffer
-* @param [in] nBatches - batch size
-* @param [in] nInChannels - input depth
-* @param [in] nOutChannels - output depth
-* @param [in] nKernelHeight - kernel height
-* @param [in] nKernelWidth - kernel width
-* @param [in] stride_height - stride height
-* @param [in] stride_width - stride width
-* @param [in] nPadHeight - padding height
-* @param [in] nPadWidth - padding width
-* @param [in] nOutHeight - output height
-* @param [in] nOutWidth - output width
-* @param [in] pQuantizedMultiplier - multiplier
-* @param [in] pQuantizedShift - shift
-* @param [in] pInZeroPoint - input zeropoint
-* @param [in] pOutZeroPoint - output zeropoint
-* @param [in] nFilterZeroPoint - filter zeropoint
-* @param [in] nActMin - min value after activation function
-* @param [in] nActMax - max value after activation function
-* 
-* @param [out] pOutputBuffer - output data
-*
-* @return None
-*
-*
-*******************************************************************************
-*/ 
-void adi_sharcfx_conv2d_dilation1x1_int8(
+/*UTILITY FUNCTION*/
+//Convolution with dilation 1 of output rows [nOutRowStart, nOutRowEnd) of every batch. Weights are in
+//[kernel height][kernel width][input channel][output channel] order, pPatch holds the gathered taps of one output pixel
+inline void conv2d_dilation1x1_int8_rows(
 		const int8_t* pInputBuffer,
-		const int8_t* pWeightsBuffer,
+		const int8_t* pWeightsTransformed,
+		int8_t* pPatch,
 		const int32_t* pBiasBuffer,
 		int8_t* pOutputBuffer,
 		int32_t nBatches,
@@ -2233,10 +2399,12 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 		int32_t pOutZeroPoint,
 		int32_t nFilterZeroPoint,
 		int32_t nActMin,
-		int32_t nActMax)
+		int32_t nActMax,
+		int32_t nOutRowStart,
+		int32_t nOutRowEnd)
 {
-	xb_vecMx8* __restrict outp  = (xb_vecMx8 *)pOutputBuffer;
-	valign outa = PDX_LA_MX8_PP (outp); // prime, NOP if a[] is aligned
+	xb_vecMx8* __restrict outp;
+	valign outa;
 	const immediate Lane=0;
 
 	xb_vec2Mx16 vin,vwt;
@@ -2250,15 +2418,12 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 	xb_vec2Mx40 acc = 0;
 
 	int32_t nTotalPadWidth, nTotalPadHeight;
-	nTotalPadWidth = (nOutWidth-1)*stride_width + nKernelWidth - nInputWidth;
-	nTotalPadHeight = (nOutHeight-1)*stride_height + nKernelHeight - nInputHeight;
-
-	uint32_t nWeightBufSize =nNumKernels*nKernelHeight*nKernelWidth*nInChannels;
-	uint32_t nPaddedInputSize =nInChannels*(nInputWidth+nTotalPadWidth)*(nInputHeight+nTotalPadHeight);
-	int32_t nIndexBuffer = 128;
+	nTotalPadWidth = MAX((nOutWidth-1)*stride_width + nKernelWidth - nInputWidth, 0);
+	nTotalPadHeight = MAX((nOutHeight-1)*stride_height + nKernelHeight - nInputHeight, 0);
 
-
-	transform_weights((int8_t*) pWeightsBuffer,(int8_t*)&pTemp[nPaddedInputSize+nIndexBuffer], nKernelHeight,nKernelWidth,nInChannels, nNumKernels);
+	int32_t nPadTop = nTotalPadHeight>>1;
+	int32_t nPadLeft = nTotalPadWidth>>1;
+	int32_t nTapStartH, nTapEndH, nTapStartW, nTapEndW, nTapCountW;
 
 
 	xb_vec2Mx8 *wtp;// = (xb_vec2Mx8 *)pWeightsBuffer;
@@ -2289,25 +2454,34 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 
 	for (int32_t nBatch = 0; nBatch < nBatches; ++nBatch) 
 	{
-		//Get padded image
-		pad_image_intrinsic((int8_t*) (pInputBuffer+nBatch*nInputHeight*nInputWidth*nInChannels),(int8_t*)pTemp, nInputHeight, nInputWidth, nInChannels,pInZeroPoint, nTotalPadHeight,nTotalPadWidth);
+		const int8_t *pBatchInput = pInputBuffer+nBatch*nInputHeight*nInputWidth*nInChannels;
+		outp = (xb_vecMx8 *)(pOutputBuffer + (nBatch*nOutputHeight + nOutRowStart)*nOutputWidth*nOutChannels);
+		outa = PDX_LA_MX8_PP (outp); // prime, NOP if a[] is aligned
 
-		for (int32_t out_y = 0; out_y < nOutputHeight; ++out_y) 
+		for (int32_t out_y = nOutRowStart; out_y < nOutRowEnd; ++out_y) 
 		{
+			//Kernel rows inside the input, taps in the padding are skipped
+			int32_t in_y = out_y*stride_height - nPadTop;
+			get_valid_tap_range(in_y, nInputHeight, nKernelHeight, 1, &nTapStartH, &nTapEndH);
+
 			//update inp and wt
 			for (int32_t out_x = 0; out_x < nOutputWidth; ++out_x) 
 			{
 				nPixLeft = nOutChannels;
-				//Extract the corresponding input buffer
-                get_padded_input_byte((int8_t*) (pTemp+out_y*stride_height*nInChannels*(nInputWidth+nTotalPadWidth)+stride_width*out_x*nInChannels),(int8_t*)&pTemp[nPaddedInputSize+nIndexBuffer+nWeightBufSize], nKernelHeight,nKernelWidth,nInChannels, nNumKernels, nInputHeight+nTotalPadHeight,nInputWidth+nTotalPadWidth,nInChannels);
+				int32_t in_x = out_x*stride_width - nPadLeft;
+				get_valid_tap_range(in_x, nInputWidth, nKernelWidth, 1, &nTapStartW, &nTapEndW);
+				nTapCountW = (nTapEndW - nTapStartW)*nInChannels;
+
+				//Extract the corresponding input buffer for the taps inside the input
+                get_padded_input_byte((int8_t*) (pBatchInput+((in_y+nTapStartH)*nInputWidth+in_x+nTapStartW)*nInChannels),pPatch, nTapEndH-nTapStartH,nTapEndW-nTapStartW,nInChannels, nNumKernels, nInputHeight,nInputWidth,nInChannels);
 
 				for (int32_t nOutChannel = 0; nOutChannel < nOutChannelsMod16; nOutChannel+=2*PDX_M) 
 				{
-					inp = (xb_vec2Mx8*)(&pTemp[nPaddedInputSize+nIndexBuffer+nWeightBufSize] + nOutChannel);
+					inp = (xb_vec2Mx8*)(pPatch + nOutChannel);
 					valign ina; // define align vector
 					ina=PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
 
-					wtp = (xb_vec2Mx8*)(&pTemp[nPaddedInputSize+nIndexBuffer]+ nOutChannel);
+					wtp = (xb_vec2Mx8*)(pWeightsTransformed+ nOutChannel);
 					valign wta;	// define align vector
 					wta=PDX_LA_2MX8_PP (wtp);
 
@@ -2337,19 +2511,25 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 					acc = 0;// Reset acc
 					//Have input buffer in required format. Perform the conv/matmul op and then store  min(2*PDX_M, RemainingOutChannels) pixels at a time
 					//Use same input buffer for all filters to get one row of output pixels.
-					for(int32_t nKerCh =0; nKerCh<nInChannels*nKernelHeight*nKernelWidth;nKerCh++)
+					for(int32_t nKerH = nTapStartH; nKerH < nTapEndH; nKerH++)
 					{
-						//READ IP
-						PDX_LA16_2MX8_XP (vin, ina, inp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel, skip to adjoining pixel
-						vin += vInZP;		//Add input offset
-						ina = PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
-						//READ WT
-						PDX_LA16_2MX8_XP (vwt, wta, wtp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel
-//								vwt += vFilterZP;	//Add filter offset
-						wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
-						//MAC
-						PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
+						//weights of the taps inside the input on this kernel row
+						wtp = (xb_vec2Mx8*)(pWeightsTransformed + (nKerH*nKernelWidth + nTapStartW)*nInChannels*nNumKernels + nOutChannel);
+						wta = PDX_LA_2MX8_PP (wtp);
+						for(int32_t nKerCh =0; nKerCh<nTapCountW;nKerCh++)
+						{
+							//READ IP
+							PDX_LA16_2MX8_XP (vin, ina, inp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel, skip to adjoining pixel
+							vin += vInZP;		//Add input offset
+							ina = PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
+							//READ WT
+							PDX_LA16_2MX8_XP (vwt, wta, wtp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel
+							vwt += vFilterZP;	//Add filter offset
+							wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+							//MAC
+							PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
 
+						}
 					}
 					//Quantize and store
 					//quantization compensation
@@ -2392,11 +2572,11 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 				//Handle non-multiple of 16 pixels
 				if(nPixLeft>0)
 				{
-					inp = (xb_vec2Mx8*)(&pTemp[nPaddedInputSize+nIndexBuffer+nWeightBufSize] + nOutChannelsMod16);
+					inp = (xb_vec2Mx8*)(pPatch + nOutChannelsMod16);
 					valign ina; // define align vector
 					ina=PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
 
-					wtp = (xb_vec2Mx8*)(&pTemp[nPaddedInputSize+nIndexBuffer]+ nOutChannelsMod16);
+					wtp = (xb_vec2Mx8*)(pWeightsTransformed+ nOutChannelsMod16);
 					valign wta;	// define align vector
 					wta=PDX_LA_2MX8_PP (wtp);
 
@@ -2427,19 +2607,25 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 					//Have input buffer in required format. Perform the conv/matmul op and then store  min(2*PDX_M, RemainingOutChannels) pixels at a time
 					//Use same input buffer for all filters to get one row of output pixels.
 
-					for(int32_t nKerCh =0; nKerCh<nInChannels*nKernelHeight*nKernelWidth;nKerCh++)
+					for(int32_t nKerH = nTapStartH; nKerH < nTapEndH; nKerH++)
 					{
-						//READ IP
-						PDX_LA16_2MX8_XP (vin, ina, inp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel, skip to adjoining pixel
-						vin += vInZP;		//Add input offset
-						ina = PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
-						//READ WT
-						PDX_LA16_2MX8_XP (vwt, wta, wtp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel
-	//								vwt += vFilterZP;	//Add filter offset
-						wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
-						//MAC
-						PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
+						//weights of the taps inside the input on this kernel row
+						wtp = (xb_vec2Mx8*)(pWeightsTransformed + (nKerH*nKernelWidth + nTapStartW)*nInChannels*nNumKernels + nOutChannelsMod16);
+						wta = PDX_LA_2MX8_PP (wtp);
+						for(int32_t nKerCh =0; nKerCh<nTapCountW;nKerCh++)
+						{
+							//READ IP
+							PDX_LA16_2MX8_XP (vin, ina, inp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel, skip to adjoining pixel
+							vin += vInZP;		//Add input offset
+							ina = PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
+							//READ WT
+							PDX_LA16_2MX8_XP (vwt, wta, wtp, nNumKernels);//read 2*PDX_M number of channels for 1 pixel
+							vwt += vFilterZP;	//Add filter offset
+							wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+							//MAC
+							PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
 
+						}
 					}
 					//Quantize and store
 					//quantization compensation
@@ -2492,3 +2678,1224 @@ void adi_sharcfx_conv2d_dilation1x1_int8(
 		}
 	}
 }
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_dilation1x1_int8_ctx
+* @brief optimized conv2d function
+*
+* @details optimized conv2d function for 8-bit integer input. 2D convolution in interleaved format using 16bit Eagle intrinsics. Assumes dialation 1x1
+* The input is not padded: for every output pixel only the kernel taps inside the input are gathered and convolved, taps in the padding
+* contribute nothing after the input offset is added.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelHeight - kernel height
+* @param [in] nKernelWidth - kernel width
+* @param [in] stride_height - stride height
+* @param [in] stride_width - stride width
+* @param [in] nPadHeight - padding height
+* @param [in] nPadWidth - padding width
+* @param [in] nOutHeight - output height
+* @param [in] nOutWidth - output width
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] pInZeroPoint - input zeropoint
+* @param [in] pOutZeroPoint - output zeropoint
+* @param [in] nFilterZeroPoint - filter zeropoint
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+* 
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_dilation1x1_int8_ctx(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext)
+{
+	//Scratch: the reordered weights followed by the gathered taps of one output pixel
+	int32_t nIndexBuffer = 128;
+	int32_t nWeightBufSize = nNumKernels*nKernelHeight*nKernelWidth*nInChannels;
+	int8_t *pWeightsTransformed = get_scratch(pContext) + nIndexBuffer;
+	transform_weights((int8_t*) pWeightsBuffer, pWeightsTransformed, nKernelHeight,nKernelWidth,nInChannels, nNumKernels);
+
+	conv2d_dilation1x1_int8_rows(pInputBuffer, pWeightsTransformed, pWeightsTransformed + nWeightBufSize, pBiasBuffer,
+								 pOutputBuffer, nBatches, nInChannels, nOutChannels, nKernelHeight, nKernelWidth,
+								 nNumKernels, nInputWidth, nInputHeight, stride_height, stride_width, nPadHeight, nPadWidth,
+								 nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+								 nFilterZeroPoint, nActMin, nActMax, 0, nOutHeight);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_dilation1x1_int8
+* @brief adi_sharcfx_conv2d_dilation1x1_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_conv2d_dilation1x1_int8_ctx without context. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_dilation1x1_int8(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+    adi_sharcfx_conv2d_dilation1x1_int8_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches,
+                                            nInChannels, nOutChannels, nKernelHeight, nKernelWidth, nNumKernels,
+                                            nInputWidth, nInputHeight, stride_height, stride_width, nPadHeight,
+                                            nPadWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift,
+                                            pInZeroPoint, pOutZeroPoint, nFilterZeroPoint, nActMin, nActMax, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_dilation1x1_rows_int8
+* @brief row range conv2d function
+*
+* @details adi_sharcfx_conv2d_dilation1x1_int8 restricted to output rows [nOutRowStart, nOutRowEnd) of every batch, with caller
+* provided scratch instead of the shared static scratch buffer. Calls on disjoint row ranges with their own scratch can run
+* concurrently, e.g. one per core, and together produce the output of adi_sharcfx_conv2d_dilation1x1_int8.
+*
+* Parameters:
+* @param [in] nOutRowStart - first output row
+* @param [in] nOutRowEnd - one past the last output row
+* @param [in] pScratch - scratch for the transformed weights and the gathered taps, 2*nKernelHeight*nKernelWidth*nInChannels*nNumKernels bytes
+*
+* see adi_sharcfx_conv2d_dilation1x1_int8 for the other parameters
+*
+* @param [out] pOutputBuffer - output data, only the rows of the range are written
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_dilation1x1_rows_int8(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax,
+		int32_t nOutRowStart,
+		int32_t nOutRowEnd,
+		int8_t* pScratch)
+{
+	//Weights are reordered to [kernel height][kernel width][input channel][output channel]
+	int32_t nWeightBufSize = nNumKernels*nKernelHeight*nKernelWidth*nInChannels;
+	transform_weights((int8_t*) pWeightsBuffer, pScratch, nKernelHeight,nKernelWidth,nInChannels, nNumKernels);
+
+	conv2d_dilation1x1_int8_rows(pInputBuffer, pScratch, pScratch + nWeightBufSize, pBiasBuffer,
+								 pOutputBuffer, nBatches, nInChannels, nOutChannels, nKernelHeight, nKernelWidth,
+								 nNumKernels, nInputWidth, nInputHeight, stride_height, stride_width, nPadHeight, nPadWidth,
+								 nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+								 nFilterZeroPoint, nActMin, nActMax, nOutRowStart, nOutRowEnd);
+}
+
+/*UTILITY FUNCTION*/
+//Dilated convolution of output rows [nOutRowStart, nOutRowEnd) of every batch. Weights are in [kernel height][kernel width][input channel][output channel] order
+inline void conv2d_dilated_int8_rows(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsTransformed,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterOffset,
+		int32_t nActMin,
+		int32_t nActMax,
+		int32_t nOutRowStart,
+		int32_t nOutRowEnd)
+{
+	xb_vecMx8* outp;
+	valign outa;
+
+	xb_vec2Mx16 vin,vwt;
+	xb_vec2Mx40 acc = 0;
+	xb_vecMx32 vmin = nActMin;
+	xb_vecMx32 vmax = nActMax;
+	xb_vec2Mx16 vInZP = pInZeroPoint;
+	xb_vecMx32 vOutZP = pOutZeroPoint;
+	xb_vec2Mx16 vFilterZP = nFilterOffset;
+
+	//Effective kernel size once the dilation gaps are included
+	int32_t nDilatedKernelHeight = (nKernelHeight-1)*nDilationHeight + 1;
+	int32_t nDilatedKernelWidth = (nKernelWidth-1)*nDilationWidth + 1;
+
+	int32_t nTotalPadWidth, nTotalPadHeight;
+	nTotalPadWidth = MAX((nOutWidth-1)*stride_width + nDilatedKernelWidth - nInputWidth, 0);
+	nTotalPadHeight = MAX((nOutHeight-1)*stride_height + nDilatedKernelHeight - nInputHeight, 0);
+
+	int32_t nPadTop = nTotalPadHeight>>1;
+	int32_t nPadLeft = nTotalPadWidth>>1;
+	int32_t nTapStartH, nTapEndH, nTapStartW, nTapEndW;
+
+	//Byte offsets between dilated kernel taps in the input
+	int32_t nTapStrideH = nDilationHeight*nInputWidth*nInChannels;
+	int32_t nTapStrideW = nDilationWidth*nInChannels;
+
+	xb_vec2Mx8 *wtp;
+	valign wta;
+
+	for (int32_t nBatch = 0; nBatch < nBatches; ++nBatch)
+	{
+		const int8_t *pBatchInput = pInputBuffer+nBatch*nInputHeight*nInputWidth*nInChannels;
+		outp = (xb_vecMx8 *)(pOutputBuffer + (nBatch*nOutHeight + nOutRowStart)*nOutWidth*nOutChannels);
+		outa = PDX_LA_MX8_PP (outp); // prime, NOP if a[] is aligned
+
+		for (int32_t out_y = nOutRowStart; out_y < nOutRowEnd; ++out_y)
+		{
+			//Kernel rows inside the input, taps in the padding are skipped
+			int32_t in_y = out_y*stride_height - nPadTop;
+			get_valid_tap_range(in_y, nInputHeight, nKernelHeight, nDilationHeight, &nTapStartH, &nTapEndH);
+
+			for (int32_t out_x = 0; out_x < nOutWidth; ++out_x)
+			{
+				int32_t in_x = out_x*stride_width - nPadLeft;
+				get_valid_tap_range(in_x, nInputWidth, nKernelWidth, nDilationWidth, &nTapStartW, &nTapEndW);
+
+				//Top left tap of the dilated window for this output pixel, may lie in the padding
+				const int8_t *pWindow = pBatchInput + (in_y*nInputWidth + in_x)*nInChannels;
+
+				for (int32_t nOutChannel = 0; nOutChannel < nOutChannels; nOutChannel+=2*PDX_M)
+				{
+					acc = 0;// Reset acc
+					for (int32_t nKerH = nTapStartH; nKerH < nTapEndH; nKerH++)
+					{
+						const int8_t *pTapRow = pWindow + nKerH*nTapStrideH;
+						wtp = (xb_vec2Mx8*)(pWeightsTransformed + (nKerH*nKernelWidth + nTapStartW)*nInChannels*nNumKernels + nOutChannel);
+						wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+						for (int32_t nKerW = nTapStartW; nKerW < nTapEndW; nKerW++)
+						{
+							const int8_t *pTap = pTapRow + nKerW*nTapStrideW;
+							for (int32_t nKerCh = 0; nKerCh < nInChannels; nKerCh++)
+							{
+								//READ IP, broadcast one input tap to all lanes
+								vin = pTap[nKerCh];
+								vin += vInZP;		//Add input offset
+								//READ WT, 2*PDX_M output channels for this tap
+								PDX_LA16_2MX8_XP (vwt, wta, wtp, nNumKernels);
+								vwt += vFilterZP;	//Add filter offset
+								wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+								//MAC
+								PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
+							}
+						}
+					}
+					//Quantize and store min(2*PDX_M, RemainingOutChannels) outputs
+					quantize_and_store_channels(acc,
+												pBiasBuffer ? pBiasBuffer + nOutChannel : NULL,
+												pQuantizedMultiplier + nOutChannel,
+												pQuantizedShift + nOutChannel,
+												MIN(nOutChannels - nOutChannel, 2*PDX_M),
+												vOutZP, vmin, vmax,
+												outp, outa);
+				}
+			}
+		}
+	}
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_dilated_int8_ctx
+* @brief optimized dilated conv2d function
+*
+* @details optimized conv2d function for 8-bit integer input with arbitrary dilation. 2D convolution in interleaved format using 16bit Eagle intrinsics.
+* The input is indexed directly with the dilation strides, so the kernel is never expanded with zeros, and only the taps inside the input are
+* convolved, so no padded copy of the input is made. Each input tap is broadcast
+* across 2*PDX_M output channels and multiplied with the transformed weights of those channels.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelHeight - kernel height
+* @param [in] nKernelWidth - kernel width
+* @param [in] nNumKernels - # of kernels
+* @param [in] nInputWidth - input width
+* @param [in] nInputHeight - input height
+* @param [in] stride_height - stride height
+* @param [in] stride_width - stride width
+* @param [in] nDilationHeight - dilation height
+* @param [in] nDilationWidth - dilation width
+* @param [in] nOutHeight - output height
+* @param [in] nOutWidth - output width
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] pInZeroPoint - input zeropoint
+* @param [in] pOutZeroPoint - output zeropoint
+* @param [in] nFilterOffset - filter offset, added to every weight
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_dilated_int8_ctx(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterOffset,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext)
+{
+	//Weights are reordered to [kernel height][kernel width][input channel][output channel]
+	int32_t nIndexBuffer = 128;
+	int8_t *pWeightsTransformed = get_scratch(pContext) + nIndexBuffer;
+	transform_weights((int8_t*) pWeightsBuffer, pWeightsTransformed, nKernelHeight,nKernelWidth,nInChannels, nNumKernels);
+
+	conv2d_dilated_int8_rows(pInputBuffer, pWeightsTransformed, pBiasBuffer, pOutputBuffer, nBatches, nInChannels, nOutChannels,
+							 nKernelHeight, nKernelWidth, nNumKernels, nInputWidth, nInputHeight, stride_height, stride_width,
+							 nDilationHeight, nDilationWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift,
+							 pInZeroPoint, pOutZeroPoint, nFilterOffset, nActMin, nActMax, 0, nOutHeight);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_dilated_int8
+* @brief adi_sharcfx_conv2d_dilated_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_conv2d_dilated_int8_ctx without context. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_dilated_int8(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterOffset,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+    adi_sharcfx_conv2d_dilated_int8_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches,
+                                        nInChannels, nOutChannels, nKernelHeight, nKernelWidth, nNumKernels,
+                                        nInputWidth, nInputHeight, stride_height, stride_width, nDilationHeight,
+                                        nDilationWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift,
+                                        pInZeroPoint, pOutZeroPoint, nFilterOffset, nActMin, nActMax, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_dilated_rows_int8
+* @brief row range dilated conv2d function
+*
+* @details adi_sharcfx_conv2d_dilated_int8 restricted to output rows [nOutRowStart, nOutRowEnd) of every batch, with caller provided
+* scratch instead of the shared static scratch buffer. Calls on disjoint row ranges with their own scratch can run concurrently,
+* e.g. one per core, and together produce the output of adi_sharcfx_conv2d_dilated_int8.
+*
+* Parameters:
+* @param [in] nOutRowStart - first output row
+* @param [in] nOutRowEnd - one past the last output row
+* @param [in] pScratch - scratch for the transformed weights, nKernelHeight*nKernelWidth*nInChannels*nNumKernels bytes
+*
+* see adi_sharcfx_conv2d_dilated_int8 for the other parameters
+*
+* @param [out] pOutputBuffer - output data, only the rows of the range are written
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_dilated_rows_int8(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterOffset,
+		int32_t nActMin,
+		int32_t nActMax,
+		int32_t nOutRowStart,
+		int32_t nOutRowEnd,
+		int8_t* pScratch)
+{
+	//Weights are reordered to [kernel height][kernel width][input channel][output channel]
+	transform_weights((int8_t*) pWeightsBuffer, pScratch, nKernelHeight,nKernelWidth,nInChannels, nNumKernels);
+
+	conv2d_dilated_int8_rows(pInputBuffer, pScratch, pBiasBuffer, pOutputBuffer, nBatches, nInChannels, nOutChannels,
+							 nKernelHeight, nKernelWidth, nNumKernels, nInputWidth, nInputHeight, stride_height, stride_width,
+							 nDilationHeight, nDilationWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift,
+							 pInZeroPoint, pOutZeroPoint, nFilterOffset, nActMin, nActMax, nOutRowStart, nOutRowEnd);
+}
+
+/*UTILITY FUNCTION*/
+//Generic 16x8 convolution on interleaved data. Weights are in [kernel height][kernel width][input channel][output channel] order.
+//16x8 activations have a zero input offset, so taps falling in the padding contribute nothing and are skipped instead of padding the input.
+inline void conv2d_int16_core(
+				const int16_t *pInputBuffer,
+				const int8_t *pWeightsTransformed,
+				const int32_t *pBiasHigh,
+				const int32_t *pBiasLow,
+				int16_t *pOutputBuffer,
+				int32_t nInputHeight,
+				int32_t nInputWidth,
+				int32_t nInChannels,
+				int32_t nOutChannels,
+				int32_t nKernelHeight,
+				int32_t nKernelWidth,
+				int32_t stride_height,
+				int32_t stride_width,
+				int32_t nDilationHeight,
+				int32_t nDilationWidth,
+				int32_t nPadTop,
+				int32_t nPadLeft,
+				int32_t nOutHeight,
+				int32_t nOutWidth,
+				const int32_t *pQuantizedMultiplier,
+				const int32_t *pQuantizedShift,
+				int32_t nActMin,
+				int32_t nActMax,
+				int32_t nOutRowStart,
+				int32_t nOutRowEnd)
+{
+	xb_vecMx16* outp = (xb_vecMx16 *)(pOutputBuffer + nOutRowStart*nOutWidth*nOutChannels);
+	valign outa = PDX_Z_ALIGN();
+
+	xb_vec2Mx16 vin,vwt;
+	xb_vec2Mx40 acc = 0;
+	xb_vecMx32 vmin = nActMin;
+	xb_vecMx32 vmax = nActMax;
+
+	xb_vec2Mx8 *wtp;
+	valign wta;
+
+	int32_t nTapStride = nKernelWidth*nInChannels*nOutChannels;//weight bytes per kernel row
+
+	for (int32_t out_y = nOutRowStart; out_y < nOutRowEnd; ++out_y)
+	{
+		//Kernel rows that land inside the input for this output row
+		int32_t in_y = out_y*stride_height - nPadTop;
+		int32_t nKerHStart = in_y < 0 ? (-in_y + nDilationHeight - 1)/nDilationHeight : 0;
+		int32_t nKerHEnd = MIN(nKernelHeight, (nInputHeight - in_y + nDilationHeight - 1)/nDilationHeight);
+
+		for (int32_t out_x = 0; out_x < nOutWidth; ++out_x)
+		{
+			//Kernel columns that land inside the input for this output pixel
+			int32_t in_x = out_x*stride_width - nPadLeft;
+			int32_t nKerWStart = in_x < 0 ? (-in_x + nDilationWidth - 1)/nDilationWidth : 0;
+			int32_t nKerWEnd = MIN(nKernelWidth, (nInputWidth - in_x + nDilationWidth - 1)/nDilationWidth);
+
+			for (int32_t nOutChannel = 0; nOutChannel < nOutChannels; nOutChannel+=2*PDX_M)
+			{
+				acc = 0;// Reset acc
+				for (int32_t nKerH = nKerHStart; nKerH < nKerHEnd; nKerH++)
+				{
+					const int16_t *pTapRow = pInputBuffer + ((in_y + nKerH*nDilationHeight)*nInputWidth + in_x)*nInChannels;
+					for (int32_t nKerW = nKerWStart; nKerW < nKerWEnd; nKerW++)
+					{
+						const int16_t *pTap = pTapRow + nKerW*nDilationWidth*nInChannels;
+						wtp = (xb_vec2Mx8*)(pWeightsTransformed + nKerH*nTapStride + nKerW*nInChannels*nOutChannels + nOutChannel);
+						wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+						for (int32_t nKerCh = 0; nKerCh < nInChannels; nKerCh++)
+						{
+							//READ IP, broadcast one input tap to all lanes
+							vin = pTap[nKerCh];
+							//READ WT, 2*PDX_M output channels for this tap
+							PDX_LA16_2MX8_XP (vwt, wta, wtp, nOutChannels);
+							wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+							//MAC without doubling
+							PDX_MULAW_2MX16(acc,vin,vwt);
+						}
+					}
+				}
+				quantize_and_store_channels_16x8(acc,
+												 pBiasHigh ? pBiasHigh + nOutChannel : NULL,
+												 pBiasHigh ? pBiasLow + nOutChannel : NULL,
+												 pQuantizedMultiplier + nOutChannel,
+												 pQuantizedShift + nOutChannel,
+												 MIN(nOutChannels - nOutChannel, 2*PDX_M),
+												 vmin, vmax,
+												 outp, outa);
+			}
+		}
+	}
+}
+
+/*UTILITY FUNCTION*/
+//Body of adi_sharcfx_conv2d_int16_ctx for output rows [nOutRowStart, nOutRowEnd) of every batch. The fixed shape entry points
+//call it with constant kernel size, stride and dilation, so each gets its own instance of conv2d_int16_core with the tap loops
+//resolved at compile time
+inline void conv2d_int16_run(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax,
+		int32_t nOutRowStart,
+		int32_t nOutRowEnd,
+		int8_t* pScratch)
+{
+	//Scratch: high and low halves of the 64bit bias, each padded to a vector, followed by the reordered weights
+	int32_t nBiasBytes = ((nOutChannels*sizeof(int32_t) + 4*PDX_M - 1)/(4*PDX_M))*4*PDX_M;
+	int32_t *pBiasHigh = (int32_t*)pScratch;
+	int32_t *pBiasLow = (int32_t*)&pScratch[nBiasBytes];
+	int8_t *pWeightsTransformed = (int8_t*)&pScratch[2*nBiasBytes];
+
+	if (pBiasBuffer)
+	{
+		split_bias_int64(pBiasBuffer, pBiasHigh, pBiasLow, nOutChannels);
+	}
+	transform_weights((int8_t*) pWeightsBuffer, pWeightsTransformed, nKernelHeight, nKernelWidth, nInChannels, nOutChannels);
+
+	for (int32_t nBatch = 0; nBatch < nBatches; ++nBatch)
+	{
+		conv2d_int16_core(pInputBuffer + nBatch*nInputHeight*nInputWidth*nInChannels,
+						  pWeightsTransformed,
+						  pBiasBuffer ? pBiasHigh : NULL,
+						  pBiasLow,
+						  pOutputBuffer + nBatch*nOutHeight*nOutWidth*nOutChannels,
+						  nInputHeight, nInputWidth, nInChannels, nOutChannels,
+						  nKernelHeight, nKernelWidth,
+						  stride_height, stride_width,
+						  nDilationHeight, nDilationWidth,
+						  nPadHeight, nPadWidth,
+						  nOutHeight, nOutWidth,
+						  pQuantizedMultiplier, pQuantizedShift,
+						  nActMin, nActMax, nOutRowStart, nOutRowEnd);
+	}
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_int16_ctx
+* @brief optimized 16x8 conv2d function
+*
+* @details optimized conv2d function for 16-bit integer input, 8-bit weights and 64-bit bias (TFLite 16x8 scheme).
+* 2D convolution in interleaved format with arbitrary kernel size, stride and dilation on the 40bit accumulator path.
+* Input and output zero points are 0 for 16x8, so padded taps are skipped rather than materialized.
+* The 64-bit bias and the 40-bit accumulator are requantized like the TFLite reference, without saturation to 32 bit.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelHeight - kernel height
+* @param [in] nKernelWidth - kernel width
+* @param [in] nInputWidth - input width
+* @param [in] nInputHeight - input height
+* @param [in] stride_height - stride height
+* @param [in] stride_width - stride width
+* @param [in] nDilationHeight - dilation height
+* @param [in] nDilationWidth - dilation width
+* @param [in] nPadHeight - top padding
+* @param [in] nPadWidth - left padding
+* @param [in] nOutHeight - output height
+* @param [in] nOutWidth - output width
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_int16_ctx(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext)
+{
+	conv2d_int16_run(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches, nInChannels, nOutChannels, nKernelHeight,
+					 nKernelWidth, nInputWidth, nInputHeight, stride_height, stride_width, nDilationHeight, nDilationWidth,
+					 nPadHeight, nPadWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift, nActMin, nActMax,
+					 0, nOutHeight, get_scratch(pContext));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_int16
+* @brief adi_sharcfx_conv2d_int16_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_conv2d_int16_ctx without context. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_int16(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+    adi_sharcfx_conv2d_int16_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches, nInChannels,
+                                 nOutChannels, nKernelHeight, nKernelWidth, nInputWidth, nInputHeight, stride_height,
+                                 stride_width, nDilationHeight, nDilationWidth, nPadHeight, nPadWidth, nOutHeight,
+                                 nOutWidth, pQuantizedMultiplier, pQuantizedShift, nActMin, nActMax, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_int16_rows
+* @brief row range 16x8 conv2d function
+*
+* @details adi_sharcfx_conv2d_int16 restricted to output rows [nOutRowStart, nOutRowEnd) of every batch, with caller provided
+* scratch instead of the shared static scratch buffer. Calls on disjoint row ranges with their own scratch can run concurrently,
+* e.g. one per core, and together produce the output of adi_sharcfx_conv2d_int16.
+*
+* Parameters:
+* @param [in] nOutRowStart - first output row
+* @param [in] nOutRowEnd - one past the last output row
+* @param [in] pScratch - 8 byte aligned scratch for the split bias and the transformed weights,
+* 2*ALIGN(4*nOutChannels, 4*PDX_M) + nKernelHeight*nKernelWidth*nInChannels*nOutChannels bytes
+*
+* see adi_sharcfx_conv2d_int16 for the other parameters
+*
+* @param [out] pOutputBuffer - output data, only the rows of the range are written
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_int16_rows(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax,
+		int32_t nOutRowStart,
+		int32_t nOutRowEnd,
+		int8_t* pScratch)
+{
+	conv2d_int16_run(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches, nInChannels, nOutChannels, nKernelHeight,
+					 nKernelWidth, nInputWidth, nInputHeight, stride_height, stride_width, nDilationHeight, nDilationWidth,
+					 nPadHeight, nPadWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift, nActMin, nActMax,
+					 nOutRowStart, nOutRowEnd, pScratch);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel1x1_int16
+* @brief optimized 16x8 conv2d function
+*
+* @details optimized conv2d function for 16-bit integer input, 8-bit weights and 64-bit bias. 1x1 2D convolution in interleaved format
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nSize - # of pixels
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel1x1_int16(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nSize,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+	//A 1x1 convolution over nSize pixels is a 1xnSize image with a 1x1 kernel
+	conv2d_int16_run(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer,
+					 nBatches, nInChannels, nOutChannels,
+					 1, 1, nSize, 1,
+					 1, 1, 1, 1, 0, 0,
+					 1, nSize,
+					 pQuantizedMultiplier, pQuantizedShift,
+					 nActMin, nActMax, 0, 1, get_scratch(NULL));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel3x3_stride1_same_pad_int16
+* @brief optimized 16x8 conv2d function
+*
+* @details optimized conv2d function for 16-bit integer input. 3x3 2D convolution in interleaved format with stride 1 and same padding
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nWidth - input width
+* @param [in] nHeight - input height
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel3x3_stride1_same_pad_int16(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nWidth,
+		int32_t nHeight,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+	conv2d_int16_run(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer,
+					 1, nInChannels, nOutChannels,
+					 INT_3x3_FILTER_WIDTH, INT_3x3_FILTER_WIDTH, nWidth, nHeight,
+					 1, 1, 1, 1, 1, 1,
+					 nHeight, nWidth,
+					 pQuantizedMultiplier, pQuantizedShift,
+					 nActMin, nActMax, 0, nHeight, get_scratch(NULL));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel3x3_stride1_valid_pad_int16
+* @brief optimized 16x8 conv2d function
+*
+* @details optimized conv2d function for 16-bit integer input. 3x3 2D convolution in interleaved format with stride 1 and valid padding
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nWidth - input width
+* @param [in] nHeight - input height
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel3x3_stride1_valid_pad_int16(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nWidth,
+		int32_t nHeight,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+	conv2d_int16_run(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer,
+					 1, nInChannels, nOutChannels,
+					 INT_3x3_FILTER_WIDTH, INT_3x3_FILTER_WIDTH, nWidth, nHeight,
+					 1, 1, 1, 1, 0, 0,
+					 nHeight - INT_3x3_FILTER_WIDTH + 1, nWidth - INT_3x3_FILTER_WIDTH + 1,
+					 pQuantizedMultiplier, pQuantizedShift,
+					 nActMin, nActMax, 0, nHeight - INT_3x3_FILTER_WIDTH + 1, get_scratch(NULL));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_kernel3x3_stride2_valid_pad_int16
+* @brief optimized 16x8 conv2d function
+*
+* @details optimized conv2d function for 16-bit integer input. 3x3 2D convolution in interleaved format with stride 2 and valid padding
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nWidth - input width
+* @param [in] nHeight - input height
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_conv2d_kernel3x3_stride2_valid_pad_int16(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nWidth,
+		int32_t nHeight,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+	conv2d_int16_run(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer,
+					 1, nInChannels, nOutChannels,
+					 INT_3x3_FILTER_WIDTH, INT_3x3_FILTER_WIDTH, nWidth, nHeight,
+					 STRIDE_2, STRIDE_2, 1, 1, 0, 0,
+					 (nHeight - INT_3x3_FILTER_WIDTH)/STRIDE_2 + 1, (nWidth - INT_3x3_FILTER_WIDTH)/STRIDE_2 + 1,
+					 pQuantizedMultiplier, pQuantizedShift,
+					 nActMin, nActMax, 0, (nHeight - INT_3x3_FILTER_WIDTH)/STRIDE_2 + 1, get_scratch(NULL));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_transpose_conv2d_int8_ctx
+* @brief optimized transpose conv2d (deconvolution) function
+*
+* @details optimized transpose conv2d function for 8-bit integer input in interleaved format using 16bit Eagle intrinsics.
+* Uses the output-stationary formulation: for every output pixel only the kernel taps with (out + pad - k) divisible by the stride
+* contribute, so each output is accumulated for 2*PDX_M channels in registers and requantized once instead of being scatter-added into memory.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer, [out channel][kernel height][kernel width][in channel]
+* @param [in] pBiasBuffer - input bias buffer, can be NULL
+* @param [in] nBatches - batch size
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelHeight - kernel height
+* @param [in] nKernelWidth - kernel width
+* @param [in] nInputWidth - input width
+* @param [in] nInputHeight - input height
+* @param [in] stride_height - stride height
+* @param [in] stride_width - stride width
+* @param [in] nPadHeight - top padding for same/valid padding
+* @param [in] nPadWidth - left padding for same/valid padding
+* @param [in] nOutHeight - output height
+* @param [in] nOutWidth - output width
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] pInZeroPoint - input zeropoint
+* @param [in] pOutZeroPoint - output zeropoint
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_transpose_conv2d_int8_ctx(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext)
+{
+	xb_vecMx8* outp  = (xb_vecMx8 *)pOutputBuffer;
+	valign outa = PDX_LA_MX8_PP (outp); // prime, NOP if a[] is aligned
+
+	xb_vec2Mx16 vin,vwt;
+	xb_vec2Mx40 acc = 0;
+	xb_vecMx32 vmin = nActMin;
+	xb_vecMx32 vmax = nActMax;
+	xb_vec2Mx16 vInZP = pInZeroPoint;
+	xb_vecMx32 vOutZP = pOutZeroPoint;
+
+	//Weights are reordered to [kernel height][kernel width][input channel][output channel]
+	int8_t *pWeightsTransformed = get_scratch(pContext);
+	transform_weights((int8_t*) pWeightsBuffer, pWeightsTransformed, nKernelHeight,nKernelWidth,nInChannels, nOutChannels);
+
+	int32_t nTapSize = nInChannels*nOutChannels;//weight bytes per kernel tap
+
+	xb_vec2Mx8 *wtp;
+	valign wta;
+
+	for (int32_t nBatch = 0; nBatch < nBatches; ++nBatch)
+	{
+		const int8_t *pInput = pInputBuffer + nBatch*nInputHeight*nInputWidth*nInChannels;
+
+		for (int32_t out_y = 0; out_y < nOutHeight; ++out_y)
+		{
+			//out_y = in_y*stride + kh - pad, so only every stride-th kernel row starting at (out_y+pad)%stride contributes
+			int32_t nRowOffset = out_y + nPadHeight;
+			int32_t nKerHStart = nRowOffset % stride_height;
+			//skip kernel rows that map past the last input row
+			if (nRowOffset - nKerHStart >= nInputHeight*stride_height)
+			{
+				nKerHStart += ((nRowOffset - nKerHStart)/stride_height - nInputHeight + 1)*stride_height;
+			}
+			int32_t nKerHEnd = MIN(nKernelHeight, nRowOffset + 1);
+
+			for (int32_t out_x = 0; out_x < nOutWidth; ++out_x)
+			{
+				int32_t nColOffset = out_x + nPadWidth;
+				int32_t nKerWStart = nColOffset % stride_width;
+				if (nColOffset - nKerWStart >= nInputWidth*stride_width)
+				{
+					nKerWStart += ((nColOffset - nKerWStart)/stride_width - nInputWidth + 1)*stride_width;
+				}
+				int32_t nKerWEnd = MIN(nKernelWidth, nColOffset + 1);
+
+				for (int32_t nOutChannel = 0; nOutChannel < nOutChannels; nOutChannel+=2*PDX_M)
+				{
+					acc = 0;// Reset acc
+					for (int32_t nKerH = nKerHStart; nKerH < nKerHEnd; nKerH+=stride_height)
+					{
+						int32_t in_y = (nRowOffset - nKerH)/stride_height;
+						for (int32_t nKerW = nKerWStart; nKerW < nKerWEnd; nKerW+=stride_width)
+						{
+							int32_t in_x = (nColOffset - nKerW)/stride_width;
+							const int8_t *pTap = pInput + (in_y*nInputWidth + in_x)*nInChannels;
+
+							wtp = (xb_vec2Mx8*)(pWeightsTransformed + (nKerH*nKernelWidth + nKerW)*nTapSize + nOutChannel);
+							wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+							for (int32_t nKerCh = 0; nKerCh < nInChannels; nKerCh++)
+							{
+								//READ IP, broadcast one input value to all lanes
+								vin = pTap[nKerCh];
+								vin += vInZP;		//Add input offset
+								//READ WT, 2*PDX_M output channels for this tap
+								PDX_LA16_2MX8_XP (vwt, wta, wtp, nOutChannels);
+								wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+								//MAC
+								PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
+							}
+						}
+					}
+					//Quantize and store min(2*PDX_M, RemainingOutChannels) outputs
+					quantize_and_store_channels(acc,
+												pBiasBuffer ? pBiasBuffer + nOutChannel : NULL,
+												pQuantizedMultiplier + nOutChannel,
+												pQuantizedShift + nOutChannel,
+												MIN(nOutChannels - nOutChannel, 2*PDX_M),
+												vOutZP, vmin, vmax,
+												outp, outa);
+				}
+			}
+		}
+	}
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_transpose_conv2d_int8
+* @brief adi_sharcfx_transpose_conv2d_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_transpose_conv2d_int8_ctx without context. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_transpose_conv2d_int8(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax)
+{
+    adi_sharcfx_transpose_conv2d_int8_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches,
+                                          nInChannels, nOutChannels, nKernelHeight, nKernelWidth, nInputWidth,
+                                          nInputHeight, stride_height, stride_width, nPadHeight, nPadWidth, nOutHeight,
+                                          nOutWidth, pQuantizedMultiplier, pQuantizedShift, pInZeroPoint,
+                                          pOutZeroPoint, nActMin, nActMax, NULL);
+}
@@ -0,0 +1,350 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_conv2d_specialized.cpp
+*
+* @brief: contains the compile time specialized conv2d kernels
+*
+* @details: contains a conv2d kernel templated on the kernel size, the stride and the output channel tail, its instantiations
+* for the common shapes and the dispatcher that falls back to the generic conv2d kernel for other shapes
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= D E F I N E S =============*/
+/*Offset of the transformed weights in the scratch, same layout as adi_sharcfx_conv2d_dilation1x1_int8*/
+#define CONV2D_SPECIALIZED_WEIGHTS_OFFSET   128
+
+/*Parameters shared by all instantiations*/
+typedef struct
+{
+    const int8_t *pInputBuffer;
+    const int8_t *pWeightsTransformed;      /*[kernel height][kernel width][input channel][output channel]*/
+    const int32_t *pBiasBuffer;
+    int8_t *pOutputBuffer;
+    int32_t nBatches;
+    int32_t nInChannels;
+    int32_t nOutChannels;
+    int32_t nInputWidth;
+    int32_t nInputHeight;
+    int32_t nOutHeight;
+    int32_t nOutWidth;
+    int32_t nPadTop;
+    int32_t nPadLeft;
+    const int32_t *pQuantizedMultiplier;
+    const int32_t *pQuantizedShift;
+    int32_t nInputOffset;
+    int32_t nOutputOffset;
+    int32_t nFilterOffset;
+    int32_t nActMin;
+    int32_t nActMax;
+} CONV2D_SPECIALIZED_ARGS;
+
+typedef void (*CONV2D_SPECIALIZED_FN)(const CONV2D_SPECIALIZED_ARGS *pArgs);
+
+/*Instantiation for one shape: all output channel blocks full, or a partial last block*/
+typedef struct
+{
+    int32_t nKernelHeight;
+    int32_t nKernelWidth;
+    int32_t nStrideHeight;
+    int32_t nStrideWidth;
+    CONV2D_SPECIALIZED_FN pfFull;
+    CONV2D_SPECIALIZED_FN pfTail;
+} CONV2D_SPECIALIZATION;
+
+#define CONV2D_SPECIALIZE(kh, kw, sh, sw)   {kh, kw, sh, sw, conv2d_specialized_int8<kh, kw, sh, sw, true>, \
+                                                             conv2d_specialized_int8<kh, kw, sh, sw, false>}
+
+/*============= F U N C T I O N P R O T O T Y P E S =============*/
+template <int32_t KH, int32_t KW, int32_t SH, int32_t SW, bool FULL_CHANNELS>
+static void conv2d_specialized_int8(const CONV2D_SPECIALIZED_ARGS *pArgs);
+
+/*============= D A T A =============*/
+/*Shapes with a specialized kernel, other shapes run adi_sharcfx_conv2d_dilation1x1_int8*/
+static const CONV2D_SPECIALIZATION sSpecializations[] = {
+    CONV2D_SPECIALIZE(1, 1, 1, 1),
+    CONV2D_SPECIALIZE(1, 1, 2, 2),
+    CONV2D_SPECIALIZE(3, 3, 1, 1),
+    CONV2D_SPECIALIZE(3, 3, 2, 2),
+    CONV2D_SPECIALIZE(5, 5, 1, 1),
+    CONV2D_SPECIALIZE(5, 5, 2, 2),
+    CONV2D_SPECIALIZE(7, 7, 2, 2),
+    CONV2D_SPECIALIZE(7, 1, 1, 1),
+    CONV2D_SPECIALIZE(1, 7, 1, 1),
+    CONV2D_SPECIALIZE(3, 1, 1, 1),
+    CONV2D_SPECIALIZE(1, 3, 1, 1)
+};
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Conv2d with a KH x KW kernel and SH x SW stride known at compile time. Each input tap is broadcast across 2*PDX_M output
+//channels and multiplied with the transformed weights of those channels. Windows fully inside the input run the unrolled
+//KH x KW tap loop with constant offsets, windows at the border skip the taps in the padding. FULL_CHANNELS drops the
+//partial last block of output channels when nOutChannels is a multiple of 2*PDX_M
+template <int32_t KH, int32_t KW, int32_t SH, int32_t SW, bool FULL_CHANNELS>
+static void conv2d_specialized_int8(const CONV2D_SPECIALIZED_ARGS *pArgs)
+{
+    const int32_t nInChannels = pArgs->nInChannels;
+    const int32_t nOutChannels = pArgs->nOutChannels;
+    const int32_t nInputWidth = pArgs->nInputWidth;
+    const int32_t nInputHeight = pArgs->nInputHeight;
+    const int32_t nRowStride = nInputWidth*nInChannels;
+
+    xb_vecMx8* outp;
+    valign outa;
+
+    xb_vec2Mx16 vin,vwt;
+    xb_vec2Mx40 acc = 0;
+    xb_vecMx32 vmin = pArgs->nActMin;
+    xb_vecMx32 vmax = pArgs->nActMax;
+    xb_vec2Mx16 vInZP = pArgs->nInputOffset;
+    xb_vec2Mx16 vFilterZP = pArgs->nFilterOffset;
+    xb_vecMx32 vOutZP = pArgs->nOutputOffset;
+
+    int32_t nTapStartH, nTapEndH, nTapStartW, nTapEndW;
+    xb_vec2Mx8 *wtp;
+    valign wta;
+
+    for (int32_t nBatch = 0; nBatch < pArgs->nBatches; ++nBatch)
+    {
+        const int8_t *pBatchInput = pArgs->pInputBuffer + nBatch*nInputHeight*nRowStride;
+        outp = (xb_vecMx8 *)(pArgs->pOutputBuffer + nBatch*pArgs->nOutHeight*pArgs->nOutWidth*nOutChannels);
+        outa = PDX_Z_ALIGN();
+
+        for (int32_t out_y = 0; out_y < pArgs->nOutHeight; ++out_y)
+        {
+            int32_t in_y = out_y*SH - pArgs->nPadTop;
+            get_valid_tap_range(in_y, nInputHeight, KH, 1, &nTapStartH, &nTapEndH);
+
+            for (int32_t out_x = 0; out_x < pArgs->nOutWidth; ++out_x)
+            {
+                int32_t in_x = out_x*SW - pArgs->nPadLeft;
+                get_valid_tap_range(in_x, nInputWidth, KW, 1, &nTapStartW, &nTapEndW);
+                int32_t nInterior = (nTapStartH == 0 && nTapEndH == KH && nTapStartW == 0 && nTapEndW == KW);
+
+                //Top left tap of the window for this output pixel, may lie in the padding
+                const int8_t *pWindow = pBatchInput + in_y*nRowStride + in_x*nInChannels;
+
+                for (int32_t nOutChannel = 0; nOutChannel < nOutChannels; nOutChannel+=2*PDX_M)
+                {
+                    acc = 0;// Reset acc
+                    if (nInterior)
+                    {
+                        //all taps valid, the weights of the window are one stream
+                        wtp = (xb_vec2Mx8*)(pArgs->pWeightsTransformed + nOutChannel);
+                        wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+                        for (int32_t nKerH = 0; nKerH < KH; nKerH++)
+                        {
+                            for (int32_t nKerW = 0; nKerW < KW; nKerW++)
+                            {
+                                const int8_t *pTap = pWindow + nKerH*nRowStride + nKerW*nInChannels;
+                                for (int32_t nKerCh = 0; nKerCh < nInChannels; nKerCh++)
+                                {
+                                    vin = pTap[nKerCh];     //broadcast one input tap to all lanes
+                                    vin += vInZP;           //Add input offset
+                                    PDX_LA16_2MX8_XP (vwt, wta, wtp, nOutChannels);
+                                    wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+                                    vwt += vFilterZP;       //Add filter offset
+                                    PDX_MULAQW_2MX16(acc,vin,vwt);
+                                }
+                            }
+                        }
+                    }
+                    else
+                    {
+                        for (int32_t nKerH = nTapStartH; nKerH < nTapEndH; nKerH++)
+                        {
+                            wtp = (xb_vec2Mx8*)(pArgs->pWeightsTransformed + (nKerH*KW + nTapStartW)*nInChannels*nOutChannels + nOutChannel);
+                            wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+                            for (int32_t nKerW = nTapStartW; nKerW < nTapEndW; nKerW++)
+                            {
+                                const int8_t *pTap = pWindow + nKerH*nRowStride + nKerW*nInChannels;
+                                for (int32_t nKerCh = 0; nKerCh < nInChannels; nKerCh++)
+                                {
+                                    vin = pTap[nKerCh];     //broadcast one input tap to all lanes
+                                    vin += vInZP;           //Add input offset
+                                    PDX_LA16_2MX8_XP (vwt, wta, wtp, nOutChannels);
+                                    wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+                                    vwt += vFilterZP;       //Add filter offset
+                                    PDX_MULAQW_2MX16(acc,vin,vwt);
+                                }
+                            }
+                        }
+                    }
+                    //Quantize and store, the block length is a constant for FULL_CHANNELS
+                    quantize_and_store_channels(acc,
+                                                pArgs->pBiasBuffer ? pArgs->pBiasBuffer + nOutChannel : NULL,
+                                                pArgs->pQuantizedMultiplier + nOutChannel,
+                                                pArgs->pQuantizedShift + nOutChannel,
+                                                FULL_CHANNELS ? 2*PDX_M : MIN(nOutChannels - nOutChannel, 2*PDX_M),
+                                                vOutZP, vmin, vmax,
+                                                outp, outa);
+                }
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_specialized_int8_ctx
+* @brief compile time specialized conv2d function
+*
+* @details conv2d function for 8-bit integer input with dilation 1, a drop in replacement of adi_sharcfx_conv2d_dilation1x1_int8_ctx.
+* Common kernel sizes and strides (1x1, 3x3, 5x5, 7x7, 7x1, 1x7, 3x1, 1x3) run a kernel instantiated for the shape, with the
+* kernel size and stride as compile time constants and no output channel tail handling when nOutChannels is a multiple of
+* 2*PDX_M. The tap loops have compile time bounds, the loop over the nInChannels of a tap is a runtime loop. Other shapes run
+* adi_sharcfx_conv2d_dilation1x1_int8_ctx. The scratch holds the transformed weights after a 128 byte offset, which is within
+* the scratch of adi_sharcfx_conv2d_dilation1x1_int8_ctx, and -1 is returned if they do not fit.
+*
+* Parameters:
+* see adi_sharcfx_conv2d_dilation1x1_int8_ctx, the padding is derived from the output size
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_conv2d_specialized_int8_ctx(const int8_t* pInputBuffer,
+                                                const int8_t* pWeightsBuffer,
+                                                const int32_t* pBiasBuffer,
+                                                int8_t* pOutputBuffer,
+                                                int32_t nBatches,
+                                                int32_t nInChannels,
+                                                int32_t nOutChannels,
+                                                int32_t nKernelHeight,
+                                                int32_t nKernelWidth,
+                                                int32_t nNumKernels,
+                                                int32_t nInputWidth,
+                                                int32_t nInputHeight,
+                                                int32_t stride_height,
+                                                int32_t stride_width,
+                                                int32_t nPadHeight,
+                                                int32_t nPadWidth,
+                                                int32_t nOutHeight,
+                                                int32_t nOutWidth,
+                                                int32_t *pQuantizedMultiplier,
+                                                int32_t *pQuantizedShift,
+                                                int32_t pInZeroPoint,
+                                                int32_t pOutZeroPoint,
+                                                int32_t nFilterZeroPoint,
+                                                int32_t nActMin,
+                                                int32_t nActMax,
+                                                const ADI_SHARCFX_CONTEXT* pContext)
+{
+    const CONV2D_SPECIALIZATION *pSpecialization = NULL;
+    for (uint32_t i = 0; i < sizeof(sSpecializations)/sizeof(sSpecializations[0]); i++)
+    {
+        if (sSpecializations[i].nKernelHeight == nKernelHeight && sSpecializations[i].nKernelWidth == nKernelWidth &&
+            sSpecializations[i].nStrideHeight == stride_height && sSpecializations[i].nStrideWidth == stride_width)
+        {
+            pSpecialization = &sSpecializations[i];
+            break;
+        }
+    }
+
+    //the transformed weights are indexed with nOutChannels, so the kernel count must match
+    if (pSpecialization == NULL || nNumKernels != nOutChannels)
+    {
+        adi_sharcfx_conv2d_dilation1x1_int8_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches,
+                                                nInChannels, nOutChannels, nKernelHeight, nKernelWidth, nNumKernels,
+                                                nInputWidth, nInputHeight, stride_height, stride_width, nPadHeight,
+                                                nPadWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift,
+                                                pInZeroPoint, pOutZeroPoint, nFilterZeroPoint, nActMin, nActMax, pContext);
+        return 0;
+    }
+
+    if (CONV2D_SPECIALIZED_WEIGHTS_OFFSET + nKernelHeight*nKernelWidth*nInChannels*nNumKernels > get_scratch_size(pContext))
+    {
+        return -1;
+    }
+    int8_t *pWeightsTransformed = get_scratch(pContext) + CONV2D_SPECIALIZED_WEIGHTS_OFFSET;
+    transform_weights((int8_t*) pWeightsBuffer, pWeightsTransformed, nKernelHeight, nKernelWidth, nInChannels, nNumKernels);
+
+    CONV2D_SPECIALIZED_ARGS sArgs;
+    sArgs.pInputBuffer = pInputBuffer;
+    sArgs.pWeightsTransformed = pWeightsTransformed;
+    sArgs.pBiasBuffer = pBiasBuffer;
+    sArgs.pOutputBuffer = pOutputBuffer;
+    sArgs.nBatches = nBatches;
+    sArgs.nInChannels = nInChannels;
+    sArgs.nOutChannels = nOutChannels;
+    sArgs.nInputWidth = nInputWidth;
+    sArgs.nInputHeight = nInputHeight;
+    sArgs.nOutHeight = nOutHeight;
+    sArgs.nOutWidth = nOutWidth;
+    //same padding as adi_sharcfx_conv2d_dilation1x1_int8_ctx
+    sArgs.nPadTop = MAX((nOutHeight-1)*stride_height + nKernelHeight - nInputHeight, 0)>>1;
+    sArgs.nPadLeft = MAX((nOutWidth-1)*stride_width + nKernelWidth - nInputWidth, 0)>>1;
+    sArgs.pQuantizedMultiplier = pQuantizedMultiplier;
+    sArgs.pQuantizedShift = pQuantizedShift;
+    sArgs.nInputOffset = pInZeroPoint;
+    sArgs.nOutputOffset = pOutZeroPoint;
+    sArgs.nFilterOffset = nFilterZeroPoint;
+    sArgs.nActMin = nActMin;
+    sArgs.nActMax = nActMax;
+
+    if (nOutChannels % (2*PDX_M) == 0)
+    {
+        pSpecialization->pfFull(&sArgs);
+    }
+    else
+    {
+        pSpecialization->pfTail(&sArgs);
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_conv2d_specialized_int8
+* @brief adi_sharcfx_conv2d_specialized_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_conv2d_specialized_int8_ctx without context and returns its status. Calls share the static scratch of the library, so they
+* must not run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_conv2d_specialized_int8(const int8_t* pInputBuffer,
+                                            const int8_t* pWeightsBuffer,
+                                            const int32_t* pBiasBuffer,
+                                            int8_t* pOutputBuffer,
+                                            int32_t nBatches,
+                                            int32_t nInChannels,
+                                            int32_t nOutChannels,
+                                            int32_t nKernelHeight,
+                                            int32_t nKernelWidth,
+                                            int32_t nNumKernels,
+                                            int32_t nInputWidth,
+                                            int32_t nInputHeight,
+                                            int32_t stride_height,
+                                            int32_t stride_width,
+                                            int32_t nPadHeight,
+                                            int32_t nPadWidth,
+                                            int32_t nOutHeight,
+                                            int32_t nOutWidth,
+                                            int32_t *pQuantizedMultiplier,
+                                            int32_t *pQuantizedShift,
+                                            int32_t pInZeroPoint,
+                                            int32_t pOutZeroPoint,
+                                            int32_t nFilterZeroPoint,
+                                            int32_t nActMin,
+                                            int32_t nActMax)
+{
+    return adi_sharcfx_conv2d_specialized_int8_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nBatches,
+                                                   nInChannels, nOutChannels, nKernelHeight, nKernelWidth, nNumKernels,
+                                                   nInputWidth, nInputHeight, stride_height, stride_width, nPadHeight,
+                                                   nPadWidth, nOutHeight, nOutWidth, pQuantizedMultiplier, pQuantizedShift,
+                                                   pInZeroPoint, pOutZeroPoint, nFilterZeroPoint, nActMin, nActMax, NULL);
+}
@@ -0,0 +1,548 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_data_movement.cpp
+*
+* @brief: contains optimized data movement kernels
+*
+* @details: contains optimized concatenation, split and channel shuffle for 8bit integer data in the channel interleaved layout
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= D A T A =============*/
+//PDX_SEL_4MX8 patterns interleaving two vectors a (indices 0..31) and b (indices 32..63) lane by lane
+static const int8_t nInterleaveLow[4*PDX_M] = {
+    0, 32, 1, 33, 2, 34, 3, 35, 4, 36, 5, 37, 6, 38, 7, 39,
+    8, 40, 9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47
+};
+static const int8_t nInterleaveHigh[4*PDX_M] = {
+    16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+    24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63
+};
+
+//PDX_SEL_2MX16 patterns interleaving the low and the high halves of two vectors a (indices 0..15) and b (indices 16..31)
+static const int16_t nZipLow16[2*PDX_M] = {
+    0, 16, 1, 17, 2, 18, 3, 19, 4, 20, 5, 21, 6, 22, 7, 23
+};
+static const int16_t nZipHigh16[2*PDX_M] = {
+    8, 24, 9, 25, 10, 26, 11, 27, 12, 28, 13, 29, 14, 30, 15, 31
+};
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Copy nSize bytes with aligning loads and variable length stores
+inline void data_movement_copy_int8(const int8_t *pInput,
+                                    int8_t *pOutput,
+                                    int32_t nSize)
+{
+    xb_vec4Mx8 vin;
+    xb_vec4Mx8 *inp = (xb_vec4Mx8 *)pInput;
+    valign ina = PDX_LA_4MX8_PP(inp);
+    xb_vec4Mx8 *outp = (xb_vec4Mx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t n = 0; n < nSize; n += 4*PDX_M)
+    {
+        PDX_LA_4MX8_XP(vin, ina, inp, 4*PDX_M);
+        PDX_SAV_4MX8_XP(vin, outa, outp, MIN(4*PDX_M, nSize - n));
+    }
+    PDX_SAPOS_4MX8_FP(outa, outp);//flush
+}
+
+/*UTILITY FUNCTION*/
+//Copy nSize bytes from one quantization to another: out = (in + input offset)*multiplier*2^shift + output offset.
+//A multiplier of 0 marks identical quantization and the block is copied as is
+inline void data_movement_block_int8(const int8_t *pInput,
+                                     int8_t *pOutput,
+                                     int32_t nSize,
+                                     int32_t nInputOffset,
+                                     int32_t nQuantizedMultiplier,
+                                     int32_t nQuantizedShift,
+                                     int32_t nOutputOffset)
+{
+    if (nQuantizedMultiplier == 0)
+    {
+        data_movement_copy_int8(pInput, pOutput, nSize);
+        return;
+    }
+
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+    }
+    xb_vecMx32 vOutZP = nOutputOffset;
+    xb_vecMx32 vmin = INT_8BIT_MIN;
+    xb_vecMx32 vmax = INT_8BIT_MAX;
+    xb_vec2Mx16 vInZP = nInputOffset;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx16 vin;
+    xb_vec2Mx40 acc;
+
+    xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pInput;
+    valign ina = PDX_LA_2MX8_PP(inp);
+    xb_vecMx8 *outp = (xb_vecMx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t n = 0; n < nSize; n += 2*PDX_M)
+    {
+        PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+        vin += vInZP;
+        acc = 0;
+        PDX_MULAQW_2MX16(acc, vin, vOne);      //doubled, as expected by quantize_and_store_channels
+        quantize_and_store_channels(acc, NULL, pMult, pShift, MIN(2*PDX_M, nSize - n), vOutZP, vmin, vmax, outp, outa);
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_concatenation_int8
+* @brief optimized concatenation function
+*
+* @details optimized concatenation of 8-bit integer tensors along one axis. Each tensor is viewed as [outer][size],
+* where size is the product of the concatenated axis and the axes after it, e.g. for channel concatenation in the
+* interleaved HWC layout outer = H*W and size = C of that input. The contiguous blocks are moved with aligning vector
+* loads and stores, and requantized in the same pass when an input quantization differs from the output.
+*
+* Parameters:
+* @param [in] ppInputBuffers - input data, one pointer per input
+* @param [in] pInputSizes - size of one outer block per input
+* @param [in] nInputs - # of inputs
+* @param [in] nOuter - product of the axes before the concatenated axis
+* @param [in] pInputOffset - input offset (negated input zeropoint) per input, can be NULL when pQuantizedMultiplier is NULL
+* @param [in] pQuantizedMultiplier - multiplier from input to output scale per input, 0 for an input with the output
+*                                    quantization, NULL when all inputs have the output quantization
+* @param [in] pQuantizedShift - shift from input to output scale per input
+* @param [in] nOutputOffset - output zeropoint
+*
+* @param [out] pOutputBuffer - output data, [outer][sum of input sizes]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_concatenation_int8(const int8_t** ppInputBuffers,
+                                    const int32_t* pInputSizes,
+                                    int32_t nInputs,
+                                    int32_t nOuter,
+                                    const int32_t* pInputOffset,
+                                    const int32_t* pQuantizedMultiplier,
+                                    const int32_t* pQuantizedShift,
+                                    int32_t nOutputOffset,
+                                    int8_t* pOutputBuffer)
+{
+    int8_t *pOut = pOutputBuffer;
+
+    for (int32_t nOut = 0; nOut < nOuter; nOut++)
+    {
+        for (int32_t i = 0; i < nInputs; i++)
+        {
+            const int8_t *pIn = ppInputBuffers[i] + nOut*pInputSizes[i];
+            if (pQuantizedMultiplier)
+            {
+                data_movement_block_int8(pIn, pOut, pInputSizes[i], pInputOffset[i],
+                                         pQuantizedMultiplier[i], pQuantizedShift[i], nOutputOffset);
+            }
+            else
+            {
+                data_movement_copy_int8(pIn, pOut, pInputSizes[i]);
+            }
+            pOut += pInputSizes[i];
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_split_int8
+* @brief optimized split function
+*
+* @details optimized split of an 8-bit integer tensor along one axis, the inverse of adi_sharcfx_concatenation_int8.
+* The input is viewed as [outer][sum of output sizes], every output receives its contiguous block of each outer row
+* and is requantized in the same pass when its quantization differs from the input.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [outer][sum of output sizes]
+* @param [in] pOutputSizes - size of one outer block per output
+* @param [in] nOutputs - # of outputs
+* @param [in] nOuter - product of the axes before the split axis
+* @param [in] nInputOffset - input offset (negated input zeropoint)
+* @param [in] pQuantizedMultiplier - multiplier from input to output scale per output, 0 for an output with the input
+*                                    quantization, NULL when all outputs have the input quantization
+* @param [in] pQuantizedShift - shift from input to output scale per output
+* @param [in] pOutputOffset - output zeropoint per output, can be NULL when pQuantizedMultiplier is NULL
+*
+* @param [out] ppOutputBuffers - output data, one pointer per output
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_split_int8(const int8_t* pInputBuffer,
+                            const int32_t* pOutputSizes,
+                            int32_t nOutputs,
+                            int32_t nOuter,
+                            int32_t nInputOffset,
+                            const int32_t* pQuantizedMultiplier,
+                            const int32_t* pQuantizedShift,
+                            const int32_t* pOutputOffset,
+                            int8_t** ppOutputBuffers)
+{
+    const int8_t *pIn = pInputBuffer;
+
+    for (int32_t nOut = 0; nOut < nOuter; nOut++)
+    {
+        for (int32_t i = 0; i < nOutputs; i++)
+        {
+            int8_t *pOut = ppOutputBuffers[i] + nOut*pOutputSizes[i];
+            if (pQuantizedMultiplier)
+            {
+                data_movement_block_int8(pIn, pOut, pOutputSizes[i], nInputOffset,
+                                         pQuantizedMultiplier[i], pQuantizedShift[i], pOutputOffset[i]);
+            }
+            else
+            {
+                data_movement_copy_int8(pIn, pOut, pOutputSizes[i]);
+            }
+            pIn += pOutputSizes[i];
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_channel_shuffle_int8
+* @brief optimized channel shuffle function
+*
+* @details optimized channel shuffle for 8-bit integer data in the channel interleaved layout. The channels of every
+* pixel are viewed as [groups][channels/groups] and transposed to [channels/groups][groups].
+* Two groups (the ShuffleNet case) are interleaved 4*PDX_M channels at a time with PDX_SEL_4MX8, other group counts
+* transpose the channels of every pixel with adi_sharcfx_transpose_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [pixels][channels]
+* @param [in] nPixels - # of pixels
+* @param [in] nChannels - # of channels, a multiple of nGroups
+* @param [in] nGroups - # of groups
+*
+* @param [out] pOutputBuffer - output data, [pixels][channels]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_channel_shuffle_int8(const int8_t* pInputBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nPixels,
+                                      int32_t nChannels,
+                                      int32_t nGroups)
+{
+    int32_t nGroupSize = nChannels / nGroups;
+
+    if (nGroups != 2)
+    {
+        //the [groups][channels/groups] channels of every pixel through the tiled register transpose
+        for (int32_t p = 0; p < nPixels; p++)
+        {
+            adi_sharcfx_transpose_int8(pInputBuffer + p*nChannels, pOutputBuffer + p*nChannels, nGroups, nGroupSize);
+        }
+        return;
+    }
+
+    xb_vec4Mx8 va, vb, vSelLow, vSelHigh;
+    xb_vec4Mx8 *selp = (xb_vec4Mx8 *)nInterleaveLow;
+    valign sela = PDX_LA_4MX8_PP(selp);
+    PDX_LA_4MX8_XP(vSelLow, sela, selp, 4*PDX_M);
+    selp = (xb_vec4Mx8 *)nInterleaveHigh;
+    sela = PDX_LA_4MX8_PP(selp);
+    PDX_LA_4MX8_XP(vSelHigh, sela, selp, 4*PDX_M);
+
+    for (int32_t p = 0; p < nPixels; p++)
+    {
+        const int8_t *pIn = pInputBuffer + p*nChannels;
+        int8_t *pOut = pOutputBuffer + p*nChannels;
+        xb_vec4Mx8 *ap = (xb_vec4Mx8 *)pIn;
+        valign aa = PDX_LA_4MX8_PP(ap);
+        xb_vec4Mx8 *bp = (xb_vec4Mx8 *)(pIn + nGroupSize);
+        valign ba = PDX_LA_4MX8_PP(bp);
+        xb_vec4Mx8 *outp = (xb_vec4Mx8 *)pOut;
+        valign outa = PDX_Z_ALIGN();
+
+        int32_t k;
+        for (k = 0; k + 4*PDX_M <= nGroupSize; k += 4*PDX_M)
+        {
+            PDX_LA_4MX8_XP(va, aa, ap, 4*PDX_M);
+            PDX_LA_4MX8_XP(vb, ba, bp, 4*PDX_M);
+            PDX_SAV_4MX8_XP(PDX_SEL_4MX8(vb, va, vSelLow), outa, outp, 4*PDX_M);
+            PDX_SAV_4MX8_XP(PDX_SEL_4MX8(vb, va, vSelHigh), outa, outp, 4*PDX_M);
+        }
+        PDX_SAPOS_4MX8_FP(outa, outp);//flush
+        for (; k < nGroupSize; k++)
+        {
+            pOut[2*k] = pIn[k];
+            pOut[2*k + 1] = pIn[nGroupSize + k];
+        }
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Transpose the 2*PDX_M x 2*PDX_M tile held in vRows in registers. Each of the LOG2_PDX_2M rounds interleaves row i with
+//row i+PDX_M, which after the last round leaves column i of the tile in vRows[i]
+inline void transpose_tile_2mx16(xb_vec2Mx16 *vRows,
+                                 xb_vec2Mx16 vSelLow,
+                                 xb_vec2Mx16 vSelHigh)
+{
+    xb_vec2Mx16 vTemp[2*PDX_M];
+
+    for (int32_t s = 0; s < LOG2_PDX_2M; s++)
+    {
+        for (int32_t i = 0; i < PDX_M; i++)
+        {
+            vTemp[2*i] = PDX_SEL_2MX16(vRows[i + PDX_M], vRows[i], vSelLow);
+            vTemp[2*i + 1] = PDX_SEL_2MX16(vRows[i + PDX_M], vRows[i], vSelHigh);
+        }
+        for (int32_t i = 0; i < 2*PDX_M; i++)
+        {
+            vRows[i] = vTemp[i];
+        }
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Load the PDX_SEL_2MX16 patterns interleaving the low and the high halves of two vectors
+inline void transpose_load_patterns(xb_vec2Mx16 &vSelLow,
+                                    xb_vec2Mx16 &vSelHigh)
+{
+    xb_vec2Mx16 *selp = (xb_vec2Mx16 *)nZipLow16;
+    valign sela = PDX_LA_2MX16_PP(selp);
+    PDX_LA_2MX16_XP(vSelLow, sela, selp, 2*PDX_M*sizeof(int16_t));
+    selp = (xb_vec2Mx16 *)nZipHigh16;
+    sela = PDX_LA_2MX16_PP(selp);
+    PDX_LA_2MX16_XP(vSelHigh, sela, selp, 2*PDX_M*sizeof(int16_t));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_transpose_int8
+* @brief optimized 2D transpose function
+*
+* @details optimized transpose of a [nRows][nCols] 8-bit integer matrix to [nCols][nRows]. 2*PDX_M x 2*PDX_M tiles are
+* loaded sign extended to 16 bit, transposed in registers with PDX_SEL_2MX16 and stored narrowed. The partial tiles at the
+* right and bottom edges, and matrices narrower than a tile such as the 3, 4 or 8 channels of an image, stay vectorized:
+* partial rows are loaded from a zeroed copy, the missing rows of a tile are zero, and the valid part of every output row
+* is written with variable length stores.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [nRows][nCols]
+* @param [in] nRows - # of rows
+* @param [in] nCols - # of columns
+*
+* @param [out] pOutputBuffer - output data, [nCols][nRows]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_transpose_int8(const int8_t* pInputBuffer,
+                                int8_t* pOutputBuffer,
+                                int32_t nRows,
+                                int32_t nCols)
+{
+    xb_vec2Mx16 vRows[2*PDX_M];
+    xb_vec2Mx16 vSelLow, vSelHigh;
+    int8_t pTail[2*PDX_M] __attribute__((aligned(8)));
+    transpose_load_patterns(vSelLow, vSelHigh);
+    memset(pTail, 0, sizeof(pTail));
+
+    for (int32_t r0 = 0; r0 < nRows; r0 += 2*PDX_M)
+    {
+        int32_t nTileRows = MIN(2*PDX_M, nRows - r0);
+        for (int32_t c0 = 0; c0 < nCols; c0 += 2*PDX_M)
+        {
+            int32_t nTileCols = MIN(2*PDX_M, nCols - c0);
+            for (int32_t i = nTileRows; i < 2*PDX_M; i++)
+            {
+                vRows[i] = 0;
+            }
+            for (int32_t i = 0; i < nTileRows; i++)
+            {
+                xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pInputBuffer + (r0 + i)*nCols + c0);
+                if (nTileCols < 2*PDX_M)
+                {
+                    //partial row through a zeroed copy, no read past the row
+                    memcpy(pTail, pInputBuffer + (r0 + i)*nCols + c0, nTileCols);
+                    inp = (xb_vec2Mx8 *)pTail;
+                }
+                valign ina = PDX_LA_2MX8_PP(inp);
+                PDX_LA16_2MX8_XP(vRows[i], ina, inp, 2*PDX_M); // load aligned, extend
+            }
+            transpose_tile_2mx16(vRows, vSelLow, vSelHigh);
+            for (int32_t i = 0; i < nTileCols; i++)
+            {
+                xb_vec2Mx8 *outp = (xb_vec2Mx8 *)(pOutputBuffer + (c0 + i)*nRows + r0);
+                valign outa = PDX_Z_ALIGN();
+                PDX_SAV16_2MX8_XP(vRows[i], outa, outp, nTileRows);
+                PDX_SAPOS_2MX8_FP(outa, outp);//flush
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_transpose_int16
+* @brief optimized 2D transpose function
+*
+* @details 16-bit integer version of adi_sharcfx_transpose_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [nRows][nCols]
+* @param [in] nRows - # of rows
+* @param [in] nCols - # of columns
+*
+* @param [out] pOutputBuffer - output data, [nCols][nRows]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_transpose_int16(const int16_t* pInputBuffer,
+                                 int16_t* pOutputBuffer,
+                                 int32_t nRows,
+                                 int32_t nCols)
+{
+    xb_vec2Mx16 vRows[2*PDX_M];
+    xb_vec2Mx16 vSelLow, vSelHigh;
+    transpose_load_patterns(vSelLow, vSelHigh);
+
+    for (int32_t r0 = 0; r0 < nRows; r0 += 2*PDX_M)
+    {
+        int32_t nTileRows = MIN(2*PDX_M, nRows - r0);
+        for (int32_t c0 = 0; c0 < nCols; c0 += 2*PDX_M)
+        {
+            int32_t nTileCols = MIN(2*PDX_M, nCols - c0);
+            for (int32_t i = nTileRows; i < 2*PDX_M; i++)
+            {
+                vRows[i] = 0;
+            }
+            for (int32_t i = 0; i < nTileRows; i++)
+            {
+                xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pInputBuffer + (r0 + i)*nCols + c0);
+                valign ina = PDX_LA_2MX16_PP(inp);
+                PDX_LAV_2MX16_XP(vRows[i], ina, inp, nTileCols*sizeof(int16_t)); // load aligned, lanes past the row are 0
+            }
+            transpose_tile_2mx16(vRows, vSelLow, vSelHigh);
+            for (int32_t i = 0; i < nTileCols; i++)
+            {
+                xb_vec2Mx16 *outp = (xb_vec2Mx16 *)(pOutputBuffer + (c0 + i)*nRows + r0);
+                valign outa = PDX_Z_ALIGN();
+                PDX_SAV_2MX16_XP(vRows[i], outa, outp, nTileRows*sizeof(int16_t));
+                PDX_SAPOS_2MX16_FP(outa, outp);//flush
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_hwc_to_chw_int8
+* @brief interleaved to non-interleaved layout conversion
+*
+* @details converts 8-bit integer data from the channel interleaved layout of the conv and depthconv kernels to the planar
+* layout of the noninterleaved kernels with adi_sharcfx_transpose_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [nHeight][nWidth][nChannels]
+* @param [in] nHeight - height
+* @param [in] nWidth - width
+* @param [in] nChannels - # of channels
+*
+* @param [out] pOutputBuffer - output data, [nChannels][nHeight][nWidth]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_hwc_to_chw_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nHeight,
+                                 int32_t nWidth,
+                                 int32_t nChannels)
+{
+    adi_sharcfx_transpose_int8(pInputBuffer, pOutputBuffer, nHeight*nWidth, nChannels);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_chw_to_hwc_int8
+* @brief non-interleaved to interleaved layout conversion
+*
+* @details inverse of adi_sharcfx_hwc_to_chw_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [nChannels][nHeight][nWidth]
+* @param [in] nHeight - height
+* @param [in] nWidth - width
+* @param [in] nChannels - # of channels
+*
+* @param [out] pOutputBuffer - output data, [nHeight][nWidth][nChannels]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_chw_to_hwc_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nHeight,
+                                 int32_t nWidth,
+                                 int32_t nChannels)
+{
+    adi_sharcfx_transpose_int8(pInputBuffer, pOutputBuffer, nChannels, nHeight*nWidth);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_hwc_to_chw_int16
+* @brief interleaved to non-interleaved layout conversion
+*
+* @details 16-bit integer version of adi_sharcfx_hwc_to_chw_int8.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_hwc_to_chw_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nHeight,
+                                  int32_t nWidth,
+                                  int32_t nChannels)
+{
+    adi_sharcfx_transpose_int16(pInputBuffer, pOutputBuffer, nHeight*nWidth, nChannels);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_chw_to_hwc_int16
+* @brief non-interleaved to interleaved layout conversion
+*
+* @details 16-bit integer version of adi_sharcfx_chw_to_hwc_int8.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_chw_to_hwc_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nHeight,
+                                  int32_t nWidth,
+                                  int32_t nChannels)
+{
+    adi_sharcfx_transpose_int16(pInputBuffer, pOutputBuffer, nChannels, nHeight*nWidth);
+}
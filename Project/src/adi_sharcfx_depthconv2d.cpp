@@ -16,7 +16,7 @@
 */
 
 /*============= I N C L U D E S =============*/
-#include "adi_sharcfx_nn.h"
+#include "adi_sharcfx_internal.h"
 
 /*============= D A T A =============*/
 //TODO: Make buffer dynamic
@@ -24,212 +24,42 @@ int8_t pTempLocal[TEMP_BUFFER_SIZE_L3]__attribute__((section(".L3.noload"), alig
 
 /*============= C O D E =============*/
 
-/**
-*******************************************************************************
-* Function: adi_sharcfx_depthconv2d_int8
-* @brief optimized depthconv2d function
-*
-* @details optimized depthconv2d function for 8-bit integer input. 2D depthwise-convolution in interleaved format using 16bit Eagle intrinsics. Also accounts for padding using a temp buffer
-*
-* Parameters:
-* @param [in] pInputBuffer - input data
-* @param [in] pWeightsBuffer - input weights buffer
-* @param [in] pBiasBuffer - input bias buffer
-* @param [in] nInputWidth - input width
-* @param [in] nInputHeight - input height
-* @param [in] nDepthMult - depth multiplier
-* @param [in] nInChannels - input depth
-* @param [in] nOutChannels - output depth
-* @param [in] nKernelSizeWidth - kernel width
-* @param [in] nKernelSizeHeight - kernel height
-* @param [in] nTotalPaddingWidth - pad width
-* @param [in] nTotalPaddingHeight - pad height
-* @param [in] pQuantizedMultiplier - multiplier
-* @param [in] pQuantizedShift - shift
-* @param [in] pInZeroPoint - input zeropoint
-* @param [in] pOutZeroPoint - output zeropoint
-* @param [in] nStrideWidth - stride width
-* @param [in] nStrideHeight - stride height
-* @param [in] nActMin - min value after activation function
-* @param [in] nActMax - max value after activation function
-* 
-* @param [out] pOutputBuffer - output data
-*
-* @return None
-*
-*
-*******************************************************************************
-*/ 
-void adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
-                                     int8_t *pOutputBuffer,
-                                     const int8_t *pWeightsBuffer,
-                                     const int32_t *pBiasBuffer,
-                                     int32_t nInputWidth,
-                                     int32_t nInputHeight,
-                                     int32_t nDepthMult,
-                                     int32_t nInChannels,
-                                     int32_t nOutChannels,
-                                     int32_t nKernelSizeWidth,
-                                     int32_t nKernelSizeHeight,
-                                     int32_t nTotalPaddingWidth,
-                                     int32_t nTotalPaddingHeight,
-                                     int32_t *pQuantizedMultiplier,
-                                     int32_t *pQuantizedShift,
-                                     int32_t pInZeroPoint,
-                                     int32_t pOutZeroPoint,
-                                     int32_t nStrideWidth,
-                                     int32_t nStrideHeight,
-                                     int32_t nActMin,
-                                     int32_t nActMax)
+/*UTILITY FUNCTION*/
+//Depthwise convolution of output rows [nOutRowStart, nOutRowEnd) on interleaved data with nPaddingChannels channels per pixel.
+//pInput holds the input rows from nInRowBase on, so a strip of rows copied to scratch memory is convolved the same way as the whole input.
+inline void depthconv2d_int8_rows(const int8_t *pInput,
+                                  int32_t nInRowBase,
+                                  int8_t *pOutputBuffer,
+                                  const int8_t *pWeightsBuffer,
+                                  const int32_t *pBiasBuffer,
+                                  int32_t nInputWidth,
+                                  int32_t nInputHeight,
+                                  int32_t nPaddingChannels,
+                                  int32_t nOutChannels,
+                                  int32_t nKernelSizeWidth,
+                                  int32_t nKernelSizeHeight,
+                                  int32_t nInitialPaddingWidth,
+                                  int32_t nInitialPaddingHeight,
+                                  int32_t nOutputWidth,
+                                  int32_t nOutRowStart,
+                                  int32_t nOutRowEnd,
+                                  int32_t *pQuantizedMultiplier,
+                                  int32_t *pQuantizedShift,
+                                  int32_t pInZeroPoint,
+                                  int32_t pOutZeroPoint,
+                                  int32_t nStrideWidth,
+                                  int32_t nStrideHeight,
+                                  int32_t nActMin,
+                                  int32_t nActMax)
 {
-    //Peform an interleaved padding for rows and columns
-    int i,nCol,nRow;
-    int8_t *pPaddedBuffer;
-	int8_t *pTempBufCopy;
-	//chooses between the L1/L3 scratch buffer based on input/output dimensions.
-	if(nOutChannels * nInputHeight * nInputWidth < TEMP_BUFFER_SIZE){
-    	pTempBufCopy = (int8_t *)pTemp;
-    }
-    else
-    {
-    	pTempBufCopy = (int8_t *)pTempL3;
-    }
-
-	pPaddedBuffer = (int8_t *)pTempBufCopy;
-    xb_vec4Mx8 vInZP = pInZeroPoint;
+    //up to 2*PDX_M channels of a pixel are processed at a time
+    int nNextPixelInc = MIN(2*PDX_M,nPaddingChannels);
+    int nChannelIncrement = MIN(2*PDX_M,nPaddingChannels);
+    int nChannelsProcesssedInLoop = MIN(2*PDX_M,nPaddingChannels);
+    int nInputRowBytes = nInputWidth*nPaddingChannels;
+    int32_t nTapStartH, nTapEndH, nTapStartW, nTapEndW;
+    int nBytesLeft;
 
-    //nDepthMult indicates whether the same set of input channels is used across all output weights
-    //for eg 1 input channel with depth mult of 1 and 8 output channels uses same weights on 1 input channel
-    //if depth mult is not 1, then num of input and output channels must match so diff weights on diff input channels in this code
-
-    //this variable indicates how many channel padding has to be done in the interleaved format
-    //if we are using depthmult = 1 it indicates we are operating on only 1 channel at a time so padding repeat = 1
-    //else we have to do padding for each of the input/output channels
-
-    int nNextPixelInc = 0;//same channel repeated for output channels
-    int nPaddingChannels = 1;
-    int nChannelIncrement = 1;
-    int nChannelsProcesssedInLoop = MIN(2*PDX_M,nInChannels);
-
-    //use different input channel for each output channel
-
-    int8_t *pInpPtrTemp = pTempLocal;
-    if(nInChannels == nOutChannels) {
-    	//CASE depth multiplier = 1. Data does not need to be reformatted.
-        nPaddingChannels = nInChannels;
-        nNextPixelInc = MIN(2*PDX_M,nInChannels);
-        nChannelIncrement = MIN(2*PDX_M,nInChannels);
-        pInpPtrTemp = (int8_t*)pInputBuffer;
-    }
-    else
-    {
-    	//CASE depth multiplier != 1. Data does needs to be reformatted.
-        //depth multiplier indicates whether the same set of input channels is used across all output weights
-        nPaddingChannels = nInChannels*nDepthMult;
-        nNextPixelInc = MIN(2*PDX_M,nInChannels*nDepthMult);
-        nChannelIncrement = MIN(2*PDX_M,nInChannels*nDepthMult);
-        nChannelsProcesssedInLoop = MIN(2*PDX_M,nInChannels*nDepthMult);
-
-        //code to repeat input data to account for the required data format in cases where depth_mul param is not 1
-        int8_t *pInpPtr = (int8_t *)pInputBuffer;
-        pInpPtr = (int8_t *)pInputBuffer;
-        for(int i=0; i< nInputHeight; i++){
-        	for(int j=0; j< nInputWidth; j++){
-    			for(int k=0; k< nInChannels; k++)
-    			{
-    					memset(pInpPtrTemp, *pInpPtr++, nDepthMult);
-    					pInpPtrTemp += nDepthMult;
-    			}
-        	}
-        }
-        pInpPtrTemp = pTempLocal;
-    }
-
-
-    //This set of code handles odd padding cases
-    //int nTotalPadding = nTotalPaddingWidth;
-    int nInitialPaddingWidth = nTotalPaddingWidth/2;
-    int nFinalPaddingWidth = (nTotalPaddingWidth + 1)/2 ;
-    int nInitialPaddingHeight = nTotalPaddingHeight/2;
-    int nFinalPaddingHeight = (nTotalPaddingHeight + 1)/2 ;
-
-    // Padding for top for all initial padding rows
-    for (i = 0; i < (nInputWidth + nTotalPaddingWidth)*nInitialPaddingHeight*nPaddingChannels; i++) {
-        *pPaddedBuffer++ = -vInZP;
-    }
-
-    //num of bytes left in the column to process
-    int nBytesLeft = (nInputWidth+nTotalPaddingWidth)*nPaddingChannels;
-
-    //pad the remaining lines as well in an interleaved way 4*PDX_M at a time
-    pInpPtrTemp -= nInitialPaddingWidth*nPaddingChannels;
-    int nBytesNotPadded = 0;
-    for (nCol = 0; nCol < (nInputWidth+nTotalPaddingWidth)*nPaddingChannels; nCol += 4*PDX_M) {
-
-        xb_vec4Mx8 * inv = (xb_vec4Mx8 *)(pInpPtrTemp);  // to account for padding values
-        //mask the first nInitialPadding * nPaddingRepeat number of cols
-        vbool4M mask0 = PDX_MOVB_AU32 (0);
-
-        //Initial padding
-        if (nCol + 4*PDX_M < nInitialPaddingWidth*nPaddingChannels)  { //initial padding > 4*PDX_M
-            //all 0s
-            mask0 = PDX_MOVB_AU32(0);//all zero padding
-        } else if (nCol < nInitialPaddingWidth*nPaddingChannels) {  // 0 < initial padding < 4*PDX_M
-            //mix of 0s and valid pixels
-            int nLeft = nCol + 4*PDX_M - nInitialPaddingWidth*nPaddingChannels; //num of non-zero elements
-            uint32_t nShift = (((uint64_t)1)<<(nLeft)) - 1;
-            nShift <<= 4*PDX_M - nLeft;//make lsb of mask = 0
-            vbool4M m = PDX_MOVB_AU32 (nShift);
-            mask0 |= m;
-        } else {
-            //no mask, all valid pixels
-            mask0 |= PDX_MOVB_AU32(0xFFFFFFFF);
-        }
-
-        //1s denote where input needs to be read from buffer
-
-        //Final padding
-        nBytesNotPadded = (nCol + 4*PDX_M) - (nInputWidth + nInitialPaddingWidth)*nPaddingChannels - nBytesNotPadded;//check if we have finished with valid pixels
-        if (nBytesNotPadded > 0) {
-            int EndPadding = 4*PDX_M - nBytesNotPadded;//mask sets 1 to pixels not to be padded
-            uint32_t nShift = (((uint64_t)1)<<(EndPadding)) - 1;
-            vbool4M m = PDX_MOVB_AU32 (nShift);
-            mask0 &= m;
-        } else {
-            nBytesNotPadded = 0;
-        }
-
-        //use the mask to copy the elements to temp buffer with padding
-        int8_t *pOut = pPaddedBuffer;
-        xb_vec4Mx8 in0;
-        int nBytesWrite = MIN(nBytesLeft,4*PDX_M);
-
-        //repeat the operation for all rows of the image
-        for (nRow = 0; nRow < nInputHeight; nRow += 1) {
-            valign ina = PDX_LA_4MX8_PP (inv);
-            PDX_LA_4MX8_XP (in0, ina, inv, nInputWidth*nPaddingChannels);  // inc to next row
-            in0 = PDX_MOV_4MX8_T (in0, -vInZP, mask0);  // Clear the first and/or last lane, if needed. set -zp so addition will zp will make it 0
-
-            xb_vec4Mx8 * outv = (xb_vec4Mx8 *) pOut;
-            valign outa = PDX_LA_4MX8_PP (outv);
-            PDX_SAV_4MX8_XP (in0, outa, outv, nBytesWrite);//doing post increment bounded to 32 here
-            PDX_SAPOS_4MX8_FP (outa, outv);
-            pOut += (nInputWidth + nTotalPaddingWidth)*nPaddingChannels;
-        }
-        pInpPtrTemp += nBytesWrite;  // go to next set of columns
-        pPaddedBuffer += nBytesWrite; // go to next column
-        nBytesLeft -= nBytesWrite;
-    }
-
-	pPaddedBuffer = (int8_t *)(pTempBufCopy + (nInputWidth + nTotalPaddingWidth)*
-                (nInputHeight + nInitialPaddingHeight)*nPaddingChannels);
-
-    // Padding for bottom for all final padding rows
-    for (i = 0; i < (nInputWidth + nTotalPaddingWidth)*nFinalPaddingHeight*nPaddingChannels; i++) {
-        *pPaddedBuffer++ = -vInZP;
-    }
-
-    //Now run the depthwise convolution on the padded buffer
     xb_vec2Mx8 *inp;
 
     xb_vec2Mx40 acc;
@@ -254,21 +84,24 @@ void adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
     valign outa = PDX_LA_MX8_PP (outp); // prime, NOP if a[] is aligned
     int8_t *pIn;
 
-    //Once padding is done, then run convolution
     //data is present in interleaved format - all channels for a pixel
     //we will do depthwise for all input channels at a time
-    for(int nRow = 0;nRow + nKernelSizeHeight <= nInputHeight + nTotalPaddingHeight;nRow += nStrideHeight)
+    for(int nOutRow = nOutRowStart;nOutRow < nOutRowEnd;nOutRow++)
     {
+        //kernel rows inside the input
+        int nInRow = nOutRow*nStrideHeight - nInitialPaddingHeight;
+        get_valid_tap_range(nInRow, nInputHeight, nKernelSizeHeight, 1, &nTapStartH, &nTapEndH);
 
-        //align with row start
-
-		 pIn = (int8_t *)(pTempBufCopy + (nInputWidth + nTotalPaddingWidth)*nRow*nPaddingChannels);  //pointer to move down the rows
-
-        for(int nCol = 0;nCol + nKernelSizeWidth<= nInputWidth + nTotalPaddingWidth;nCol += nStrideWidth)
+        for(int nOutCol = 0;nOutCol < nOutputWidth;nOutCol++)
         {
             //perform operation for all output channels for 1 pixel
 
-            //align with next col start
+            //kernel columns inside the input
+            int nInCol = nOutCol*nStrideWidth - nInitialPaddingWidth;
+            get_valid_tap_range(nInCol, nInputWidth, nKernelSizeWidth, 1, &nTapStartW, &nTapEndW);
+
+            //align with the first tap inside the input
+            pIn = (int8_t *)pInput + ((nInRow + nTapStartH - nInRowBase)*nInputWidth + nInCol + nTapStartW)*nPaddingChannels;
             int8_t *pInputIter = pIn;
 
             //perform on all inputs channels for 1 pixel first
@@ -309,16 +142,19 @@ void adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
                 vbias_h = PDX_SLS_MX32(vbias_h,1);//*2 to match with acc
 
                 acc = 0;
-                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *)(pCurrWts); //Move to next filter for each output pixel
-                valign wta = PDX_LA_2MX8_PP (wtp); //wt align vector
+                xb_vec2Mx8 *wtp;
+                valign wta;
 
                 //do depthwise on all these channels at once
-                for(int nFilterHeight = 0;nFilterHeight < nKernelSizeHeight;nFilterHeight++)
+                for(int nFilterHeight = nTapStartH;nFilterHeight < nTapEndH;nFilterHeight++)
                 {
                     inp = (xb_vec2Mx8 *)(pInputCol);    //Reinitialise input pointer for each output pixel
                     valign ina = PDX_LA_2MX8_PP (inp); // align vector
 
-                    for(int nFilterWidth = 0;nFilterWidth < nKernelSizeWidth;nFilterWidth++)
+                    wtp = (xb_vec2Mx8 *)(pCurrWts + (nFilterHeight*nKernelSizeWidth + nTapStartW)*nOutChannels); //first tap inside the input
+                    wta = PDX_LA_2MX8_PP (wtp); //wt align vector
+
+                    for(int nFilterWidth = nTapStartW;nFilterWidth < nTapEndW;nFilterWidth++)
                     {
                         //reading 16 way 8 bit inputs and weights
                         PDX_LA16_2MX8_XP (vin, ina, inp, nPaddingChannels);//read 2*PDX_M number of channels for 1 pixel, skip to adjoining pixel
@@ -333,7 +169,7 @@ void adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
                         PDX_MULAQW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
                     }
                     //set to next row
-                    pInputCol += (nInputWidth + nTotalPaddingWidth)*nPaddingChannels;
+                    pInputCol += nInputRowBytes;
                     //pCurrWts += nKernelSizeWidth*nOutChannels;
                 }
 
@@ -386,11 +222,492 @@ void adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
                 nRemainingChannels -= nChannelIncrement;
                 pInputIter += nNextPixelInc;//process next channel
             }
-            pIn += nPaddingChannels*nStrideWidth;//go to next pixel
         }
     }
 }
 
+
+/*UTILITY FUNCTION*/
+//Repeat every input channel nDepthMult times, so that each output channel has its own input channel
+inline void depthconv2d_expand_channels(const int8_t *pInputBuffer,
+                                        int8_t *pOutputBuffer,
+                                        int32_t nPixels,
+                                        int32_t nInChannels,
+                                        int32_t nDepthMult)
+{
+    const int8_t *pInpPtr = pInputBuffer;
+    for(int i=0; i< nPixels; i++){
+        for(int k=0; k< nInChannels; k++)
+        {
+            memset(pOutputBuffer, *pInpPtr++, nDepthMult);
+            pOutputBuffer += nDepthMult;
+        }
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Input rows [*pInRowStart, *pInRowEnd) read by the strip of output rows starting at nOutRowStart, clipped to the input
+inline void depthconv2d_strip_input_rows(int32_t nOutRowStart,
+                                         int32_t nStripOutRows,
+                                         int32_t nOutputHeight,
+                                         int32_t nStrideHeight,
+                                         int32_t nInitialPaddingHeight,
+                                         int32_t nKernelSizeHeight,
+                                         int32_t nInputHeight,
+                                         int32_t *pInRowStart,
+                                         int32_t *pInRowEnd)
+{
+    int32_t nOutRowEnd = MIN(nOutRowStart + nStripOutRows, nOutputHeight);
+    *pInRowStart = MAX(nOutRowStart*nStrideHeight - nInitialPaddingHeight, 0);
+    *pInRowEnd = MIN((nOutRowEnd - 1)*nStrideHeight - nInitialPaddingHeight + nKernelSizeHeight, nInputHeight);
+    *pInRowEnd = MAX(*pInRowEnd, *pInRowStart);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_int8_ctx
+* @brief optimized depthconv2d function
+*
+* @details optimized depthconv2d function for 8-bit integer input. 2D depthwise-convolution in interleaved format using 16bit Eagle intrinsics. Accounts for padding by skipping the kernel taps outside the input, without a padded copy
+* With a depth multiplier the input is repeated in the large scratch, and -1 is returned if it does not fit.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nInputWidth - input width
+* @param [in] nInputHeight - input height
+* @param [in] nDepthMult - depth multiplier
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelSizeWidth - kernel width
+* @param [in] nKernelSizeHeight - kernel height
+* @param [in] nTotalPaddingWidth - pad width
+* @param [in] nTotalPaddingHeight - pad height
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] pInZeroPoint - input zeropoint
+* @param [in] pOutZeroPoint - output zeropoint
+* @param [in] nStrideWidth - stride width
+* @param [in] nStrideHeight - stride height
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+* 
+* @param [out] pOutputBuffer - output data
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_depthconv2d_int8_ctx(const int8_t *pInputBuffer,
+                                            int8_t *pOutputBuffer,
+                                            const int8_t *pWeightsBuffer,
+                                            const int32_t *pBiasBuffer,
+                                            int32_t nInputWidth,
+                                            int32_t nInputHeight,
+                                            int32_t nDepthMult,
+                                            int32_t nInChannels,
+                                            int32_t nOutChannels,
+                                            int32_t nKernelSizeWidth,
+                                            int32_t nKernelSizeHeight,
+                                            int32_t nTotalPaddingWidth,
+                                            int32_t nTotalPaddingHeight,
+                                            int32_t *pQuantizedMultiplier,
+                                            int32_t *pQuantizedShift,
+                                            int32_t pInZeroPoint,
+                                            int32_t pOutZeroPoint,
+                                            int32_t nStrideWidth,
+                                            int32_t nStrideHeight,
+                                            int32_t nActMin,
+                                            int32_t nActMax,
+                                         const ADI_SHARCFX_CONTEXT* pContext)
+{
+    //nDepthMult indicates whether the same set of input channels is used across all output weights
+    //for eg 1 input channel with depth mult of 1 and 8 output channels uses same weights on 1 input channel
+    //if depth mult is not 1, then num of input and output channels must match so diff weights on diff input channels in this code
+
+    //nPaddingChannels is the # of interleaved channels per pixel the convolution runs on
+    int nPaddingChannels = nInChannels;
+    const int8_t *pInpPtrTemp = pInputBuffer;
+    if(nInChannels != nOutChannels)
+    {
+    	//CASE depth multiplier != 1. Data does needs to be reformatted.
+        //code to repeat input data to account for the required data format in cases where depth_mul param is not 1
+        nPaddingChannels = nInChannels*nDepthMult;
+        if (nInputHeight*nInputWidth*nPaddingChannels > get_scratch_l3_size(pContext, TEMP_BUFFER_SIZE_L3))
+        {
+            return -1;
+        }
+        int8_t *pExpanded = get_scratch_l3(pContext, pTempLocal);
+        depthconv2d_expand_channels(pInputBuffer, pExpanded, nInputHeight*nInputWidth, nInChannels, nDepthMult);
+        pInpPtrTemp = pExpanded;
+    }
+
+    //The input is not padded: taps falling in the padding read the input zeropoint, which is zero once the input offset
+    //is added, so only the kernel taps inside the input are convolved
+    int nOutputHeight = (nInputHeight + nTotalPaddingHeight - nKernelSizeHeight)/nStrideHeight + 1;
+    int nOutputWidth = (nInputWidth + nTotalPaddingWidth - nKernelSizeWidth)/nStrideWidth + 1;
+
+    depthconv2d_int8_rows(pInpPtrTemp, 0, pOutputBuffer, pWeightsBuffer, pBiasBuffer,
+                          nInputWidth, nInputHeight, nPaddingChannels, nOutChannels,
+                          nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth/2, nTotalPaddingHeight/2,
+                          nOutputWidth, 0, nOutputHeight,
+                          pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+                          nStrideWidth, nStrideHeight, nActMin, nActMax);
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_int8
+* @brief adi_sharcfx_depthconv2d_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_depthconv2d_int8_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
+                                        int8_t *pOutputBuffer,
+                                        const int8_t *pWeightsBuffer,
+                                        const int32_t *pBiasBuffer,
+                                        int32_t nInputWidth,
+                                        int32_t nInputHeight,
+                                        int32_t nDepthMult,
+                                        int32_t nInChannels,
+                                        int32_t nOutChannels,
+                                        int32_t nKernelSizeWidth,
+                                        int32_t nKernelSizeHeight,
+                                        int32_t nTotalPaddingWidth,
+                                        int32_t nTotalPaddingHeight,
+                                        int32_t *pQuantizedMultiplier,
+                                        int32_t *pQuantizedShift,
+                                        int32_t pInZeroPoint,
+                                        int32_t pOutZeroPoint,
+                                        int32_t nStrideWidth,
+                                        int32_t nStrideHeight,
+                                        int32_t nActMin,
+                                        int32_t nActMax)
+{
+    return adi_sharcfx_depthconv2d_int8_ctx(pInputBuffer, pOutputBuffer, pWeightsBuffer, pBiasBuffer, nInputWidth,
+                                            nInputHeight, nDepthMult, nInChannels, nOutChannels, nKernelSizeWidth,
+                                            nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight, pQuantizedMultiplier,
+                                            pQuantizedShift, pInZeroPoint, pOutZeroPoint, nStrideWidth, nStrideHeight,
+                                            nActMin, nActMax, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_strip_int8
+* @brief row range depthconv2d function writing a strip
+*
+* @details adi_sharcfx_depthconv2d_rows_int8 writing output row nOutRowStart at the start of pOutputBuffer, so a strip of rows can
+* be produced into a small buffer and consumed before the next strip, e.g. by a fused pointwise convolution.
+*
+* Parameters:
+* see adi_sharcfx_depthconv2d_rows_int8
+*
+* @param [out] pOutputBuffer - strip of output rows [nOutRowStart, nOutRowEnd)
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_depthconv2d_strip_int8(const int8_t *pInputBuffer,
+                                        int8_t *pOutputBuffer,
+                                        const int8_t *pWeightsBuffer,
+                                        const int32_t *pBiasBuffer,
+                                        int32_t nInputWidth,
+                                        int32_t nInputHeight,
+                                        int32_t nDepthMult,
+                                        int32_t nInChannels,
+                                        int32_t nOutChannels,
+                                        int32_t nKernelSizeWidth,
+                                        int32_t nKernelSizeHeight,
+                                        int32_t nTotalPaddingWidth,
+                                        int32_t nTotalPaddingHeight,
+                                        int32_t *pQuantizedMultiplier,
+                                        int32_t *pQuantizedShift,
+                                        int32_t pInZeroPoint,
+                                        int32_t pOutZeroPoint,
+                                        int32_t nStrideWidth,
+                                        int32_t nStrideHeight,
+                                        int32_t nActMin,
+                                        int32_t nActMax,
+                                        int32_t nOutRowStart,
+                                        int32_t nOutRowEnd,
+                                        int8_t *pScratch)
+{
+    int nPaddingChannels = nInChannels;
+    int nOutputHeight = (nInputHeight + nTotalPaddingHeight - nKernelSizeHeight)/nStrideHeight + 1;
+    int nOutputWidth = (nInputWidth + nTotalPaddingWidth - nKernelSizeWidth)/nStrideWidth + 1;
+    const int8_t *pRows = pInputBuffer;
+    int32_t nInRowBase = 0;
+
+    if (nInChannels != nOutChannels)
+    {
+        //repeat only the input rows read by the range
+        int32_t nInRowEnd;
+        nPaddingChannels = nInChannels*nDepthMult;
+        depthconv2d_strip_input_rows(nOutRowStart, nOutRowEnd - nOutRowStart, nOutputHeight, nStrideHeight, nTotalPaddingHeight/2,
+                                     nKernelSizeHeight, nInputHeight, &nInRowBase, &nInRowEnd);
+        depthconv2d_expand_channels(pInputBuffer + nInRowBase*nInputWidth*nInChannels, pScratch,
+                                    (nInRowEnd - nInRowBase)*nInputWidth, nInChannels, nDepthMult);
+        pRows = pScratch;
+    }
+
+    depthconv2d_int8_rows(pRows, nInRowBase, pOutputBuffer,
+                          pWeightsBuffer, pBiasBuffer,
+                          nInputWidth, nInputHeight, nPaddingChannels, nOutChannels,
+                          nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth/2, nTotalPaddingHeight/2,
+                          nOutputWidth, nOutRowStart, nOutRowEnd,
+                          pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+                          nStrideWidth, nStrideHeight, nActMin, nActMax);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_rows_int8
+* @brief row range depthconv2d function
+*
+* @details adi_sharcfx_depthconv2d_int8 restricted to output rows [nOutRowStart, nOutRowEnd), with caller provided scratch instead
+* of the shared static scratch buffer. Calls on disjoint row ranges with their own scratch can run concurrently, e.g. one per core,
+* and together produce the output of adi_sharcfx_depthconv2d_int8.
+*
+* Parameters:
+* @param [in] nOutRowStart - first output row
+* @param [in] nOutRowEnd - one past the last output row
+* @param [in] pScratch - scratch for the input rows of the range repeated for the depth multiplier, input rows read by the range
+*                        * nInputWidth * nOutChannels bytes, can be NULL when nInChannels == nOutChannels
+*
+* see adi_sharcfx_depthconv2d_int8 for the other parameters
+*
+* @param [out] pOutputBuffer - output data, only the rows of the range are written
+*
+* @return None
+*
+*
+*******************************************************************************
+*/
+void adi_sharcfx_depthconv2d_rows_int8(const int8_t *pInputBuffer,
+                                       int8_t *pOutputBuffer,
+                                       const int8_t *pWeightsBuffer,
+                                       const int32_t *pBiasBuffer,
+                                       int32_t nInputWidth,
+                                       int32_t nInputHeight,
+                                       int32_t nDepthMult,
+                                       int32_t nInChannels,
+                                       int32_t nOutChannels,
+                                       int32_t nKernelSizeWidth,
+                                       int32_t nKernelSizeHeight,
+                                       int32_t nTotalPaddingWidth,
+                                       int32_t nTotalPaddingHeight,
+                                       int32_t *pQuantizedMultiplier,
+                                       int32_t *pQuantizedShift,
+                                       int32_t pInZeroPoint,
+                                       int32_t pOutZeroPoint,
+                                       int32_t nStrideWidth,
+                                       int32_t nStrideHeight,
+                                       int32_t nActMin,
+                                       int32_t nActMax,
+                                       int32_t nOutRowStart,
+                                       int32_t nOutRowEnd,
+                                       int8_t *pScratch)
+{
+    int nOutputWidth = (nInputWidth + nTotalPaddingWidth - nKernelSizeWidth)/nStrideWidth + 1;
+    adi_sharcfx_depthconv2d_strip_int8(pInputBuffer, pOutputBuffer + nOutRowStart*nOutputWidth*nOutChannels,
+                                       pWeightsBuffer, pBiasBuffer, nInputWidth, nInputHeight, nDepthMult, nInChannels,
+                                       nOutChannels, nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth,
+                                       nTotalPaddingHeight, pQuantizedMultiplier, pQuantizedShift, pInZeroPoint,
+                                       pOutZeroPoint, nStrideWidth, nStrideHeight, nActMin, nActMax, nOutRowStart,
+                                       nOutRowEnd, pScratch);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_tiled_int8_ctx
+* @brief optimized row tiled depthconv2d function
+*
+* @details adi_sharcfx_depthconv2d_int8 executed in horizontal strips. The output rows are split into strips whose input rows,
+* including the halo rows shared with the neighbouring strips, fit in nL1Budget bytes, and are convolved from the L1 scratch buffer,
+* so the working set stays in L1 for any layer height. Without depth multiplier the budget is split in two strip buffers and the
+* next strip is staged by the copy engine of the context, or of adi_sharcfx_set_copy_engine, while the current one is convolved; with a depth
+* multiplier the strip is repeated per channel into a single buffer.
+* Falls back to adi_sharcfx_depthconv2d_int8_ctx, and returns its status, when a single output row does not fit in the budget.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nInputWidth - input width
+* @param [in] nInputHeight - input height
+* @param [in] nDepthMult - depth multiplier
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelSizeWidth - kernel width
+* @param [in] nKernelSizeHeight - kernel height
+* @param [in] nTotalPaddingWidth - pad width
+* @param [in] nTotalPaddingHeight - pad height
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] pInZeroPoint - input zeropoint
+* @param [in] pOutZeroPoint - output zeropoint
+* @param [in] nStrideWidth - stride width
+* @param [in] nStrideHeight - stride height
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] nL1Budget - # of L1 bytes available for a strip, at most the scratch size of the context
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_depthconv2d_tiled_int8_ctx(const int8_t *pInputBuffer,
+                                               int8_t *pOutputBuffer,
+                                               const int8_t *pWeightsBuffer,
+                                               const int32_t *pBiasBuffer,
+                                               int32_t nInputWidth,
+                                               int32_t nInputHeight,
+                                               int32_t nDepthMult,
+                                               int32_t nInChannels,
+                                               int32_t nOutChannels,
+                                               int32_t nKernelSizeWidth,
+                                               int32_t nKernelSizeHeight,
+                                               int32_t nTotalPaddingWidth,
+                                               int32_t nTotalPaddingHeight,
+                                               int32_t *pQuantizedMultiplier,
+                                               int32_t *pQuantizedShift,
+                                               int32_t pInZeroPoint,
+                                               int32_t pOutZeroPoint,
+                                               int32_t nStrideWidth,
+                                               int32_t nStrideHeight,
+                                               int32_t nActMin,
+                                               int32_t nActMax,
+                                               int32_t nL1Budget,
+                                               const ADI_SHARCFX_CONTEXT* pContext)
+{
+    int nPaddingChannels = (nInChannels == nOutChannels) ? nInChannels : nInChannels*nDepthMult;
+    int nInputRowBytes = nInputWidth*nPaddingChannels;
+    int nOutputHeight = (nInputHeight + nTotalPaddingHeight - nKernelSizeHeight)/nStrideHeight + 1;
+    int nOutputWidth = (nInputWidth + nTotalPaddingWidth - nKernelSizeWidth)/nStrideWidth + 1;
+    int nInitialPaddingHeight = nTotalPaddingHeight/2;
+    int nStripBytes = MIN(nL1Budget, get_scratch_size(pContext));
+    int nInRowStart, nInRowEnd, nNextInRowStart, nNextInRowEnd;
+
+    //Without depth multiplier the strips are double buffered: the copy engine stages the next strip in one half of the
+    //budget while the current strip is convolved from the other half
+    ADI_SHARCFX_TILE_PIPELINE sPipeline;
+    int nDoubleBuffer = (nInChannels == nOutChannels);
+    if (nDoubleBuffer)
+    {
+        adi_sharcfx_tile_pipeline_init(&sPipeline, get_copy_engine(pContext), get_scratch(pContext), nStripBytes);
+        nStripBytes = sPipeline.nBufferSize;
+    }
+
+    //# of output rows per strip, a strip of S output rows reads (S-1)*stride + kernel height input rows
+    int nStripInRows = nStripBytes/nInputRowBytes;
+    if (nStripInRows < nKernelSizeHeight)
+    {
+        return adi_sharcfx_depthconv2d_int8_ctx(pInputBuffer, pOutputBuffer, pWeightsBuffer, pBiasBuffer,
+                                                nInputWidth, nInputHeight, nDepthMult, nInChannels, nOutChannels,
+                                                nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight,
+                                                pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+                                                nStrideWidth, nStrideHeight, nActMin, nActMax, pContext);
+    }
+    int nStripOutRows = (nStripInRows - nKernelSizeHeight)/nStrideHeight + 1;
+
+    if (nDoubleBuffer)
+    {
+        depthconv2d_strip_input_rows(0, nStripOutRows, nOutputHeight, nStrideHeight, nInitialPaddingHeight,
+                                     nKernelSizeHeight, nInputHeight, &nInRowStart, &nInRowEnd);
+        adi_sharcfx_tile_pipeline_prefetch(&sPipeline, pInputBuffer + nInRowStart*nInputRowBytes,
+                                           (nInRowEnd - nInRowStart)*nInputRowBytes);
+    }
+
+    for (int nOutRowStart = 0; nOutRowStart < nOutputHeight; nOutRowStart += nStripOutRows)
+    {
+        int nOutRowEnd = MIN(nOutRowStart + nStripOutRows, nOutputHeight);
+        int8_t *pStrip;
+
+        //input rows of the strip including the halo, clipped to the input
+        depthconv2d_strip_input_rows(nOutRowStart, nStripOutRows, nOutputHeight, nStrideHeight, nInitialPaddingHeight,
+                                     nKernelSizeHeight, nInputHeight, &nInRowStart, &nInRowEnd);
+
+        if (nDoubleBuffer)
+        {
+            pStrip = adi_sharcfx_tile_pipeline_next(&sPipeline);
+            if (nOutRowEnd < nOutputHeight)
+            {
+                depthconv2d_strip_input_rows(nOutRowEnd, nStripOutRows, nOutputHeight, nStrideHeight, nInitialPaddingHeight,
+                                             nKernelSizeHeight, nInputHeight, &nNextInRowStart, &nNextInRowEnd);
+                adi_sharcfx_tile_pipeline_prefetch(&sPipeline, pInputBuffer + nNextInRowStart*nInputRowBytes,
+                                                   (nNextInRowEnd - nNextInRowStart)*nInputRowBytes);
+            }
+        }
+        else
+        {
+            pStrip = get_scratch(pContext);
+            depthconv2d_expand_channels(pInputBuffer + nInRowStart*nInputWidth*nInChannels, pStrip,
+                                        (nInRowEnd - nInRowStart)*nInputWidth, nInChannels, nDepthMult);
+        }
+
+        depthconv2d_int8_rows(pStrip, nInRowStart, pOutputBuffer + nOutRowStart*nOutputWidth*nOutChannels,
+                              pWeightsBuffer, pBiasBuffer,
+                              nInputWidth, nInputHeight, nPaddingChannels, nOutChannels,
+                              nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth/2, nInitialPaddingHeight,
+                              nOutputWidth, nOutRowStart, nOutRowEnd,
+                              pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+                              nStrideWidth, nStrideHeight, nActMin, nActMax);
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_tiled_int8
+* @brief adi_sharcfx_depthconv2d_tiled_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_depthconv2d_tiled_int8_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_depthconv2d_tiled_int8(const int8_t *pInputBuffer,
+                                           int8_t *pOutputBuffer,
+                                           const int8_t *pWeightsBuffer,
+                                           const int32_t *pBiasBuffer,
+                                           int32_t nInputWidth,
+                                           int32_t nInputHeight,
+                                           int32_t nDepthMult,
+                                           int32_t nInChannels,
+                                           int32_t nOutChannels,
+                                           int32_t nKernelSizeWidth,
+                                           int32_t nKernelSizeHeight,
+                                           int32_t nTotalPaddingWidth,
+                                           int32_t nTotalPaddingHeight,
+                                           int32_t *pQuantizedMultiplier,
+                                           int32_t *pQuantizedShift,
+                                           int32_t pInZeroPoint,
+                                           int32_t pOutZeroPoint,
+                                           int32_t nStrideWidth,
+                                           int32_t nStrideHeight,
+                                           int32_t nActMin,
+                                           int32_t nActMax,
+                                           int32_t nL1Budget)
+{
+    return adi_sharcfx_depthconv2d_tiled_int8_ctx(pInputBuffer, pOutputBuffer, pWeightsBuffer, pBiasBuffer, nInputWidth,
+                                                  nInputHeight, nDepthMult, nInChannels, nOutChannels, nKernelSizeWidth,
+                                                  nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight,
+                                                  pQuantizedMultiplier, pQuantizedShift, pInZeroPoint, pOutZeroPoint,
+                                                  nStrideWidth, nStrideHeight, nActMin, nActMax, nL1Budget, NULL);
+}
+
 /**
 *******************************************************************************
 * Function: adi_sharcfx_depthconv2d_stride1_noninterleaved_int8
@@ -3310,3 +3627,244 @@ void adi_sharcfx_depthconv2d_stride2_kernel8x10_noninterleaved_int8 (const int8_
         }
     }
 }
+
+/*UTILITY FUNCTION*/
+//Interleaved 16x8 depthwise convolution over 2*PDX_M channels at a time. The 16x8 input zero point is 0, so kernel taps
+//that fall in the padding are clipped instead of reading a padded copy. Inlined with constant strides for the fast paths
+inline void depthconv2d_int16_core(const int16_t *pInputBuffer,
+                                   int16_t *pOutputBuffer,
+                                   const int8_t *pWeightsBuffer,
+                                   const int32_t *pBiasHigh,
+                                   const int32_t *pBiasLow,
+                                   int32_t nInputWidth,
+                                   int32_t nInputHeight,
+                                   int32_t nChannels,
+                                   int32_t nKernelSizeWidth,
+                                   int32_t nKernelSizeHeight,
+                                   int32_t nTotalPaddingWidth,
+                                   int32_t nTotalPaddingHeight,
+                                   const int32_t *pQuantizedMultiplier,
+                                   const int32_t *pQuantizedShift,
+                                   int32_t nStrideWidth,
+                                   int32_t nStrideHeight,
+                                   int32_t nActMin,
+                                   int32_t nActMax)
+{
+    xb_vec2Mx40 acc;
+    xb_vec2Mx16 vin,vwt;
+    xb_vecMx32 vmin = nActMin;
+    xb_vecMx32 vmax = nActMax;
+    xb_vecMx16* outp  = (xb_vecMx16 *)pOutputBuffer;
+    valign outa = PDX_Z_ALIGN();
+
+    int nInitialPaddingWidth = nTotalPaddingWidth/2;
+    int nInitialPaddingHeight = nTotalPaddingHeight/2;
+
+    for(int nRow = 0;nRow + nKernelSizeHeight <= nInputHeight + nTotalPaddingHeight;nRow += nStrideHeight)
+    {
+        //kernel rows inside the input for this output row
+        int nInRow = nRow - nInitialPaddingHeight;
+        int nKerHStart = MAX(0, -nInRow);
+        int nKerHEnd = MIN(nKernelSizeHeight, nInputHeight - nInRow);
+
+        for(int nCol = 0;nCol + nKernelSizeWidth <= nInputWidth + nTotalPaddingWidth;nCol += nStrideWidth)
+        {
+            //kernel columns inside the input for this output pixel
+            int nInCol = nCol - nInitialPaddingWidth;
+            int nKerWStart = MAX(0, -nInCol);
+            int nKerWEnd = MIN(nKernelSizeWidth, nInputWidth - nInCol);
+
+            for(int nChannel = 0;nChannel < nChannels;nChannel+=2*PDX_M)
+            {
+                acc = 0;
+                for(int nFilterHeight = nKerHStart;nFilterHeight < nKerHEnd;nFilterHeight++)
+                {
+                    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pInputBuffer + ((nInRow + nFilterHeight)*nInputWidth + nInCol + nKerWStart)*nChannels + nChannel);
+                    valign ina = PDX_LA_2MX16_PP (inp); // align vector
+                    xb_vec2Mx8 *wtp = (xb_vec2Mx8 *)(pWeightsBuffer + (nFilterHeight*nKernelSizeWidth + nKerWStart)*nChannels + nChannel);
+                    valign wta = PDX_LA_2MX8_PP (wtp); //wt align vector
+
+                    for(int nFilterWidth = nKerWStart;nFilterWidth < nKerWEnd;nFilterWidth++)
+                    {
+                        //reading 16 way 16 bit inputs and 8 bit weights, skip to adjoining pixel
+                        PDX_LA_2MX16_XP (vin, ina, inp, nChannels*sizeof(int16_t));
+                        ina = PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
+                        PDX_LA16_2MX8_XP (vwt, wta, wtp, nChannels);
+                        wta = PDX_LA_2MX8_PP (wtp); // prime, NOP if a[] is aligned
+
+                        //multiply and accumulate without doubling
+                        PDX_MULAW_2MX16(acc,vin,vwt);//acc contains upto 2*PDX_M channel results for pixel
+                    }
+                }
+                quantize_and_store_channels_16x8(acc,
+                                                 pBiasHigh ? pBiasHigh + nChannel : NULL,
+                                                 pBiasHigh ? pBiasLow + nChannel : NULL,
+                                                 pQuantizedMultiplier + nChannel,
+                                                 pQuantizedShift + nChannel,
+                                                 MIN(nChannels - nChannel, 2*PDX_M),
+                                                 vmin, vmax,
+                                                 outp, outa);
+            }
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_int16_ctx
+* @brief optimized depthconv2d function
+*
+* @details optimized depthconv2d function for 16-bit integer input, 8-bit weights and 64-bit bias (TFLite 16x8 scheme).
+* 2D depthwise-convolution in interleaved format using 16bit Eagle intrinsics with per channel requantization.
+* Stride 1 and stride 2 use dedicated instances of the convolution loop.
+* With a depth multiplier the input is repeated in the large scratch, and -1 is returned if it does not fit.
+* The bias is split in 32 bit high and low halves in the scratch, which must hold both.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pWeightsBuffer - input weights buffer
+* @param [in] pBiasBuffer - input bias buffer
+* @param [in] nInputWidth - input width
+* @param [in] nInputHeight - input height
+* @param [in] nDepthMult - depth multiplier
+* @param [in] nInChannels - input depth
+* @param [in] nOutChannels - output depth
+* @param [in] nKernelSizeWidth - kernel width
+* @param [in] nKernelSizeHeight - kernel height
+* @param [in] nTotalPaddingWidth - pad width
+* @param [in] nTotalPaddingHeight - pad height
+* @param [in] pQuantizedMultiplier - multiplier
+* @param [in] pQuantizedShift - shift
+* @param [in] nStrideWidth - stride width
+* @param [in] nStrideHeight - stride height
+* @param [in] nActMin - min value after activation function
+* @param [in] nActMax - max value after activation function
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_depthconv2d_int16_ctx(const int16_t *pInputBuffer,
+                                          int16_t *pOutputBuffer,
+                                          const int8_t *pWeightsBuffer,
+                                          const int64_t *pBiasBuffer,
+                                          int32_t nInputWidth,
+                                          int32_t nInputHeight,
+                                          int32_t nDepthMult,
+                                          int32_t nInChannels,
+                                          int32_t nOutChannels,
+                                          int32_t nKernelSizeWidth,
+                                          int32_t nKernelSizeHeight,
+                                          int32_t nTotalPaddingWidth,
+                                          int32_t nTotalPaddingHeight,
+                                          int32_t *pQuantizedMultiplier,
+                                          int32_t *pQuantizedShift,
+                                          int32_t nStrideWidth,
+                                          int32_t nStrideHeight,
+                                          int32_t nActMin,
+                                          int32_t nActMax,
+                                          const ADI_SHARCFX_CONTEXT* pContext)
+{
+    //split the 64 bit bias once so it can be read per channel with the 32 bit vector loads
+    int32_t nBiasBytes = ((nOutChannels*sizeof(int32_t) + 4*PDX_M - 1)/(4*PDX_M))*4*PDX_M;
+    if (pBiasBuffer && 2*nBiasBytes > get_scratch_size(pContext))
+    {
+        return -1;
+    }
+    int32_t *pBiasHigh = (int32_t *)get_scratch(pContext);
+    int32_t *pBiasLow = (int32_t *)(get_scratch(pContext) + nBiasBytes);
+    if(pBiasBuffer)
+    {
+        split_bias_int64(pBiasBuffer, pBiasHigh, pBiasLow, nOutChannels);
+    }
+
+    const int16_t *pInpPtr = pInputBuffer;
+    if(nInChannels != nOutChannels)
+    {
+        if ((int32_t)(nInputHeight*nInputWidth*nInChannels*nDepthMult*sizeof(int16_t)) >
+            get_scratch_l3_size(pContext, TEMP_BUFFER_SIZE_L3))
+        {
+            return -1;
+        }
+        //CASE depth multiplier != 1. Repeat every input channel nDepthMult times so each output channel
+        //lines up with its input channel in the interleaved format
+        int16_t *pInpPtrTemp = (int16_t *)get_scratch_l3(pContext, pTempLocal);
+        for(int i=0; i< nInputHeight*nInputWidth; i++){
+            for(int k=0; k< nInChannels; k++)
+            {
+                for(int m=0; m< nDepthMult; m++)
+                {
+                    *pInpPtrTemp++ = *pInpPtr;
+                }
+                pInpPtr++;
+            }
+        }
+        pInpPtr = (const int16_t *)get_scratch_l3(pContext, pTempLocal);
+    }
+
+    if(nStrideWidth == 1 && nStrideHeight == 1)
+    {
+        depthconv2d_int16_core(pInpPtr, pOutputBuffer, pWeightsBuffer, pBiasBuffer ? pBiasHigh : NULL, pBiasLow,
+                               nInputWidth, nInputHeight, nOutChannels,
+                               nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight,
+                               pQuantizedMultiplier, pQuantizedShift,
+                               1, 1, nActMin, nActMax);
+    }
+    else if(nStrideWidth == STRIDE_2 && nStrideHeight == STRIDE_2)
+    {
+        depthconv2d_int16_core(pInpPtr, pOutputBuffer, pWeightsBuffer, pBiasBuffer ? pBiasHigh : NULL, pBiasLow,
+                               nInputWidth, nInputHeight, nOutChannels,
+                               nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight,
+                               pQuantizedMultiplier, pQuantizedShift,
+                               STRIDE_2, STRIDE_2, nActMin, nActMax);
+    }
+    else
+    {
+        depthconv2d_int16_core(pInpPtr, pOutputBuffer, pWeightsBuffer, pBiasBuffer ? pBiasHigh : NULL, pBiasLow,
+                               nInputWidth, nInputHeight, nOutChannels,
+                               nKernelSizeWidth, nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight,
+                               pQuantizedMultiplier, pQuantizedShift,
+                               nStrideWidth, nStrideHeight, nActMin, nActMax);
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_depthconv2d_int16
+* @brief adi_sharcfx_depthconv2d_int16_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_depthconv2d_int16_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_depthconv2d_int16(const int16_t *pInputBuffer,
+                                      int16_t *pOutputBuffer,
+                                      const int8_t *pWeightsBuffer,
+                                      const int64_t *pBiasBuffer,
+                                      int32_t nInputWidth,
+                                      int32_t nInputHeight,
+                                      int32_t nDepthMult,
+                                      int32_t nInChannels,
+                                      int32_t nOutChannels,
+                                      int32_t nKernelSizeWidth,
+                                      int32_t nKernelSizeHeight,
+                                      int32_t nTotalPaddingWidth,
+                                      int32_t nTotalPaddingHeight,
+                                      int32_t *pQuantizedMultiplier,
+                                      int32_t *pQuantizedShift,
+                                      int32_t nStrideWidth,
+                                      int32_t nStrideHeight,
+                                      int32_t nActMin,
+                                      int32_t nActMax)
+{
+    return adi_sharcfx_depthconv2d_int16_ctx(pInputBuffer, pOutputBuffer, pWeightsBuffer, pBiasBuffer, nInputWidth,
+                                             nInputHeight, nDepthMult, nInChannels, nOutChannels, nKernelSizeWidth,
+                                             nKernelSizeHeight, nTotalPaddingWidth, nTotalPaddingHeight, pQuantizedMultiplier,
+                                             pQuantizedShift, nStrideWidth, nStrideHeight, nActMin, nActMax, NULL);
+}
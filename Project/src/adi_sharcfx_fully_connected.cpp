@@ -16,11 +16,60 @@
 */
 
 /*============= I N C L U D E S =============*/
-#include "adi_sharcfx_nn.h"
+#include <string.h>
+#include "adi_sharcfx_internal.h"
 
 /*============= C O D E =============*/
 
 
+/*UTILITY FUNCTION*/
+//MAC core of the int16 fully connected layer: per lane products of one 8bit filter row with the 16bit input, offsets added.
+//PDX_MULAQW_2MX16 doubles every product, a tail shorter than 2*PDX_M is masked
+xb_vec2Mx40 fully_connected_int16_mac(const int16_t* pInputBuffer,
+                                      const int8_t* pWeightsBuffer,
+                                      int32_t nFilterDepth,
+                                      xb_vec2Mx16 vInZP,
+                                      xb_vec2Mx16 vFilterZP)
+{
+    xb_vec2Mx16 vin,vwt;
+    xb_vec2Mx40 acc = 0;
+    vbool4M temp_mask;
+    vbool2M acc_mask;
+
+    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pInputBuffer;
+    valign ina; // define align vector
+    ina=PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
+
+    xb_vec2Mx8 *wtp = (xb_vec2Mx8 *)pWeightsBuffer;
+    valign wta;    // define align vector
+    wta=PDX_LA_2MX8_PP (wtp);
+
+    int32_t nPixProcessed;
+    for (nPixProcessed = 0; nPixProcessed + 2*PDX_M <= nFilterDepth; nPixProcessed += (2*PDX_M))
+    {
+        PDX_LA_2MX16_XP (vin, ina, inp, 2*PDX_M*sizeof(int16_t)); // load aligned
+        PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
+        vin+=vInZP;        //Add input offset
+        vwt+=vFilterZP;    //Add filter offset
+
+        PDX_MULAQW_2MX16(acc,vwt,vin);
+    }
+
+    if(nFilterDepth % (2*PDX_M))
+    {
+        PDX_LA_2MX16_XP (vin, ina, inp, 0); // load aligned
+        PDX_LA16_2MX8_XP (vwt, wta, wtp, 0); // load aligned, extend
+        vin+=vInZP;        //Add input offset
+        vwt+=vFilterZP;    //Add filter offset
+
+        temp_mask = PDX_MOVB_AU32((0b1<<(nFilterDepth % (2*PDX_M))) - 1);
+        acc_mask = PDX_CVTBB2M_B4M_L(temp_mask);
+        //multiply and accumulate
+        PDX_MULAQW_2MX16_T(acc,vwt,vin,acc_mask);
+    }
+    return acc;
+}
+
 void adi_sharcfx_fully_connected_int16(const int16_t* pInputBuffer,
                                        const int8_t* pWeightsBuffer,
                                        const int64_t* pBiasBuffer,
@@ -43,120 +92,152 @@ void adi_sharcfx_fully_connected_int16(const int16_t* pInputBuffer,
     xb_vec2Mx16 vInZP = PDX_REP_2MX16((xb_vec2Mx16)nInputOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
     xb_vec2Mx16 vFilterZP = PDX_REP_2MX16((xb_vec2Mx16)nFilterOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
 
-    xb_vec2Mx16 vin,vwt;
     xb_int32 temp;
     xb_int40 sat_sum;
     xb_int80 product;
 
-    vbool4M temp_mask;
-    vbool2M acc_mask, ffff;
-
-    temp_mask = PDX_MOVB_AU32(0xFFFFFFFF);
-    PDX_CVTBB2M_B4M(ffff, ffff, temp_mask);
-
-    int32_t nPixProcessed=0;
     xb_vec2Mx40 acc = 0;
 
-    if(nFilterDepth % 16)
+    for (int b = 0; b < nBatches; b++)
     {
-        for (int b = 0; b < nBatches; b++)
+        //No of filter is equals to the nOutsize
+        for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
         {
-            //No of filter is equals to the nOutsize
-            for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
+            acc = fully_connected_int16_mac(pInputBuffer + b*nFilterDepth,
+                                            pWeightsBuffer + nFilterDepth*nChannelCnt,
+                                            nFilterDepth, vInZP, vFilterZP);
+
+            sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+            //adding bias<<1 to compensate for sign bit during multiplication
+            //doubling index for bias buffer to account for 32bit bias instead of 64bit
+            if(pBiasBuffer)
             {
-                acc = 0;//reset accumulator
-
-                xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pInputBuffer + b*nFilterDepth);    //Reinitialise input pointer for each output pixel
-                valign ina; // define align vector
-                ina=PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
+                sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
+            }
+            temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+            product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+            product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+            temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
+            temp+= (xb_int32)nOutputOffset;                                    //add output offset
+            temp = MIN(temp, (xb_int32)output_activation_max);
+            temp = MAX(temp, (xb_int32)output_activation_min);                //saturation check to store result
+            *outp++ =(int16_t)((int32_t)temp);                                //store result as 16-bit data
+        }
+    }
+}
 
-                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pWeightsBuffer + nFilterDepth*nChannelCnt); //Move to next filter for each output pixel
-                valign wta;    // define align vector
-                wta=PDX_LA_2MX8_PP (wtp);
+/*UTILITY FUNCTION*/
+//MAC core of the int8 fully connected layer: per lane products of one filter row with the input, offsets added.
+//PDX_MULAQW_2MX16 doubles every product, a tail shorter than 2*PDX_M is masked
+xb_vec2Mx40 fully_connected_int8_mac(const int8_t* pInputBuffer,
+                                     const int8_t* pWeightsBuffer,
+                                     int32_t nFilterDepth,
+                                     xb_vec2Mx16 vInZP,
+                                     xb_vec2Mx16 vFilterZP)
+{
+    xb_vec2Mx16 vin,vwt;
+    xb_vec2Mx40 acc = 0;
+    vbool4M temp_mask;
+    vbool2M acc_mask;
 
-                //for all the input pixels
-                for (nPixProcessed= 0; nFilterDepth - nPixProcessed > 2*PDX_M; nPixProcessed += (2*PDX_M))
-                {
-                    PDX_LA_2MX16_XP (vin, ina, inp, 2*PDX_M*sizeof(int16_t)); // load aligned, extend
-                    PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
-                    vin+=vInZP;        //Add input offset
-                    vwt+=vFilterZP;    //Add filter offset
+    xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pInputBuffer;
+    valign ina; // define align vector
+    ina=PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
 
-                    PDX_MULAQW_2MX16(acc,vwt,vin);
-                }
+    xb_vec2Mx8 *wtp = (xb_vec2Mx8 *)pWeightsBuffer;
+    valign wta;    // define align vector
+    wta=PDX_LA_2MX8_PP (wtp);
 
-                PDX_LA_2MX16_XP (vin, ina, inp, 0); // load aligned, extend
-                PDX_LA16_2MX8_XP (vwt, wta, wtp, 0); // load aligned, extend
-                vin+=vInZP;        //Add input offset
-                vwt+=vFilterZP;    //Add filter offset
+    int32_t nPixProcessed;
+    for (nPixProcessed = 0; nPixProcessed + 2*PDX_M <= nFilterDepth; nPixProcessed += (2*PDX_M))
+    {
+        PDX_LA16_2MX8_XP (vin, ina, inp, 2*PDX_M); // load aligned, extend
+        PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
+        vin+=vInZP;        //Add input offset
+        vwt+=vFilterZP;    //Add filter offset
 
-                temp_mask = PDX_MOVB_AU32((0b1<<(nFilterDepth % 16)) - 1);
-                acc_mask = PDX_CVTBB2M_B4M_L(temp_mask);
-                //multiply and accumulate
-                PDX_MULAQW_2MX16_T(acc,vwt,vin,acc_mask);
+        PDX_MULAQW_2MX16(acc,vwt,vin);
+    }
 
-                sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
-                //adding bias<<1 to compensate for sign bit during multiplication
-                //doubling index for bias buffer to account for 32bit bias instead of 64bit
-                if(pBiasBuffer)
-                {
-                    sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
-                }
-                temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
-
-                product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
-                product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
-                temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
-                temp+= (xb_int32)nOutputOffset;                                    //add output offset
-                temp = MIN(temp, (xb_int32)output_activation_max);
-                temp = MAX(temp, (xb_int32)output_activation_min);//saturation check to store result
-                *outp++ =(int16_t)((int32_t)temp);                                //store result as 16-bit data
-            }
-        }
+    if(nFilterDepth % (2*PDX_M))
+    {
+        PDX_LA16_2MX8_XP (vin, ina, inp, 2*PDX_M); // load aligned, extend
+        PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
+        vin+=vInZP;        //Add input offset
+        vwt+=vFilterZP;    //Add filter offset
+
+        temp_mask = PDX_MOVB_AU32((0b1<<(nFilterDepth % (2*PDX_M))) - 1);
+        acc_mask = PDX_CVTBB2M_B4M_L(temp_mask);
+        //multiply and accumulate
+        PDX_MULAQW_2MX16_T(acc,vwt,vin,acc_mask);
     }
-    else{
-        for (int b = 0; b < nBatches; b++)
-        {
-            //No of filter is equals to the nOutsize
-            for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
-            {
-                acc = 0;//reset accumulator
+    return acc;
+}
 
-                xb_vec2Mx16 * inp = (xb_vec2Mx16 *)(pInputBuffer + b*nFilterDepth);    //Reinitialise input pointer for each output pixel
-                valign ina; // define align vector
-                ina=PDX_LA_2MX16_PP (inp); // prime, NOP if a[] is aligned
+/**
+*******************************************************************************
+* Function: adi_sharcfx_fully_connected_channels_int8
+* @brief channel range fully connected function
+*
+* @details adi_sharcfx_fully_connected_int8 restricted to output channels [nChannelStart, nChannelEnd) of every batch. It uses no
+* scratch, so calls on disjoint channel ranges can run concurrently, e.g. one per core, and together produce the output of
+* adi_sharcfx_fully_connected_int8.
+*
+*******************************************************************************
+*/
+void adi_sharcfx_fully_connected_channels_int8(const int8_t* pInputBuffer,
+                                               const int8_t* pWeightsBuffer,
+                                               const int32_t* pBiasBuffer,
+                                               int8_t* pOutputBuffer,
+                                               int32_t nFilterDepth,
+                                               int32_t nOutsize,
+                                               int32_t nBatches,
+                                               uint32_t nQuantizedMultiplier,
+                                               int32_t nQuantizedShift,
+                                               int32_t nInputOffset,
+                                               int32_t nFilterOffset,
+                                               int32_t nOutputOffset,
+                                               int32_t output_activation_min,
+                                               int32_t output_activation_max,
+                                               int32_t nChannelStart,
+                                               int32_t nChannelEnd)
+{
+    int8_t* __restrict outp;
 
-                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pWeightsBuffer + nFilterDepth*nChannelCnt); //Move to next filter for each output pixel
-                valign wta;    // define align vector
-                wta=PDX_LA_2MX8_PP (wtp);
+    const immediate Lane=0;
+    //Defining the input and filter offsets
+    xb_vec2Mx16 vInZP = PDX_REP_2MX16((xb_vec2Mx16)nInputOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
+    xb_vec2Mx16 vFilterZP = PDX_REP_2MX16((xb_vec2Mx16)nFilterOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
+    xb_int32 temp;
+    xb_int40 sat_sum;
+    xb_int80 product;
 
-                //for all the input pixels
-                for (int32_t nFilterCnt = 0; nFilterCnt <= nFilterDepth; nFilterCnt += (2*PDX_M))
-                {
-                    PDX_LA_2MX16_XP (vin, ina, inp, 2*PDX_M*sizeof(int16_t)); // load aligned, extend
-                    PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M);
-                    vin+=vInZP;        //Add input offset
-                    vwt+=vFilterZP;    //Add filter offset
+    xb_vec2Mx40 acc = 0;
+    for (int b = 0; b < nBatches; b++){
+        outp = pOutputBuffer + b*nOutsize + nChannelStart;
+        //No of filter is equals to the nOutsize, only the filters of the range are run
+        for (int32_t nChannelCnt = nChannelStart; nChannelCnt < nChannelEnd; nChannelCnt++)
+        {
+            acc = fully_connected_int8_mac(pInputBuffer + b*nFilterDepth,
+                                           pWeightsBuffer + nFilterDepth*nChannelCnt,
+                                           nFilterDepth, vInZP, vFilterZP);
 
-                    PDX_MULAQW_2MX16(acc,vwt,vin);
-                }
-                sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+            sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+            if(pBiasBuffer)
+            {
                 //adding bias<<1 to compensate for sign bit during multiplication
-                //doubling index for bias buffer to account for 32bit bias instead of 64bit
-                if(pBiasBuffer)
-                {
-                    sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
-                }
-                temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
-
-                product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
-                product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
-                temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
-                temp+= (xb_int32)nOutputOffset;                                    //add output offset
-                temp = MIN(temp, (xb_int32)output_activation_max);
-                temp = MAX(temp, (xb_int32)output_activation_min);                //saturation check to store result
-                *outp++ =(int16_t)((int32_t)temp);                                //store result as 16-bit data
+                sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
             }
+            temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+            product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+            product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+            temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
+            temp+= (xb_int32)nOutputOffset;                                    //add output offset
+            temp = MIN(temp, (xb_int32)output_activation_max);
+            temp = MAX(temp, (xb_int32)output_activation_min);//8bit saturation check to store result
+            *outp++ =(int8_t)((int32_t)temp);                                //store result as 8-bit data
         }
     }
 }
@@ -176,125 +257,371 @@ void adi_sharcfx_fully_connected_int8(const int8_t* pInputBuffer,
                                       int32_t output_activation_min,
                                       int32_t output_activation_max)
 {
-    int8_t* __restrict outp = (int8_t*) pOutputBuffer;
+    adi_sharcfx_fully_connected_channels_int8(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer,
+                                              nFilterDepth, nOutsize, nBatches, nQuantizedMultiplier, nQuantizedShift,
+                                              nInputOffset, nFilterOffset, nOutputOffset,
+                                              output_activation_min, output_activation_max,
+                                              0, nOutsize);
+}
+
+/*UTILITY FUNCTION*/
+//MAC core of the int4 weight layers: per lane products of one packed filter row with the input, input offset added.
+//Every 16 packed bytes hold weights j in the low and j+2*PDX_M in the high nibbles of a 2*PDX_M block of the row.
+//The row is zero padded to a full block, so a partial last block is loaded from a zero padded copy of the input tail and
+//no input byte past nFilterDepth is read
+xb_vec2Mx40 fully_connected_int4_mac(const int8_t* pInputBuffer,
+                                     const int8_t* pPackedWeights,
+                                     int32_t nFilterDepth,
+                                     xb_vec2Mx16 vInZP)
+{
+    xb_vec2Mx16 vin_lo,vin_hi,vwt,vwt_lo,vwt_hi;
+    xb_vec2Mx40 acc = 0;
+    int8_t pTail[ADI_SHARCFX_INT4_BLOCK] __attribute__((aligned(8)));
+    int32_t nFullDepth = nFilterDepth - nFilterDepth % ADI_SHARCFX_INT4_BLOCK;
+
+    xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pInputBuffer;
+    valign ina; // define align vector
+    ina=PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
+
+    xb_vec2Mx8 *wtp = (xb_vec2Mx8 *)pPackedWeights;
+    valign wta;    // define align vector
+    wta=PDX_LA_2MX8_PP (wtp);
+
+    int32_t nPixProcessed;
+    for (nPixProcessed = 0; nPixProcessed < nFilterDepth; nPixProcessed += ADI_SHARCFX_INT4_BLOCK)
+    {
+        if (nPixProcessed == nFullDepth)
+        {
+            //partial last block, the padding weights are zero so the padding input only has to be readable
+            memset(pTail, 0, sizeof(pTail));
+            memcpy(pTail, pInputBuffer + nPixProcessed, nFilterDepth - nPixProcessed);
+            inp = (xb_vec2Mx8 *)pTail;
+            ina = PDX_LA_2MX8_PP (inp);
+        }
+        PDX_LA16_2MX8_XP (vin_lo, ina, inp, 2*PDX_M); // load aligned, extend
+        PDX_LA16_2MX8_XP (vin_hi, ina, inp, 2*PDX_M); // load aligned, extend
+        PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M);    // 2*PDX_M packed bytes, sign extended
+        vwt_lo = PDX_SRAI_2MX16(PDX_SLLI_2MX16(vwt, 12), 12);    //sign extend the low nibble
+        vwt_hi = PDX_SRAI_2MX16(vwt, 4);                          //high nibble, already sign extended by the load
+        vin_lo+=vInZP;        //Add input offset
+        vin_hi+=vInZP;        //Add input offset
+
+        PDX_MULAQW_2MX16(acc,vwt_lo,vin_lo);
+        PDX_MULAQW_2MX16(acc,vwt_hi,vin_hi);
+    }
+    return acc;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_pack_int4
+* @brief packs int4 weights two per byte
+*
+* @details offline packing of the weights of adi_sharcfx_fully_connected_int4 and adi_sharcfx_conv2d_kernel1x1_int4. Every row is
+* zero padded to a multiple of ADI_SHARCFX_INT4_BLOCK weights and stored in ADI_SHARCFX_INT4_ROW_BYTES(nDepth) bytes. Byte j of a
+* block holds weight j in the low and weight j+ADI_SHARCFX_INT4_BLOCK/2 in the high nibble, so a single load and two shifts unpack
+* a block into two vectors in registers.
+*
+* Parameters:
+* @param [in] pWeights - weights, nRows x nDepth, each in [-8, 7]
+* @param [in] nRows - # of rows, i.e. output channels
+* @param [in] nDepth - weights per row
+*
+* @param [out] pPackedWeights - packed weights, nRows x ADI_SHARCFX_INT4_ROW_BYTES(nDepth) bytes
+*
+* @return packed row size in bytes, -1 if a weight is out of the int4 range
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_pack_int4(const int8_t* pWeights,
+                              int8_t* pPackedWeights,
+                              int32_t nRows,
+                              int32_t nDepth)
+{
+    int32_t nRowBytes = ADI_SHARCFX_INT4_ROW_BYTES(nDepth);
+    int32_t nHalf = ADI_SHARCFX_INT4_BLOCK/2;
+
+    for (int32_t nRow = 0; nRow < nRows; nRow++)
+    {
+        const int8_t *pRow = pWeights + nRow*nDepth;
+        int8_t *pPacked = pPackedWeights + nRow*nRowBytes;
+        for (int32_t nByte = 0; nByte < nRowBytes; nByte++)
+        {
+            //byte nByte of block nBlock holds weights nBlock*BLOCK + j and nBlock*BLOCK + j + BLOCK/2
+            int32_t nLow = (nByte / nHalf) * ADI_SHARCFX_INT4_BLOCK + (nByte % nHalf);
+            int32_t nHigh = nLow + nHalf;
+            int32_t wLow = nLow < nDepth ? pRow[nLow] : 0;
+            int32_t wHigh = nHigh < nDepth ? pRow[nHigh] : 0;
+            if (wLow < -8 || wLow > 7 || wHigh < -8 || wHigh > 7)
+            {
+                return -1;
+            }
+            pPacked[nByte] = (int8_t)((wHigh << 4) | (wLow & 0xF));
+        }
+    }
+    return nRowBytes;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_fully_connected_int4
+* @brief fully connected function with int4 weights
+*
+* @details fully connected function for 8-bit integer input and symmetric int4 weights packed with adi_sharcfx_pack_int4. The
+* nibbles are unpacked in registers, so the weights take half the memory and bandwidth of adi_sharcfx_fully_connected_int8.
+* Weights are requantized per output channel.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pPackedWeights - packed weights, nOutsize rows of ADI_SHARCFX_INT4_ROW_BYTES(nFilterDepth) bytes
+* @param [in] pBiasBuffer - input bias buffer, may be NULL
+* @param [in] nFilterDepth - input size
+* @param [in] nOutsize - output size
+* @param [in] nBatches - batch size
+* @param [in] pQuantizedMultiplier - per channel multiplier
+* @param [in] pQuantizedShift - per channel shift
+* @param [in] nInputOffset - input offset
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] output_activation_min - activation min
+* @param [in] output_activation_max - activation max
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_fully_connected_int4(const int8_t* pInputBuffer,
+                                      const int8_t* pPackedWeights,
+                                      const int32_t* pBiasBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nFilterDepth,
+                                      int32_t nOutsize,
+                                      int32_t nBatches,
+                                      const int32_t* pQuantizedMultiplier,
+                                      const int32_t* pQuantizedShift,
+                                      int32_t nInputOffset,
+                                      int32_t nOutputOffset,
+                                      int32_t output_activation_min,
+                                      int32_t output_activation_max)
+{
+    int8_t* __restrict outp = pOutputBuffer;
+    int32_t nRowBytes = ADI_SHARCFX_INT4_ROW_BYTES(nFilterDepth);
 
     const immediate Lane=0;
-    //Defining the input and filter offsets
+    //Defining the input offset, int4 weights are symmetric
     xb_vec2Mx16 vInZP = PDX_REP_2MX16((xb_vec2Mx16)nInputOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
-    xb_vec2Mx16 vFilterZP = PDX_REP_2MX16((xb_vec2Mx16)nFilterOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
-    xb_vec2Mx16 vin,vwt;
     xb_int32 temp;
     xb_int40 sat_sum;
     xb_int80 product;
 
-    vbool4M temp_mask;
-    vbool2M acc_mask, ffff;
-
-    temp_mask = PDX_MOVB_AU32(0xFFFFFFFF);
-    PDX_CVTBB2M_B4M(ffff, ffff, temp_mask);
-
-    int32_t nPixProcessed=0;
-
     xb_vec2Mx40 acc = 0;
-    xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pInputBuffer;
-    if(nFilterDepth % 16){
-        int32_t nFilterDepth_16mul = nFilterDepth - ((nFilterDepth % 16)*nFilterDepth);
-        for (int b = 0; b < nBatches; b++){
-            //No of filter is equals to the nOutsize
-            for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
-            {
-                acc = 0;//reset accumulator
-
-                inp = (xb_vec2Mx8 *)(pInputBuffer + b*nFilterDepth);    //Reinitialise input pointer for each output pixel
-                valign ina; // define align vector
-                ina=PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
+    for (int b = 0; b < nBatches; b++){
+        for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
+        {
+            acc = fully_connected_int4_mac(pInputBuffer + b*nFilterDepth,
+                                           pPackedWeights + nRowBytes*nChannelCnt,
+                                           nFilterDepth, vInZP);
 
-                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pWeightsBuffer + nFilterDepth*nChannelCnt); //Move to next filter for each output pixel
-                valign wta;    // define align vector
-                wta=PDX_LA_2MX8_PP (wtp);
+            sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+            if(pBiasBuffer)
+            {
+                //adding bias<<1 to compensate for sign bit during multiplication
+                sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
+            }
+            sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+            sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);                    //32bit saturation before the conversion
+            temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+            product = PDX_MULW_32(temp, (uint32_t)pQuantizedMultiplier[nChannelCnt]);    //multiply with the channel multiplier
+            product =  PDX_SLA_80(product, (xb_int32)pQuantizedShift[nChannelCnt]);      //shift result by the channel shift
+            temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
+            temp+= (xb_int32)nOutputOffset;                                    //add output offset
+            temp = MIN(temp, (xb_int32)output_activation_max);
+            temp = MAX(temp, (xb_int32)output_activation_min);//8bit saturation check to store result
+            *outp++ =(int8_t)((int32_t)temp);                                //store result as 8-bit data
+        }
+    }
+}
 
-                //for all the input pixels
-                for (nPixProcessed= 0; nPixProcessed < nFilterDepth_16mul; nPixProcessed += (2*PDX_M))
-                {
-                    PDX_LA16_2MX8_XP (vin, ina, inp, 2*PDX_M); // load aligned, extend
-                    PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
-                    vin+=vInZP;        //Add input offset
-                    vwt+=vFilterZP;    //Add filter offset
+/*UTILITY FUNCTION*/
+//MAC core of the block sparse layers: products of the nBlocks nonzero 2*PDX_M weight blocks of one filter row with the
+//input at the block positions, input offset added. Blocks are zero padded past the filter depth, and a block crossing
+//nFilterDepth is loaded from a zero padded copy of the input tail, so no input byte past nFilterDepth is read
+xb_vec2Mx40 fully_connected_sparse_mac(const int8_t* pInputBuffer,
+                                       const int16_t* pBlockIdx,
+                                       const int8_t* pValues,
+                                       int32_t nBlocks,
+                                       int32_t nFilterDepth,
+                                       xb_vec2Mx16 vInZP)
+{
+    xb_vec2Mx16 vin,vwt;
+    xb_vec2Mx40 acc = 0;
+    int8_t pTail[ADI_SHARCFX_SPARSE_BLOCK] __attribute__((aligned(8)));
 
-                    PDX_MULAQW_2MX16(acc,vwt,vin);
+    xb_vec2Mx8 *wtp = (xb_vec2Mx8 *)pValues;
+    valign wta;    // define align vector
+    wta=PDX_LA_2MX8_PP (wtp);
 
-                }
+    for (int32_t nBlock = 0; nBlock < nBlocks; nBlock++)
+    {
+        //blocks are scattered over the input, prime the load for each of them
+        int32_t nStart = pBlockIdx[nBlock]*ADI_SHARCFX_SPARSE_BLOCK;
+        xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pInputBuffer + nStart);
+        if (nStart + ADI_SHARCFX_SPARSE_BLOCK > nFilterDepth)
+        {
+            //partial last block, the padding weights are zero so the padding input only has to be readable
+            memset(pTail, 0, sizeof(pTail));
+            memcpy(pTail, pInputBuffer + nStart, nFilterDepth - nStart);
+            inp = (xb_vec2Mx8 *)pTail;
+        }
+        valign ina = PDX_LA_2MX8_PP (inp);
+        PDX_LA16_2MX8_XP (vin, ina, inp, 2*PDX_M); // load aligned, extend
+        PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
+        vin+=vInZP;        //Add input offset
 
-                PDX_LA16_2MX8_XP (vin, ina, inp, 2*PDX_M); // load aligned, extend
-                PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
-                vin+=vInZP;        //Add input offset
-                vwt+=vFilterZP;    //Add filter offset
+        PDX_MULAQW_2MX16(acc,vwt,vin);
+    }
+    return acc;
+}
 
-                temp_mask = PDX_MOVB_AU32((0b1<<(nFilterDepth % 16)) - 1);
-                acc_mask = PDX_CVTBB2M_B4M_L(temp_mask);
-                //multiply and accumulate
-                PDX_MULAQW_2MX16_T(acc,vwt,vin,acc_mask);
+/**
+*******************************************************************************
+* Function: adi_sharcfx_pack_block_sparse
+* @brief packs weights into the block sparse format
+*
+* @details offline packing of the weights of adi_sharcfx_fully_connected_sparse_int8 and adi_sharcfx_conv2d_kernel1x1_sparse_int8.
+* Every row is split into blocks of ADI_SHARCFX_SPARSE_BLOCK weights along the depth and only blocks with a nonzero weight are
+* kept, with their position. The sparse kernels skip the dropped blocks, so only symmetric weights (zero filter offset) can be
+* packed. pSparse arrays must hold up to nRows * ADI_SHARCFX_SPARSE_BLOCKS(nDepth) blocks.
+*
+* Parameters:
+* @param [in] pWeights - weights, nRows x nDepth
+* @param [in] nRows - # of rows, i.e. output channels
+* @param [in] nDepth - weights per row
+*
+* @param [out] pSparse - block pointers, block positions and block values of the packed weights
+*
+* @return # of nonzero blocks
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_pack_block_sparse(const int8_t* pWeights,
+                                      int32_t nRows,
+                                      int32_t nDepth,
+                                      ADI_SHARCFX_SPARSE_WEIGHTS* pSparse)
+{
+    int32_t nBlocks = 0;
 
-                sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
-                if(pBiasBuffer)
-                {
-                    //adding bias>>1 to compensate for sign bit during multiplication
-                    sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
-                }
-                temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
-
-                product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
-                product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
-                temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
-                temp+= (xb_int32)nOutputOffset;                                    //add output offset
-                temp = MIN(temp, (xb_int32)output_activation_max);
-                temp = MAX(temp, (xb_int32)output_activation_min);//8bit saturation check to store result
-                *outp++ =(int8_t)((int32_t)temp);                                //store result as 8-bit data
+    for (int32_t nRow = 0; nRow < nRows; nRow++)
+    {
+        const int8_t *pRow = pWeights + nRow*nDepth;
+        pSparse->pBlockPtr[nRow] = nBlocks;
+        for (int32_t nBlock = 0; nBlock < ADI_SHARCFX_SPARSE_BLOCKS(nDepth); nBlock++)
+        {
+            int32_t nStart = nBlock*ADI_SHARCFX_SPARSE_BLOCK;
+            int32_t nLen = MIN(ADI_SHARCFX_SPARSE_BLOCK, nDepth - nStart);
+            int32_t nNonZero = 0;
+            for (int32_t i = 0; i < nLen; i++)
+            {
+                nNonZero |= pRow[nStart + i];
+            }
+            if (!nNonZero)
+            {
+                continue;
+            }
+            //keep the block, zero padded past the row end
+            int8_t *pValues = pSparse->pValues + nBlocks*ADI_SHARCFX_SPARSE_BLOCK;
+            for (int32_t i = 0; i < ADI_SHARCFX_SPARSE_BLOCK; i++)
+            {
+                pValues[i] = i < nLen ? pRow[nStart + i] : 0;
             }
+            pSparse->pBlockIdx[nBlocks++] = (int16_t)nBlock;
         }
     }
-    else{
-        for (int b = 0; b < nBatches; b++){
-            //No of filter is equals to the nOutsize
-            for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
-            {
-                acc = 0;//reset accumulator
-
-                inp = (xb_vec2Mx8 *)(pInputBuffer + b*nFilterDepth);    //Reinitialise input pointer for each output pixel
-                valign ina; // define align vector
-                ina=PDX_LA_2MX8_PP (inp); // prime, NOP if a[] is aligned
-
-                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pWeightsBuffer + nFilterDepth*nChannelCnt); //Move to next filter for each output pixel
-                valign wta;    // define align vector
-                wta=PDX_LA_2MX8_PP (wtp);
+    pSparse->pBlockPtr[nRows] = nBlocks;
+    return nBlocks;
+}
 
-                //for all the input pixels
-                for (int32_t nFilterCnt = 0; nFilterCnt < nFilterDepth; nFilterCnt += (2*PDX_M))
-                {
-                    PDX_LA16_2MX8_XP (vin, ina, inp, 2*PDX_M); // load aligned, extend
-                    PDX_LA16_2MX8_XP (vwt, wta, wtp, 2*PDX_M); // load aligned, extend
-                    vin+=vInZP;        //Add input offset
-                    vwt+=vFilterZP;    //Add filter offset
+/**
+*******************************************************************************
+* Function: adi_sharcfx_fully_connected_sparse_int8
+* @brief block sparse fully connected function
+*
+* @details fully connected function for 8-bit integer input and symmetric weights packed with adi_sharcfx_pack_block_sparse.
+* Only the nonzero weight blocks are loaded and multiplied, so the run time scales with the block density. The input does
+* not need padding, a partial last block is read from a zero padded copy of the input tail.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] pSparse - packed weights, nOutsize rows
+* @param [in] pBiasBuffer - input bias buffer, may be NULL
+* @param [in] nFilterDepth - input size
+* @param [in] nOutsize - output size
+* @param [in] nBatches - batch size
+* @param [in] nQuantizedMultiplier - multiplier
+* @param [in] nQuantizedShift - shift
+* @param [in] nInputOffset - input offset
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] output_activation_min - activation min
+* @param [in] output_activation_max - activation max
+*
+* @param [out] pOutputBuffer - output data
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_fully_connected_sparse_int8(const int8_t* pInputBuffer,
+                                             const ADI_SHARCFX_SPARSE_WEIGHTS* pSparse,
+                                             const int32_t* pBiasBuffer,
+                                             int8_t* pOutputBuffer,
+                                             int32_t nFilterDepth,
+                                             int32_t nOutsize,
+                                             int32_t nBatches,
+                                             uint32_t nQuantizedMultiplier,
+                                             int32_t nQuantizedShift,
+                                             int32_t nInputOffset,
+                                             int32_t nOutputOffset,
+                                             int32_t output_activation_min,
+                                             int32_t output_activation_max)
+{
+    int8_t* __restrict outp = pOutputBuffer;
 
-                    PDX_MULAQW_2MX16(acc,vwt,vin);
+    const immediate Lane=0;
+    //Defining the input offset, sparse weights are symmetric
+    xb_vec2Mx16 vInZP = PDX_REP_2MX16((xb_vec2Mx16)nInputOffset,Lane);//Replicates the lane of data specified, across all lanes of a vector register
+    xb_int32 temp;
+    xb_int40 sat_sum;
+    xb_int80 product;
 
-                }
-                sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
-                if(pBiasBuffer)
-                {
-                    //adding bias>>1 to compensate for sign bit during multiplication
-                    sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
-                }
-                temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
-
-                product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
-                product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
-                temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
-                temp+= (xb_int32)nOutputOffset;                                    //add output offset
-                temp = MIN(temp, (xb_int32)output_activation_max);
-                temp = MAX(temp, (xb_int32)output_activation_min);//8bit saturation check to store result
-                *outp++ =(int8_t)((int32_t)temp);                                //store result as 8-bit data
+    xb_vec2Mx40 acc = 0;
+    for (int b = 0; b < nBatches; b++){
+        for (int32_t nChannelCnt = 0; nChannelCnt < nOutsize; nChannelCnt++)
+        {
+            int32_t nFirst = pSparse->pBlockPtr[nChannelCnt];
+            acc = fully_connected_sparse_mac(pInputBuffer + b*nFilterDepth,
+                                             pSparse->pBlockIdx + nFirst,
+                                             pSparse->pValues + nFirst*ADI_SHARCFX_SPARSE_BLOCK,
+                                             pSparse->pBlockPtr[nChannelCnt + 1] - nFirst, nFilterDepth, vInZP);
+
+            sat_sum = PDX_RADD_2MX40(acc);                                    //PDX_RADD_2MX40: Adds across all 16lanes of acc and returns sum
+            if(pBiasBuffer)
+            {
+                //adding bias<<1 to compensate for sign bit during multiplication
+                sat_sum += (xb_int40)(pBiasBuffer[nChannelCnt]<<1);
             }
+            sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+            sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+            temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+            product = PDX_MULW_32(temp, (uint32_t)nQuantizedMultiplier);    //multiply with the quantization multiplier; product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+            product =  PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+            temp = PDX_PACKQSRV_80(product,2);                                //packs 80bit product into 32bit var with saturation and rounding
+            temp+= (xb_int32)nOutputOffset;                                    //add output offset
+            temp = MIN(temp, (xb_int32)output_activation_max);
+            temp = MAX(temp, (xb_int32)output_activation_min);//8bit saturation check to store result
+            *outp++ =(int8_t)((int32_t)temp);                                //store result as 8-bit data
         }
     }
 }
@@ -311,20 +638,21 @@ void transform_matrices(const int8_t * inputMat, int32_t M, int32_t N, int8_t *
     }
 }
 
-void adi_sharcfx_fully_connected_int8_new(const int8_t* pInputBuffer,
-                                      const int8_t* pWeightsBuffer,
-                                      const int32_t* pBiasBuffer,
-                                      int8_t* pOutputBuffer,
-                                      int32_t nFilterDepth,
-                                      int32_t nOutsize,
-                                      int32_t nBatches,
-                                      uint32_t nQuantizedMultiplier,
-                                      int32_t nQuantizedShift,
-                                      int32_t nInputOffset,
-                                      int32_t nFilterOffset,
-                                      int32_t nOutputOffset,
-                                      int32_t output_activation_min,
-                                      int32_t output_activation_max)
+void adi_sharcfx_fully_connected_int8_new_ctx(const int8_t* pInputBuffer,
+                                          const int8_t* pWeightsBuffer,
+                                          const int32_t* pBiasBuffer,
+                                          int8_t* pOutputBuffer,
+                                          int32_t nFilterDepth,
+                                          int32_t nOutsize,
+                                          int32_t nBatches,
+                                          uint32_t nQuantizedMultiplier,
+                                          int32_t nQuantizedShift,
+                                          int32_t nInputOffset,
+                                          int32_t nFilterOffset,
+                                          int32_t nOutputOffset,
+                                          int32_t output_activation_min,
+                                          int32_t output_activation_max,
+                                          const ADI_SHARCFX_CONTEXT* pContext)
 {
     xb_vecMx8* __restrict outp  = (xb_vecMx8 *)pOutputBuffer;
     valign outa = PDX_LA_MX8_PP (outp); // prime, NOP if a[] is aligned
@@ -361,9 +689,10 @@ void adi_sharcfx_fully_connected_int8_new(const int8_t* pInputBuffer,
 
     int16_t nPixToWrite;
 
-    //Store transposed weight matrix in pTemp
-    //Use pTemp as the weights buff
-    transform_matrices(pWeightsBuffer, nOutsize, nFilterDepth, pTemp);
+    //Store transposed weight matrix in the scratch
+    //Use the scratch as the weights buff
+    int8_t *pScratch = get_scratch(pContext);
+    transform_matrices(pWeightsBuffer, nOutsize, nFilterDepth, pScratch);
 
     for(int32_t b = 0; b < nBatches; b++)
     {
@@ -380,7 +709,7 @@ void adi_sharcfx_fully_connected_int8_new(const int8_t* pInputBuffer,
 
                 inp = (int8_t *)(pInputBuffer+b*nFilterDepth + outP);    //Reinitialise input pointer for each output pixel
 
-                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pTemp + outP); //Move to next filter for each output pixel
+                xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pScratch + outP); //Move to next filter for each output pixel
                 valign wta;    // define align vector
                 wta=PDX_LA_2MX8_PP (wtp);
                 if (pBiasBuffer){
@@ -454,7 +783,7 @@ void adi_sharcfx_fully_connected_int8_new(const int8_t* pInputBuffer,
 
             inp = (int8_t *)(pInputBuffer+b*nFilterDepth + nPixProcessed);
 
-            xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pTemp + nPixProcessed); //Move to next filter for each output pixel
+            xb_vec2Mx8 *wtp = (xb_vec2Mx8 *) (pScratch + nPixProcessed); //Move to next filter for each output pixel
             valign wta;    // define align vector
             wta=PDX_LA_2MX8_PP (wtp);
 
@@ -530,3 +859,24 @@ void adi_sharcfx_fully_connected_int8_new(const int8_t* pInputBuffer,
         }
     }
 }
+
+void adi_sharcfx_fully_connected_int8_new(const int8_t* pInputBuffer,
+                                      const int8_t* pWeightsBuffer,
+                                      const int32_t* pBiasBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nFilterDepth,
+                                      int32_t nOutsize,
+                                      int32_t nBatches,
+                                      uint32_t nQuantizedMultiplier,
+                                      int32_t nQuantizedShift,
+                                      int32_t nInputOffset,
+                                      int32_t nFilterOffset,
+                                      int32_t nOutputOffset,
+                                      int32_t output_activation_min,
+                                      int32_t output_activation_max)
+{
+    adi_sharcfx_fully_connected_int8_new_ctx(pInputBuffer, pWeightsBuffer, pBiasBuffer, pOutputBuffer, nFilterDepth,
+                                             nOutsize, nBatches, nQuantizedMultiplier, nQuantizedShift, nInputOffset,
+                                             nFilterOffset, nOutputOffset, output_activation_min,
+                                             output_activation_max, NULL);
+}
@@ -0,0 +1,738 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_graph.cpp
+*
+* @brief: contains the graph executor
+*
+* @details: contains the loading of serialized graphs, the fusion and kernel selection passes and the execution of a
+* prepared graph from planned arenas without allocation
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include <string.h>
+#include "adi_sharcfx_nn.h"
+
+/*============= D E F I N E S =============*/
+#define GRAPH_ALIGN             8       /*alignment of the scratch regions of fused operators*/
+#define GRAPH_INT_FIELDS        24      /*int32 fields of a serialized node, followed by the 4 parameter offsets*/
+#define GRAPH_SHAPE_FIELDS      12      /*serialized fields from nInHeight to nDilationWidth, which must not be negative*/
+#define GRAPH_PARAMETERS        4       /*weights, bias, multipliers and shifts*/
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Total padding a convolution applies for its output size, the kernels pad (total padding)/2 on top and left
+static int32_t graph_total_pad(int32_t nOut,
+                               int32_t nStride,
+                               int32_t nKernel,
+                               int32_t nDilation,
+                               int32_t nIn)
+{
+    return MAX((nOut - 1)*nStride + (nKernel - 1)*nDilation + 1 - nIn, 0);
+}
+
+/*UTILITY FUNCTION*/
+//1x1 stride 1 convolution without padding, which runs as a matrix product over the pixels
+static int32_t graph_is_pointwise(const ADI_SHARCFX_GRAPH_NODE* pNode)
+{
+    return pNode->nKernelHeight == 1 && pNode->nKernelWidth == 1 && pNode->nStrideHeight == 1 && pNode->nStrideWidth == 1 &&
+           pNode->nOutHeight == pNode->nInHeight && pNode->nOutWidth == pNode->nInWidth;
+}
+
+/*UTILITY FUNCTION*/
+//Input node of nNode if nNode is its only reader and it is not the graph output, -1 otherwise
+static int32_t graph_fusable_input(const ADI_SHARCFX_GRAPH* pGraph,
+                                   int32_t nNode)
+{
+    int32_t nInput = pGraph->pNodes[nNode].nInputNode;
+    if (nInput < 0 || pGraph->pNodes[nInput].nOp == ADI_SHARCFX_OP_NONE || nInput == pGraph->nOutputNode)
+    {
+        return -1;
+    }
+    for (int32_t n = 0; n < pGraph->nNodes; n++)
+    {
+        if (n != nNode && pGraph->pNodes[n].nOp != ADI_SHARCFX_OP_NONE && pGraph->pNodes[n].nInputNode == nInput)
+        {
+            return -1;
+        }
+    }
+    return nInput;
+}
+
+/*UTILITY FUNCTION*/
+//Removes nNode, its readers read nTo instead
+static void graph_remove(ADI_SHARCFX_GRAPH* pGraph,
+                         int32_t nNode,
+                         int32_t nTo)
+{
+    for (int32_t n = 0; n < pGraph->nNodes; n++)
+    {
+        if (pGraph->pNodes[n].nInputNode == nNode)
+        {
+            pGraph->pNodes[n].nInputNode = nTo;
+        }
+    }
+    if (pGraph->nOutputNode == nNode)
+    {
+        pGraph->nOutputNode = nTo;
+    }
+    pGraph->pNodes[nNode].nOp = ADI_SHARCFX_OP_NONE;
+    pGraph->pNodes[nNode].nInputNode = -1;
+}
+
+/*UTILITY FUNCTION*/
+//Pad + conv: convolutions skip the taps in their implicit padding, which equals padding with the input zeropoint, so a
+//pad that matches the implicit padding of the convolution on the unpadded input is dropped. A 1x1 conv absorbing a pad
+//is no longer pointwise and runs the padded conv kernel
+static void graph_fuse_pad(ADI_SHARCFX_GRAPH* pGraph)
+{
+    for (int32_t i = 0; i < pGraph->nNodes; i++)
+    {
+        ADI_SHARCFX_GRAPH_NODE *pConv = &pGraph->pNodes[i];
+        if (pConv->nOp != ADI_SHARCFX_OP_CONV2D_INT8 && pConv->nOp != ADI_SHARCFX_OP_DEPTHCONV2D_INT8)
+        {
+            continue;
+        }
+        int32_t nPad = graph_fusable_input(pGraph, i);
+        if (nPad < 0 || pGraph->pNodes[nPad].nOp != ADI_SHARCFX_OP_PAD_INT8)
+        {
+            continue;
+        }
+        ADI_SHARCFX_GRAPH_NODE *pPadNode = &pGraph->pNodes[nPad];
+
+        int32_t nPaddedH = graph_total_pad(pConv->nOutHeight, pConv->nStrideHeight, pConv->nKernelHeight, pConv->nDilationHeight,
+                                           pConv->nInHeight);
+        int32_t nPaddedW = graph_total_pad(pConv->nOutWidth, pConv->nStrideWidth, pConv->nKernelWidth, pConv->nDilationWidth,
+                                           pConv->nInWidth);
+        int32_t nTotalH = graph_total_pad(pConv->nOutHeight, pConv->nStrideHeight, pConv->nKernelHeight, pConv->nDilationHeight,
+                                          pPadNode->nInHeight);
+        int32_t nTotalW = graph_total_pad(pConv->nOutWidth, pConv->nStrideWidth, pConv->nKernelWidth, pConv->nDilationWidth,
+                                          pPadNode->nInWidth);
+        if (pPadNode->nPadValue != -pConv->nInputOffset || nPaddedH != 0 || nPaddedW != 0 ||
+            (nTotalH >> 1) != pPadNode->nPadTop || (nTotalW >> 1) != pPadNode->nPadLeft)
+        {
+            continue;
+        }
+
+        pConv->nInHeight = pPadNode->nInHeight;
+        pConv->nInWidth = pPadNode->nInWidth;
+        pConv->nInputNode = pPadNode->nInputNode;
+        pPadNode->nOp = ADI_SHARCFX_OP_NONE;
+        pPadNode->nInputNode = -1;
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Conv + relu: the relu range narrows the activation range of the operator writing the output. Runs before the operator
+//fusions, so a relu after a 1x1 conv is already in the conv when it is fused into a depthconv
+static void graph_fuse_activation(ADI_SHARCFX_GRAPH* pGraph)
+{
+    for (int32_t i = 0; i < pGraph->nNodes; i++)
+    {
+        ADI_SHARCFX_GRAPH_NODE *pRelu = &pGraph->pNodes[i];
+        if (pRelu->nOp != ADI_SHARCFX_OP_RELU_INT8)
+        {
+            continue;
+        }
+        int32_t nProducer = graph_fusable_input(pGraph, i);
+        if (nProducer < 0)
+        {
+            continue;
+        }
+        ADI_SHARCFX_GRAPH_NODE *pProducer = &pGraph->pNodes[nProducer];
+        if (pProducer->nOp != ADI_SHARCFX_OP_CONV2D_INT8 && pProducer->nOp != ADI_SHARCFX_OP_DEPTHCONV2D_INT8 &&
+            pProducer->nOp != ADI_SHARCFX_OP_FULLY_CONNECTED_INT8)
+        {
+            continue;
+        }
+
+        pProducer->nActMin = MAX(pProducer->nActMin, pRelu->nActMin);
+        pProducer->nActMax = MIN(pProducer->nActMax, pRelu->nActMax);
+        graph_remove(pGraph, i, nProducer);
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Depthconv + 1x1 conv: the depthconv output is produced row by row into scratch and consumed by the 1x1 conv, so the
+//intermediate tensor is never stored
+static void graph_fuse_depthconv_pointwise(ADI_SHARCFX_GRAPH* pGraph)
+{
+    for (int32_t i = 0; i < pGraph->nNodes; i++)
+    {
+        ADI_SHARCFX_GRAPH_NODE *pPointwise = &pGraph->pNodes[i];
+        if (pPointwise->nOp != ADI_SHARCFX_OP_CONV2D_INT8 || !graph_is_pointwise(pPointwise))
+        {
+            continue;
+        }
+        int32_t nDepthconv = graph_fusable_input(pGraph, i);
+        if (nDepthconv < 0 || pGraph->pNodes[nDepthconv].nOp != ADI_SHARCFX_OP_DEPTHCONV2D_INT8)
+        {
+            continue;
+        }
+
+        pGraph->pNodes[nDepthconv].nOp = ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8;
+        pGraph->pNodes[nDepthconv].nFusedNode = i;
+        graph_remove(pGraph, i, nDepthconv);
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Fully connected + logistic: the logistic runs in place on the fully connected output, so no separate tensor is planned
+static void graph_fuse_logistic(ADI_SHARCFX_GRAPH* pGraph)
+{
+    for (int32_t i = 0; i < pGraph->nNodes; i++)
+    {
+        if (pGraph->pNodes[i].nOp != ADI_SHARCFX_OP_LOGISTIC_INT8)
+        {
+            continue;
+        }
+        int32_t nFc = graph_fusable_input(pGraph, i);
+        if (nFc < 0 || pGraph->pNodes[nFc].nOp != ADI_SHARCFX_OP_FULLY_CONNECTED_INT8)
+        {
+            continue;
+        }
+
+        pGraph->pNodes[nFc].nOp = ADI_SHARCFX_OP_FULLY_CONNECTED_LOGISTIC_INT8;
+        pGraph->pNodes[nFc].nFusedNode = i;
+        graph_remove(pGraph, i, nFc);
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Kernel of a convolution: the 1x1 kernel needs no scratch and no weight reordering but has no padding and saturates to
+//the full int8 range
+static int32_t graph_select_conv(const ADI_SHARCFX_GRAPH_NODE* pNode)
+{
+    if (graph_is_pointwise(pNode) && pNode->nFilterOffset == 0 && pNode->nActMin <= INT_8BIT_MIN && pNode->nActMax >= INT_8BIT_MAX)
+    {
+        return ADI_SHARCFX_KERNEL_GENERIC;
+    }
+    return ADI_SHARCFX_KERNEL_CONV2D_INT8;
+}
+
+/*UTILITY FUNCTION*/
+//Fast scratch of a fused depthconv and 1x1 conv: the 1x1 conv scratch, one depthconv output row and the input rows of
+//that row repeated for the depth multiplier
+static int32_t graph_depthconv_pointwise_scratch(const ADI_SHARCFX_GRAPH_NODE* pNodes,
+                                                 const ADI_SHARCFX_GRAPH_NODE* pNode,
+                                                 int32_t* pRowOffset,
+                                                 int32_t* pExpandOffset)
+{
+    const ADI_SHARCFX_GRAPH_NODE *pPointwise = &pNodes[pNode->nFusedNode];
+    ADI_SHARCFX_LAYER sLayer;
+
+    memset(&sLayer, 0, sizeof(sLayer));
+    sLayer.nKernel = ADI_SHARCFX_KERNEL_CONV2D_INT8;
+    sLayer.nKernelHeight = 1;
+    sLayer.nKernelWidth = 1;
+    sLayer.nInChannels = pPointwise->nInChannels;
+    sLayer.nOutChannels = pPointwise->nOutChannels;
+
+    int32_t nPointwise = (adi_sharcfx_scratch_size(&sLayer, NULL) + GRAPH_ALIGN - 1) & ~(GRAPH_ALIGN - 1);
+    int32_t nRow = (pNode->nOutWidth*pNode->nOutChannels + GRAPH_ALIGN - 1) & ~(GRAPH_ALIGN - 1);
+    int32_t nExpand = (pNode->nInChannels != pNode->nOutChannels) ? pNode->nKernelHeight*pNode->nInWidth*pNode->nOutChannels : 0;
+
+    *pRowOffset = nPointwise;
+    *pExpandOffset = nPointwise + nRow;
+    return nPointwise + nRow + nExpand;
+}
+
+/*UTILITY FUNCTION*/
+//Selects the kernel of a node and describes it to the memory planner
+static void graph_select_kernel(ADI_SHARCFX_GRAPH* pGraph,
+                                int32_t nNode)
+{
+    ADI_SHARCFX_GRAPH_NODE *pNode = &pGraph->pNodes[nNode];
+    ADI_SHARCFX_LAYER *pLayer = &pGraph->pLayers[nNode];
+    const ADI_SHARCFX_GRAPH_NODE *pOutputNode = pNode;
+    int32_t nRowOffset, nExpandOffset;
+
+    memset(pLayer, 0, sizeof(*pLayer));
+    pLayer->nInputLayer[0] = pNode->nInputNode;
+    pLayer->nInputLayer[1] = -1;
+    //removed nodes keep the kernel selected for the fused operator using their parameters
+    if (pNode->nOp == ADI_SHARCFX_OP_NONE)
+    {
+        return;
+    }
+    if (pNode->nOp == ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8)
+    {
+        pOutputNode = &pGraph->pNodes[pNode->nFusedNode];
+    }
+
+    pLayer->nBatches = 1;
+    pLayer->nInHeight = pNode->nInHeight;
+    pLayer->nInWidth = pNode->nInWidth;
+    pLayer->nInChannels = pNode->nInChannels;
+    pLayer->nOutHeight = pOutputNode->nOutHeight;
+    pLayer->nOutWidth = pOutputNode->nOutWidth;
+    pLayer->nOutChannels = pOutputNode->nOutChannels;
+    pLayer->nKernelHeight = pNode->nKernelHeight;
+    pLayer->nKernelWidth = pNode->nKernelWidth;
+    pLayer->nElementSize = sizeof(int8_t);
+
+    switch (pNode->nOp)
+    {
+        case ADI_SHARCFX_OP_CONV2D_INT8:
+            pNode->nKernel = graph_select_conv(pNode);
+            break;
+        case ADI_SHARCFX_OP_DEPTHCONV2D_INT8:
+            pNode->nKernel = ADI_SHARCFX_KERNEL_DEPTHCONV2D_INT8;
+            break;
+        case ADI_SHARCFX_OP_FULLY_CONNECTED_INT8:
+            pNode->nKernel = ADI_SHARCFX_KERNEL_FULLY_CONNECTED_INT8;
+            break;
+        case ADI_SHARCFX_OP_RELU_INT8:
+            pNode->nKernel = ADI_SHARCFX_KERNEL_ELEMENTWISE;
+            break;
+        case ADI_SHARCFX_OP_LOGISTIC_INT8:
+            pNode->nKernel = ADI_SHARCFX_KERNEL_LOGISTIC_INT8;
+            break;
+        case ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8:
+            pGraph->pNodes[pNode->nFusedNode].nKernel = graph_select_conv(&pGraph->pNodes[pNode->nFusedNode]);
+            pNode->nKernel = ADI_SHARCFX_KERNEL_GENERIC;
+            pLayer->nExtraScratch = graph_depthconv_pointwise_scratch(pGraph->pNodes, pNode, &nRowOffset, &nExpandOffset);
+            break;
+        case ADI_SHARCFX_OP_FULLY_CONNECTED_LOGISTIC_INT8:
+        {
+            ADI_SHARCFX_LAYER sLogistic = *pLayer;
+            sLogistic.nKernel = ADI_SHARCFX_KERNEL_LOGISTIC_INT8;
+            sLogistic.nInHeight = pNode->nOutHeight;
+            sLogistic.nInWidth = pNode->nOutWidth;
+            sLogistic.nInChannels = pNode->nOutChannels;
+            adi_sharcfx_scratch_size(&sLogistic, &pLayer->nExtraScratchL3);
+            pNode->nKernel = ADI_SHARCFX_KERNEL_FULLY_CONNECTED_INT8;
+            break;
+        }
+        default:
+            pNode->nKernel = ADI_SHARCFX_KERNEL_GENERIC;
+            break;
+    }
+    pLayer->nKernel = pNode->nKernel;
+}
+
+/*UTILITY FUNCTION*/
+//1x1 stride 1 convolution of nRows input rows, returns the kernel status
+static int32_t graph_pointwise_rows(const ADI_SHARCFX_GRAPH_NODE* pNode,
+                                    const int8_t* pInput,
+                                    int8_t* pOutput,
+                                    int32_t nRows,
+                                    const ADI_SHARCFX_CONTEXT* pContext)
+{
+    if (pNode->nKernel == ADI_SHARCFX_KERNEL_GENERIC)
+    {
+        adi_sharcfx_conv2d_kernel1x1_int8(pInput, pNode->pWeights, pNode->pBias, pOutput, 1,
+                                          pNode->nInChannels, pNode->nOutChannels, nRows*pNode->nInWidth,
+                                          pNode->pQuantizedMultiplier, pNode->pQuantizedShift,
+                                          pNode->nInputOffset, pNode->nOutputOffset);
+        return 0;
+    }
+    return adi_sharcfx_conv2d_specialized_int8_ctx(pInput, pNode->pWeights, pNode->pBias, pOutput, 1,
+                                                   pNode->nInChannels, pNode->nOutChannels, 1, 1, pNode->nOutChannels,
+                                                   pNode->nInWidth, nRows, 1, 1, 0, 0, nRows, pNode->nOutWidth,
+                                                   pNode->pQuantizedMultiplier, pNode->pQuantizedShift,
+                                                   pNode->nInputOffset, pNode->nOutputOffset, pNode->nFilterOffset,
+                                                   pNode->nActMin, pNode->nActMax, pContext);
+}
+
+/*UTILITY FUNCTION*/
+//Convolution of a node, returns the kernel status
+static int32_t graph_conv2d(const ADI_SHARCFX_GRAPH_NODE* pNode,
+                            const int8_t* pInput,
+                            int8_t* pOutput,
+                            const ADI_SHARCFX_CONTEXT* pContext)
+{
+    if (graph_is_pointwise(pNode))
+    {
+        return graph_pointwise_rows(pNode, pInput, pOutput, pNode->nInHeight, pContext);
+    }
+    else if (pNode->nDilationHeight == 1 && pNode->nDilationWidth == 1)
+    {
+        return adi_sharcfx_conv2d_specialized_int8_ctx(pInput, pNode->pWeights, pNode->pBias, pOutput, 1,
+                                                       pNode->nInChannels, pNode->nOutChannels, pNode->nKernelHeight,
+                                                       pNode->nKernelWidth, pNode->nOutChannels, pNode->nInWidth, pNode->nInHeight,
+                                                       pNode->nStrideHeight, pNode->nStrideWidth, 0, 0,
+                                                       pNode->nOutHeight, pNode->nOutWidth,
+                                                       pNode->pQuantizedMultiplier, pNode->pQuantizedShift,
+                                                       pNode->nInputOffset, pNode->nOutputOffset, pNode->nFilterOffset,
+                                                       pNode->nActMin, pNode->nActMax, pContext);
+    }
+    else
+    {
+        adi_sharcfx_conv2d_dilated_int8_ctx(pInput, pNode->pWeights, pNode->pBias, pOutput, 1,
+                                            pNode->nInChannels, pNode->nOutChannels, pNode->nKernelHeight,
+                                            pNode->nKernelWidth, pNode->nOutChannels, pNode->nInWidth, pNode->nInHeight,
+                                            pNode->nStrideHeight, pNode->nStrideWidth,
+                                            pNode->nDilationHeight, pNode->nDilationWidth,
+                                            pNode->nOutHeight, pNode->nOutWidth,
+                                            pNode->pQuantizedMultiplier, pNode->pQuantizedShift,
+                                            pNode->nInputOffset, pNode->nOutputOffset, pNode->nFilterOffset,
+                                            pNode->nActMin, pNode->nActMax, pContext);
+    }
+    return 0;
+}
+
+/*UTILITY FUNCTION*/
+//Depthconv of output rows [nRowStart, nRowEnd), written from the start of pOutput
+static void graph_depthconv_rows(const ADI_SHARCFX_GRAPH_NODE* pNode,
+                                 const int8_t* pInput,
+                                 int8_t* pOutput,
+                                 int32_t nRowStart,
+                                 int32_t nRowEnd,
+                                 int8_t* pScratch)
+{
+    adi_sharcfx_depthconv2d_strip_int8(pInput, pOutput, pNode->pWeights, pNode->pBias,
+                                       pNode->nInWidth, pNode->nInHeight, pNode->nOutChannels/pNode->nInChannels,
+                                       pNode->nInChannels, pNode->nOutChannels, pNode->nKernelWidth, pNode->nKernelHeight,
+                                       graph_total_pad(pNode->nOutWidth, pNode->nStrideWidth, pNode->nKernelWidth, 1, pNode->nInWidth),
+                                       graph_total_pad(pNode->nOutHeight, pNode->nStrideHeight, pNode->nKernelHeight, 1, pNode->nInHeight),
+                                       pNode->pQuantizedMultiplier, pNode->pQuantizedShift,
+                                       pNode->nInputOffset, pNode->nOutputOffset, pNode->nStrideWidth, pNode->nStrideHeight,
+                                       pNode->nActMin, pNode->nActMax, nRowStart, nRowEnd, pScratch);
+}
+
+/*UTILITY FUNCTION*/
+//Clamps to the activation range, can run in place
+static void graph_clamp_int8(const int8_t* pInput,
+                             int8_t* pOutput,
+                             int32_t nSize,
+                             int32_t nActMin,
+                             int32_t nActMax)
+{
+    xb_vec4Mx8 vin;
+    xb_vec4Mx8 vmin = nActMin;
+    xb_vec4Mx8 vmax = nActMax;
+    xb_vec4Mx8 *inp = (xb_vec4Mx8 *)pInput;
+    valign ina = PDX_LA_4MX8_PP(inp);
+    xb_vec4Mx8 *outp = (xb_vec4Mx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t i = 0; i < nSize; i += 4*PDX_M)
+    {
+        PDX_LA_4MX8_XP(vin, ina, inp, 4*PDX_M);
+        vin = PDX_MIN_4MX8(PDX_MAX_4MX8(vin, vmin), vmax);
+        PDX_SAV_4MX8_XP(vin, outa, outp, MIN(4*PDX_M, nSize - i));
+    }
+    PDX_SAPOS_4MX8_FP(outa, outp);//flush
+}
+
+/*UTILITY FUNCTION*/
+//Bytes of the weights, bias, multipliers and shifts a loaded node reads, and whether the operator needs them
+static void graph_parameter_sizes(const ADI_SHARCFX_GRAPH_NODE* pNode,
+                                  int64_t* pBytes,
+                                  int32_t* pRequired)
+{
+    int64_t nKernel = (int64_t)pNode->nKernelHeight*pNode->nKernelWidth;
+    int64_t nChannels = pNode->nOutChannels;
+
+    for (int32_t p = 0; p < GRAPH_PARAMETERS; p++)
+    {
+        pBytes[p] = 0;
+        pRequired[p] = 0;
+    }
+    switch (pNode->nOp)
+    {
+        case ADI_SHARCFX_OP_CONV2D_INT8:
+            pBytes[0] = nKernel*pNode->nInChannels*nChannels;
+            break;
+        case ADI_SHARCFX_OP_DEPTHCONV2D_INT8:
+            pBytes[0] = nKernel*nChannels;
+            break;
+        case ADI_SHARCFX_OP_FULLY_CONNECTED_INT8:
+            pBytes[0] = (int64_t)pNode->nInHeight*pNode->nInWidth*pNode->nInChannels*nChannels;
+            break;
+        case ADI_SHARCFX_OP_LOGISTIC_INT8:
+            pBytes[2] = pBytes[3] = sizeof(int32_t);
+            pRequired[2] = pRequired[3] = 1;
+            return;
+        default:
+            return;
+    }
+    //per channel bias and requantization, a single multiplier and shift for fully connected
+    pBytes[1] = nChannels*sizeof(int32_t);
+    pBytes[2] = pBytes[3] = (pNode->nOp == ADI_SHARCFX_OP_FULLY_CONNECTED_INT8) ? sizeof(int32_t) : pBytes[1];
+    pRequired[0] = pRequired[2] = pRequired[3] = 1;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_graph_load
+* @brief loads a serialized graph
+*
+* @details loads the nodes of a graph from its serialized description, e.g. read from a file on the host. The description
+* holds the # of nodes followed by ADI_SHARCFX_GRAPH_NODE_WORDS int32 words per node: the fields of ADI_SHARCFX_GRAPH_NODE
+* from nOp to nActMax in order, then the byte offsets of the weights, bias, multipliers and shifts in pParameters, -1 for none.
+* The description is validated before any node is used: operators must be unfused ADI_SHARCFX_OP_* operators, every node
+* reads the graph input (-1) or an earlier node, shapes are not negative, and the parameters an operator reads for its
+* shapes lie inside the blob, 4 byte aligned for the 32bit ones. Parameters an operator needs must be present.
+*
+* Parameters:
+* @param [in] nMaxNodes - # of entries of pNodes
+* @param [in] pDescription - serialized description
+* @param [in] nWords - # of int32 words of the description
+* @param [in] pParameters - parameter blob the nodes point into, 4 byte aligned, must outlive the graph
+* @param [in] nParametersSize - size of the parameter blob in bytes
+*
+* @param [out] pNodes - nodes
+*
+* @return # of nodes, -1 if the description is malformed or has more than nMaxNodes nodes
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_graph_load(ADI_SHARCFX_GRAPH_NODE* pNodes,
+                               int32_t nMaxNodes,
+                               const int32_t* pDescription,
+                               int32_t nWords,
+                               int8_t* pParameters,
+                               int32_t nParametersSize)
+{
+    if (nWords < 1)
+    {
+        return -1;
+    }
+    int32_t nNodes = pDescription[0];
+    if (nNodes < 0 || nNodes > nMaxNodes || nParametersSize < 0 ||
+        (int64_t)nWords != 1 + (int64_t)nNodes*ADI_SHARCFX_GRAPH_NODE_WORDS)
+    {
+        return -1;
+    }
+
+    for (int32_t i = 0; i < nNodes; i++)
+    {
+        ADI_SHARCFX_GRAPH_NODE *pNode = &pNodes[i];
+        const int32_t *pWords = pDescription + 1 + i*ADI_SHARCFX_GRAPH_NODE_WORDS;
+        int32_t *pFields[GRAPH_INT_FIELDS] = {&pNode->nOp, &pNode->nInputNode,
+                                              &pNode->nInHeight, &pNode->nInWidth, &pNode->nInChannels,
+                                              &pNode->nOutHeight, &pNode->nOutWidth, &pNode->nOutChannels,
+                                              &pNode->nKernelHeight, &pNode->nKernelWidth,
+                                              &pNode->nStrideHeight, &pNode->nStrideWidth,
+                                              &pNode->nDilationHeight, &pNode->nDilationWidth,
+                                              &pNode->nPadTop, &pNode->nPadBottom, &pNode->nPadLeft, &pNode->nPadRight,
+                                              &pNode->nPadValue, &pNode->nInputOffset, &pNode->nFilterOffset,
+                                              &pNode->nOutputOffset, &pNode->nActMin, &pNode->nActMax};
+
+        for (int32_t f = 0; f < GRAPH_INT_FIELDS; f++)
+        {
+            *pFields[f] = pWords[f];
+        }
+        //fused operators are only created by adi_sharcfx_graph_prepare
+        if (pNode->nOp < ADI_SHARCFX_OP_NONE || pNode->nOp > ADI_SHARCFX_OP_PAD_INT8 ||
+            pNode->nInputNode < -1 || pNode->nInputNode >= i)
+        {
+            return -1;
+        }
+        for (int32_t f = 0; f < GRAPH_SHAPE_FIELDS; f++)
+        {
+            if (*pFields[2 + f] < 0)
+            {
+                return -1;
+            }
+        }
+        if (pNode->nOp == ADI_SHARCFX_OP_DEPTHCONV2D_INT8 && pNode->nInChannels == 0)
+        {
+            return -1;
+        }
+
+        int64_t pBytes[GRAPH_PARAMETERS];
+        int32_t pRequired[GRAPH_PARAMETERS];
+        int8_t *pParameter[GRAPH_PARAMETERS];
+        graph_parameter_sizes(pNode, pBytes, pRequired);
+        pWords += GRAPH_INT_FIELDS;
+        for (int32_t p = 0; p < GRAPH_PARAMETERS; p++)
+        {
+            int32_t nOffset = pWords[p];
+            pParameter[p] = NULL;
+            if (nOffset == -1 && !pRequired[p])
+            {
+                continue;
+            }
+            //only the weights are bytes, the other parameters are 32bit
+            if (nOffset < 0 || nOffset + pBytes[p] > nParametersSize || (p > 0 && (nOffset & 3)))
+            {
+                return -1;
+            }
+            pParameter[p] = pParameters + nOffset;
+        }
+        pNode->pWeights = (const int8_t *)pParameter[0];
+        pNode->pBias = (const int32_t *)pParameter[1];
+        pNode->pQuantizedMultiplier = (int32_t *)pParameter[2];
+        pNode->pQuantizedShift = (int32_t *)pParameter[3];
+        pNode->nFusedNode = -1;
+        pNode->nKernel = ADI_SHARCFX_KERNEL_GENERIC;
+    }
+    return nNodes;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_graph_prepare
+* @brief prepares a graph for execution
+*
+* @details runs the fusion passes (pad + conv, conv/depthconv/fully connected + relu, depthconv + 1x1 conv, fully connected
+* + logistic), selects the kernel of every node and plans the fast and large arena with adi_sharcfx_plan_memory. Fused nodes are rewritten
+* in place and the nodes they absorb become ADI_SHARCFX_OP_NONE. Called once, adi_sharcfx_graph_run then executes the graph
+* from the arenas without allocation.
+*
+* Parameters:
+* @param [in] pNodes - nodes in execution order, rewritten by the fusion passes
+* @param [in] nNodes - # of nodes, the last node holds the graph output
+* @param [in] pLayers - planner layers, nNodes entries
+* @param [in] pPlans - arena placement, nNodes entries
+*
+* @param [out] pGraph - prepared graph
+*
+* @return large arena size in bytes, the fast arena size is in pGraph->nFastArenaSize, -1 if a node reads itself or a later node
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_graph_prepare(ADI_SHARCFX_GRAPH* pGraph,
+                                  ADI_SHARCFX_GRAPH_NODE* pNodes,
+                                  int32_t nNodes,
+                                  ADI_SHARCFX_LAYER* pLayers,
+                                  ADI_SHARCFX_LAYER_PLAN* pPlans)
+{
+    pGraph->pNodes = pNodes;
+    pGraph->nNodes = nNodes;
+    pGraph->nOutputNode = nNodes - 1;
+    pGraph->pLayers = pLayers;
+    pGraph->pPlans = pPlans;
+    pGraph->nArenaSize = -1;
+    pGraph->nFastArenaSize = -1;
+
+    for (int32_t i = 0; i < nNodes; i++)
+    {
+        ADI_SHARCFX_GRAPH_NODE *pNode = &pNodes[i];
+        if (pNode->nInputNode >= i)
+        {
+            return -1;
+        }
+        pNode->nStrideHeight = MAX(pNode->nStrideHeight, 1);
+        pNode->nStrideWidth = MAX(pNode->nStrideWidth, 1);
+        pNode->nDilationHeight = MAX(pNode->nDilationHeight, 1);
+        pNode->nDilationWidth = MAX(pNode->nDilationWidth, 1);
+        pNode->nFusedNode = -1;
+    }
+
+    //activations first, so a relu between a depthconv and a 1x1 conv does not block their fusion
+    graph_fuse_pad(pGraph);
+    graph_fuse_activation(pGraph);
+    graph_fuse_depthconv_pointwise(pGraph);
+    graph_fuse_logistic(pGraph);
+
+    for (int32_t i = 0; i < nNodes; i++)
+    {
+        graph_select_kernel(pGraph, i);
+    }
+    pGraph->nArenaSize = adi_sharcfx_plan_memory(pLayers, nNodes, pPlans, &pGraph->nFastArenaSize);
+    return pGraph->nArenaSize;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_graph_run
+* @brief executes a prepared graph
+*
+* @details executes the nodes of a graph prepared with adi_sharcfx_graph_prepare. Node outputs and kernel scratch are in the
+* arenas, so calls with different arenas can run concurrently.
+*
+* Parameters:
+* @param [in] pGraph - prepared graph
+* @param [in] pArena - large arena, pGraph->nArenaSize bytes, 8 byte aligned
+* @param [in] pFastArena - fast arena, pGraph->nFastArenaSize bytes, 8 byte aligned, usually in L1
+* @param [in] pInput - graph input
+*
+* @return graph output, in the large arena, or NULL if a kernel found its scratch too small
+*
+*******************************************************************************
+*/
+int8_t* adi_sharcfx_graph_run(const ADI_SHARCFX_GRAPH* pGraph,
+                              int8_t* pArena,
+                              int8_t* pFastArena,
+                              const int8_t* pInput)
+{
+    ADI_SHARCFX_CONTEXT sContext;
+    int32_t nStatus = 0;
+
+    for (int32_t i = 0; i < pGraph->nNodes; i++)
+    {
+        const ADI_SHARCFX_GRAPH_NODE *pNode = &pGraph->pNodes[i];
+        if (pNode->nOp == ADI_SHARCFX_OP_NONE)
+        {
+            continue;
+        }
+        const int8_t *pIn = (pNode->nInputNode < 0) ? pInput : pArena + pGraph->pPlans[pNode->nInputNode].nOutputOffset;
+        int8_t *pOut = pArena + pGraph->pPlans[i].nOutputOffset;
+        int32_t nInputSize = pNode->nInHeight*pNode->nInWidth*pNode->nInChannels;
+        adi_sharcfx_plan_context(&pGraph->pPlans[i], pArena, pFastArena, &sContext);
+
+        switch (pNode->nOp)
+        {
+            case ADI_SHARCFX_OP_CONV2D_INT8:
+                nStatus |= graph_conv2d(pNode, pIn, pOut, &sContext);
+                break;
+            case ADI_SHARCFX_OP_DEPTHCONV2D_INT8:
+                nStatus |= adi_sharcfx_depthconv2d_int8_ctx(pIn, pOut, pNode->pWeights, pNode->pBias,
+                                                            pNode->nInWidth, pNode->nInHeight, pNode->nOutChannels/pNode->nInChannels,
+                                                            pNode->nInChannels, pNode->nOutChannels, pNode->nKernelWidth, pNode->nKernelHeight,
+                                                            graph_total_pad(pNode->nOutWidth, pNode->nStrideWidth, pNode->nKernelWidth, 1, pNode->nInWidth),
+                                                            graph_total_pad(pNode->nOutHeight, pNode->nStrideHeight, pNode->nKernelHeight, 1, pNode->nInHeight),
+                                                            pNode->pQuantizedMultiplier, pNode->pQuantizedShift,
+                                                            pNode->nInputOffset, pNode->nOutputOffset, pNode->nStrideWidth, pNode->nStrideHeight,
+                                                            pNode->nActMin, pNode->nActMax, &sContext);
+                break;
+            case ADI_SHARCFX_OP_FULLY_CONNECTED_INT8:
+            case ADI_SHARCFX_OP_FULLY_CONNECTED_LOGISTIC_INT8:
+                adi_sharcfx_fully_connected_int8(pIn, pNode->pWeights, pNode->pBias, pOut, nInputSize, pNode->nOutChannels, 1,
+                                                 (uint32_t)pNode->pQuantizedMultiplier[0], pNode->pQuantizedShift[0],
+                                                 pNode->nInputOffset, pNode->nFilterOffset, pNode->nOutputOffset,
+                                                 pNode->nActMin, pNode->nActMax);
+                if (pNode->nOp == ADI_SHARCFX_OP_FULLY_CONNECTED_LOGISTIC_INT8)
+                {
+                    const ADI_SHARCFX_GRAPH_NODE *pLogistic = &pGraph->pNodes[pNode->nFusedNode];
+                    nStatus |= adi_sharcfx_logistic_int8_ctx(pLogistic->nInputOffset, pLogistic->pQuantizedMultiplier[0],
+                                                             pLogistic->pQuantizedShift[0], pNode->nOutChannels, pOut, pOut,
+                                                             &sContext);
+                }
+                break;
+            case ADI_SHARCFX_OP_RELU_INT8:
+                graph_clamp_int8(pIn, pOut, nInputSize, pNode->nActMin, pNode->nActMax);
+                break;
+            case ADI_SHARCFX_OP_LOGISTIC_INT8:
+                nStatus |= adi_sharcfx_logistic_int8_ctx(pNode->nInputOffset, pNode->pQuantizedMultiplier[0],
+                                                         pNode->pQuantizedShift[0], nInputSize, pIn, pOut, &sContext);
+                break;
+            case ADI_SHARCFX_OP_PAD_INT8:
+                adi_sharcfx_pad_int8(pIn, pOut, 1, pNode->nInHeight, pNode->nInWidth, pNode->nInChannels,
+                                     pNode->nPadTop, pNode->nPadBottom, pNode->nPadLeft, pNode->nPadRight, pNode->nPadValue);
+                break;
+            case ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8:
+            {
+                const ADI_SHARCFX_GRAPH_NODE *pPointwise = &pGraph->pNodes[pNode->nFusedNode];
+                int32_t nRowOffset, nExpandOffset;
+                graph_depthconv_pointwise_scratch(pGraph->pNodes, pNode, &nRowOffset, &nExpandOffset);
+                int8_t *pRow = sContext.pScratch + nRowOffset;
+                int8_t *pExpand = sContext.pScratch + nExpandOffset;
+                sContext.nScratchSize = nRowOffset;
+
+                for (int32_t nRow = 0; nRow < pNode->nOutHeight; nRow++)
+                {
+                    graph_depthconv_rows(pNode, pIn, pRow, nRow, nRow + 1, pExpand);
+                    nStatus |= graph_pointwise_rows(pPointwise, pRow,
+                                                    pOut + nRow*pPointwise->nOutWidth*pPointwise->nOutChannels, 1, &sContext);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+    return nStatus ? NULL : pArena + pGraph->pPlans[pGraph->nOutputNode].nOutputOffset;
+}
@@ -0,0 +1,373 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_gru.cpp
+*
+* @brief: contains optimized version of the GRU cell
+*
+* @details: contains optimized single step GRU cell for 8bit and 16bit integer input with 16bit hidden state
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= D E F I N E S =============*/
+#define GRU_NUM_GATES       3       /*update(z), reset(r) and candidate(n), in this order in weights and biases*/
+#define GRU_GATE_MULTIPLIER 0       /*Q3.12 gate inputs have a power of two scale, 0 selects the 3<<shift input expansion*/
+#define GRU_GATE_SHIFT      0       /*input left shift of Q3.12: 15 - 3 integer bits - 12 fraction bits*/
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Requantize a gate matmul output (doubled products + doubled bias) to the Q3.12 format used by the 16bit sigmoid/tanh
+inline int16_t gru_requantize_q3_12(xb_int40 sat_sum,
+                                    int32_t nQuantizedMultiplier,
+                                    int32_t nQuantizedShift)
+{
+    xb_int32 temp;
+    xb_int80 product;
+
+    sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+    sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+    temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+    product = PDX_MULW_32(temp, (xb_int32)nQuantizedMultiplier);    //product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+    product = PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+    temp = PDX_PACKQSRV_80(product,ROUNDING_MODE_2);                //packs 80bit product into 32bit var with saturation and rounding
+    temp = MIN(temp, (xb_int32)INT_16BIT_MAX);
+    temp = MAX(temp, (xb_int32)INT_16BIT_MIN);
+    return (int16_t)((int32_t)temp);
+}
+
+/*UTILITY FUNCTION*/
+//Hidden state matmul, gate nonlinearities and blend for one batch. pGateX holds the 3*nHiddenSize Q3.12 input contributions
+//and is reused as scratch. The updated state overwrites pHiddenState
+void gru_step_hidden(const int8_t* pWeightsHidden,
+                     const int32_t* pBiasHidden,
+                     const int32_t* pQuantizedMultiplierHidden,
+                     const int32_t* pQuantizedShiftHidden,
+                     int16_t* pHiddenState,
+                     int16_t* pGateX,
+                     int32_t nHiddenSize)
+{
+    int16_t *pGateH = pGateX + GRU_NUM_GATES*nHiddenSize;       //hidden contributions, Q3.12
+    int16_t *pZR = pGateH + GRU_NUM_GATES*nHiddenSize;          //update and reset gates, Q0.15
+    xb_vec2Mx16 vZero = 0;
+    xb_vec2Mx40 acc;
+    xb_int40 sat_sum;
+
+    //Fused update, reset and candidate matmul on the previous hidden state
+    for (int32_t nRow = 0; nRow < GRU_NUM_GATES*nHiddenSize; nRow++)
+    {
+        int32_t nGate = nRow / nHiddenSize;
+        acc = fully_connected_int16_mac(pHiddenState, pWeightsHidden + nRow*nHiddenSize, nHiddenSize, vZero, vZero);
+        sat_sum = PDX_RADD_2MX40(acc);
+        if (pBiasHidden)
+        {
+            sat_sum += ((xb_int40)pBiasHidden[nRow])<<1;   //bias<<1 to match the doubled products
+        }
+        pGateH[nRow] = gru_requantize_q3_12(sat_sum, pQuantizedMultiplierHidden[nGate], pQuantizedShiftHidden[nGate]);
+    }
+
+    xb_vec2Mx16 vx, vh, vr, vz, vn;
+    xb_vec2Mx40 w;
+    valign ax, ah, ar, az, an, outa;
+    xb_vec2Mx16 *px, *ph, *pr, *pz, *pn, *pout;
+    int32_t nBytes;
+
+    //z and r pre-activations: saturating sum of both contributions, written over the input contributions
+    px = (xb_vec2Mx16 *)pGateX;
+    ph = (xb_vec2Mx16 *)pGateH;
+    pout = (xb_vec2Mx16 *)pGateX;
+    ax = PDX_LA_2MX16_PP(px);
+    ah = PDX_LA_2MX16_PP(ph);
+    outa = PDX_Z_ALIGN();
+    nBytes = 2*nHiddenSize*sizeof(int16_t);
+    for (int32_t n = 0; n < 2*nHiddenSize; n += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vx, ax, px, nBytes);
+        PDX_LAV_2MX16_XP(vh, ah, ph, nBytes);
+        PDX_SAV_2MX16_XP(PDX_ADDS_2MX16(vx, vh), outa, pout, nBytes);
+        nBytes -= PDX_4M;
+    }
+    PDX_SAPOS_2MX16_FP(outa, pout);
+    adi_sharcfx_logistic_int16(GRU_GATE_MULTIPLIER, GRU_GATE_SHIFT, 2*nHiddenSize, pGateX, pZR);
+
+    //candidate pre-activation: x_n + r*h_n, computed as (x_n*32768 + r*h_n)>>15 with rounding
+    px = (xb_vec2Mx16 *)(pGateX + 2*nHiddenSize);
+    ph = (xb_vec2Mx16 *)(pGateH + 2*nHiddenSize);
+    pr = (xb_vec2Mx16 *)(pZR + nHiddenSize);
+    pout = (xb_vec2Mx16 *)(pGateX + 2*nHiddenSize);
+    ax = PDX_LA_2MX16_PP(px);
+    ah = PDX_LA_2MX16_PP(ph);
+    ar = PDX_LA_2MX16_PP(pr);
+    outa = PDX_Z_ALIGN();
+    nBytes = nHiddenSize*sizeof(int16_t);
+    for (int32_t n = 0; n < nHiddenSize; n += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vx, ax, px, nBytes);
+        PDX_LAV_2MX16_XP(vh, ah, ph, nBytes);
+        PDX_LAV_2MX16_XP(vr, ar, pr, nBytes);
+        w = PDX_MULW_2MX16(vr, vh);
+        PDX_MULAW_2MX16(w, vx, INT_16BIT_MAX);
+        PDX_MULAW_2MX16(w, vx, 1);
+        w = PDX_ADD_2MX40(w, 1<<14);
+        PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(w, 15), outa, pout, nBytes);
+        nBytes -= PDX_4M;
+    }
+    PDX_SAPOS_2MX16_FP(outa, pout);
+    //candidate gate goes to the start of the hidden contributions, which are no longer needed
+    adi_sharcfx_tanh_int16(GRU_GATE_MULTIPLIER, GRU_GATE_SHIFT, nHiddenSize, pGateX + 2*nHiddenSize, pGateH);
+
+    //blend: h' = z*h + (1-z)*n = z*h - z*n + 32768*n, rounded back to Q0.15
+    ph = (xb_vec2Mx16 *)pHiddenState;
+    pz = (xb_vec2Mx16 *)pZR;
+    pn = (xb_vec2Mx16 *)pGateH;
+    pout = (xb_vec2Mx16 *)pHiddenState;
+    ah = PDX_LA_2MX16_PP(ph);
+    az = PDX_LA_2MX16_PP(pz);
+    an = PDX_LA_2MX16_PP(pn);
+    outa = PDX_Z_ALIGN();
+    nBytes = nHiddenSize*sizeof(int16_t);
+    for (int32_t n = 0; n < nHiddenSize; n += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vh, ah, ph, nBytes);
+        PDX_LAV_2MX16_XP(vz, az, pz, nBytes);
+        PDX_LAV_2MX16_XP(vn, an, pn, nBytes);
+        w = PDX_MULW_2MX16(vz, vh);
+        PDX_MULAW_2MX16(w, PDX_NEG_2MX16(vz), vn);
+        PDX_MULAW_2MX16(w, vn, INT_16BIT_MAX);
+        PDX_MULAW_2MX16(w, vn, 1);
+        w = PDX_ADD_2MX40(w, 1<<14);
+        PDX_SAV_2MX16_XP(PDX_PACKSIV_2MX40(w, 15), outa, pout, nBytes);
+        nBytes -= PDX_4M;
+    }
+    PDX_SAPOS_2MX16_FP(outa, pout);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_gru_int8_ctx
+* @brief optimized GRU cell
+*
+* @details optimized single time step of a GRU cell for 8-bit integer input and 16-bit Q0.15 hidden state.
+* z = sigmoid(Wz*x + Uz*h + b), r = sigmoid(Wr*x + Ur*h + b), n = tanh(Wn*x + b + r*(Un*h + b)), h = z*h + (1-z)*n.
+* The three gate matmuls on x and on h are each done in one pass, gate pre-activations are requantized to Q3.12 and
+* the nonlinearities and the blend run in one pass over the hidden state, which stays in caller memory across frames.
+* The gate nonlinearities are the int16 logistic and tanh kernels.
+* The gate state takes 16*nHiddenSize bytes of large scratch, -1 is returned if it does not fit.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [batch][input size]
+* @param [in] pWeightsInput - input weights, [3][hidden size][input size], gates ordered z, r, n
+* @param [in] pWeightsHidden - recurrent weights, [3][hidden size][hidden size], gates ordered z, r, n
+* @param [in] pBiasInput - input bias, [3][hidden size], can be NULL
+* @param [in] pBiasHidden - recurrent bias, [3][hidden size], can be NULL
+* @param [in] nBatches - batch size
+* @param [in] nInputSize - input depth
+* @param [in] nHiddenSize - # of hidden units
+* @param [in] nInputOffset - input offset (negated input zeropoint)
+* @param [in] pQuantizedMultiplierInput - per gate multiplier from input matmul to Q3.12
+* @param [in] pQuantizedShiftInput - per gate shift from input matmul to Q3.12
+* @param [in] pQuantizedMultiplierHidden - per gate multiplier from recurrent matmul to Q3.12
+* @param [in] pQuantizedShiftHidden - per gate shift from recurrent matmul to Q3.12
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [in,out] pHiddenState - hidden state in Q0.15, [batch][hidden size], updated in place
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_gru_int8_ctx(const int8_t* pInputBuffer,
+                                 const int8_t* pWeightsInput,
+                                 const int8_t* pWeightsHidden,
+                                 const int32_t* pBiasInput,
+                                 const int32_t* pBiasHidden,
+                                 int16_t* pHiddenState,
+                                 int32_t nBatches,
+                                 int32_t nInputSize,
+                                 int32_t nHiddenSize,
+                                 int32_t nInputOffset,
+                                 const int32_t* pQuantizedMultiplierInput,
+                                 const int32_t* pQuantizedShiftInput,
+                                 const int32_t* pQuantizedMultiplierHidden,
+                                 const int32_t* pQuantizedShiftHidden,
+                                 const ADI_SHARCFX_CONTEXT* pContext)
+{
+    //input and hidden contributions of the 3 gates and the 2 sigmoid gates, in whole vectors
+    int32_t nStateBytes = (int32_t)(((2*GRU_NUM_GATES + 2)*nHiddenSize + 2*PDX_M - 1)/(2*PDX_M)*2*PDX_M*sizeof(int16_t));
+    if (nStateBytes > get_scratch_l3_size(pContext, (int32_t)sizeof(nQFormatBuffer)))
+    {
+        return -1;
+    }
+    int16_t* pGateX = (int16_t*)get_scratch_l3(pContext, (int8_t*)nQFormatBuffer);
+    xb_vec2Mx16 vInZP = nInputOffset;
+    xb_vec2Mx16 vFilterZP = 0;
+    xb_vec2Mx40 acc;
+    xb_int40 sat_sum;
+
+    for (int32_t b = 0; b < nBatches; b++)
+    {
+        //Fused update, reset and candidate matmul on the input
+        for (int32_t nRow = 0; nRow < GRU_NUM_GATES*nHiddenSize; nRow++)
+        {
+            int32_t nGate = nRow / nHiddenSize;
+            acc = fully_connected_int8_mac(pInputBuffer + b*nInputSize, pWeightsInput + nRow*nInputSize, nInputSize, vInZP, vFilterZP);
+            sat_sum = PDX_RADD_2MX40(acc);
+            if (pBiasInput)
+            {
+                sat_sum += ((xb_int40)pBiasInput[nRow])<<1;   //bias<<1 to match the doubled products
+            }
+            pGateX[nRow] = gru_requantize_q3_12(sat_sum, pQuantizedMultiplierInput[nGate], pQuantizedShiftInput[nGate]);
+        }
+
+        gru_step_hidden(pWeightsHidden, pBiasHidden,
+                        pQuantizedMultiplierHidden, pQuantizedShiftHidden,
+                        pHiddenState + b*nHiddenSize, pGateX, nHiddenSize);
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_gru_int8
+* @brief adi_sharcfx_gru_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_gru_int8_ctx without context and returns its status. Calls share the static scratch of the
+* library, so they must not run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_gru_int8(const int8_t* pInputBuffer,
+                             const int8_t* pWeightsInput,
+                             const int8_t* pWeightsHidden,
+                             const int32_t* pBiasInput,
+                             const int32_t* pBiasHidden,
+                             int16_t* pHiddenState,
+                             int32_t nBatches,
+                             int32_t nInputSize,
+                             int32_t nHiddenSize,
+                             int32_t nInputOffset,
+                             const int32_t* pQuantizedMultiplierInput,
+                             const int32_t* pQuantizedShiftInput,
+                             const int32_t* pQuantizedMultiplierHidden,
+                             const int32_t* pQuantizedShiftHidden)
+{
+    return adi_sharcfx_gru_int8_ctx(pInputBuffer, pWeightsInput, pWeightsHidden, pBiasInput, pBiasHidden, pHiddenState,
+                                    nBatches, nInputSize, nHiddenSize, nInputOffset, pQuantizedMultiplierInput,
+                                    pQuantizedShiftInput, pQuantizedMultiplierHidden, pQuantizedShiftHidden, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_gru_int16_ctx
+* @brief optimized GRU cell
+*
+* @details optimized single time step of a GRU cell for 16-bit integer input and 16-bit Q0.15 hidden state.
+* Same cell as adi_sharcfx_gru_int8, the input matmul uses the 16x8 fully connected MAC core with a zero input offset.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [batch][input size]
+* @param [in] pWeightsInput - input weights, [3][hidden size][input size], gates ordered z, r, n
+* @param [in] pWeightsHidden - recurrent weights, [3][hidden size][hidden size], gates ordered z, r, n
+* @param [in] pBiasInput - input bias, [3][hidden size], can be NULL
+* @param [in] pBiasHidden - recurrent bias, [3][hidden size], can be NULL
+* @param [in] nBatches - batch size
+* @param [in] nInputSize - input depth
+* @param [in] nHiddenSize - # of hidden units
+* @param [in] pQuantizedMultiplierInput - per gate multiplier from input matmul to Q3.12
+* @param [in] pQuantizedShiftInput - per gate shift from input matmul to Q3.12
+* @param [in] pQuantizedMultiplierHidden - per gate multiplier from recurrent matmul to Q3.12
+* @param [in] pQuantizedShiftHidden - per gate shift from recurrent matmul to Q3.12
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [in,out] pHiddenState - hidden state in Q0.15, [batch][hidden size], updated in place
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_gru_int16_ctx(const int16_t* pInputBuffer,
+                                  const int8_t* pWeightsInput,
+                                  const int8_t* pWeightsHidden,
+                                  const int32_t* pBiasInput,
+                                  const int32_t* pBiasHidden,
+                                  int16_t* pHiddenState,
+                                  int32_t nBatches,
+                                  int32_t nInputSize,
+                                  int32_t nHiddenSize,
+                                  const int32_t* pQuantizedMultiplierInput,
+                                  const int32_t* pQuantizedShiftInput,
+                                  const int32_t* pQuantizedMultiplierHidden,
+                                  const int32_t* pQuantizedShiftHidden,
+                                  const ADI_SHARCFX_CONTEXT* pContext)
+{
+    //input and hidden contributions of the 3 gates and the 2 sigmoid gates, in whole vectors
+    int32_t nStateBytes = (int32_t)(((2*GRU_NUM_GATES + 2)*nHiddenSize + 2*PDX_M - 1)/(2*PDX_M)*2*PDX_M*sizeof(int16_t));
+    if (nStateBytes > get_scratch_l3_size(pContext, (int32_t)sizeof(nQFormatBuffer)))
+    {
+        return -1;
+    }
+    int16_t* pGateX = (int16_t*)get_scratch_l3(pContext, (int8_t*)nQFormatBuffer);
+    xb_vec2Mx16 vZero = 0;
+    xb_vec2Mx40 acc;
+    xb_int40 sat_sum;
+
+    for (int32_t b = 0; b < nBatches; b++)
+    {
+        //Fused update, reset and candidate matmul on the input
+        for (int32_t nRow = 0; nRow < GRU_NUM_GATES*nHiddenSize; nRow++)
+        {
+            int32_t nGate = nRow / nHiddenSize;
+            acc = fully_connected_int16_mac(pInputBuffer + b*nInputSize, pWeightsInput + nRow*nInputSize, nInputSize, vZero, vZero);
+            sat_sum = PDX_RADD_2MX40(acc);
+            if (pBiasInput)
+            {
+                sat_sum += ((xb_int40)pBiasInput[nRow])<<1;   //bias<<1 to match the doubled products
+            }
+            pGateX[nRow] = gru_requantize_q3_12(sat_sum, pQuantizedMultiplierInput[nGate], pQuantizedShiftInput[nGate]);
+        }
+
+        gru_step_hidden(pWeightsHidden, pBiasHidden,
+                        pQuantizedMultiplierHidden, pQuantizedShiftHidden,
+                        pHiddenState + b*nHiddenSize, pGateX, nHiddenSize);
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_gru_int16
+* @brief adi_sharcfx_gru_int16_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_gru_int16_ctx without context and returns its status. Calls share the static scratch of the
+* library, so they must not run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_gru_int16(const int16_t* pInputBuffer,
+                              const int8_t* pWeightsInput,
+                              const int8_t* pWeightsHidden,
+                              const int32_t* pBiasInput,
+                              const int32_t* pBiasHidden,
+                              int16_t* pHiddenState,
+                              int32_t nBatches,
+                              int32_t nInputSize,
+                              int32_t nHiddenSize,
+                              const int32_t* pQuantizedMultiplierInput,
+                              const int32_t* pQuantizedShiftInput,
+                              const int32_t* pQuantizedMultiplierHidden,
+                              const int32_t* pQuantizedShiftHidden)
+{
+    return adi_sharcfx_gru_int16_ctx(pInputBuffer, pWeightsInput, pWeightsHidden, pBiasInput, pBiasHidden, pHiddenState,
+                                     nBatches, nInputSize, nHiddenSize, pQuantizedMultiplierInput, pQuantizedShiftInput,
+                                     pQuantizedMultiplierHidden, pQuantizedShiftHidden, NULL);
+}
@@ -0,0 +1,97 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_internal.h
+*
+* @brief: internal header file for the optimized kernel files
+*
+* @details: contains the prototypes of the utility functions shared between kernel files. Not part of the public interface
+* and not copied to Include.
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+#ifndef __ADI_SHARCFX_INTERNAL_H__
+#define __ADI_SHARCFX_INTERNAL_H__
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_nn.h"
+
+/*============= F U N C T I O N P R O T O T Y P E S =============*/
+/*Requantization and store of 2*PDX_M per channel accumulators, adi_sharcfx_conv2d.cpp*/
+void quantize_and_store_channels(xb_vec2Mx40 acc,
+                                 const int32_t *pBiasBuffer,
+                                 const int32_t *pQuantizedMultiplier,
+                                 const int32_t *pQuantizedShift,
+                                 int32_t nChannels,
+                                 xb_vecMx32 vOutZP,
+                                 xb_vecMx32 vmin,
+                                 xb_vecMx32 vmax,
+                                 xb_vecMx8* &outp,
+                                 valign &outa);
+
+void quantize_and_store_channels_int16(xb_vec2Mx40 acc,
+                                       const int32_t *pBiasBuffer,
+                                       const int32_t *pQuantizedMultiplier,
+                                       const int32_t *pQuantizedShift,
+                                       int32_t nChannels,
+                                       xb_vecMx32 vmin,
+                                       xb_vecMx32 vmax,
+                                       xb_vecMx16* &outp,
+                                       valign &outa);
+
+void quantize_and_store_channels_16x8(xb_vec2Mx40 acc,
+                                      const int32_t *pBiasHigh,
+                                      const int32_t *pBiasLow,
+                                      const int32_t *pQuantizedMultiplier,
+                                      const int32_t *pQuantizedShift,
+                                      int32_t nChannels,
+                                      xb_vecMx32 vmin,
+                                      xb_vecMx32 vmax,
+                                      xb_vecMx16* &outp,
+                                      valign &outa);
+
+void split_bias_int64(const int64_t *pBiasBuffer,
+                      int32_t *pBiasHigh,
+                      int32_t *pBiasLow,
+                      int32_t nChannels);
+
+/*Weight reordering of the dilation 1 conv, adi_sharcfx_conv2d.cpp*/
+void transform_weights(int8_t* pOldBuffer,
+                       int8_t* pNewBuffer,
+                       int32_t nKernelH,
+                       int32_t nKernelW,
+                       int32_t nKernelCh,
+                       int32_t nNumKernels);
+
+/*MAC cores of one filter row, adi_sharcfx_fully_connected.cpp*/
+xb_vec2Mx40 fully_connected_int8_mac(const int8_t* pInputBuffer,
+                                     const int8_t* pWeightsBuffer,
+                                     int32_t nFilterDepth,
+                                     xb_vec2Mx16 vInZP,
+                                     xb_vec2Mx16 vFilterZP);
+
+xb_vec2Mx40 fully_connected_int16_mac(const int16_t* pInputBuffer,
+                                      const int8_t* pWeightsBuffer,
+                                      int32_t nFilterDepth,
+                                      xb_vec2Mx16 vInZP,
+                                      xb_vec2Mx16 vFilterZP);
+
+xb_vec2Mx40 fully_connected_int4_mac(const int8_t* pInputBuffer,
+                                     const int8_t* pPackedWeights,
+                                     int32_t nFilterDepth,
+                                     xb_vec2Mx16 vInZP);
+
+xb_vec2Mx40 fully_connected_sparse_mac(const int8_t* pInputBuffer,
+                                       const int16_t* pBlockIdx,
+                                       const int8_t* pValues,
+                                       int32_t nBlocks,
+                                       int32_t nFilterDepth,
+                                       xb_vec2Mx16 vInZP);
+
+#endif /* __ADI_SHARCFX_INTERNAL_H__ */
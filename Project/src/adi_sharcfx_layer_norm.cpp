@@ -0,0 +1,388 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_layer_norm.cpp
+*
+* @brief: contains optimized version of layer normalization
+*
+* @details: contains optimized layer normalization and RMS normalization for 8bit and 16bit integer input
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= D E F I N E S =============*/
+#define LAYER_NORM_FLUSH_VECTORS        16      /*# of 16bit vectors accumulated in 40bit lanes before the partial sums are moved to 64bit*/
+#define LAYER_NORM_RSQRT_ITERATIONS     4       /*Newton iterations of the reciprocal square root, from a linear first estimate*/
+#define LAYER_NORM_OUTPUT_FRAC_BITS     11      /*normalized values are kept in Q4.11 between the normalize and affine passes*/
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Fixed point reciprocal square root of a positive 64bit value.
+//Returns M in Q29 and sets *pShift to k such that 1/sqrt(nValue) = M * 2^(k-60)
+inline int32_t layer_norm_rsqrt(int64_t nValue,
+                                int32_t *pShift)
+{
+    int32_t k = 0;
+
+    //normalize with an even shift into [2^60, 2^62), i.e. [0.25, 1) in Q62
+    while (nValue < ((int64_t)1 << 60))
+    {
+        nValue <<= 2;
+        k++;
+    }
+    int64_t nX = nValue >> 32;                          //Q30
+    int64_t nR = 1252698795 - (nX*2)/3;                 //Q29, 7/3 - 4x/3 is exact at both ends of the range
+
+    for (int32_t i = 0; i < LAYER_NORM_RSQRT_ITERATIONS; i++)
+    {
+        int64_t nR2 = (nR*nR) >> 29;                    //Q29
+        int64_t nT = ((int64_t)3 << 29) - ((nX*nR2) >> 30);
+        nR = (nR*nT) >> 30;                             //r*(3 - x*r*r)/2
+    }
+    *pShift = k;
+    return (int32_t)nR;
+}
+
+/*UTILITY FUNCTION*/
+//Normalize one row of 16bit values (input offset already applied) to Q4.11.
+//Sum and sum of squares are computed in one pass, the centered value N*x - sum is then scaled by 1/sqrt(N*sumsq - sum^2),
+//which equals (x - mean)/sqrt(variance) without any division
+void layer_norm_normalize(const int16_t *pInput,
+                          int16_t *pNorm,
+                          int32_t nSize,
+                          int32_t nRmsNorm,
+                          int32_t nEpsilon)
+{
+    int64_t nSum = 0, nSumSq = 0;
+    xb_vec2Mx16 vd;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx40 accSum, accSumSq;
+
+    xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pInput;
+    valign ina = PDX_LA_2MX16_PP(inp);
+    int32_t nBytesLeft = nSize*sizeof(int16_t);
+    int32_t n = 0;
+
+    while (n < nSize)
+    {
+        accSum = 0;
+        accSumSq = 0;
+        for (int32_t v = 0; v < LAYER_NORM_FLUSH_VECTORS && n < nSize; v++, n += 2*PDX_M)
+        {
+            PDX_LAV_2MX16_XP(vd, ina, inp, nBytesLeft);    //lanes past nSize are loaded as 0
+            nBytesLeft -= PDX_4M;
+            PDX_MULAW_2MX16(accSum, vd, vOne);
+            PDX_MULAW_2MX16(accSumSq, vd, vd);
+        }
+        nSum += (int64_t)PDX_CVT64_40(PDX_RADD_2MX40(accSum));
+        nSumSq += (int64_t)PDX_CVT64_40(PDX_RADD_2MX40(accSumSq));
+    }
+    if (nRmsNorm)
+    {
+        nSum = 0;      //RMS normalization does not center
+    }
+
+    //N^2 * (variance + epsilon)
+    int64_t nDenominator = (int64_t)nSize*nSumSq - nSum*nSum + (int64_t)nSize*nSize*nEpsilon;
+    nDenominator = MAX(nDenominator, (int64_t)1);
+    int32_t k;
+    int32_t nMult = layer_norm_rsqrt(nDenominator, &k);
+    //z = c * M * 2^(k-60) * 2^11 and PDX_PACKQSRV_MX80 divides by 2^32
+    int32_t nShift = k - 60 + LAYER_NORM_OUTPUT_FRAC_BITS + 32;
+
+    xb_vec2Mx16 vSize = nSize;
+    xb_vec2Mx40 vSum = (xb_vec2Mx40)((int32_t)nSum);
+    xb_vecMx32 vMult = nMult;
+    xb_vecMx32 vShift = nShift;
+    xb_vecMx32 vmin = INT_16BIT_MIN;
+    xb_vecMx32 vmax = INT_16BIT_MAX;
+    xb_vec2Mx40 vmax32bit = (xb_vec2Mx40)INT_32BIT_MAX;
+    xb_vec2Mx40 vmin32bit = (xb_vec2Mx40)INT_32BIT_MIN;
+    vbool2M greater_than32bit, lesser_than32bit;
+    xb_vecMx32 first8, last8, norm_out;
+    xb_vecMx80 quant_acc;
+    xb_vec2Mx40 acc;
+
+    inp = (xb_vec2Mx16 *)pInput;
+    ina = PDX_LA_2MX16_PP(inp);
+    xb_vecMx16 *outp = (xb_vecMx16 *)pNorm;
+    valign outa = PDX_Z_ALIGN();
+
+    for (n = 0; n < nSize; n += 2*PDX_M)
+    {
+        PDX_LA_2MX16_XP(vd, ina, inp, 2*PDX_M*sizeof(int16_t));
+        acc = PDX_MULW_2MX16(vd, vSize);
+        acc -= vSum;                                        //N*x - sum
+
+        greater_than32bit = PDX_GT_2MX40(acc, vmax32bit);
+        lesser_than32bit = PDX_LT_2MX40(acc, vmin32bit);
+        acc = PDX_MOV_2MX40_T(vmax32bit, acc, greater_than32bit);
+        acc = PDX_MOV_2MX40_T(vmin32bit, acc, lesser_than32bit);
+        PDX_CVT32D_2MX40(last8, first8, acc);
+
+        quant_acc = vMult * first8;
+        quant_acc = PDX_SLS_MX80(quant_acc, vShift);
+        norm_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);
+        norm_out = PDX_MIN_MX32(norm_out, vmax);
+        norm_out = PDX_MAX_MX32(norm_out, vmin);
+        PDX_SAV32_MX16_XP(norm_out, outa, outp, MIN(nSize - n, PDX_M)*sizeof(int16_t));
+
+        if (nSize - n > PDX_M)
+        {
+            quant_acc = vMult * last8;
+            quant_acc = PDX_SLS_MX80(quant_acc, vShift);
+            norm_out = PDX_PACKQSRV_MX80(quant_acc, ROUNDING_MODE);
+            norm_out = PDX_MIN_MX32(norm_out, vmax);
+            norm_out = PDX_MAX_MX32(norm_out, vmin);
+            PDX_SAV32_MX16_XP(norm_out, outa, outp, MIN(nSize - n - PDX_M, PDX_M)*sizeof(int16_t));
+        }
+    }
+    PDX_SAPOS_MX16_FP(outa, outp);//flush
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_layer_norm_int8_ctx
+* @brief optimized layer normalization function
+*
+* @details optimized layer normalization (or RMS normalization) over the innermost dimension for 8-bit integer input.
+* Each row is staged in L1 as 16bit with the input offset applied, mean and variance come from one vectorized pass
+* with 40bit accumulators and the reciprocal standard deviation is computed in fixed point.
+* The normalized row is kept in Q4.11, multiplied by gamma and requantized with beta added in one pass.
+* The output multiplier and shift map (gamma scale / 2^11) to the output scale, beta is in the same (gamma scale / 2^11) scale.
+* The normalized and the staged row take nSize*2*sizeof(int16_t) bytes of scratch, -1 is returned if they do not fit.
+* nSize must be less than 32768.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [rows][size]
+* @param [in] pGammaBuffer - scale per element, [size]
+* @param [in] pBetaBuffer - offset per element, [size], can be NULL
+* @param [in] nRows - # of rows to normalize
+* @param [in] nSize - # of elements normalized together
+* @param [in] nRmsNorm - 1 for RMS normalization (no centering), 0 for layer normalization
+* @param [in] nEpsilon - epsilon in squared input units
+* @param [in] nInputOffset - input offset (negated input zeropoint)
+* @param [in] nQuantizedMultiplier - output multiplier
+* @param [in] nQuantizedShift - output shift
+* @param [in] nOutputOffset - output zeropoint
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data, [rows][size]
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_layer_norm_int8_ctx(const int8_t* pInputBuffer,
+                                        const int16_t* pGammaBuffer,
+                                        const int32_t* pBetaBuffer,
+                                        int8_t* pOutputBuffer,
+                                        int32_t nRows,
+                                        int32_t nSize,
+                                        int32_t nRmsNorm,
+                                        int32_t nEpsilon,
+                                        int32_t nInputOffset,
+                                        int32_t nQuantizedMultiplier,
+                                        int32_t nQuantizedShift,
+                                        int32_t nOutputOffset,
+                                        const ADI_SHARCFX_CONTEXT* pContext)
+{
+    if ((int32_t)(nSize*2*sizeof(int16_t)) > get_scratch_size(pContext))
+    {
+        return -1;
+    }
+    int16_t *pNorm = (int16_t *)get_scratch(pContext);
+    int16_t *pStage = pNorm + nSize;
+    xb_vec2Mx16 vInZP = nInputOffset;
+    xb_vec2Mx16 vin, vz, vg;
+    xb_vec2Mx40 acc;
+
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+    }
+    xb_vecMx32 vOutZP = nOutputOffset;
+    xb_vecMx32 vmin = INT_8BIT_MIN;
+    xb_vecMx32 vmax = INT_8BIT_MAX;
+
+    for (int32_t nRow = 0; nRow < nRows; nRow++)
+    {
+        //stage the row in L1 as 16bit with the offset applied
+        xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pInputBuffer + nRow*nSize);
+        valign ina = PDX_LA_2MX8_PP(inp);
+        xb_vec2Mx16 *stp = (xb_vec2Mx16 *)pStage;
+        valign sta = PDX_Z_ALIGN();
+        for (int32_t n = 0; n < nSize; n += 2*PDX_M)
+        {
+            PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+            vin += vInZP;
+            PDX_SAV_2MX16_XP(vin, sta, stp, (nSize - n)*sizeof(int16_t));
+        }
+        PDX_SAPOS_2MX16_FP(sta, stp);
+
+        layer_norm_normalize(pStage, pNorm, nSize, nRmsNorm, nEpsilon);
+
+        //gamma, beta and output requantization
+        xb_vec2Mx16 *zp = (xb_vec2Mx16 *)pNorm;
+        valign za = PDX_LA_2MX16_PP(zp);
+        xb_vec2Mx16 *gp = (xb_vec2Mx16 *)pGammaBuffer;
+        valign ga = PDX_LA_2MX16_PP(gp);
+        xb_vecMx8 *outp = (xb_vecMx8 *)(pOutputBuffer + nRow*nSize);
+        valign outa = PDX_Z_ALIGN();
+        for (int32_t n = 0; n < nSize; n += 2*PDX_M)
+        {
+            PDX_LA_2MX16_XP(vz, za, zp, 2*PDX_M*sizeof(int16_t));
+            PDX_LA_2MX16_XP(vg, ga, gp, 2*PDX_M*sizeof(int16_t));
+            acc = 0;
+            PDX_MULAQW_2MX16(acc, vz, vg);
+            quantize_and_store_channels(acc, pBetaBuffer ? pBetaBuffer + n : NULL, pMult, pShift,
+                                        MIN(2*PDX_M, nSize - n), vOutZP, vmin, vmax, outp, outa);
+        }
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_layer_norm_int8
+* @brief adi_sharcfx_layer_norm_int8_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_layer_norm_int8_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_layer_norm_int8(const int8_t* pInputBuffer,
+                                    const int16_t* pGammaBuffer,
+                                    const int32_t* pBetaBuffer,
+                                    int8_t* pOutputBuffer,
+                                    int32_t nRows,
+                                    int32_t nSize,
+                                    int32_t nRmsNorm,
+                                    int32_t nEpsilon,
+                                    int32_t nInputOffset,
+                                    int32_t nQuantizedMultiplier,
+                                    int32_t nQuantizedShift,
+                                    int32_t nOutputOffset)
+{
+    return adi_sharcfx_layer_norm_int8_ctx(pInputBuffer, pGammaBuffer, pBetaBuffer, pOutputBuffer, nRows, nSize, nRmsNorm,
+                                           nEpsilon, nInputOffset, nQuantizedMultiplier, nQuantizedShift, nOutputOffset, NULL);
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_layer_norm_int16_ctx
+* @brief optimized layer normalization function
+*
+* @details optimized layer normalization (or RMS normalization) over the innermost dimension for 16-bit integer input.
+* Same as adi_sharcfx_layer_norm_int8 for symmetric 16bit tensors, the statistics are read directly from the input
+* and gamma products are accumulated undoubled.
+* The normalized row takes nSize*sizeof(int16_t) bytes of scratch, -1 is returned if it does not fit.
+* nSize must be less than 32768.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [rows][size]
+* @param [in] pGammaBuffer - scale per element, [size]
+* @param [in] pBetaBuffer - offset per element, [size], can be NULL
+* @param [in] nRows - # of rows to normalize
+* @param [in] nSize - # of elements normalized together
+* @param [in] nRmsNorm - 1 for RMS normalization (no centering), 0 for layer normalization
+* @param [in] nEpsilon - epsilon in squared input units
+* @param [in] nQuantizedMultiplier - output multiplier
+* @param [in] nQuantizedShift - output shift
+* @param [in] pContext - context with the scratch of the call, NULL for the shared static scratch
+*
+* @param [out] pOutputBuffer - output data, [rows][size]
+*
+* @return 0, or -1 if the scratch is too small for the call, the output is then left untouched
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_layer_norm_int16_ctx(const int16_t* pInputBuffer,
+                                         const int16_t* pGammaBuffer,
+                                         const int32_t* pBetaBuffer,
+                                         int16_t* pOutputBuffer,
+                                         int32_t nRows,
+                                         int32_t nSize,
+                                         int32_t nRmsNorm,
+                                         int32_t nEpsilon,
+                                         int32_t nQuantizedMultiplier,
+                                         int32_t nQuantizedShift,
+                                         const ADI_SHARCFX_CONTEXT* pContext)
+{
+    if ((int32_t)(nSize*sizeof(int16_t)) > get_scratch_size(pContext))
+    {
+        return -1;
+    }
+    int16_t *pNorm = (int16_t *)get_scratch(pContext);
+    xb_vec2Mx16 vz, vg;
+    xb_vec2Mx40 acc;
+
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+    }
+    xb_vecMx32 vmin = INT_16BIT_MIN;
+    xb_vecMx32 vmax = INT_16BIT_MAX;
+
+    for (int32_t nRow = 0; nRow < nRows; nRow++)
+    {
+        layer_norm_normalize(pInputBuffer + nRow*nSize, pNorm, nSize, nRmsNorm, nEpsilon);
+
+        //gamma, beta and output requantization
+        xb_vec2Mx16 *zp = (xb_vec2Mx16 *)pNorm;
+        valign za = PDX_LA_2MX16_PP(zp);
+        xb_vec2Mx16 *gp = (xb_vec2Mx16 *)pGammaBuffer;
+        valign ga = PDX_LA_2MX16_PP(gp);
+        xb_vecMx16 *outp = (xb_vecMx16 *)(pOutputBuffer + nRow*nSize);
+        valign outa = PDX_Z_ALIGN();
+        for (int32_t n = 0; n < nSize; n += 2*PDX_M)
+        {
+            PDX_LA_2MX16_XP(vz, za, zp, 2*PDX_M*sizeof(int16_t));
+            PDX_LA_2MX16_XP(vg, ga, gp, 2*PDX_M*sizeof(int16_t));
+            acc = 0;
+            PDX_MULAW_2MX16(acc, vz, vg);
+            quantize_and_store_channels_int16(acc, pBetaBuffer ? pBetaBuffer + n : NULL, pMult, pShift,
+                                              MIN(2*PDX_M, nSize - n), vmin, vmax, outp, outa);
+        }
+    }
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_layer_norm_int16
+* @brief adi_sharcfx_layer_norm_int16_ctx with the shared static scratch
+*
+* @details calls adi_sharcfx_layer_norm_int16_ctx without context and returns its status. Calls share the static scratch of the library, so they must not
+* run concurrently.
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_layer_norm_int16(const int16_t* pInputBuffer,
+                                     const int16_t* pGammaBuffer,
+                                     const int32_t* pBetaBuffer,
+                                     int16_t* pOutputBuffer,
+                                     int32_t nRows,
+                                     int32_t nSize,
+                                     int32_t nRmsNorm,
+                                     int32_t nEpsilon,
+                                     int32_t nQuantizedMultiplier,
+                                     int32_t nQuantizedShift)
+{
+    return adi_sharcfx_layer_norm_int16_ctx(pInputBuffer, pGammaBuffer, pBetaBuffer, pOutputBuffer, nRows, nSize, nRmsNorm,
+                                            nEpsilon, nQuantizedMultiplier, nQuantizedShift, NULL);
+}
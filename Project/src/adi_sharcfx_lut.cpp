@@ -0,0 +1,219 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_lut.cpp
+*
+* @brief: contains table driven int8 activation functions
+*
+* @details: contains population of 256 entry lookup tables for any int8 to int8 unary activation and the vectorized table lookup
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_nn.h"
+
+/*============= D E F I N E S =============*/
+#define LUT_REGION_SIZE     64      /*# of table entries addressed by one PDX_SEL_4MX8 over two table vectors*/
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Built-in transforms, evaluated in float once per table entry
+static float lut_logistic(float x)
+{
+    return 1.0f / (1.0f + expf(-x));
+}
+
+static float lut_tanh(float x)
+{
+    return tanhf(x);
+}
+
+static float lut_elu(float x)
+{
+    return x < 0.0f ? expm1f(x) : x;
+}
+
+static float lut_gelu(float x)
+{
+    return 0.5f * x * (1.0f + erff(x * 0.70710678f));
+}
+
+static float lut_swish(float x)
+{
+    return x / (1.0f + expf(-x));
+}
+
+static float lut_hard_swish(float x)
+{
+    return x * MIN(MAX(x + 3.0f, 0.0f), 6.0f) / 6.0f;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_lut_populate_int8
+* @brief populates an int8 activation lookup table
+*
+* @details populates the 256 entry table of an int8 to int8 unary activation from a float transform and the input and
+* output quantization, in the same way as the TFLite LUT kernels. Entry i holds the output for input i-128, i.e. the table
+* is in signed order. Called once at prepare time.
+*
+* Parameters:
+* @param [in] pTransform - activation function
+* @param [in] fInputScale - input scale
+* @param [in] nInputZeroPoint - input zeropoint
+* @param [in] fOutputScale - output scale
+* @param [in] nOutputZeroPoint - output zeropoint
+*
+* @param [out] pTable - table, ADI_SHARCFX_LUT_SIZE entries
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_lut_populate_int8(int8_t* pTable,
+                                   float (*pTransform)(float),
+                                   float fInputScale,
+                                   int32_t nInputZeroPoint,
+                                   float fOutputScale,
+                                   int32_t nOutputZeroPoint)
+{
+    for (int32_t i = 0; i < ADI_SHARCFX_LUT_SIZE; i++)
+    {
+        float fInput = fInputScale * (float)(i + INT_8BIT_MIN - nInputZeroPoint);
+        float fOutput = pTransform(fInput);
+        int32_t nOutput = (int32_t)roundf(fOutput / fOutputScale) + nOutputZeroPoint;
+        nOutput = MIN(nOutput, INT_8BIT_MAX);
+        nOutput = MAX(nOutput, INT_8BIT_MIN);
+        pTable[i] = (int8_t)nOutput;
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_lut_populate_builtin_int8
+* @brief populates an int8 activation lookup table for a built-in activation
+*
+* @details populates the table with adi_sharcfx_lut_populate_int8 for one of the ADI_SHARCFX_LUT_* activations.
+*
+* Parameters:
+* @param [in] nTransform - ADI_SHARCFX_LUT_LOGISTIC, _TANH, _ELU, _GELU, _SWISH or _HARD_SWISH
+* @param [in] fInputScale - input scale
+* @param [in] nInputZeroPoint - input zeropoint
+* @param [in] fOutputScale - output scale
+* @param [in] nOutputZeroPoint - output zeropoint
+*
+* @param [out] pTable - table, ADI_SHARCFX_LUT_SIZE entries
+*
+* @return 0 on success, -1 for an unknown transform
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_lut_populate_builtin_int8(int8_t* pTable,
+                                              int32_t nTransform,
+                                              float fInputScale,
+                                              int32_t nInputZeroPoint,
+                                              float fOutputScale,
+                                              int32_t nOutputZeroPoint)
+{
+    float (*pTransform)(float);
+
+    switch (nTransform)
+    {
+        case ADI_SHARCFX_LUT_LOGISTIC:
+            pTransform = lut_logistic;
+            break;
+        case ADI_SHARCFX_LUT_TANH:
+            pTransform = lut_tanh;
+            break;
+        case ADI_SHARCFX_LUT_ELU:
+            pTransform = lut_elu;
+            break;
+        case ADI_SHARCFX_LUT_GELU:
+            pTransform = lut_gelu;
+            break;
+        case ADI_SHARCFX_LUT_SWISH:
+            pTransform = lut_swish;
+            break;
+        case ADI_SHARCFX_LUT_HARD_SWISH:
+            pTransform = lut_hard_swish;
+            break;
+        default:
+            return -1;
+    }
+    adi_sharcfx_lut_populate_int8(pTable, pTransform, fInputScale, nInputZeroPoint, fOutputScale, nOutputZeroPoint);
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_lut_int8
+* @brief optimized table lookup activation
+*
+* @details applies a 256 entry table from adi_sharcfx_lut_populate_int8 to int8 data in a single pass.
+* The table is held in 8 vector registers. For 4*PDX_M inputs per iteration, PDX_SEL_4MX8 gathers from each 64 entry
+* region with the low 6 bits of the input as index, and the region is chosen per lane from the input sign and magnitude.
+*
+* Parameters:
+* @param [in] pInput - input buffer
+* @param [in] pTable - table, ADI_SHARCFX_LUT_SIZE entries in signed order
+* @param [in] nSize - # of elements
+*
+* @param [out] pOutput - output buffer
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_lut_int8(const int8_t* pInput,
+                          const int8_t* pTable,
+                          int8_t* pOutput,
+                          int32_t nSize)
+{
+    xb_vec4Mx8 vTable0, vTable1, vTable2, vTable3, vTable4, vTable5, vTable6, vTable7;
+    xb_vec4Mx8 vin, vIndex, vRegion0, vRegion1, vRegion2, vRegion3, result;
+    xb_vec4Mx8 vIndexMask = LUT_REGION_SIZE - 1;
+    xb_vec4Mx8 vBound0 = -LUT_REGION_SIZE;
+    xb_vec4Mx8 vBound1 = 0;
+    xb_vec4Mx8 vBound2 = LUT_REGION_SIZE;
+
+    //keep the whole table in registers
+    xb_vec4Mx8 *tp = (xb_vec4Mx8 *)pTable;
+    valign ta = PDX_LA_4MX8_PP(tp);
+    PDX_LA_4MX8_XP(vTable0, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable1, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable2, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable3, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable4, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable5, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable6, ta, tp, 4*PDX_M);
+    PDX_LA_4MX8_XP(vTable7, ta, tp, 4*PDX_M);
+
+    xb_vec4Mx8 *inp = (xb_vec4Mx8 *)pInput;
+    valign ina = PDX_LA_4MX8_PP(inp);
+    xb_vec4Mx8 *outp = (xb_vec4Mx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t n = 0; n < nSize; n += 4*PDX_M)
+    {
+        PDX_LA_4MX8_XP(vin, ina, inp, 4*PDX_M);
+        //(x+128) mod 64 == x mod 64, the region is (x+128)/64
+        vIndex = PDX_AND_4MX8(vin, vIndexMask);
+        vRegion0 = PDX_SEL_4MX8(vTable1, vTable0, vIndex);    //x in [-128,-64)
+        vRegion1 = PDX_SEL_4MX8(vTable3, vTable2, vIndex);    //x in [-64,0)
+        vRegion2 = PDX_SEL_4MX8(vTable5, vTable4, vIndex);    //x in [0,64)
+        vRegion3 = PDX_SEL_4MX8(vTable7, vTable6, vIndex);    //x in [64,128)
+
+        result = PDX_MOV_4MX8_T(vRegion2, vRegion3, PDX_LT_4MX8(vin, vBound2));
+        result = PDX_MOV_4MX8_T(vRegion1, result, PDX_LT_4MX8(vin, vBound1));
+        result = PDX_MOV_4MX8_T(vRegion0, result, PDX_LT_4MX8(vin, vBound0));
+        PDX_SAV_4MX8_XP(result, outa, outp, MIN(4*PDX_M, nSize - n));
+    }
+    PDX_SAPOS_4MX8_FP(outa, outp);//flush
+}
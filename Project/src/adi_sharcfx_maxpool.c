@@ -22,35 +22,26 @@
 
 /**
 *******************************************************************************
-* Function: adi_sharcfx_maxpool_int8
-* @brief optimized maxpool function for 8-bit integer input 
+* Function: adi_sharcfx_maxpool_rows_int8
+* @brief row range maxpool function for 8-bit integer input
 *
-* @details optimized maxpool function for 8-bit integer input 
+* @details adi_sharcfx_maxpool_int8 restricted to output rows [out_row_start, out_row_end). It uses no scratch, so calls on
+* disjoint row ranges can run concurrently, e.g. one per core, and together produce the output of adi_sharcfx_maxpool_int8.
 *
 * Parameters:
-* @param [in] input_y - input height
-* @param [in] input_x - input width
-* @param [in] output_y - output height
-* @param [in] output_x - output width
-* @param [in] stride_y - stride height
-* @param [in] stride_x - stride width
-* @param [in] kernel_y - kernel height
-* @param [in] kernel_x - kernel width
-* @param [in] pad_y - padding height 
-* @param [in] pad_x - padding width
-* @param [in] act_min - min value after activation function
-* @param [in] act_max - max value after activation function
-* @param [in] ch_src - input depth (channels)
-* @param [in] src - input data
-* 
-* @param [out] dst - output data
+* @param [in] out_row_start - first output row
+* @param [in] out_row_end - one past the last output row
+*
+* see adi_sharcfx_maxpool_int8 for the other parameters
+*
+* @param [out] dst - output data, only the rows of the range are written
 *
 * @return None
 *
 *
 *******************************************************************************
-*/ 
-void adi_sharcfx_maxpool_int8(
+*/
+void adi_sharcfx_maxpool_rows_int8(
 							const int32_t input_y,
 							const int32_t input_x,
 							const int32_t output_y,
@@ -65,13 +56,15 @@ void adi_sharcfx_maxpool_int8(
 							const int32_t act_max,
 							const int32_t ch_src,
 						    const int8_t *src,
-						    int8_t *dst)
+						    int8_t *dst,
+							const int32_t out_row_start,
+							const int32_t out_row_end)
 {
 	xb_vec4Mx8 in_vec0;
 	xb_vec4Mx8 act_ll = act_min;
 	xb_vec4Mx8 act_hl = act_max;
-	xb_vec4Mx8* __restrict pvOut  = (xb_vec4Mx8 *)(dst);
-	for (int i_y = 0; i_y < output_y; i_y++)
+	xb_vec4Mx8* __restrict pvOut  = (xb_vec4Mx8 *)(dst + out_row_start * output_x * ch_src);
+	for (int i_y = out_row_start; i_y < out_row_end; i_y++)
 	{
 		for (int i_x = 0; i_x < output_x; i_x++ )//process upto 4*PDX_M at a time
 		{
@@ -115,8 +108,53 @@ void adi_sharcfx_maxpool_int8(
 	}
 }
 
-
-
-
-
-
+/**
+*******************************************************************************
+* Function: adi_sharcfx_maxpool_int8
+* @brief optimized maxpool function for 8-bit integer input 
+*
+* @details optimized maxpool function for 8-bit integer input 
+*
+* Parameters:
+* @param [in] input_y - input height
+* @param [in] input_x - input width
+* @param [in] output_y - output height
+* @param [in] output_x - output width
+* @param [in] stride_y - stride height
+* @param [in] stride_x - stride width
+* @param [in] kernel_y - kernel height
+* @param [in] kernel_x - kernel width
+* @param [in] pad_y - padding height 
+* @param [in] pad_x - padding width
+* @param [in] act_min - min value after activation function
+* @param [in] act_max - max value after activation function
+* @param [in] ch_src - input depth (channels)
+* @param [in] src - input data
+* 
+* @param [out] dst - output data
+*
+* @return None
+*
+*
+*******************************************************************************
+*/ 
+void adi_sharcfx_maxpool_int8(
+							const int32_t input_y,
+							const int32_t input_x,
+							const int32_t output_y,
+							const int32_t output_x,
+							const int32_t stride_y,
+							const int32_t stride_x,
+							const int32_t kernel_y,
+							const int32_t kernel_x,
+							const int32_t pad_y,
+							const int32_t pad_x,
+							const int32_t act_min,
+							const int32_t act_max,
+							const int32_t ch_src,
+						    const int8_t *src,
+						    int8_t *dst)
+{
+	adi_sharcfx_maxpool_rows_int8(input_y, input_x, output_y, output_x, stride_y, stride_x, kernel_y, kernel_x,
+								  pad_y, pad_x, act_min, act_max, ch_src, src, dst, 0, output_y);
+}
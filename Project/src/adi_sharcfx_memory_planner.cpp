@@ -0,0 +1,368 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_memory_planner.cpp
+*
+* @brief: contains the static memory planner of a model
+*
+* @details: contains the scratch size queries of the kernels and the planner placing the layer outputs and scratch of a whole
+* model in a fast and a large arena
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_nn.h"
+
+/*============= D E F I N E S =============*/
+#define PLAN_ALIGN              8       /*alignment of every arena buffer, as the static scratch buffers*/
+#define PLAN_BUFFERS            3       /*output, fast scratch and large scratch of a layer*/
+#define PLAN_FAST_BUFFER        1       /*buffer k of a layer in the fast arena, the others are in the large arena*/
+#define PLAN_CONV_WEIGHT_OFFSET 128     /*offset of the reordered weights in the conv2d int8 scratch*/
+#define PLAN_GRU_STATE_SIZE     8       /*input and hidden contributions of the 3 gates and the 2 sigmoid gates*/
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Rounds a size up to the arena alignment
+static int32_t plan_align(int32_t nSize)
+{
+    return (nSize + PLAN_ALIGN - 1) & ~(PLAN_ALIGN - 1);
+}
+
+/*UTILITY FUNCTION*/
+//Size of buffer nBuffer, buffer k of layer i is nBuffer = i*PLAN_BUFFERS + k. Outputs reusing an earlier buffer in place
+//are not buffers of their own
+static int32_t plan_buffer_size(const ADI_SHARCFX_LAYER_PLAN* pPlans,
+                                int32_t nBuffer)
+{
+    int32_t nLayer = nBuffer / PLAN_BUFFERS;
+    const ADI_SHARCFX_LAYER_PLAN *pPlan = &pPlans[nLayer];
+
+    switch (nBuffer % PLAN_BUFFERS)
+    {
+        case 0:
+            return (pPlan->nAlias == nLayer) ? pPlan->nOutputSize : 0;
+        case 1:
+            return pPlan->nScratchSize;
+        default:
+            return pPlan->nScratchL3Size;
+    }
+}
+
+static int32_t* plan_buffer_offset(ADI_SHARCFX_LAYER_PLAN* pPlans,
+                                   int32_t nBuffer)
+{
+    ADI_SHARCFX_LAYER_PLAN *pPlan = &pPlans[nBuffer / PLAN_BUFFERS];
+
+    switch (nBuffer % PLAN_BUFFERS)
+    {
+        case 0:
+            return &pPlan->nOutputOffset;
+        case 1:
+            return &pPlan->nScratchOffset;
+        default:
+            return &pPlan->nScratchL3Offset;
+    }
+}
+
+/*UTILITY FUNCTION*/
+//1 if buffer nBuffer is in the fast arena, 0 if it is in the large arena
+static int32_t plan_buffer_is_fast(int32_t nBuffer)
+{
+    return (nBuffer % PLAN_BUFFERS) == PLAN_FAST_BUFFER;
+}
+
+/*UTILITY FUNCTION*/
+//Buffers are live from their layer to the last layer using them, scratch only during its layer
+static int32_t plan_buffer_end(const ADI_SHARCFX_LAYER_PLAN* pPlans,
+                               int32_t nBuffer)
+{
+    int32_t nLayer = nBuffer / PLAN_BUFFERS;
+    return (nBuffer % PLAN_BUFFERS) ? nLayer : pPlans[nLayer].nLastUse;
+}
+
+/*UTILITY FUNCTION*/
+//Lowest offset where buffer nBuffer does not overlap any placed buffer of its arena live at the same time. The lowest fit is
+//at 0 or right after a placed buffer of the arena
+static int32_t plan_first_fit(ADI_SHARCFX_LAYER_PLAN* pPlans,
+                              int32_t nBuffers,
+                              int32_t nBuffer)
+{
+    int32_t nSize = plan_buffer_size(pPlans, nBuffer);
+    int32_t nStart = nBuffer / PLAN_BUFFERS;
+    int32_t nEnd = plan_buffer_end(pPlans, nBuffer);
+    int32_t nFast = plan_buffer_is_fast(nBuffer);
+    int32_t nBest = -1;
+
+    for (int32_t c = -1; c < nBuffers; c++)
+    {
+        int32_t nCandidate = 0;
+        if (c >= 0)
+        {
+            if (*plan_buffer_offset(pPlans, c) < 0 || plan_buffer_size(pPlans, c) == 0 || plan_buffer_is_fast(c) != nFast)
+            {
+                continue;
+            }
+            nCandidate = *plan_buffer_offset(pPlans, c) + plan_buffer_size(pPlans, c);
+        }
+        if (nBest >= 0 && nCandidate >= nBest)
+        {
+            continue;
+        }
+
+        int32_t nFits = 1;
+        for (int32_t m = 0; m < nBuffers && nFits; m++)
+        {
+            int32_t nOffset = *plan_buffer_offset(pPlans, m);
+            int32_t nSizeM = plan_buffer_size(pPlans, m);
+            if (nOffset < 0 || nSizeM == 0 || m == nBuffer || plan_buffer_is_fast(m) != nFast)
+            {
+                continue;
+            }
+            //overlap in time and in the arena
+            if (m / PLAN_BUFFERS <= nEnd && nStart <= plan_buffer_end(pPlans, m) &&
+                nOffset < nCandidate + nSize && nCandidate < nOffset + nSizeM)
+            {
+                nFits = 0;
+            }
+        }
+        if (nFits)
+        {
+            nBest = nCandidate;
+        }
+    }
+    return nBest;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_scratch_size
+* @brief returns the scratch a kernel needs for a layer
+*
+* @details returns the fast and large scratch the _ctx entry point of the layer kernel uses with the layer shapes, i.e. the
+* minimum nScratchSize and nScratchL3Size of its ADI_SHARCFX_CONTEXT. ADI_SHARCFX_KERNEL_CONV2D_INT8 covers the
+* dilation 1x1, the specialized and the dilated kernel, ADI_SHARCFX_KERNEL_FULLY_CONNECTED_INT8 is adi_sharcfx_fully_connected_int8.
+*
+* Parameters:
+* @param [in] pLayer - layer
+*
+* @param [out] pScratchL3Size - large scratch size in bytes, may be NULL
+*
+* @return fast scratch size in bytes
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_scratch_size(const ADI_SHARCFX_LAYER* pLayer,
+                                 int32_t* pScratchL3Size)
+{
+    int32_t nWeights = pLayer->nKernelHeight*pLayer->nKernelWidth*pLayer->nInChannels*pLayer->nOutChannels;
+    int32_t nInputSize = pLayer->nBatches*pLayer->nInHeight*pLayer->nInWidth*pLayer->nInChannels;
+    int32_t nExpandedSize = pLayer->nInHeight*pLayer->nInWidth*pLayer->nOutChannels;
+    int32_t nScratch = 0;
+    int32_t nScratchL3 = 0;
+
+    switch (pLayer->nKernel)
+    {
+        case ADI_SHARCFX_KERNEL_CONV2D_INT8:
+            //reordered weights and, without dilation, the taps of one output pixel repeated for every kernel
+            nScratch = PLAN_CONV_WEIGHT_OFFSET + 2*nWeights;
+            break;
+        case ADI_SHARCFX_KERNEL_CONV2D_INT16:
+            //high and low halves of the 64bit bias, each padded to a vector, then the reordered weights
+            nScratch = 2*((pLayer->nOutChannels*sizeof(int32_t) + 4*PDX_M - 1)/(4*PDX_M))*4*PDX_M + nWeights;
+            break;
+        case ADI_SHARCFX_KERNEL_TRANSPOSE_CONV2D_INT8:
+            nScratch = nWeights;
+            break;
+        case ADI_SHARCFX_KERNEL_DEPTHCONV2D_INT8:
+            //input repeated for the depth multiplier
+            nScratchL3 = (pLayer->nInChannels != pLayer->nOutChannels) ? nExpandedSize : 0;
+            break;
+        case ADI_SHARCFX_KERNEL_DEPTHCONV2D_INT16:
+            //high and low halves of the 64bit bias, each padded to a vector
+            nScratch = 2*((pLayer->nOutChannels*sizeof(int32_t) + 4*PDX_M - 1)/(4*PDX_M))*4*PDX_M;
+            nScratchL3 = (pLayer->nInChannels != pLayer->nOutChannels) ? nExpandedSize*sizeof(int16_t) : 0;
+            break;
+        case ADI_SHARCFX_KERNEL_BATCH_MATMUL_INT8:
+        case ADI_SHARCFX_KERNEL_BATCH_MATMUL_INT16:
+            //one panel of 2*PDX_M 16bit columns, the transposed RHS is blocked to the scratch size
+            nScratch = pLayer->nInChannels*2*PDX_M*sizeof(int16_t);
+            break;
+        case ADI_SHARCFX_KERNEL_LAYER_NORM_INT8:
+            nScratch = 2*pLayer->nInChannels*sizeof(int16_t);
+            break;
+        case ADI_SHARCFX_KERNEL_LAYER_NORM_INT16:
+            nScratch = pLayer->nInChannels*sizeof(int16_t);
+            break;
+        case ADI_SHARCFX_KERNEL_LOGISTIC_INT8:
+            //Q3.4 input, written in whole vectors
+            nScratchL3 = ((nInputSize + 4*PDX_M - 1)/(4*PDX_M))*4*PDX_M;
+            break;
+        case ADI_SHARCFX_KERNEL_GRU_INT8:
+        case ADI_SHARCFX_KERNEL_GRU_INT16:
+            nScratchL3 = ((PLAN_GRU_STATE_SIZE*pLayer->nOutChannels + 2*PDX_M - 1)/(2*PDX_M))*2*PDX_M*sizeof(int16_t);
+            break;
+        default:
+            break;
+    }
+
+    if (pScratchL3Size)
+    {
+        *pScratchL3Size = nScratchL3;
+    }
+    return nScratch;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_plan_memory
+* @brief plans the memory of a model in a fast and a large arena
+*
+* @details places the fast scratch of every layer in the fast arena, usually in L1, and the outputs and large scratch in the
+* large arena, usually in L3, so the model runs with two allocations of deterministic size. The two arenas are planned
+* independently and each has its own peak. Layers run in order. An output is live from its layer to the last layer reading it,
+* an output read by no later layer is a model output and is kept to the end. Scratch is live during its layer only.
+* An ADI_SHARCFX_KERNEL_ELEMENTWISE layer that is the last reader of an output of the same size runs in place on it.
+* Buffers are placed largest first at the lowest offset not overlapping a buffer live at the same time, offsets are
+* 8 byte aligned. Called once at prepare time, the cost is cubic in the # of layers.
+*
+* Parameters:
+* @param [in] pLayers - layers in execution order
+* @param [in] nLayers - # of layers
+*
+* @param [out] pPlans - arena placement of every layer, nLayers entries
+* @param [out] pFastArenaSize - fast arena size in bytes
+*
+* @return large arena size in bytes, -1 if a layer reads the output of itself or of a later layer
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_plan_memory(const ADI_SHARCFX_LAYER* pLayers,
+                                int32_t nLayers,
+                                ADI_SHARCFX_LAYER_PLAN* pPlans,
+                                int32_t* pFastArenaSize)
+{
+    int32_t nBuffers = nLayers*PLAN_BUFFERS;
+    int32_t nArenaSize = 0;
+    int32_t nFastArenaSize = 0;
+
+    *pFastArenaSize = 0;
+
+    for (int32_t i = 0; i < nLayers; i++)
+    {
+        const ADI_SHARCFX_LAYER *pLayer = &pLayers[i];
+        ADI_SHARCFX_LAYER_PLAN *pPlan = &pPlans[i];
+
+        pPlan->nOutputSize = plan_align(pLayer->nBatches*pLayer->nOutHeight*pLayer->nOutWidth*pLayer->nOutChannels*pLayer->nElementSize);
+        pPlan->nScratchSize = plan_align(adi_sharcfx_scratch_size(pLayer, &pPlan->nScratchL3Size) + pLayer->nExtraScratch);
+        pPlan->nScratchL3Size = plan_align(pPlan->nScratchL3Size + pLayer->nExtraScratchL3);
+        pPlan->nOutputOffset = -1;
+        pPlan->nScratchOffset = -1;
+        pPlan->nScratchL3Offset = -1;
+        pPlan->nLastUse = -1;
+        pPlan->nAlias = i;
+
+        for (int32_t k = 0; k < 2; k++)
+        {
+            int32_t nInput = pLayer->nInputLayer[k];
+            if (nInput >= i)
+            {
+                return -1;
+            }
+            if (nInput >= 0)
+            {
+                pPlans[nInput].nLastUse = i;
+            }
+        }
+    }
+
+    //outputs nobody reads are model outputs
+    for (int32_t i = 0; i < nLayers; i++)
+    {
+        if (pPlans[i].nLastUse < 0)
+        {
+            pPlans[i].nLastUse = nLayers - 1;
+        }
+    }
+
+    //in place layers take over the buffer of their input, which then lives until their output is last read
+    for (int32_t i = 0; i < nLayers; i++)
+    {
+        int32_t nInput = pLayers[i].nInputLayer[0];
+        if (pLayers[i].nKernel == ADI_SHARCFX_KERNEL_ELEMENTWISE && nInput >= 0 && pLayers[i].nInputLayer[1] < 0 &&
+            pPlans[nInput].nLastUse == i && pPlans[nInput].nOutputSize == pPlans[i].nOutputSize)
+        {
+            int32_t nRoot = pPlans[nInput].nAlias;
+            pPlans[i].nAlias = nRoot;
+            pPlans[nRoot].nLastUse = MAX(pPlans[nRoot].nLastUse, pPlans[i].nLastUse);
+        }
+    }
+
+    //greedy by size, ties in layer order so the plan is deterministic
+    for (int32_t nPlaced = 0; nPlaced < nBuffers; nPlaced++)
+    {
+        int32_t nBuffer = -1;
+        for (int32_t n = 0; n < nBuffers; n++)
+        {
+            if (*plan_buffer_offset(pPlans, n) < 0 &&
+                (nBuffer < 0 || plan_buffer_size(pPlans, n) > plan_buffer_size(pPlans, nBuffer)))
+            {
+                nBuffer = n;
+            }
+        }
+        int32_t nOffset = plan_buffer_size(pPlans, nBuffer) ? plan_first_fit(pPlans, nBuffers, nBuffer) : 0;
+        *plan_buffer_offset(pPlans, nBuffer) = nOffset;
+        if (plan_buffer_is_fast(nBuffer))
+        {
+            nFastArenaSize = MAX(nFastArenaSize, nOffset + plan_buffer_size(pPlans, nBuffer));
+        }
+        else
+        {
+            nArenaSize = MAX(nArenaSize, nOffset + plan_buffer_size(pPlans, nBuffer));
+        }
+    }
+
+    for (int32_t i = 0; i < nLayers; i++)
+    {
+        pPlans[i].nOutputOffset = pPlans[pPlans[i].nAlias].nOutputOffset;
+    }
+    *pFastArenaSize = nFastArenaSize;
+    return nArenaSize;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_plan_context
+* @brief returns the context of a planned layer
+*
+* @details points the fast scratch of a context into the fast arena and the large scratch into the large arena, at the
+* scratch the planner placed for the layer, for the _ctx entry point of its kernel. The copy engine of the context is reset to the library engine, set pCopyEngine afterwards to use another.
+*
+* Parameters:
+* @param [in] pPlan - arena placement of the layer
+* @param [in] pArena - large arena, 8 byte aligned
+* @param [in] pFastArena - fast arena, 8 byte aligned
+*
+* @param [out] pContext - context of the layer
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_plan_context(const ADI_SHARCFX_LAYER_PLAN* pPlan,
+                              int8_t* pArena,
+                              int8_t* pFastArena,
+                              ADI_SHARCFX_CONTEXT* pContext)
+{
+    pContext->pScratch = pFastArena + pPlan->nScratchOffset;
+    pContext->nScratchSize = pPlan->nScratchSize;
+    pContext->pScratchL3 = pArena + pPlan->nScratchL3Offset;
+    pContext->nScratchL3Size = pPlan->nScratchL3Size;
+    pContext->pCopyEngine = NULL;
+}
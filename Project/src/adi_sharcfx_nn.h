@@ -38,10 +38,79 @@
 #define USE_OPTIMIZED_1x1_CONV
 #define USE_OPTIMIZED_FC
 #define USE_OPTIMIZED_RELU
+#define USE_OPTIMIZED_HARD_SWISH
+#define USE_OPTIMIZED_LEAKY_RELU
+#define USE_OPTIMIZED_PRELU
 #define USE_OPTIMIZED_LSTM
 #define USE_OPTIMIZED_LOGISTIC_INT8
-//#define USE_OPTIMIZED_TANH_INT16          /*not enabled by default as they have limited resolution. refer to ADI_TFLITE_MICRO_SHARCFX_Library_Product_Reference_Guide.pdf for additional information*/
-//#define USE_OPTIMIZED_LOGISTIC_INT16      /*not enabled by default as they have limited resolution. refer to ADI_TFLITE_MICRO_SHARCFX_Library_Product_Reference_Guide.pdf for additional information*/
+#define USE_OPTIMIZED_DILATED_CONV
+#define USE_OPTIMIZED_CONV_INT16
+#define USE_OPTIMIZED_DEPTHCONV_INT16
+#define USE_OPTIMIZED_DEPTHCONV_TILED
+#define USE_OPTIMIZED_TRANSPOSE_CONV
+#define USE_OPTIMIZED_SVDF
+#define USE_OPTIMIZED_GRU
+#define USE_OPTIMIZED_BATCH_MATMUL
+#define USE_OPTIMIZED_LAYER_NORM
+#define USE_OPTIMIZED_REDUCE
+#define USE_OPTIMIZED_LUT
+#define USE_OPTIMIZED_CONCATENATION
+#define USE_OPTIMIZED_SPLIT
+#define USE_OPTIMIZED_CHANNEL_SHUFFLE
+#define USE_OPTIMIZED_PAD
+#define USE_OPTIMIZED_MIRROR_PAD
+#define USE_OPTIMIZED_TANH_INT16           /*table interpolation of the TFLite int16 reference kernel, bit exact*/
+#define USE_OPTIMIZED_LOGISTIC_INT16       /*over all int16 inputs (Test/src/test_activations_int16.cpp)*/
+
+/*Table driven int8 activations*/
+#define ADI_SHARCFX_LUT_SIZE            256
+#define ADI_SHARCFX_LUT_LOGISTIC        0
+#define ADI_SHARCFX_LUT_TANH            1
+#define ADI_SHARCFX_LUT_ELU             2
+#define ADI_SHARCFX_LUT_GELU            3
+#define ADI_SHARCFX_LUT_SWISH           4
+#define ADI_SHARCFX_LUT_HARD_SWISH      5
+
+/*Mirror pad modes*/
+#define ADI_SHARCFX_MIRROR_PAD_REFLECT      0
+#define ADI_SHARCFX_MIRROR_PAD_SYMMETRIC    1
+
+/*Packed int4 weights, see adi_sharcfx_pack_int4*/
+#define ADI_SHARCFX_INT4_BLOCK              32      /*weights per packed block of 16 bytes*/
+#define ADI_SHARCFX_INT4_ROW_BYTES(nDepth)  ((((nDepth) + ADI_SHARCFX_INT4_BLOCK - 1) / ADI_SHARCFX_INT4_BLOCK) * (ADI_SHARCFX_INT4_BLOCK / 2))
+
+/*Block sparse weights, see adi_sharcfx_pack_block_sparse*/
+#define ADI_SHARCFX_SPARSE_BLOCK            16      /*weights per block along the depth*/
+#define ADI_SHARCFX_SPARSE_BLOCKS(nDepth)   (((nDepth) + ADI_SHARCFX_SPARSE_BLOCK - 1) / ADI_SHARCFX_SPARSE_BLOCK)
+
+/*Kernel types of the memory planner*/
+#define ADI_SHARCFX_KERNEL_GENERIC                  0       /*no scratch, output separate from the inputs*/
+#define ADI_SHARCFX_KERNEL_ELEMENTWISE              1       /*unary elementwise, no scratch, can run in place*/
+#define ADI_SHARCFX_KERNEL_CONV2D_INT8              2
+#define ADI_SHARCFX_KERNEL_CONV2D_INT16             3
+#define ADI_SHARCFX_KERNEL_TRANSPOSE_CONV2D_INT8    4
+#define ADI_SHARCFX_KERNEL_DEPTHCONV2D_INT8         5
+#define ADI_SHARCFX_KERNEL_DEPTHCONV2D_INT16        6
+#define ADI_SHARCFX_KERNEL_FULLY_CONNECTED_INT8     7
+#define ADI_SHARCFX_KERNEL_BATCH_MATMUL_INT8        8
+#define ADI_SHARCFX_KERNEL_BATCH_MATMUL_INT16       9
+#define ADI_SHARCFX_KERNEL_LAYER_NORM_INT8          10
+#define ADI_SHARCFX_KERNEL_LAYER_NORM_INT16         11
+#define ADI_SHARCFX_KERNEL_LOGISTIC_INT8            12
+#define ADI_SHARCFX_KERNEL_GRU_INT8                 13
+#define ADI_SHARCFX_KERNEL_GRU_INT16                14
+
+/*Graph operators*/
+#define ADI_SHARCFX_OP_NONE                         0       /*removed by fusion*/
+#define ADI_SHARCFX_OP_CONV2D_INT8                  1
+#define ADI_SHARCFX_OP_DEPTHCONV2D_INT8             2
+#define ADI_SHARCFX_OP_FULLY_CONNECTED_INT8         3
+#define ADI_SHARCFX_OP_RELU_INT8                    4       /*clamp to [nActMin, nActMax], same quantization in and out*/
+#define ADI_SHARCFX_OP_LOGISTIC_INT8                5
+#define ADI_SHARCFX_OP_PAD_INT8                     6
+#define ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8     7       /*depthconv fused with the following 1x1 conv*/
+#define ADI_SHARCFX_OP_FULLY_CONNECTED_LOGISTIC_INT8 8      /*fully connected fused with the following logistic*/
+#define ADI_SHARCFX_GRAPH_NODE_WORDS                28      /*int32 words of a serialized node*/
 
 /* Enable or disable profiling */
 //#define DISPLAY_CYCLE_COUNTS
@@ -52,6 +121,102 @@
 #include <cycle_count.h>
 #endif
 /*============= D A T A =============*/
+/*Double buffered L1 tile pipeline*/
+typedef struct
+{
+    ADI_SHARCFX_COPY_ENGINE *pEngine;
+    int8_t *pBuffer[2];         /*tile buffers in L1*/
+    int32_t nBufferSize;        /*size of one tile buffer in bytes*/
+    int32_t nCurrent;           /*index of the buffer being computed on*/
+    int32_t nPending;           /*1 while a tile is copied into the other buffer*/
+} ADI_SHARCFX_TILE_PIPELINE;
+
+/*Layer of the memory planner. The output of layer i is tensor i, the model input is not planned*/
+typedef struct
+{
+    int32_t nKernel;            /*ADI_SHARCFX_KERNEL_* type*/
+    int32_t nInputLayer[2];     /*layers whose outputs are read, -1 for the model input or no input*/
+    int32_t nBatches;
+    int32_t nInHeight;          /*rows for matmul, layer norm and gru*/
+    int32_t nInWidth;
+    int32_t nInChannels;        /*depth for matmul, size for layer norm, input size for gru*/
+    int32_t nOutHeight;
+    int32_t nOutWidth;
+    int32_t nOutChannels;       /*columns for matmul, hidden size for gru*/
+    int32_t nKernelHeight;
+    int32_t nKernelWidth;
+    int32_t nElementSize;       /*bytes per output element*/
+    int32_t nExtraScratch;      /*fast scratch on top of the kernel scratch, e.g. for fused layers*/
+    int32_t nExtraScratchL3;    /*large scratch on top of the kernel scratch*/
+} ADI_SHARCFX_LAYER;
+
+/*Block sparse weights, the nonzero ADI_SHARCFX_SPARSE_BLOCK weight blocks of every row*/
+typedef struct
+{
+    int32_t *pBlockPtr;     /*nRows+1 entries, the blocks of row r are [pBlockPtr[r], pBlockPtr[r+1])*/
+    int16_t *pBlockIdx;     /*depth position of every block in blocks*/
+    int8_t *pValues;        /*ADI_SHARCFX_SPARSE_BLOCK weights per block, zero padded past the row end*/
+} ADI_SHARCFX_SPARSE_WEIGHTS;
+
+/*Arena placement of one layer, offsets in bytes from the start of the large arena, or of the fast arena for the fast scratch*/
+typedef struct
+{
+    int32_t nOutputOffset;
+    int32_t nOutputSize;
+    int32_t nScratchOffset;     /*fast scratch in the fast arena, ADI_SHARCFX_CONTEXT pScratch*/
+    int32_t nScratchSize;
+    int32_t nScratchL3Offset;   /*large scratch in the large arena, ADI_SHARCFX_CONTEXT pScratchL3*/
+    int32_t nScratchL3Size;
+    int32_t nLastUse;           /*last layer reading the output*/
+    int32_t nAlias;             /*layer whose output buffer is reused in place, the layer itself without aliasing*/
+} ADI_SHARCFX_LAYER_PLAN;
+
+/*Node of a graph. Nodes are in execution order and read the output of an earlier node*/
+typedef struct
+{
+    int32_t nOp;                        /*ADI_SHARCFX_OP_* operator*/
+    int32_t nInputNode;                 /*node whose output is read, -1 for the graph input*/
+    int32_t nInHeight;
+    int32_t nInWidth;
+    int32_t nInChannels;                /*input size for fully connected*/
+    int32_t nOutHeight;
+    int32_t nOutWidth;
+    int32_t nOutChannels;
+    int32_t nKernelHeight;
+    int32_t nKernelWidth;
+    int32_t nStrideHeight;
+    int32_t nStrideWidth;
+    int32_t nDilationHeight;
+    int32_t nDilationWidth;
+    int32_t nPadTop;                    /*padding of the pad operator, convolutions pad from their output size*/
+    int32_t nPadBottom;
+    int32_t nPadLeft;
+    int32_t nPadRight;
+    int32_t nPadValue;
+    int32_t nInputOffset;               /*added to the input, i.e. minus the input zeropoint*/
+    int32_t nFilterOffset;
+    int32_t nOutputOffset;              /*output zeropoint*/
+    int32_t nActMin;
+    int32_t nActMax;
+    const int8_t *pWeights;
+    const int32_t *pBias;
+    int32_t *pQuantizedMultiplier;      /*per output channel, a single entry for fully connected and logistic*/
+    int32_t *pQuantizedShift;
+    int32_t nFusedNode;                 /*node whose parameters a fused operator uses too, set by adi_sharcfx_graph_prepare*/
+    int32_t nKernel;                    /*ADI_SHARCFX_KERNEL_* kernel, set by adi_sharcfx_graph_prepare*/
+} ADI_SHARCFX_GRAPH_NODE;
+
+/*Prepared graph, all memory is provided by the caller*/
+typedef struct
+{
+    ADI_SHARCFX_GRAPH_NODE *pNodes;
+    int32_t nNodes;
+    int32_t nOutputNode;                /*node holding the graph output*/
+    ADI_SHARCFX_LAYER *pLayers;         /*planner layers, nNodes entries*/
+    ADI_SHARCFX_LAYER_PLAN *pPlans;     /*arena placement, nNodes entries*/
+    int32_t nArenaSize;                 /*large arena, node outputs and large scratch*/
+    int32_t nFastArenaSize;             /*fast arena, fast scratch*/
+} ADI_SHARCFX_GRAPH;
 
 /*============= F U N C T I O N P R O T O T Y P E S =============*/
 void adi_sharcfx_maxpool_int8(const int32_t input_y,
@@ -70,6 +235,24 @@ void adi_sharcfx_maxpool_int8(const int32_t input_y,
                               const int8_t  *src,
                               int8_t        *dst);
 
+void adi_sharcfx_maxpool_rows_int8(const int32_t input_y,
+                                   const int32_t input_x,
+                                   const int32_t output_y,
+                                   const int32_t output_x,
+                                   const int32_t stride_y,
+                                   const int32_t stride_x,
+                                   const int32_t kernel_y,
+                                   const int32_t kernel_x,
+                                   const int32_t pad_y,
+                                   const int32_t pad_x,
+                                   const int32_t act_min,
+                                   const int32_t act_max,
+                                   const int32_t ch_src,
+                                   const int8_t  *src,
+                                   int8_t        *dst,
+                                   const int32_t out_row_start,
+                                   const int32_t out_row_end);
+
 void adi_sharcfx_depthconv2d_stride2_noninterleaved_int8(const int8_t *pInputBuffer,
                                                          int8_t *pOutputBuffer,
                                                          const int8_t *pWeightsBuffer,
@@ -121,27 +304,482 @@ void adi_sharcfx_depthconv2d_stride2_kernel8x10_noninterleaved_int8(const int8_t
                                                                     int32_t output_activation_min,
                                                                     int32_t output_activation_max);
 
-void adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
-                                  int8_t *pOutputBuffer,
-                                  const int8_t *pWeightsBuffer,
-                                  const int32_t *pBiasBuffer,
-                                  int32_t nInputWidth,
-                                  int32_t nInputHeight,
-                                  int32_t nDepthMult,
-                                  int32_t nInChannels,
-                                  int32_t nOutChannels,
-                                  int32_t nKernelSizeWidth,
-                                  int32_t nKernelSizeHeight,
-                                  int32_t nTotalPaddingWidth,
-                                  int32_t nTotalPaddingHeight,
-                                  int32_t *pQuantizedMultiplier,
-                                  int32_t *pQuantizedShift,
-                                  int32_t pInZeroPoint,
-                                  int32_t pOutZeroPoint,
-                                  int32_t nStrideWidth,
-                                  int32_t nStrideHeight,
-                                  int32_t nActMin,
-                                  int32_t nActMax);
+void adi_sharcfx_set_copy_engine(ADI_SHARCFX_COPY_ENGINE* pEngine);
+
+ADI_SHARCFX_COPY_ENGINE* adi_sharcfx_get_copy_engine(void);
+
+void adi_sharcfx_tile_pipeline_init(ADI_SHARCFX_TILE_PIPELINE* pPipeline,
+                                    ADI_SHARCFX_COPY_ENGINE* pEngine,
+                                    int8_t* pBuffer,
+                                    int32_t nSize);
+
+int32_t adi_sharcfx_tile_pipeline_prefetch(ADI_SHARCFX_TILE_PIPELINE* pPipeline,
+                                           const void* pSrc,
+                                           int32_t nBytes);
+
+int8_t* adi_sharcfx_tile_pipeline_next(ADI_SHARCFX_TILE_PIPELINE* pPipeline);
+
+int32_t adi_sharcfx_scratch_size(const ADI_SHARCFX_LAYER* pLayer,
+                                 int32_t* pScratchL3Size);
+
+int32_t adi_sharcfx_plan_memory(const ADI_SHARCFX_LAYER* pLayers,
+                                int32_t nLayers,
+                                ADI_SHARCFX_LAYER_PLAN* pPlans,
+                                int32_t* pFastArenaSize);
+
+void adi_sharcfx_plan_context(const ADI_SHARCFX_LAYER_PLAN* pPlan,
+                              int8_t* pArena,
+                              int8_t* pFastArena,
+                              ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_graph_load(ADI_SHARCFX_GRAPH_NODE* pNodes,
+                               int32_t nMaxNodes,
+                               const int32_t* pDescription,
+                               int32_t nWords,
+                               int8_t* pParameters,
+                               int32_t nParametersSize);
+
+int32_t adi_sharcfx_graph_prepare(ADI_SHARCFX_GRAPH* pGraph,
+                                  ADI_SHARCFX_GRAPH_NODE* pNodes,
+                                  int32_t nNodes,
+                                  ADI_SHARCFX_LAYER* pLayers,
+                                  ADI_SHARCFX_LAYER_PLAN* pPlans);
+
+int8_t* adi_sharcfx_graph_run(const ADI_SHARCFX_GRAPH* pGraph,
+                              int8_t* pArena,
+                              int8_t* pFastArena,
+                              const int8_t* pInput);
+
+int32_t adi_sharcfx_depthconv2d_int8(const int8_t *pInputBuffer,
+                                     int8_t *pOutputBuffer,
+                                     const int8_t *pWeightsBuffer,
+                                     const int32_t *pBiasBuffer,
+                                     int32_t nInputWidth,
+                                     int32_t nInputHeight,
+                                     int32_t nDepthMult,
+                                     int32_t nInChannels,
+                                     int32_t nOutChannels,
+                                     int32_t nKernelSizeWidth,
+                                     int32_t nKernelSizeHeight,
+                                     int32_t nTotalPaddingWidth,
+                                     int32_t nTotalPaddingHeight,
+                                     int32_t *pQuantizedMultiplier,
+                                     int32_t *pQuantizedShift,
+                                     int32_t pInZeroPoint,
+                                     int32_t pOutZeroPoint,
+                                     int32_t nStrideWidth,
+                                     int32_t nStrideHeight,
+                                     int32_t nActMin,
+                                     int32_t nActMax);
+
+int32_t adi_sharcfx_depthconv2d_int8_ctx(const int8_t *pInputBuffer,
+                                            int8_t *pOutputBuffer,
+                                            const int8_t *pWeightsBuffer,
+                                            const int32_t *pBiasBuffer,
+                                            int32_t nInputWidth,
+                                            int32_t nInputHeight,
+                                            int32_t nDepthMult,
+                                            int32_t nInChannels,
+                                            int32_t nOutChannels,
+                                            int32_t nKernelSizeWidth,
+                                            int32_t nKernelSizeHeight,
+                                            int32_t nTotalPaddingWidth,
+                                            int32_t nTotalPaddingHeight,
+                                            int32_t *pQuantizedMultiplier,
+                                            int32_t *pQuantizedShift,
+                                            int32_t pInZeroPoint,
+                                            int32_t pOutZeroPoint,
+                                            int32_t nStrideWidth,
+                                            int32_t nStrideHeight,
+                                            int32_t nActMin,
+                                            int32_t nActMax,
+                                         const ADI_SHARCFX_CONTEXT* pContext);
+
+void adi_sharcfx_depthconv2d_strip_int8(const int8_t *pInputBuffer,
+                                        int8_t *pOutputBuffer,
+                                        const int8_t *pWeightsBuffer,
+                                        const int32_t *pBiasBuffer,
+                                        int32_t nInputWidth,
+                                        int32_t nInputHeight,
+                                        int32_t nDepthMult,
+                                        int32_t nInChannels,
+                                        int32_t nOutChannels,
+                                        int32_t nKernelSizeWidth,
+                                        int32_t nKernelSizeHeight,
+                                        int32_t nTotalPaddingWidth,
+                                        int32_t nTotalPaddingHeight,
+                                        int32_t *pQuantizedMultiplier,
+                                        int32_t *pQuantizedShift,
+                                        int32_t pInZeroPoint,
+                                        int32_t pOutZeroPoint,
+                                        int32_t nStrideWidth,
+                                        int32_t nStrideHeight,
+                                        int32_t nActMin,
+                                        int32_t nActMax,
+                                        int32_t nOutRowStart,
+                                        int32_t nOutRowEnd,
+                                        int8_t *pScratch);
+
+void adi_sharcfx_depthconv2d_rows_int8(const int8_t *pInputBuffer,
+                                       int8_t *pOutputBuffer,
+                                       const int8_t *pWeightsBuffer,
+                                       const int32_t *pBiasBuffer,
+                                       int32_t nInputWidth,
+                                       int32_t nInputHeight,
+                                       int32_t nDepthMult,
+                                       int32_t nInChannels,
+                                       int32_t nOutChannels,
+                                       int32_t nKernelSizeWidth,
+                                       int32_t nKernelSizeHeight,
+                                       int32_t nTotalPaddingWidth,
+                                       int32_t nTotalPaddingHeight,
+                                       int32_t *pQuantizedMultiplier,
+                                       int32_t *pQuantizedShift,
+                                       int32_t pInZeroPoint,
+                                       int32_t pOutZeroPoint,
+                                       int32_t nStrideWidth,
+                                       int32_t nStrideHeight,
+                                       int32_t nActMin,
+                                       int32_t nActMax,
+                                       int32_t nOutRowStart,
+                                       int32_t nOutRowEnd,
+                                       int8_t *pScratch);
+
+int32_t adi_sharcfx_depthconv2d_tiled_int8(const int8_t *pInputBuffer,
+                                           int8_t *pOutputBuffer,
+                                           const int8_t *pWeightsBuffer,
+                                           const int32_t *pBiasBuffer,
+                                           int32_t nInputWidth,
+                                           int32_t nInputHeight,
+                                           int32_t nDepthMult,
+                                           int32_t nInChannels,
+                                           int32_t nOutChannels,
+                                           int32_t nKernelSizeWidth,
+                                           int32_t nKernelSizeHeight,
+                                           int32_t nTotalPaddingWidth,
+                                           int32_t nTotalPaddingHeight,
+                                           int32_t *pQuantizedMultiplier,
+                                           int32_t *pQuantizedShift,
+                                           int32_t pInZeroPoint,
+                                           int32_t pOutZeroPoint,
+                                           int32_t nStrideWidth,
+                                           int32_t nStrideHeight,
+                                           int32_t nActMin,
+                                           int32_t nActMax,
+                                           int32_t nL1Budget);
+
+int32_t adi_sharcfx_depthconv2d_tiled_int8_ctx(const int8_t *pInputBuffer,
+                                               int8_t *pOutputBuffer,
+                                               const int8_t *pWeightsBuffer,
+                                               const int32_t *pBiasBuffer,
+                                               int32_t nInputWidth,
+                                               int32_t nInputHeight,
+                                               int32_t nDepthMult,
+                                               int32_t nInChannels,
+                                               int32_t nOutChannels,
+                                               int32_t nKernelSizeWidth,
+                                               int32_t nKernelSizeHeight,
+                                               int32_t nTotalPaddingWidth,
+                                               int32_t nTotalPaddingHeight,
+                                               int32_t *pQuantizedMultiplier,
+                                               int32_t *pQuantizedShift,
+                                               int32_t pInZeroPoint,
+                                               int32_t pOutZeroPoint,
+                                               int32_t nStrideWidth,
+                                               int32_t nStrideHeight,
+                                               int32_t nActMin,
+                                               int32_t nActMax,
+                                               int32_t nL1Budget,
+                                               const ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_depthconv2d_int16(const int16_t *pInputBuffer,
+                                      int16_t *pOutputBuffer,
+                                      const int8_t *pWeightsBuffer,
+                                      const int64_t *pBiasBuffer,
+                                      int32_t nInputWidth,
+                                      int32_t nInputHeight,
+                                      int32_t nDepthMult,
+                                      int32_t nInChannels,
+                                      int32_t nOutChannels,
+                                      int32_t nKernelSizeWidth,
+                                      int32_t nKernelSizeHeight,
+                                      int32_t nTotalPaddingWidth,
+                                      int32_t nTotalPaddingHeight,
+                                      int32_t *pQuantizedMultiplier,
+                                      int32_t *pQuantizedShift,
+                                      int32_t nStrideWidth,
+                                      int32_t nStrideHeight,
+                                      int32_t nActMin,
+                                      int32_t nActMax);
+
+int32_t adi_sharcfx_depthconv2d_int16_ctx(const int16_t *pInputBuffer,
+                                          int16_t *pOutputBuffer,
+                                          const int8_t *pWeightsBuffer,
+                                          const int64_t *pBiasBuffer,
+                                          int32_t nInputWidth,
+                                          int32_t nInputHeight,
+                                          int32_t nDepthMult,
+                                          int32_t nInChannels,
+                                          int32_t nOutChannels,
+                                          int32_t nKernelSizeWidth,
+                                          int32_t nKernelSizeHeight,
+                                          int32_t nTotalPaddingWidth,
+                                          int32_t nTotalPaddingHeight,
+                                          int32_t *pQuantizedMultiplier,
+                                          int32_t *pQuantizedShift,
+                                          int32_t nStrideWidth,
+                                          int32_t nStrideHeight,
+                                          int32_t nActMin,
+                                          int32_t nActMax,
+                                          const ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_batch_matmul_int8(const int8_t* pLhsBuffer,
+                                      const int8_t* pRhsBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nBatches,
+                                      int32_t nRows,
+                                      int32_t nDepth,
+                                      int32_t nCols,
+                                      int32_t nTransposeRhs,
+                                      int32_t nLhsBatchStride,
+                                      int32_t nRhsBatchStride,
+                                      int32_t nLhsOffset,
+                                      int32_t nRhsOffset,
+                                      int32_t nQuantizedMultiplier,
+                                      int32_t nQuantizedShift,
+                                      int32_t nOutputOffset);
+
+int32_t adi_sharcfx_batch_matmul_int8_ctx(const int8_t* pLhsBuffer,
+                                          const int8_t* pRhsBuffer,
+                                          int8_t* pOutputBuffer,
+                                          int32_t nBatches,
+                                          int32_t nRows,
+                                          int32_t nDepth,
+                                          int32_t nCols,
+                                          int32_t nTransposeRhs,
+                                          int32_t nLhsBatchStride,
+                                          int32_t nRhsBatchStride,
+                                          int32_t nLhsOffset,
+                                          int32_t nRhsOffset,
+                                          int32_t nQuantizedMultiplier,
+                                          int32_t nQuantizedShift,
+                                          int32_t nOutputOffset,
+                                          const ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_batch_matmul_int16(const int16_t* pLhsBuffer,
+                                       const int16_t* pRhsBuffer,
+                                       int16_t* pOutputBuffer,
+                                       int32_t nBatches,
+                                       int32_t nRows,
+                                       int32_t nDepth,
+                                       int32_t nCols,
+                                       int32_t nTransposeRhs,
+                                       int32_t nLhsBatchStride,
+                                       int32_t nRhsBatchStride,
+                                       int32_t nQuantizedMultiplier,
+                                       int32_t nQuantizedShift);
+
+int32_t adi_sharcfx_batch_matmul_int16_ctx(const int16_t* pLhsBuffer,
+                                           const int16_t* pRhsBuffer,
+                                           int16_t* pOutputBuffer,
+                                           int32_t nBatches,
+                                           int32_t nRows,
+                                           int32_t nDepth,
+                                           int32_t nCols,
+                                           int32_t nTransposeRhs,
+                                           int32_t nLhsBatchStride,
+                                           int32_t nRhsBatchStride,
+                                           int32_t nQuantizedMultiplier,
+                                           int32_t nQuantizedShift,
+                                           const ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_layer_norm_int8(const int8_t* pInputBuffer,
+                                    const int16_t* pGammaBuffer,
+                                    const int32_t* pBetaBuffer,
+                                    int8_t* pOutputBuffer,
+                                    int32_t nRows,
+                                    int32_t nSize,
+                                    int32_t nRmsNorm,
+                                    int32_t nEpsilon,
+                                    int32_t nInputOffset,
+                                    int32_t nQuantizedMultiplier,
+                                    int32_t nQuantizedShift,
+                                    int32_t nOutputOffset);
+
+int32_t adi_sharcfx_layer_norm_int8_ctx(const int8_t* pInputBuffer,
+                                        const int16_t* pGammaBuffer,
+                                        const int32_t* pBetaBuffer,
+                                        int8_t* pOutputBuffer,
+                                        int32_t nRows,
+                                        int32_t nSize,
+                                        int32_t nRmsNorm,
+                                        int32_t nEpsilon,
+                                        int32_t nInputOffset,
+                                        int32_t nQuantizedMultiplier,
+                                        int32_t nQuantizedShift,
+                                        int32_t nOutputOffset,
+                                        const ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_layer_norm_int16(const int16_t* pInputBuffer,
+                                     const int16_t* pGammaBuffer,
+                                     const int32_t* pBetaBuffer,
+                                     int16_t* pOutputBuffer,
+                                     int32_t nRows,
+                                     int32_t nSize,
+                                     int32_t nRmsNorm,
+                                     int32_t nEpsilon,
+                                     int32_t nQuantizedMultiplier,
+                                     int32_t nQuantizedShift);
+
+int32_t adi_sharcfx_layer_norm_int16_ctx(const int16_t* pInputBuffer,
+                                         const int16_t* pGammaBuffer,
+                                         const int32_t* pBetaBuffer,
+                                         int16_t* pOutputBuffer,
+                                         int32_t nRows,
+                                         int32_t nSize,
+                                         int32_t nRmsNorm,
+                                         int32_t nEpsilon,
+                                         int32_t nQuantizedMultiplier,
+                                         int32_t nQuantizedShift,
+                                         const ADI_SHARCFX_CONTEXT* pContext);
+
+void adi_sharcfx_reduce_sum_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nOuter,
+                                 int32_t nReduce,
+                                 int32_t nInner,
+                                 int32_t nInputOffset,
+                                 int32_t nQuantizedMultiplier,
+                                 int32_t nQuantizedShift,
+                                 int32_t nOutputOffset);
+
+void adi_sharcfx_reduce_sum_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nOuter,
+                                  int32_t nReduce,
+                                  int32_t nInner,
+                                  int32_t nQuantizedMultiplier,
+                                  int32_t nQuantizedShift);
+
+void adi_sharcfx_reduce_max_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nOuter,
+                                 int32_t nReduce,
+                                 int32_t nInner);
+
+void adi_sharcfx_reduce_max_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nOuter,
+                                  int32_t nReduce,
+                                  int32_t nInner);
+
+void adi_sharcfx_pad_int8(const int8_t* pInputBuffer,
+                          int8_t* pOutputBuffer,
+                          int32_t nBatches,
+                          int32_t nInHeight,
+                          int32_t nInWidth,
+                          int32_t nChannels,
+                          int32_t nPadTop,
+                          int32_t nPadBottom,
+                          int32_t nPadLeft,
+                          int32_t nPadRight,
+                          int32_t nPadValue);
+
+void adi_sharcfx_pad_int16(const int16_t* pInputBuffer,
+                           int16_t* pOutputBuffer,
+                           int32_t nBatches,
+                           int32_t nInHeight,
+                           int32_t nInWidth,
+                           int32_t nChannels,
+                           int32_t nPadTop,
+                           int32_t nPadBottom,
+                           int32_t nPadLeft,
+                           int32_t nPadRight,
+                           int32_t nPadValue);
+
+void adi_sharcfx_mirror_pad_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nBatches,
+                                 int32_t nInHeight,
+                                 int32_t nInWidth,
+                                 int32_t nChannels,
+                                 int32_t nPadTop,
+                                 int32_t nPadBottom,
+                                 int32_t nPadLeft,
+                                 int32_t nPadRight,
+                                 int32_t nMode);
+
+void adi_sharcfx_mirror_pad_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nBatches,
+                                  int32_t nInHeight,
+                                  int32_t nInWidth,
+                                  int32_t nChannels,
+                                  int32_t nPadTop,
+                                  int32_t nPadBottom,
+                                  int32_t nPadLeft,
+                                  int32_t nPadRight,
+                                  int32_t nMode);
+
+void adi_sharcfx_concatenation_int8(const int8_t** ppInputBuffers,
+                                    const int32_t* pInputSizes,
+                                    int32_t nInputs,
+                                    int32_t nOuter,
+                                    const int32_t* pInputOffset,
+                                    const int32_t* pQuantizedMultiplier,
+                                    const int32_t* pQuantizedShift,
+                                    int32_t nOutputOffset,
+                                    int8_t* pOutputBuffer);
+
+void adi_sharcfx_split_int8(const int8_t* pInputBuffer,
+                            const int32_t* pOutputSizes,
+                            int32_t nOutputs,
+                            int32_t nOuter,
+                            int32_t nInputOffset,
+                            const int32_t* pQuantizedMultiplier,
+                            const int32_t* pQuantizedShift,
+                            const int32_t* pOutputOffset,
+                            int8_t** ppOutputBuffers);
+
+void adi_sharcfx_channel_shuffle_int8(const int8_t* pInputBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nPixels,
+                                      int32_t nChannels,
+                                      int32_t nGroups);
+
+void adi_sharcfx_transpose_int8(const int8_t* pInputBuffer,
+                                int8_t* pOutputBuffer,
+                                int32_t nRows,
+                                int32_t nCols);
+
+void adi_sharcfx_transpose_int16(const int16_t* pInputBuffer,
+                                 int16_t* pOutputBuffer,
+                                 int32_t nRows,
+                                 int32_t nCols);
+
+void adi_sharcfx_hwc_to_chw_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nHeight,
+                                 int32_t nWidth,
+                                 int32_t nChannels);
+
+void adi_sharcfx_chw_to_hwc_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nHeight,
+                                 int32_t nWidth,
+                                 int32_t nChannels);
+
+void adi_sharcfx_hwc_to_chw_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nHeight,
+                                  int32_t nWidth,
+                                  int32_t nChannels);
+
+void adi_sharcfx_chw_to_hwc_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nHeight,
+                                  int32_t nWidth,
+                                  int32_t nChannels);
 
 void adi_sharcfx_fully_connected_int8(const int8_t* pInputBuffer,
                                       const int8_t* pWeightsBuffer,
@@ -158,6 +796,61 @@ void adi_sharcfx_fully_connected_int8(const int8_t* pInputBuffer,
                                       int32_t output_activation_min,
                                       int32_t output_activation_max);
 
+void adi_sharcfx_fully_connected_channels_int8(const int8_t* pInputBuffer,
+                                               const int8_t* pWeightsBuffer,
+                                               const int32_t* pBiasBuffer,
+                                               int8_t* pOutputBuffer,
+                                               int32_t nFilterDepth,
+                                               int32_t nOutsize,
+                                               int32_t nBatches,
+                                               uint32_t nQuantizedMultiplier,
+                                               int32_t nQuantizedShift,
+                                               int32_t nInputOffset,
+                                               int32_t nFilterOffset,
+                                               int32_t nOutputOffset,
+                                               int32_t output_activation_min,
+                                               int32_t output_activation_max,
+                                               int32_t nChannelStart,
+                                               int32_t nChannelEnd);
+
+int32_t adi_sharcfx_pack_int4(const int8_t* pWeights,
+                              int8_t* pPackedWeights,
+                              int32_t nRows,
+                              int32_t nDepth);
+
+void adi_sharcfx_fully_connected_int4(const int8_t* pInputBuffer,
+                                      const int8_t* pPackedWeights,
+                                      const int32_t* pBiasBuffer,
+                                      int8_t* pOutputBuffer,
+                                      int32_t nFilterDepth,
+                                      int32_t nOutsize,
+                                      int32_t nBatches,
+                                      const int32_t* pQuantizedMultiplier,
+                                      const int32_t* pQuantizedShift,
+                                      int32_t nInputOffset,
+                                      int32_t nOutputOffset,
+                                      int32_t output_activation_min,
+                                      int32_t output_activation_max);
+
+int32_t adi_sharcfx_pack_block_sparse(const int8_t* pWeights,
+                                      int32_t nRows,
+                                      int32_t nDepth,
+                                      ADI_SHARCFX_SPARSE_WEIGHTS* pSparse);
+
+void adi_sharcfx_fully_connected_sparse_int8(const int8_t* pInputBuffer,
+                                             const ADI_SHARCFX_SPARSE_WEIGHTS* pSparse,
+                                             const int32_t* pBiasBuffer,
+                                             int8_t* pOutputBuffer,
+                                             int32_t nFilterDepth,
+                                             int32_t nOutsize,
+                                             int32_t nBatches,
+                                             uint32_t nQuantizedMultiplier,
+                                             int32_t nQuantizedShift,
+                                             int32_t nInputOffset,
+                                             int32_t nOutputOffset,
+                                             int32_t output_activation_min,
+                                             int32_t output_activation_max);
+
 void adi_sharcfx_fully_connected_int16(const int16_t* pInputBuffer,
                                        const int8_t* pWeightsBuffer,
                                        const int64_t* pBiasBuffer,
@@ -173,18 +866,105 @@ void adi_sharcfx_fully_connected_int16(const int16_t* pInputBuffer,
                                        int32_t output_activation_min,
                                        int32_t output_activation_max);
 
+void adi_sharcfx_svdf_int8(const int8_t* pInputBuffer,
+                           const int8_t* pWeightsFeature,
+                           const int16_t* pWeightsTime,
+                           const int32_t* pBiasBuffer,
+                           int16_t* pStateBuffer,
+                           int32_t* pStateIndex,
+                           int8_t* pOutputBuffer,
+                           int32_t nBatches,
+                           int32_t nInputSize,
+                           int32_t nFilters,
+                           int32_t nMemorySize,
+                           int32_t nRank,
+                           int32_t nInputOffset,
+                           int32_t nQuantizedMultiplier1,
+                           int32_t nQuantizedShift1,
+                           int32_t nQuantizedMultiplier2,
+                           int32_t nQuantizedShift2,
+                           int32_t nOutputOffset);
+
+int32_t adi_sharcfx_gru_int8(const int8_t* pInputBuffer,
+                             const int8_t* pWeightsInput,
+                             const int8_t* pWeightsHidden,
+                             const int32_t* pBiasInput,
+                             const int32_t* pBiasHidden,
+                             int16_t* pHiddenState,
+                             int32_t nBatches,
+                             int32_t nInputSize,
+                             int32_t nHiddenSize,
+                             int32_t nInputOffset,
+                             const int32_t* pQuantizedMultiplierInput,
+                             const int32_t* pQuantizedShiftInput,
+                             const int32_t* pQuantizedMultiplierHidden,
+                             const int32_t* pQuantizedShiftHidden);
+
+int32_t adi_sharcfx_gru_int8_ctx(const int8_t* pInputBuffer,
+                                 const int8_t* pWeightsInput,
+                                 const int8_t* pWeightsHidden,
+                                 const int32_t* pBiasInput,
+                                 const int32_t* pBiasHidden,
+                                 int16_t* pHiddenState,
+                                 int32_t nBatches,
+                                 int32_t nInputSize,
+                                 int32_t nHiddenSize,
+                                 int32_t nInputOffset,
+                                 const int32_t* pQuantizedMultiplierInput,
+                                 const int32_t* pQuantizedShiftInput,
+                                 const int32_t* pQuantizedMultiplierHidden,
+                                 const int32_t* pQuantizedShiftHidden,
+                                 const ADI_SHARCFX_CONTEXT* pContext);
+
+int32_t adi_sharcfx_gru_int16(const int16_t* pInputBuffer,
+                              const int8_t* pWeightsInput,
+                              const int8_t* pWeightsHidden,
+                              const int32_t* pBiasInput,
+                              const int32_t* pBiasHidden,
+                              int16_t* pHiddenState,
+                              int32_t nBatches,
+                              int32_t nInputSize,
+                              int32_t nHiddenSize,
+                              const int32_t* pQuantizedMultiplierInput,
+                              const int32_t* pQuantizedShiftInput,
+                              const int32_t* pQuantizedMultiplierHidden,
+                              const int32_t* pQuantizedShiftHidden);
+
+int32_t adi_sharcfx_gru_int16_ctx(const int16_t* pInputBuffer,
+                                  const int8_t* pWeightsInput,
+                                  const int8_t* pWeightsHidden,
+                                  const int32_t* pBiasInput,
+                                  const int32_t* pBiasHidden,
+                                  int16_t* pHiddenState,
+                                  int32_t nBatches,
+                                  int32_t nInputSize,
+                                  int32_t nHiddenSize,
+                                  const int32_t* pQuantizedMultiplierInput,
+                                  const int32_t* pQuantizedShiftInput,
+                                  const int32_t* pQuantizedMultiplierHidden,
+                                  const int32_t* pQuantizedShiftHidden,
+                                  const ADI_SHARCFX_CONTEXT* pContext);
+
 void adi_sharcfx_tanh_int16(int32_t nInputMultiplier, 
                             int32_t nInputLeftShift, 
                             int32_t nLength,
                             const int16_t* pInputData, 
                             int16_t* pOutputData);
 
-void adi_sharcfx_logistic_int8 (int32_t nInputZeroPoint, 
-                                int32_t nInputMultiplier, 
-                                int32_t nInputLeftShift, 
-                                int32_t nInputSize, 
-                                const int8_t* pInputData, 
-                                int8_t* pOutputData);
+int32_t adi_sharcfx_logistic_int8(int32_t nInputZeroPoint, 
+                                  int32_t nInputMultiplier, 
+                                  int32_t nInputLeftShift, 
+                                  int32_t nInputSize, 
+                                  const int8_t* pInputData, 
+                                  int8_t* pOutputData);
+
+int32_t adi_sharcfx_logistic_int8_ctx(int32_t nInputZeroPoint, 
+                                      int32_t nInputMultiplier, 
+                                      int32_t nInputLeftShift, 
+                                      int32_t nInputSize, 
+                                      const int8_t* pInputData, 
+                                      int8_t* pOutputData,
+                                      const ADI_SHARCFX_CONTEXT* pContext);
 
 void adi_sharcfx_logistic_int16(int32_t nInputMultiplier, 
                                 int32_t nInputLeftShift, 
@@ -234,6 +1014,58 @@ void adi_sharcfx_relu_int8(const int8_t* pInput,
                            int32_t output_activation_min,
                            int32_t output_activation_max);
 
+void adi_sharcfx_hard_swish_int8(const int8_t* pInput,
+                                 int8_t* pOutput,
+                                 int32_t nSize,
+                                 int32_t nInputZeroPoint,
+                                 int32_t nOutputZeroPoint,
+                                 int16_t nReluishMultiplier,
+                                 int32_t nReluishShift,
+                                 int16_t nOutputMultiplier,
+                                 int32_t nOutputShift);
+
+void adi_sharcfx_leaky_relu_int8(const int8_t* pInput,
+                                 int8_t* pOutput,
+                                 int32_t nSize,
+                                 int32_t nInputZeroPoint,
+                                 int32_t nOutputZeroPoint,
+                                 int32_t nMultiplierAlpha,
+                                 int32_t nShiftAlpha,
+                                 int32_t nMultiplierIdentity,
+                                 int32_t nShiftIdentity);
+
+void adi_sharcfx_prelu_int8(const int8_t* pInput,
+                            const int8_t* pAlpha,
+                            int8_t* pOutput,
+                            int32_t nSize,
+                            int32_t nChannels,
+                            int32_t nInputOffset,
+                            int32_t nAlphaOffset,
+                            int32_t nOutputOffset,
+                            int32_t nMultiplier1,
+                            int32_t nShift1,
+                            int32_t nMultiplier2,
+                            int32_t nShift2);
+
+void adi_sharcfx_lut_populate_int8(int8_t* pTable,
+                                   float (*pTransform)(float),
+                                   float fInputScale,
+                                   int32_t nInputZeroPoint,
+                                   float fOutputScale,
+                                   int32_t nOutputZeroPoint);
+
+int32_t adi_sharcfx_lut_populate_builtin_int8(int8_t* pTable,
+                                              int32_t nTransform,
+                                              float fInputScale,
+                                              int32_t nInputZeroPoint,
+                                              float fOutputScale,
+                                              int32_t nOutputZeroPoint);
+
+void adi_sharcfx_lut_int8(const int8_t* pInput,
+                          const int8_t* pTable,
+                          int8_t* pOutput,
+                          int32_t nSize);
+
 void adi_sharcfx_conv2d_dilation1x1_int8(const int8_t* pInputBuffer,
                                          const int8_t* pWeightsBuffer,
                                          const int32_t* pBiasBuffer,
@@ -260,6 +1092,249 @@ void adi_sharcfx_conv2d_dilation1x1_int8(const int8_t* pInputBuffer,
                                          int32_t nActMin,
                                          int32_t nActMax);
 
+void adi_sharcfx_conv2d_dilation1x1_int8_ctx(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext);
+
+void adi_sharcfx_conv2d_dilation1x1_rows_int8(const int8_t* pInputBuffer,
+                                              const int8_t* pWeightsBuffer,
+                                              const int32_t* pBiasBuffer,
+                                              int8_t* pOutputBuffer,
+                                              int32_t nBatches,
+                                              int32_t nInChannels,
+                                              int32_t nOutChannels,
+                                              int32_t nKernelHeight,
+                                              int32_t nKernelWidth,
+                                              int32_t nNumKernels,
+                                              int32_t nInputWidth,
+                                              int32_t nInputHeight,
+                                              int32_t stride_height,
+                                              int32_t stride_width,
+                                              int32_t nPadHeight,
+                                              int32_t nPadWidth,
+                                              int32_t nOutHeight,
+                                              int32_t nOutWidth,
+                                              int32_t *pQuantizedMultiplier,
+                                              int32_t *pQuantizedShift,
+                                              int32_t pInZeroPoint,
+                                              int32_t pOutZeroPoint,
+                                              int32_t nFilterZeroPoint,
+                                              int32_t nActMin,
+                                              int32_t nActMax,
+                                              int32_t nOutRowStart,
+                                              int32_t nOutRowEnd,
+                                              int8_t* pScratch);
+
+int32_t adi_sharcfx_conv2d_specialized_int8(const int8_t* pInputBuffer,
+                                            const int8_t* pWeightsBuffer,
+                                            const int32_t* pBiasBuffer,
+                                            int8_t* pOutputBuffer,
+                                            int32_t nBatches,
+                                            int32_t nInChannels,
+                                            int32_t nOutChannels,
+                                            int32_t nKernelHeight,
+                                            int32_t nKernelWidth,
+                                            int32_t nNumKernels,
+                                            int32_t nInputWidth,
+                                            int32_t nInputHeight,
+                                            int32_t stride_height,
+                                            int32_t stride_width,
+                                            int32_t nPadHeight,
+                                            int32_t nPadWidth,
+                                            int32_t nOutHeight,
+                                            int32_t nOutWidth,
+                                            int32_t *pQuantizedMultiplier,
+                                            int32_t *pQuantizedShift,
+                                            int32_t pInZeroPoint,
+                                            int32_t pOutZeroPoint,
+                                            int32_t nFilterZeroPoint,
+                                            int32_t nActMin,
+                                            int32_t nActMax);
+
+int32_t adi_sharcfx_conv2d_specialized_int8_ctx(const int8_t* pInputBuffer,
+                                                const int8_t* pWeightsBuffer,
+                                                const int32_t* pBiasBuffer,
+                                                int8_t* pOutputBuffer,
+                                                int32_t nBatches,
+                                                int32_t nInChannels,
+                                                int32_t nOutChannels,
+                                                int32_t nKernelHeight,
+                                                int32_t nKernelWidth,
+                                                int32_t nNumKernels,
+                                                int32_t nInputWidth,
+                                                int32_t nInputHeight,
+                                                int32_t stride_height,
+                                                int32_t stride_width,
+                                                int32_t nPadHeight,
+                                                int32_t nPadWidth,
+                                                int32_t nOutHeight,
+                                                int32_t nOutWidth,
+                                                int32_t *pQuantizedMultiplier,
+                                                int32_t *pQuantizedShift,
+                                                int32_t pInZeroPoint,
+                                                int32_t pOutZeroPoint,
+                                                int32_t nFilterZeroPoint,
+                                                int32_t nActMin,
+                                                int32_t nActMax,
+                                                const ADI_SHARCFX_CONTEXT* pContext);
+
+void adi_sharcfx_conv2d_dilated_int8(const int8_t* pInputBuffer,
+                                     const int8_t* pWeightsBuffer,
+                                     const int32_t* pBiasBuffer,
+                                     int8_t* pOutputBuffer,
+                                     int32_t nBatches,
+                                     int32_t nInChannels,
+                                     int32_t nOutChannels,
+                                     int32_t nKernelHeight,
+                                     int32_t nKernelWidth,
+                                     int32_t nNumKernels,
+                                     int32_t nInputWidth,
+                                     int32_t nInputHeight,
+                                     int32_t stride_height,
+                                     int32_t stride_width,
+                                     int32_t nDilationHeight,
+                                     int32_t nDilationWidth,
+                                     int32_t nOutHeight,
+                                     int32_t nOutWidth,
+                                     int32_t *pQuantizedMultiplier,
+                                     int32_t *pQuantizedShift,
+                                     int32_t pInZeroPoint,
+                                     int32_t pOutZeroPoint,
+                                     int32_t nFilterOffset,
+                                     int32_t nActMin,
+                                     int32_t nActMax);
+
+void adi_sharcfx_conv2d_dilated_int8_ctx(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nNumKernels,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nFilterOffset,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext);
+
+void adi_sharcfx_conv2d_dilated_rows_int8(const int8_t* pInputBuffer,
+                                          const int8_t* pWeightsBuffer,
+                                          const int32_t* pBiasBuffer,
+                                          int8_t* pOutputBuffer,
+                                          int32_t nBatches,
+                                          int32_t nInChannels,
+                                          int32_t nOutChannels,
+                                          int32_t nKernelHeight,
+                                          int32_t nKernelWidth,
+                                          int32_t nNumKernels,
+                                          int32_t nInputWidth,
+                                          int32_t nInputHeight,
+                                          int32_t stride_height,
+                                          int32_t stride_width,
+                                          int32_t nDilationHeight,
+                                          int32_t nDilationWidth,
+                                          int32_t nOutHeight,
+                                          int32_t nOutWidth,
+                                          int32_t *pQuantizedMultiplier,
+                                          int32_t *pQuantizedShift,
+                                          int32_t pInZeroPoint,
+                                          int32_t pOutZeroPoint,
+                                          int32_t nFilterOffset,
+                                          int32_t nActMin,
+                                          int32_t nActMax,
+                                          int32_t nOutRowStart,
+                                          int32_t nOutRowEnd,
+                                          int8_t* pScratch);
+
+void adi_sharcfx_transpose_conv2d_int8(const int8_t* pInputBuffer,
+                                       const int8_t* pWeightsBuffer,
+                                       const int32_t* pBiasBuffer,
+                                       int8_t* pOutputBuffer,
+                                       int32_t nBatches,
+                                       int32_t nInChannels,
+                                       int32_t nOutChannels,
+                                       int32_t nKernelHeight,
+                                       int32_t nKernelWidth,
+                                       int32_t nInputWidth,
+                                       int32_t nInputHeight,
+                                       int32_t stride_height,
+                                       int32_t stride_width,
+                                       int32_t nPadHeight,
+                                       int32_t nPadWidth,
+                                       int32_t nOutHeight,
+                                       int32_t nOutWidth,
+                                       int32_t *pQuantizedMultiplier,
+                                       int32_t *pQuantizedShift,
+                                       int32_t pInZeroPoint,
+                                       int32_t pOutZeroPoint,
+                                       int32_t nActMin,
+                                       int32_t nActMax);
+
+void adi_sharcfx_transpose_conv2d_int8_ctx(
+		const int8_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int32_t* pBiasBuffer,
+		int8_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t pInZeroPoint,
+		int32_t pOutZeroPoint,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext);
+
 void adi_sharcfx_conv2d_kernel3x3_stride1_valid_pad_int8(const int8_t* pInputBuffer,
                                                          const int8_t* pWeightsBuffer,
                                                          const int32_t* pBiasBuffer,
@@ -315,6 +1390,178 @@ void adi_sharcfx_conv2d_kernel1x1_int8(const int8_t* pInputBuffer,
                                        int32_t nInputOffset,
                                        int32_t nOutputOffset);
 
+void adi_sharcfx_conv2d_kernel1x1_pixels_int8(const int8_t* pInputBuffer,
+                                              const int8_t* pWeightsBuffer,
+                                              const int32_t* pBiasBuffer,
+                                              int8_t* pOutputBuffer,
+                                              int32_t nInChannels,
+                                              int32_t nOutChannels,
+                                              int32_t *nQuantizedMultiplier,
+                                              int32_t *nQuantizedShift,
+                                              int32_t nInputOffset,
+                                              int32_t nOutputOffset,
+                                              int32_t nPixelStart,
+                                              int32_t nPixelEnd);
+
+void adi_sharcfx_conv2d_kernel1x1_int4(const int8_t* pInputBuffer,
+                                       const int8_t* pPackedWeights,
+                                       const int32_t* pBiasBuffer,
+                                       int8_t* pOutputBuffer,
+                                       int32_t nBatches,
+                                       int32_t nInChannels,
+                                       int32_t nOutChannels,
+                                       int32_t nSize,
+                                       const int32_t *pQuantizedMultiplier,
+                                       const int32_t *pQuantizedShift,
+                                       int32_t nInputOffset,
+                                       int32_t nOutputOffset,
+                                       int32_t nActMin,
+                                       int32_t nActMax);
+
+void adi_sharcfx_conv2d_kernel1x1_sparse_int8(const int8_t* pInputBuffer,
+                                              const ADI_SHARCFX_SPARSE_WEIGHTS* pSparse,
+                                              const int32_t* pBiasBuffer,
+                                              int8_t* pOutputBuffer,
+                                              int32_t nBatches,
+                                              int32_t nInChannels,
+                                              int32_t nOutChannels,
+                                              int32_t nSize,
+                                              const int32_t *pQuantizedMultiplier,
+                                              const int32_t *pQuantizedShift,
+                                              int32_t nInputOffset,
+                                              int32_t nOutputOffset,
+                                              int32_t nActMin,
+                                              int32_t nActMax);
+
+void adi_sharcfx_conv2d_int16(const int16_t* pInputBuffer,
+                              const int8_t* pWeightsBuffer,
+                              const int64_t* pBiasBuffer,
+                              int16_t* pOutputBuffer,
+                              int32_t nBatches,
+                              int32_t nInChannels,
+                              int32_t nOutChannels,
+                              int32_t nKernelHeight,
+                              int32_t nKernelWidth,
+                              int32_t nInputWidth,
+                              int32_t nInputHeight,
+                              int32_t stride_height,
+                              int32_t stride_width,
+                              int32_t nDilationHeight,
+                              int32_t nDilationWidth,
+                              int32_t nPadHeight,
+                              int32_t nPadWidth,
+                              int32_t nOutHeight,
+                              int32_t nOutWidth,
+                              int32_t *pQuantizedMultiplier,
+                              int32_t *pQuantizedShift,
+                              int32_t nActMin,
+                              int32_t nActMax);
+
+void adi_sharcfx_conv2d_int16_ctx(
+		const int16_t* pInputBuffer,
+		const int8_t* pWeightsBuffer,
+		const int64_t* pBiasBuffer,
+		int16_t* pOutputBuffer,
+		int32_t nBatches,
+		int32_t nInChannels,
+		int32_t nOutChannels,
+		int32_t nKernelHeight,
+		int32_t nKernelWidth,
+		int32_t nInputWidth,
+		int32_t nInputHeight,
+		int32_t stride_height,
+		int32_t stride_width,
+		int32_t nDilationHeight,
+		int32_t nDilationWidth,
+		int32_t nPadHeight,
+		int32_t nPadWidth,
+		int32_t nOutHeight,
+		int32_t nOutWidth,
+		int32_t *pQuantizedMultiplier,
+		int32_t *pQuantizedShift,
+		int32_t nActMin,
+		int32_t nActMax,
+		const ADI_SHARCFX_CONTEXT* pContext);
+
+void adi_sharcfx_conv2d_int16_rows(const int16_t* pInputBuffer,
+                                   const int8_t* pWeightsBuffer,
+                                   const int64_t* pBiasBuffer,
+                                   int16_t* pOutputBuffer,
+                                   int32_t nBatches,
+                                   int32_t nInChannels,
+                                   int32_t nOutChannels,
+                                   int32_t nKernelHeight,
+                                   int32_t nKernelWidth,
+                                   int32_t nInputWidth,
+                                   int32_t nInputHeight,
+                                   int32_t stride_height,
+                                   int32_t stride_width,
+                                   int32_t nDilationHeight,
+                                   int32_t nDilationWidth,
+                                   int32_t nPadHeight,
+                                   int32_t nPadWidth,
+                                   int32_t nOutHeight,
+                                   int32_t nOutWidth,
+                                   int32_t *pQuantizedMultiplier,
+                                   int32_t *pQuantizedShift,
+                                   int32_t nActMin,
+                                   int32_t nActMax,
+                                   int32_t nOutRowStart,
+                                   int32_t nOutRowEnd,
+                                   int8_t* pScratch);
+
+void adi_sharcfx_conv2d_kernel1x1_int16(const int16_t* pInputBuffer,
+                                        const int8_t* pWeightsBuffer,
+                                        const int64_t* pBiasBuffer,
+                                        int16_t* pOutputBuffer,
+                                        int32_t nBatches,
+                                        int32_t nInChannels,
+                                        int32_t nOutChannels,
+                                        int32_t nSize,
+                                        int32_t *pQuantizedMultiplier,
+                                        int32_t *pQuantizedShift,
+                                        int32_t nActMin,
+                                        int32_t nActMax);
+
+void adi_sharcfx_conv2d_kernel3x3_stride1_same_pad_int16(const int16_t* pInputBuffer,
+                                                         const int8_t* pWeightsBuffer,
+                                                         const int64_t* pBiasBuffer,
+                                                         int16_t* pOutputBuffer,
+                                                         int32_t nInChannels,
+                                                         int32_t nOutChannels,
+                                                         int32_t nWidth,
+                                                         int32_t nHeight,
+                                                         int32_t *pQuantizedMultiplier,
+                                                         int32_t *pQuantizedShift,
+                                                         int32_t nActMin,
+                                                         int32_t nActMax);
+
+void adi_sharcfx_conv2d_kernel3x3_stride1_valid_pad_int16(const int16_t* pInputBuffer,
+                                                          const int8_t* pWeightsBuffer,
+                                                          const int64_t* pBiasBuffer,
+                                                          int16_t* pOutputBuffer,
+                                                          int32_t nInChannels,
+                                                          int32_t nOutChannels,
+                                                          int32_t nWidth,
+                                                          int32_t nHeight,
+                                                          int32_t *pQuantizedMultiplier,
+                                                          int32_t *pQuantizedShift,
+                                                          int32_t nActMin,
+                                                          int32_t nActMax);
+
+void adi_sharcfx_conv2d_kernel3x3_stride2_valid_pad_int16(const int16_t* pInputBuffer,
+                                                          const int8_t* pWeightsBuffer,
+                                                          const int64_t* pBiasBuffer,
+                                                          int16_t* pOutputBuffer,
+                                                          int32_t nInChannels,
+                                                          int32_t nOutChannels,
+                                                          int32_t nWidth,
+                                                          int32_t nHeight,
+                                                          int32_t *pQuantizedMultiplier,
+                                                          int32_t *pQuantizedShift,
+                                                          int32_t nActMin,
+                                                          int32_t nActMax);
+
 void adi_sharcfx_conv2d_kernel1x1_noninterleaved_int16(const int16_t *pInputBuffer,
                                                        int16_t *pOutputBuffer,
                                                        const int8_t *pWeightsBuffer,
@@ -0,0 +1,341 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_pad.cpp
+*
+* @brief: contains optimized padding functions
+*
+* @details: contains optimized constant and mirror padding for 8bit and 16bit integer data in the channel interleaved layout
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_nn.h"
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Copy nBytes with aligning loads and variable length stores, no scalar remainder
+inline void pad_copy_bytes(const int8_t *pInput,
+                           int8_t *pOutput,
+                           int32_t nBytes)
+{
+    xb_vec4Mx8 vin;
+    xb_vec4Mx8 *inp = (xb_vec4Mx8 *)pInput;
+    valign ina = PDX_LA_4MX8_PP(inp);
+    xb_vec4Mx8 *outp = (xb_vec4Mx8 *)pOutput;
+    valign outa = PDX_Z_ALIGN();
+
+    for (int32_t n = 0; n < nBytes; n += 4*PDX_M)
+    {
+        PDX_LA_4MX8_XP(vin, ina, inp, 4*PDX_M);
+        PDX_SAV_4MX8_XP(vin, outa, outp, MIN(4*PDX_M, nBytes - n));
+    }
+    PDX_SAPOS_4MX8_FP(outa, outp);//flush
+}
+
+/*UTILITY FUNCTION*/
+//Fill nBytes with a replicated 8bit or 16bit pad value
+inline void pad_fill_bytes(int8_t *pOutput,
+                           int32_t nBytes,
+                           int32_t nPadValue,
+                           int32_t nElementSize)
+{
+    if (nElementSize == sizeof(int8_t))
+    {
+        xb_vec4Mx8 vPad = (int8_t)nPadValue;
+        xb_vec4Mx8 *outp = (xb_vec4Mx8 *)pOutput;
+        valign outa = PDX_Z_ALIGN();
+        for (int32_t n = 0; n < nBytes; n += 4*PDX_M)
+        {
+            PDX_SAV_4MX8_XP(vPad, outa, outp, MIN(4*PDX_M, nBytes - n));
+        }
+        PDX_SAPOS_4MX8_FP(outa, outp);//flush
+    }
+    else
+    {
+        xb_vec2Mx16 vPad = (int16_t)nPadValue;
+        xb_vec2Mx16 *outp = (xb_vec2Mx16 *)pOutput;
+        valign outa = PDX_Z_ALIGN();
+        for (int32_t n = 0; n < nBytes; n += 4*PDX_M)
+        {
+            PDX_SAV_2MX16_XP(vPad, outa, outp, MIN(4*PDX_M, nBytes - n));
+        }
+        PDX_SAPOS_2MX16_FP(outa, outp);//flush
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Constant padding of [batches][height][width][channels] data with elements of nElementSize bytes
+void pad_constant(const int8_t *pInputBuffer,
+                  int8_t *pOutputBuffer,
+                  int32_t nBatches,
+                  int32_t nInHeight,
+                  int32_t nInWidth,
+                  int32_t nChannels,
+                  int32_t nPadTop,
+                  int32_t nPadBottom,
+                  int32_t nPadLeft,
+                  int32_t nPadRight,
+                  int32_t nPadValue,
+                  int32_t nElementSize)
+{
+    int32_t nPixelBytes = nChannels * nElementSize;
+    int32_t nInRowBytes = nInWidth * nPixelBytes;
+    int32_t nOutRowBytes = (nInWidth + nPadLeft + nPadRight) * nPixelBytes;
+    const int8_t *pIn = pInputBuffer;
+    int8_t *pOut = pOutputBuffer;
+
+    for (int32_t nBatch = 0; nBatch < nBatches; nBatch++)
+    {
+        //top padding rows are contiguous
+        pad_fill_bytes(pOut, nPadTop * nOutRowBytes, nPadValue, nElementSize);
+        pOut += nPadTop * nOutRowBytes;
+
+        for (int32_t nRow = 0; nRow < nInHeight; nRow++)
+        {
+            pad_fill_bytes(pOut, nPadLeft * nPixelBytes, nPadValue, nElementSize);
+            pOut += nPadLeft * nPixelBytes;
+            pad_copy_bytes(pIn, pOut, nInRowBytes);
+            pOut += nInRowBytes;
+            pIn += nInRowBytes;
+            pad_fill_bytes(pOut, nPadRight * nPixelBytes, nPadValue, nElementSize);
+            pOut += nPadRight * nPixelBytes;
+        }
+
+        pad_fill_bytes(pOut, nPadBottom * nOutRowBytes, nPadValue, nElementSize);
+        pOut += nPadBottom * nOutRowBytes;
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Mirror padding of [batches][height][width][channels] data with elements of nElementSize bytes.
+//The middle rows are built first, the top and bottom rows are then copied from the finished output rows
+void pad_mirror(const int8_t *pInputBuffer,
+                int8_t *pOutputBuffer,
+                int32_t nBatches,
+                int32_t nInHeight,
+                int32_t nInWidth,
+                int32_t nChannels,
+                int32_t nPadTop,
+                int32_t nPadBottom,
+                int32_t nPadLeft,
+                int32_t nPadRight,
+                int32_t nMode,
+                int32_t nElementSize)
+{
+    int32_t nPixelBytes = nChannels * nElementSize;
+    int32_t nInRowBytes = nInWidth * nPixelBytes;
+    int32_t nOutRowBytes = (nInWidth + nPadLeft + nPadRight) * nPixelBytes;
+    int32_t nEdge = (nMode == ADI_SHARCFX_MIRROR_PAD_REFLECT) ? 1 : 0;    //reflect skips the edge element
+
+    for (int32_t nBatch = 0; nBatch < nBatches; nBatch++)
+    {
+        const int8_t *pIn = pInputBuffer + nBatch * nInHeight * nInRowBytes;
+        int8_t *pOut = pOutputBuffer + nBatch * (nInHeight + nPadTop + nPadBottom) * nOutRowBytes;
+
+        for (int32_t nRow = 0; nRow < nInHeight; nRow++)
+        {
+            const int8_t *pInRow = pIn + nRow * nInRowBytes;
+            int8_t *pOutRow = pOut + (nRow + nPadTop) * nOutRowBytes;
+            for (int32_t nCol = 0; nCol < nPadLeft; nCol++)
+            {
+                int32_t nSrc = nPadLeft - 1 - nCol + nEdge;
+                pad_copy_bytes(pInRow + nSrc * nPixelBytes, pOutRow + nCol * nPixelBytes, nPixelBytes);
+            }
+            pad_copy_bytes(pInRow, pOutRow + nPadLeft * nPixelBytes, nInRowBytes);
+            for (int32_t nCol = 0; nCol < nPadRight; nCol++)
+            {
+                int32_t nSrc = nInWidth - 1 - nCol - nEdge;
+                pad_copy_bytes(pInRow + nSrc * nPixelBytes, pOutRow + (nPadLeft + nInWidth + nCol) * nPixelBytes, nPixelBytes);
+            }
+        }
+
+        for (int32_t nRow = 0; nRow < nPadTop; nRow++)
+        {
+            int32_t nSrc = nPadTop - 1 - nRow + nEdge;
+            pad_copy_bytes(pOut + (nSrc + nPadTop) * nOutRowBytes, pOut + nRow * nOutRowBytes, nOutRowBytes);
+        }
+        for (int32_t nRow = 0; nRow < nPadBottom; nRow++)
+        {
+            int32_t nSrc = nInHeight - 1 - nRow - nEdge;
+            pad_copy_bytes(pOut + (nSrc + nPadTop) * nOutRowBytes, pOut + (nPadTop + nInHeight + nRow) * nOutRowBytes, nOutRowBytes);
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_pad_int8
+* @brief optimized constant padding function for int8
+*
+* @details optimized constant padding of 8-bit integer [batches][height][width][channels] data with independent
+* padding per side. Input rows are moved with aligning vector loads and variable length stores and the padding is
+* written with replicated vector stores, without scalar remainders. Also used for the padding of the convolutions.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] nBatches - # of batches
+* @param [in] nInHeight - input height
+* @param [in] nInWidth - input width
+* @param [in] nChannels - # of channels
+* @param [in] nPadTop - # of rows added above
+* @param [in] nPadBottom - # of rows added below
+* @param [in] nPadLeft - # of columns added to the left
+* @param [in] nPadRight - # of columns added to the right
+* @param [in] nPadValue - pad value, usually the input zeropoint
+*
+* @param [out] pOutputBuffer - output data, [batches][height+top+bottom][width+left+right][channels]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_pad_int8(const int8_t* pInputBuffer,
+                          int8_t* pOutputBuffer,
+                          int32_t nBatches,
+                          int32_t nInHeight,
+                          int32_t nInWidth,
+                          int32_t nChannels,
+                          int32_t nPadTop,
+                          int32_t nPadBottom,
+                          int32_t nPadLeft,
+                          int32_t nPadRight,
+                          int32_t nPadValue)
+{
+    pad_constant(pInputBuffer, pOutputBuffer, nBatches, nInHeight, nInWidth, nChannels,
+                 nPadTop, nPadBottom, nPadLeft, nPadRight, nPadValue, sizeof(int8_t));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_pad_int16
+* @brief optimized constant padding function for int16
+*
+* @details optimized constant padding of 16-bit integer [batches][height][width][channels] data with independent
+* padding per side, as adi_sharcfx_pad_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] nBatches - # of batches
+* @param [in] nInHeight - input height
+* @param [in] nInWidth - input width
+* @param [in] nChannels - # of channels
+* @param [in] nPadTop - # of rows added above
+* @param [in] nPadBottom - # of rows added below
+* @param [in] nPadLeft - # of columns added to the left
+* @param [in] nPadRight - # of columns added to the right
+* @param [in] nPadValue - pad value
+*
+* @param [out] pOutputBuffer - output data, [batches][height+top+bottom][width+left+right][channels]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_pad_int16(const int16_t* pInputBuffer,
+                           int16_t* pOutputBuffer,
+                           int32_t nBatches,
+                           int32_t nInHeight,
+                           int32_t nInWidth,
+                           int32_t nChannels,
+                           int32_t nPadTop,
+                           int32_t nPadBottom,
+                           int32_t nPadLeft,
+                           int32_t nPadRight,
+                           int32_t nPadValue)
+{
+    pad_constant((const int8_t*)pInputBuffer, (int8_t*)pOutputBuffer, nBatches, nInHeight, nInWidth, nChannels,
+                 nPadTop, nPadBottom, nPadLeft, nPadRight, nPadValue, sizeof(int16_t));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_mirror_pad_int8
+* @brief optimized mirror padding function for int8
+*
+* @details optimized mirror padding of 8-bit integer [batches][height][width][channels] data with independent
+* padding per side. ADI_SHARCFX_MIRROR_PAD_REFLECT mirrors around the edge element and needs padding smaller than the
+* dimension, ADI_SHARCFX_MIRROR_PAD_SYMMETRIC includes the edge element and needs padding up to the dimension.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] nBatches - # of batches
+* @param [in] nInHeight - input height
+* @param [in] nInWidth - input width
+* @param [in] nChannels - # of channels
+* @param [in] nPadTop - # of rows added above
+* @param [in] nPadBottom - # of rows added below
+* @param [in] nPadLeft - # of columns added to the left
+* @param [in] nPadRight - # of columns added to the right
+* @param [in] nMode - ADI_SHARCFX_MIRROR_PAD_REFLECT or ADI_SHARCFX_MIRROR_PAD_SYMMETRIC
+*
+* @param [out] pOutputBuffer - output data, [batches][height+top+bottom][width+left+right][channels]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_mirror_pad_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nBatches,
+                                 int32_t nInHeight,
+                                 int32_t nInWidth,
+                                 int32_t nChannels,
+                                 int32_t nPadTop,
+                                 int32_t nPadBottom,
+                                 int32_t nPadLeft,
+                                 int32_t nPadRight,
+                                 int32_t nMode)
+{
+    pad_mirror(pInputBuffer, pOutputBuffer, nBatches, nInHeight, nInWidth, nChannels,
+               nPadTop, nPadBottom, nPadLeft, nPadRight, nMode, sizeof(int8_t));
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_mirror_pad_int16
+* @brief optimized mirror padding function for int16
+*
+* @details optimized mirror padding of 16-bit integer [batches][height][width][channels] data with independent
+* padding per side, as adi_sharcfx_mirror_pad_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data
+* @param [in] nBatches - # of batches
+* @param [in] nInHeight - input height
+* @param [in] nInWidth - input width
+* @param [in] nChannels - # of channels
+* @param [in] nPadTop - # of rows added above
+* @param [in] nPadBottom - # of rows added below
+* @param [in] nPadLeft - # of columns added to the left
+* @param [in] nPadRight - # of columns added to the right
+* @param [in] nMode - ADI_SHARCFX_MIRROR_PAD_REFLECT or ADI_SHARCFX_MIRROR_PAD_SYMMETRIC
+*
+* @param [out] pOutputBuffer - output data, [batches][height+top+bottom][width+left+right][channels]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_mirror_pad_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nBatches,
+                                  int32_t nInHeight,
+                                  int32_t nInWidth,
+                                  int32_t nChannels,
+                                  int32_t nPadTop,
+                                  int32_t nPadBottom,
+                                  int32_t nPadLeft,
+                                  int32_t nPadRight,
+                                  int32_t nMode)
+{
+    pad_mirror((const int8_t*)pInputBuffer, (int8_t*)pOutputBuffer, nBatches, nInHeight, nInWidth, nChannels,
+               nPadTop, nPadBottom, nPadLeft, nPadRight, nMode, sizeof(int16_t));
+}
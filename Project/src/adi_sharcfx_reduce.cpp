@@ -0,0 +1,412 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_reduce.cpp
+*
+* @brief: contains optimized version of reduction operators
+*
+* @details: contains optimized sum, mean and max reductions for 8bit and 16bit integer input
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Requantize a 40bit sum with the per tensor multiplier and shift, saturating the sum to 32bit first
+inline int32_t reduce_requantize(xb_int40 sat_sum,
+                                 int32_t nQuantizedMultiplier,
+                                 int32_t nQuantizedShift)
+{
+    xb_int32 temp;
+    xb_int80 product;
+
+    sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+    sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+    temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+    product = PDX_MULW_32(temp, (xb_int32)nQuantizedMultiplier);    //product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+    product = PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+    temp = PDX_PACKQSRV_80(product,ROUNDING_MODE);                  //same rounding as quantize_and_store_channels of the channel path
+    return (int32_t)temp;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_reduce_sum_int8
+* @brief optimized sum/mean reduction function
+*
+* @details optimized sum reduction for 8-bit integer input. The tensor is collapsed to [outer][reduce][inner] and
+* reduced over the middle axis, e.g. global average pooling of a channel interleaved HWC tensor is outer = 1,
+* reduce = H*W, inner = C. When inner > 1 the inner (channel) axis is vectorized and the reduced axis is accumulated
+* in 40bit lanes, otherwise the contiguous reduced axis is vectorized. There is a single requantization per output, with the
+same rounding on both paths, so an output does not depend on the tensor layout.
+* For MEAN pass a multiplier that includes 1/reduce, as computed for the TFLite MEAN operator.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [outer][reduce][inner]
+* @param [in] nOuter - product of the dimensions before the reduced axes
+* @param [in] nReduce - product of the reduced dimensions
+* @param [in] nInner - product of the dimensions after the reduced axes
+* @param [in] nInputOffset - input offset (negated input zeropoint)
+* @param [in] nQuantizedMultiplier - output multiplier
+* @param [in] nQuantizedShift - output shift
+* @param [in] nOutputOffset - output zeropoint
+*
+* @param [out] pOutputBuffer - output data, [outer][inner]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_reduce_sum_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nOuter,
+                                 int32_t nReduce,
+                                 int32_t nInner,
+                                 int32_t nInputOffset,
+                                 int32_t nQuantizedMultiplier,
+                                 int32_t nQuantizedShift,
+                                 int32_t nOutputOffset)
+{
+    xb_vec2Mx16 vin;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx40 acc;
+
+    if (nInner == 1)
+    {
+        vbool4M temp_mask;
+        vbool2M acc_mask;
+        for (int32_t nOut = 0; nOut < nOuter; nOut++)
+        {
+            xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pInputBuffer + nOut*nReduce);
+            valign ina = PDX_LA_2MX8_PP(inp);
+            acc = 0;
+            int32_t n;
+            for (n = 0; n + 2*PDX_M <= nReduce; n += 2*PDX_M)
+            {
+                PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+                PDX_MULAQW_2MX16(acc, vin, vOne);
+            }
+            if (nReduce % (2*PDX_M))
+            {
+                PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+                temp_mask = PDX_MOVB_AU32((0b1<<(nReduce % (2*PDX_M))) - 1);
+                acc_mask = PDX_CVTBB2M_B4M_L(temp_mask);
+                PDX_MULAQW_2MX16_T(acc, vin, vOne, acc_mask);
+            }
+            xb_int40 sat_sum = PDX_RADD_2MX40(acc);
+            sat_sum += ((xb_int40)nReduce*nInputOffset)<<1;     //offset<<1 to match the doubled products
+            int32_t nResult = reduce_requantize(sat_sum, nQuantizedMultiplier, nQuantizedShift);
+            nResult += nOutputOffset;
+            nResult = MIN(nResult, INT_8BIT_MAX);
+            nResult = MAX(nResult, INT_8BIT_MIN);
+            pOutputBuffer[nOut] = (int8_t)nResult;
+        }
+        return;
+    }
+
+    //per lane constants for the channel vectorized path, the input offset is applied once as a bias of reduce*offset
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M], pOffset[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+        pOffset[i] = nReduce*nInputOffset;
+    }
+    xb_vecMx32 vOutZP = nOutputOffset;
+    xb_vecMx32 vmin = INT_8BIT_MIN;
+    xb_vecMx32 vmax = INT_8BIT_MAX;
+
+    for (int32_t nOut = 0; nOut < nOuter; nOut++)
+    {
+        const int8_t *pIn = pInputBuffer + nOut*nReduce*nInner;
+        xb_vecMx8 *outp = (xb_vecMx8 *)(pOutputBuffer + nOut*nInner);
+        valign outa = PDX_Z_ALIGN();
+
+        for (int32_t nChannel = 0; nChannel < nInner; nChannel += 2*PDX_M)
+        {
+            acc = 0;
+            for (int32_t r = 0; r < nReduce; r++)
+            {
+                xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pIn + r*nInner + nChannel);
+                valign ina = PDX_LA_2MX8_PP(inp);
+                PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+                PDX_MULAQW_2MX16(acc, vin, vOne);
+            }
+            quantize_and_store_channels(acc, pOffset, pMult, pShift, MIN(2*PDX_M, nInner - nChannel),
+                                        vOutZP, vmin, vmax, outp, outa);
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_reduce_sum_int16
+* @brief optimized sum/mean reduction function
+*
+* @details optimized sum reduction for 16-bit integer input. Same layout and dispatch as adi_sharcfx_reduce_sum_int8,
+* 16bit tensors are symmetric and the products with 1 are accumulated undoubled.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [outer][reduce][inner]
+* @param [in] nOuter - product of the dimensions before the reduced axes
+* @param [in] nReduce - product of the reduced dimensions
+* @param [in] nInner - product of the dimensions after the reduced axes
+* @param [in] nQuantizedMultiplier - output multiplier
+* @param [in] nQuantizedShift - output shift
+*
+* @param [out] pOutputBuffer - output data, [outer][inner]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_reduce_sum_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nOuter,
+                                  int32_t nReduce,
+                                  int32_t nInner,
+                                  int32_t nQuantizedMultiplier,
+                                  int32_t nQuantizedShift)
+{
+    xb_vec2Mx16 vin;
+    xb_vec2Mx16 vOne = 1;
+    xb_vec2Mx40 acc;
+
+    if (nInner == 1)
+    {
+        for (int32_t nOut = 0; nOut < nOuter; nOut++)
+        {
+            xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pInputBuffer + nOut*nReduce);
+            valign ina = PDX_LA_2MX16_PP(inp);
+            int32_t nBytesLeft = nReduce*sizeof(int16_t);
+            acc = 0;
+            for (int32_t n = 0; n < nReduce; n += 2*PDX_M)
+            {
+                PDX_LAV_2MX16_XP(vin, ina, inp, nBytesLeft);   //lanes past nReduce are loaded as 0
+                nBytesLeft -= PDX_4M;
+                PDX_MULAW_2MX16(acc, vin, vOne);
+            }
+            //sum is not doubled, shift one more to match PDX_PACKQSRV_80
+            int32_t nResult = reduce_requantize(PDX_RADD_2MX40(acc), nQuantizedMultiplier, nQuantizedShift + 1);
+            nResult = MIN(nResult, INT_16BIT_MAX);
+            nResult = MAX(nResult, INT_16BIT_MIN);
+            pOutputBuffer[nOut] = (int16_t)nResult;
+        }
+        return;
+    }
+
+    int32_t pMult[2*PDX_M], pShift[2*PDX_M];
+    for (int32_t i = 0; i < 2*PDX_M; i++)
+    {
+        pMult[i] = nQuantizedMultiplier;
+        pShift[i] = nQuantizedShift;
+    }
+    xb_vecMx32 vmin = INT_16BIT_MIN;
+    xb_vecMx32 vmax = INT_16BIT_MAX;
+
+    for (int32_t nOut = 0; nOut < nOuter; nOut++)
+    {
+        const int16_t *pIn = pInputBuffer + nOut*nReduce*nInner;
+        xb_vecMx16 *outp = (xb_vecMx16 *)(pOutputBuffer + nOut*nInner);
+        valign outa = PDX_Z_ALIGN();
+
+        for (int32_t nChannel = 0; nChannel < nInner; nChannel += 2*PDX_M)
+        {
+            acc = 0;
+            for (int32_t r = 0; r < nReduce; r++)
+            {
+                xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pIn + r*nInner + nChannel);
+                valign ina = PDX_LA_2MX16_PP(inp);
+                PDX_LA_2MX16_XP(vin, ina, inp, 2*PDX_M*sizeof(int16_t));
+                PDX_MULAW_2MX16(acc, vin, vOne);
+            }
+            quantize_and_store_channels_int16(acc, NULL, pMult, pShift, MIN(2*PDX_M, nInner - nChannel),
+                                              vmin, vmax, outp, outa);
+        }
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_reduce_max_int8
+* @brief optimized max reduction function
+*
+* @details optimized max reduction for 8-bit integer input over the middle axis of [outer][reduce][inner].
+* Input and output share the same quantization, as required by the TFLite REDUCE_MAX operator.
+* When inner > 1 the inner (channel) axis is vectorized, otherwise the contiguous reduced axis is vectorized
+* and the lane maxima are combined at the end.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [outer][reduce][inner]
+* @param [in] nOuter - product of the dimensions before the reduced axes
+* @param [in] nReduce - product of the reduced dimensions
+* @param [in] nInner - product of the dimensions after the reduced axes
+*
+* @param [out] pOutputBuffer - output data, [outer][inner]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_reduce_max_int8(const int8_t* pInputBuffer,
+                                 int8_t* pOutputBuffer,
+                                 int32_t nOuter,
+                                 int32_t nReduce,
+                                 int32_t nInner)
+{
+    xb_vec2Mx16 vin, vmax;
+    int16_t pLaneMax[2*PDX_M];
+
+    if (nInner == 1)
+    {
+        for (int32_t nOut = 0; nOut < nOuter; nOut++)
+        {
+            const int8_t *pIn = pInputBuffer + nOut*nReduce;
+            xb_vec2Mx8 *inp = (xb_vec2Mx8 *)pIn;
+            valign ina = PDX_LA_2MX8_PP(inp);
+            int32_t nMax = INT_8BIT_MIN;
+            int32_t n = 0;
+            if (nReduce >= 2*PDX_M)
+            {
+                vmax = INT_8BIT_MIN;
+                for (; n + 2*PDX_M <= nReduce; n += 2*PDX_M)
+                {
+                    PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+                    vmax = PDX_MAX_2MX16(vmax, vin);
+                }
+                //combine the lane maxima
+                xb_vec2Mx16 *maxp = (xb_vec2Mx16 *)pLaneMax;
+                valign maxa = PDX_Z_ALIGN();
+                PDX_SAV_2MX16_XP(vmax, maxa, maxp, 2*PDX_M*sizeof(int16_t));
+                PDX_SAPOS_2MX16_FP(maxa, maxp);
+                for (int32_t i = 0; i < 2*PDX_M; i++)
+                {
+                    nMax = MAX(nMax, (int32_t)pLaneMax[i]);
+                }
+            }
+            for (; n < nReduce; n++)
+            {
+                nMax = MAX(nMax, (int32_t)pIn[n]);
+            }
+            pOutputBuffer[nOut] = (int8_t)nMax;
+        }
+        return;
+    }
+
+    for (int32_t nOut = 0; nOut < nOuter; nOut++)
+    {
+        const int8_t *pIn = pInputBuffer + nOut*nReduce*nInner;
+        xb_vec2Mx8 *outp = (xb_vec2Mx8 *)(pOutputBuffer + nOut*nInner);
+        valign outa = PDX_Z_ALIGN();
+
+        for (int32_t nChannel = 0; nChannel < nInner; nChannel += 2*PDX_M)
+        {
+            vmax = INT_8BIT_MIN;
+            for (int32_t r = 0; r < nReduce; r++)
+            {
+                xb_vec2Mx8 *inp = (xb_vec2Mx8 *)(pIn + r*nInner + nChannel);
+                valign ina = PDX_LA_2MX8_PP(inp);
+                PDX_LA16_2MX8_XP(vin, ina, inp, 2*PDX_M);
+                vmax = PDX_MAX_2MX16(vmax, vin);
+            }
+            PDX_SAV16_2MX8_XP(vmax, outa, outp, MIN(2*PDX_M, nInner - nChannel));
+        }
+        PDX_SAPOS_2MX8_FP(outa, outp);
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_reduce_max_int16
+* @brief optimized max reduction function
+*
+* @details optimized max reduction for 16-bit integer input. Same layout and dispatch as adi_sharcfx_reduce_max_int8.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [outer][reduce][inner]
+* @param [in] nOuter - product of the dimensions before the reduced axes
+* @param [in] nReduce - product of the reduced dimensions
+* @param [in] nInner - product of the dimensions after the reduced axes
+*
+* @param [out] pOutputBuffer - output data, [outer][inner]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_reduce_max_int16(const int16_t* pInputBuffer,
+                                  int16_t* pOutputBuffer,
+                                  int32_t nOuter,
+                                  int32_t nReduce,
+                                  int32_t nInner)
+{
+    xb_vec2Mx16 vin, vmax;
+    int16_t pLaneMax[2*PDX_M];
+
+    if (nInner == 1)
+    {
+        for (int32_t nOut = 0; nOut < nOuter; nOut++)
+        {
+            const int16_t *pIn = pInputBuffer + nOut*nReduce;
+            xb_vec2Mx16 *inp = (xb_vec2Mx16 *)pIn;
+            valign ina = PDX_LA_2MX16_PP(inp);
+            int32_t nMax = INT_16BIT_MIN;
+            int32_t n = 0;
+            if (nReduce >= 2*PDX_M)
+            {
+                vmax = INT_16BIT_MIN;
+                for (; n + 2*PDX_M <= nReduce; n += 2*PDX_M)
+                {
+                    PDX_LA_2MX16_XP(vin, ina, inp, 2*PDX_M*sizeof(int16_t));
+                    vmax = PDX_MAX_2MX16(vmax, vin);
+                }
+                //combine the lane maxima
+                xb_vec2Mx16 *maxp = (xb_vec2Mx16 *)pLaneMax;
+                valign maxa = PDX_Z_ALIGN();
+                PDX_SAV_2MX16_XP(vmax, maxa, maxp, 2*PDX_M*sizeof(int16_t));
+                PDX_SAPOS_2MX16_FP(maxa, maxp);
+                for (int32_t i = 0; i < 2*PDX_M; i++)
+                {
+                    nMax = MAX(nMax, (int32_t)pLaneMax[i]);
+                }
+            }
+            for (; n < nReduce; n++)
+            {
+                nMax = MAX(nMax, (int32_t)pIn[n]);
+            }
+            pOutputBuffer[nOut] = (int16_t)nMax;
+        }
+        return;
+    }
+
+    for (int32_t nOut = 0; nOut < nOuter; nOut++)
+    {
+        const int16_t *pIn = pInputBuffer + nOut*nReduce*nInner;
+        xb_vec2Mx16 *outp = (xb_vec2Mx16 *)(pOutputBuffer + nOut*nInner);
+        valign outa = PDX_Z_ALIGN();
+
+        for (int32_t nChannel = 0; nChannel < nInner; nChannel += 2*PDX_M)
+        {
+            vmax = INT_16BIT_MIN;
+            for (int32_t r = 0; r < nReduce; r++)
+            {
+                xb_vec2Mx16 *inp = (xb_vec2Mx16 *)(pIn + r*nInner + nChannel);
+                valign ina = PDX_LA_2MX16_PP(inp);
+                PDX_LA_2MX16_XP(vin, ina, inp, 2*PDX_M*sizeof(int16_t));
+                vmax = PDX_MAX_2MX16(vmax, vin);
+            }
+            PDX_SAV_2MX16_XP(vmax, outa, outp, MIN(2*PDX_M, nInner - nChannel)*sizeof(int16_t));
+        }
+        PDX_SAPOS_2MX16_FP(outa, outp);
+    }
+}
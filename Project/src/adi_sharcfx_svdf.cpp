@@ -0,0 +1,178 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_svdf.cpp
+*
+* @brief: contains optimized version of the SVDF layer
+*
+* @details: contains optimized version of the singular value decomposition filter (SVDF) layer for 8bit integer input
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "adi_sharcfx_internal.h"
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Requantize a 40bit sum with a 32bit multiplier and shift and return the 32bit result
+//sum is expected to hold doubled products, as produced by PDX_MULAQW_2MX16
+inline int32_t svdf_requantize(xb_int40 sat_sum,
+                               int32_t nQuantizedMultiplier,
+                               int32_t nQuantizedShift)
+{
+    xb_int32 temp;
+    xb_int80 product;
+
+    sat_sum = MIN(sat_sum, (xb_int40)INT_32BIT_MAX);
+    sat_sum = MAX(sat_sum, (xb_int40)INT_32BIT_MIN);
+    temp = (xb_int32)((int32_t)((int64_t)PDX_CVT64_40(sat_sum)));    //convert 40bit var into 32bit to perform multiplication
+
+    product = PDX_MULW_32(temp, (xb_int32)nQuantizedMultiplier);    //product(80bit) = temp(32bit) * nQuantizedMultiplier(32bit)
+    product = PDX_SLA_80(product, (xb_int32)nQuantizedShift);        //shift result by quantization multiplier
+    temp = PDX_PACKQSRV_80(product,ROUNDING_MODE_2);                //packs 80bit product into 32bit var with saturation and rounding
+    return (int32_t)temp;
+}
+
+/*UTILITY FUNCTION*/
+//Accumulate nLength products of 16bit state and 16bit time weights into acc.
+//Variable length loads zero the lanes past nLength, so the tail needs no mask
+inline void svdf_time_dot(xb_vec2Mx40 &acc,
+                          const int16_t *pState,
+                          const int16_t *pWeights,
+                          int32_t nLength)
+{
+    xb_vec2Mx16 vState, vWt;
+    xb_vec2Mx16 *sp = (xb_vec2Mx16 *)pState;
+    xb_vec2Mx16 *wp = (xb_vec2Mx16 *)pWeights;
+    valign sa = PDX_LA_2MX16_PP(sp);
+    valign wa = PDX_LA_2MX16_PP(wp);
+    int32_t nBytesLeft = nLength*sizeof(int16_t);
+
+    for (int32_t n = 0; n < nLength; n += 2*PDX_M)
+    {
+        PDX_LAV_2MX16_XP(vState, sa, sp, nBytesLeft);
+        PDX_LAV_2MX16_XP(vWt, wa, wp, nBytesLeft);
+        nBytesLeft -= PDX_4M;
+        //16bit x 16bit products are not doubled to keep headroom in the 40bit lanes
+        PDX_MULAW_2MX16(acc, vState, vWt);
+    }
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_svdf_int8
+* @brief optimized SVDF function
+*
+* @details optimized singular value decomposition filter for 8-bit integer input and 16-bit activation state.
+* The activation state is a circular buffer [batch][filter][memory] with the write position kept by the caller in pStateIndex,
+* so no state is moved between frames. The feature filter uses the fully connected MAC core and the time filter
+* dot products are computed as two contiguous vector segments around the write position.
+*
+* Parameters:
+* @param [in] pInputBuffer - input data, [batch][input size]
+* @param [in] pWeightsFeature - feature weights, [filters][input size]
+* @param [in] pWeightsTime - time weights, [filters][memory size], oldest to newest
+* @param [in] pBiasBuffer - bias per unit, can be NULL
+* @param [in,out] pStateBuffer - circular activation state, zero initialised before the first frame
+* @param [in,out] pStateIndex - slot written by the next frame, 0 before the first frame
+* @param [in] nBatches - batch size
+* @param [in] nInputSize - input depth
+* @param [in] nFilters - # of filters (units * rank)
+* @param [in] nMemorySize - # of frames kept in the state
+* @param [in] nRank - rank of the filter
+* @param [in] nInputOffset - input offset (negated input zeropoint)
+* @param [in] nQuantizedMultiplier1 - multiplier from feature output to state
+* @param [in] nQuantizedShift1 - shift from feature output to state
+* @param [in] nQuantizedMultiplier2 - multiplier from time output to layer output
+* @param [in] nQuantizedShift2 - shift from time output to layer output
+* @param [in] nOutputOffset - output zeropoint
+*
+* @param [out] pOutputBuffer - output data, [batch][filters/rank]
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_svdf_int8(const int8_t* pInputBuffer,
+                           const int8_t* pWeightsFeature,
+                           const int16_t* pWeightsTime,
+                           const int32_t* pBiasBuffer,
+                           int16_t* pStateBuffer,
+                           int32_t* pStateIndex,
+                           int8_t* pOutputBuffer,
+                           int32_t nBatches,
+                           int32_t nInputSize,
+                           int32_t nFilters,
+                           int32_t nMemorySize,
+                           int32_t nRank,
+                           int32_t nInputOffset,
+                           int32_t nQuantizedMultiplier1,
+                           int32_t nQuantizedShift1,
+                           int32_t nQuantizedMultiplier2,
+                           int32_t nQuantizedShift2,
+                           int32_t nOutputOffset)
+{
+    xb_vec2Mx16 vInZP = nInputOffset;
+    xb_vec2Mx16 vFilterZP = 0;
+    xb_vec2Mx40 acc;
+    xb_int40 sat_sum;
+    int32_t nUnits = nFilters / nRank;
+
+    //slot receiving this frame's feature output, the oldest entry follows it
+    int32_t nWrite = *pStateIndex;
+    int32_t nOldest = nMemorySize - nWrite - 1;//# of entries after the write slot
+
+    for (int32_t b = 0; b < nBatches; b++)
+    {
+        const int8_t *pInput = pInputBuffer + b*nInputSize;
+        int16_t *pState = pStateBuffer + b*nFilters*nMemorySize;
+
+        //Feature filter: FC over the input, result goes to the newest slot of every filter
+        for (int32_t nFilter = 0; nFilter < nFilters; nFilter++)
+        {
+            acc = fully_connected_int8_mac(pInput, pWeightsFeature + nFilter*nInputSize, nInputSize, vInZP, vFilterZP);
+            int32_t nOut = svdf_requantize(PDX_RADD_2MX40(acc), nQuantizedMultiplier1, nQuantizedShift1);
+            nOut = MIN(nOut, INT_16BIT_MAX);
+            nOut = MAX(nOut, INT_16BIT_MIN);
+            pState[nFilter*nMemorySize + nWrite] = (int16_t)nOut;
+        }
+
+        //Time filter, rank reduction, bias and requantization per unit
+        for (int32_t nUnit = 0; nUnit < nUnits; nUnit++)
+        {
+            acc = 0;
+            for (int32_t r = 0; r < nRank; r++)
+            {
+                int32_t nFilter = nUnit*nRank + r;
+                const int16_t *pFilterState = pState + nFilter*nMemorySize;
+                const int16_t *pFilterWt = pWeightsTime + nFilter*nMemorySize;
+
+                //oldest entries sit after the write slot and meet the first time weights
+                svdf_time_dot(acc, pFilterState + nWrite + 1, pFilterWt, nOldest);
+                //entries up to and including the write slot are the most recent ones
+                svdf_time_dot(acc, pFilterState, pFilterWt + nOldest, nWrite + 1);
+            }
+            sat_sum = PDX_RADD_2MX40(acc);
+            if (pBiasBuffer)
+            {
+                sat_sum += (xb_int40)pBiasBuffer[nUnit];
+            }
+            //time products are not doubled, shift one more to match PDX_PACKQSRV_80
+            int32_t nOut = svdf_requantize(sat_sum, nQuantizedMultiplier2, nQuantizedShift2 + 1);
+            nOut += nOutputOffset;
+            nOut = MIN(nOut, INT_8BIT_MAX);
+            nOut = MAX(nOut, INT_8BIT_MIN);
+            pOutputBuffer[b*nUnits + nUnit] = (int8_t)nOut;
+        }
+    }
+
+    //advance the circular buffer for the next frame
+    *pStateIndex = (nWrite + 1 == nMemorySize) ? 0 : nWrite + 1;
+}
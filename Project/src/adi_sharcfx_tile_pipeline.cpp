@@ -0,0 +1,178 @@
+/**
+********************************************************************************
+*
+* @file: adi_sharcfx_tile_pipeline.cpp
+*
+* @brief: contains the double buffered tile pipeline
+*
+* @details: contains the pluggable copy engine and the double buffered L1 tile pipeline used to stage tiles from L3 while the previous tile is computed
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include <string.h>
+#include "adi_sharcfx_nn.h"
+
+/*============= F U N C T I O N P R O T O T Y P E S =============*/
+static void copy_engine_memcpy_start(void *pDst,
+                                     const void *pSrc,
+                                     int32_t nBytes,
+                                     void *pEngineData);
+
+static void copy_engine_memcpy_wait(void *pEngineData);
+
+/*============= D A T A =============*/
+static ADI_SHARCFX_COPY_ENGINE sMemcpyEngine = {copy_engine_memcpy_start, copy_engine_memcpy_wait, NULL};
+static ADI_SHARCFX_COPY_ENGINE *pCopyEngine = &sMemcpyEngine;     /*engine of the tiled kernels without a context engine*/
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Synchronous copy engine, the copy is complete when the start function returns
+static void copy_engine_memcpy_start(void *pDst,
+                                     const void *pSrc,
+                                     int32_t nBytes,
+                                     void *pEngineData)
+{
+    memcpy(pDst, pSrc, nBytes);
+}
+
+static void copy_engine_memcpy_wait(void *pEngineData)
+{
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_set_copy_engine
+* @brief selects the library copy engine of the tiled kernels
+*
+* @details selects the copy engine the tiled kernels stage their tiles with when they are called without a context or with
+* a context whose pCopyEngine is NULL. An asynchronous engine, e.g. MDMA on the target, starts a transfer in pfStart and
+* blocks until all transfers started so far are complete in pfWait. The default engine is a synchronous memcpy, which is
+* also the stand-in for host builds.
+* The library engine is a global that is not synchronized. Select it once before any kernel runs and before threads or
+* cores that run kernels are started. Models running concurrently with an asynchronous engine set their own engine in
+* the pCopyEngine of their contexts instead, so a wait only covers the copies of its own context.
+*
+* Parameters:
+* @param [in] pEngine - copy engine, NULL selects the memcpy engine
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_set_copy_engine(ADI_SHARCFX_COPY_ENGINE* pEngine)
+{
+    pCopyEngine = pEngine ? pEngine : &sMemcpyEngine;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_get_copy_engine
+* @brief returns the library copy engine of the tiled kernels
+*
+* @return current library copy engine
+*
+*******************************************************************************
+*/
+ADI_SHARCFX_COPY_ENGINE* adi_sharcfx_get_copy_engine(void)
+{
+    return pCopyEngine;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_tile_pipeline_init
+* @brief initializes a double buffered tile pipeline
+*
+* @details splits an L1 buffer in two halves. One half holds the tile being computed while the copy engine fills the other
+* half with the next tile.
+*
+* Parameters:
+* @param [in] pEngine - copy engine, NULL for the library engine selected with adi_sharcfx_set_copy_engine
+* @param [in] pBuffer - L1 buffer, nSize bytes
+* @param [in] nSize - size of the L1 buffer in bytes
+*
+* @param [out] pPipeline - pipeline
+*
+* @return None
+*
+*******************************************************************************
+*/
+void adi_sharcfx_tile_pipeline_init(ADI_SHARCFX_TILE_PIPELINE* pPipeline,
+                                    ADI_SHARCFX_COPY_ENGINE* pEngine,
+                                    int8_t* pBuffer,
+                                    int32_t nSize)
+{
+    //keep the second half 8 byte aligned like the scratch buffers
+    int32_t nHalf = (nSize >> 1) & ~7;
+
+    pPipeline->pEngine = pEngine ? pEngine : pCopyEngine;
+    pPipeline->pBuffer[0] = pBuffer;
+    pPipeline->pBuffer[1] = pBuffer + nHalf;
+    pPipeline->nBufferSize = nHalf;
+    pPipeline->nCurrent = 1;
+    pPipeline->nPending = 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_tile_pipeline_prefetch
+* @brief starts staging the next tile
+*
+* @details starts the copy of the next tile into the buffer that is not being computed on. Only one tile can be in flight.
+*
+* Parameters:
+* @param [in] pPipeline - pipeline
+* @param [in] pSrc - tile source, usually in L3
+* @param [in] nBytes - tile size in bytes
+*
+* @return 0 on success, -1 if the tile does not fit in a buffer or a tile is already in flight
+*
+*******************************************************************************
+*/
+int32_t adi_sharcfx_tile_pipeline_prefetch(ADI_SHARCFX_TILE_PIPELINE* pPipeline,
+                                           const void* pSrc,
+                                           int32_t nBytes)
+{
+    if (nBytes > pPipeline->nBufferSize || pPipeline->nPending)
+    {
+        return -1;
+    }
+    pPipeline->pEngine->pfStart(pPipeline->pBuffer[pPipeline->nCurrent ^ 1], pSrc, nBytes, pPipeline->pEngine->pEngineData);
+    pPipeline->nPending = 1;
+    return 0;
+}
+
+/**
+*******************************************************************************
+* Function: adi_sharcfx_tile_pipeline_next
+* @brief returns the next staged tile
+*
+* @details waits for the tile in flight and swaps the buffers, so the returned tile can be computed on while the next one
+* is prefetched into the other buffer.
+*
+* Parameters:
+* @param [in] pPipeline - pipeline
+*
+* @return L1 buffer holding the tile, NULL if no tile was prefetched
+*
+*******************************************************************************
+*/
+int8_t* adi_sharcfx_tile_pipeline_next(ADI_SHARCFX_TILE_PIPELINE* pPipeline)
+{
+    if (!pPipeline->nPending)
+    {
+        return NULL;
+    }
+    pPipeline->pEngine->pfWait(pPipeline->pEngine->pEngineData);
+    pPipeline->nPending = 0;
+    pPipeline->nCurrent ^= 1;
+    return pPipeline->pBuffer[pPipeline->nCurrent];
+}
@@ -0,0 +1,164 @@
+/**
+********************************************************************************
+*
+* @file: test_activations_int16.cpp
+*
+* @brief: exhaustive tests of the int16 tanh and logistic kernels
+*
+* @details: runs adi_sharcfx_tanh_int16 and adi_sharcfx_logistic_int16 on every int16 input, for the power of two input
+* scales and for general input multipliers, and compares them with scalar code of the TFLite int16 reference kernels.
+* The reference table is sigmoid(i/24) in Q0.16 computed here. The kernels are expected to be bit exact.
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include <math.h>
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_INPUTS         65536
+#define TEST_TABLE_SIZE     256
+#define TEST_MAX_LSB        0       /*largest difference to the reference allowed, in output LSBs*/
+
+/*============= D A T A =============*/
+static uint16_t pSigmoidTable[TEST_TABLE_SIZE];
+static int16_t pInput[TEST_INPUTS];
+static int16_t pExpected[TEST_INPUTS];
+static int16_t pOutput[TEST_INPUTS];
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//TFLite int16 tanh reference: tanh(x) = 2*sigmoid(2x) - 1 with 8 fraction bits per table step
+static void test_reference_tanh(int32_t nInputMultiplier, int32_t nInputLeftShift)
+{
+    if (nInputMultiplier == 0)
+    {
+        nInputMultiplier = 3 << nInputLeftShift;
+        nInputLeftShift = 0;
+    }
+    int32_t nRound = nInputLeftShift > 0 ? 1 << (nInputLeftShift - 1) : 0;
+    for (int32_t i = 0; i < TEST_INPUTS; i++)
+    {
+        int32_t nInputData = (pInput[i]*nInputMultiplier + nRound) >> nInputLeftShift;
+        uint32_t nAbs = nInputData < 0 ? -nInputData : nInputData;
+        uint32_t nStep = nAbs >> 8;
+        int32_t nResult;
+        if (nStep >= 255)
+        {
+            nResult = 0xFFFF << 8;
+        }
+        else
+        {
+            uint32_t ua = pSigmoidTable[nStep], ub = pSigmoidTable[nStep + 1];
+            nResult = (ua << 8) + (nAbs & 0xFF)*(ub - ua);
+        }
+        nResult = nInputData >= 0 ? nResult - (1 << (14 + 9)) + (1 << (9 - 2))
+                                  : -nResult + (1 << (14 + 9)) + (1 << (9 - 2)) - 1;
+        pExpected[i] = (int16_t)(nResult >> (9 - 1));
+    }
+}
+
+/*UTILITY FUNCTION*/
+//TFLite int16 logistic reference with 9 fraction bits per table step
+static void test_reference_logistic(int32_t nInputMultiplier, int32_t nInputLeftShift)
+{
+    if (nInputMultiplier == 0)
+    {
+        nInputMultiplier = 3 << nInputLeftShift;
+        nInputLeftShift = 0;
+    }
+    int32_t nRound = nInputLeftShift > 0 ? 1 << (nInputLeftShift - 1) : 0;
+    for (int32_t i = 0; i < TEST_INPUTS; i++)
+    {
+        int32_t nInputData = (pInput[i]*nInputMultiplier + nRound) >> nInputLeftShift;
+        uint32_t nAbs = nInputData < 0 ? -nInputData : nInputData;
+        uint32_t nStep = nAbs >> 9;
+        uint32_t nResult;
+        if (nStep >= 255)
+        {
+            nResult = 0x7FFF << 10;
+        }
+        else
+        {
+            uint32_t ua = pSigmoidTable[nStep], ub = pSigmoidTable[nStep + 1];
+            nResult = (ua << 9) + (nAbs & 0x1FF)*(ub - ua);
+        }
+        nResult = nInputData >= 0 ? nResult + (1 << 9) : (1 << (16 + 9)) - nResult + (1 << 9) - 1;
+        pExpected[i] = (int16_t)(nResult >> 10);
+    }
+}
+
+/*UTILITY FUNCTION*/
+//Largest difference between the first nLength outputs and the reference, prints the first input at the largest difference
+static int32_t test_max_difference(const char *pName, int32_t nLength, int32_t nInputMultiplier,
+                                   int32_t nInputLeftShift)
+{
+    int32_t nMax = 0, nWorst = 0;
+    for (int32_t i = 0; i < nLength; i++)
+    {
+        int32_t nDiff = pOutput[i] - pExpected[i];
+        nDiff = nDiff < 0 ? -nDiff : nDiff;
+        if (nDiff > nMax)
+        {
+            nMax = nDiff;
+            nWorst = i;
+        }
+    }
+    if (nMax > TEST_MAX_LSB)
+    {
+        printf("%s multiplier %d shift %d: input %d gives %d, expected %d\n", pName, (int)nInputMultiplier,
+               (int)nInputLeftShift, (int)pInput[nWorst], (int)pOutput[nWorst], (int)pExpected[nWorst]);
+    }
+    return nMax;
+}
+
+static void test_activations(int32_t nInputMultiplier, int32_t nInputLeftShift)
+{
+    memset(pOutput, 0x55, sizeof(pOutput));
+    adi_sharcfx_tanh_int16(nInputMultiplier, nInputLeftShift, TEST_INPUTS, pInput, pOutput);
+    test_reference_tanh(nInputMultiplier, nInputLeftShift);
+    TEST_CHECK(test_max_difference("tanh_int16", TEST_INPUTS, nInputMultiplier, nInputLeftShift) <= TEST_MAX_LSB);
+
+    memset(pOutput, 0x55, sizeof(pOutput));
+    adi_sharcfx_logistic_int16(nInputMultiplier, nInputLeftShift, TEST_INPUTS, pInput, pOutput);
+    test_reference_logistic(nInputMultiplier, nInputLeftShift);
+    TEST_CHECK(test_max_difference("logistic_int16", TEST_INPUTS, nInputMultiplier, nInputLeftShift) <= TEST_MAX_LSB);
+}
+
+int main(void)
+{
+    for (int32_t i = 0; i < TEST_TABLE_SIZE; i++)
+    {
+        pSigmoidTable[i] = (uint16_t)floor(65536.0/(1.0 + exp(-i/24.0)) + 0.5);
+    }
+    for (int32_t i = 0; i < TEST_INPUTS; i++)
+    {
+        pInput[i] = (int16_t)(i - 32768);
+    }
+
+    //power of two input scales
+    test_activations(0, 0);
+    test_activations(0, 1);
+
+    //general input scales, multipliers in (32767/2, 32767] as prepared by the reference
+    test_activations(24576, 3);
+    test_activations(20001, 0);
+    test_activations(32767, 14);
+    test_activations(16385, 7);
+
+    //a length that leaves a partial last vector
+    memset(pOutput, 0x55, sizeof(pOutput));
+    adi_sharcfx_tanh_int16(24576, 3, TEST_INPUTS - 5, pInput, pOutput);
+    test_reference_tanh(24576, 3);
+    TEST_CHECK(test_max_difference("tanh_int16 partial", TEST_INPUTS - 5, 24576, 3) <= TEST_MAX_LSB);
+    TEST_CHECK(pOutput[TEST_INPUTS - 5] == 0x5555);
+
+    return test_report("test_activations_int16");
+}
@@ -0,0 +1,140 @@
+/**
+********************************************************************************
+*
+* @file: test_batch_matmul.cpp
+*
+* @brief: tests of the batch matmul entry points
+*
+* @details: compares adi_sharcfx_batch_matmul_int8 and adi_sharcfx_batch_matmul_int16 with their _ctx variants on a context
+* of its own, with batch strides that differ from the matrix sizes, broadcast operands and the right operand stored
+* plain and transposed, and checks that both right operand layouts give the same outputs
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_BATCHES        3
+#define TEST_ROWS           5
+#define TEST_DEPTH          37
+#define TEST_COLS           21
+#define TEST_LHS_STRIDE     (TEST_ROWS*TEST_DEPTH + 11)     /*padded batches, distinct from every other argument*/
+#define TEST_RHS_STRIDE     (TEST_DEPTH*TEST_COLS + 29)
+#define TEST_OUT_SIZE       (TEST_BATCHES*TEST_ROWS*TEST_COLS)
+#define TEST_SCRATCH_SIZE   (16*1024)
+
+/*============= D A T A =============*/
+static int8_t pLhs[TEST_BATCHES*TEST_LHS_STRIDE];
+static int8_t pRhs[TEST_BATCHES*TEST_RHS_STRIDE];
+static int16_t pLhs16[TEST_BATCHES*TEST_LHS_STRIDE];
+static int16_t pRhs16[TEST_BATCHES*TEST_RHS_STRIDE];
+static int8_t pRhsT[TEST_BATCHES*TEST_RHS_STRIDE];
+static int16_t pRhsT16[TEST_BATCHES*TEST_RHS_STRIDE];
+static int8_t pExpected[TEST_OUT_SIZE];
+static int8_t pOutput[TEST_OUT_SIZE];
+static int16_t pExpected16[TEST_OUT_SIZE];
+static int16_t pOutput16[TEST_OUT_SIZE];
+static int64_t pScratch[TEST_SCRATCH_SIZE/sizeof(int64_t)];
+static int64_t pScratchL3[TEST_SCRATCH_SIZE/sizeof(int64_t)];
+
+/*============= C O D E =============*/
+
+static void test_batch_matmul(const ADI_SHARCFX_CONTEXT *pContext, int32_t nTransposeRhs, int32_t nLhsStride,
+                              int32_t nRhsStride)
+{
+    char pName[64];
+
+    memset(pExpected, 0x55, sizeof(pExpected));
+    adi_sharcfx_batch_matmul_int8_ctx(pLhs, pRhs, pExpected, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                      nTransposeRhs, nLhsStride, nRhsStride, 3, -2, 1<<30, -9, 4, pContext);
+    memset(pOutput, 0x55, sizeof(pOutput));
+    adi_sharcfx_batch_matmul_int8(pLhs, pRhs, pOutput, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                  nTransposeRhs, nLhsStride, nRhsStride, 3, -2, 1<<30, -9, 4);
+    snprintf(pName, sizeof(pName), "batch_matmul_int8 transpose %d strides %d %d", (int)nTransposeRhs, (int)nLhsStride,
+             (int)nRhsStride);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, TEST_OUT_SIZE, pName) == 0);
+
+    memset(pExpected16, 0x55, sizeof(pExpected16));
+    adi_sharcfx_batch_matmul_int16_ctx(pLhs16, pRhs16, pExpected16, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                       nTransposeRhs, nLhsStride, nRhsStride, 1<<30, -14, pContext);
+    memset(pOutput16, 0x55, sizeof(pOutput16));
+    adi_sharcfx_batch_matmul_int16(pLhs16, pRhs16, pOutput16, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                   nTransposeRhs, nLhsStride, nRhsStride, 1<<30, -14);
+    snprintf(pName, sizeof(pName), "batch_matmul_int16 transpose %d strides %d %d", (int)nTransposeRhs, (int)nLhsStride,
+             (int)nRhsStride);
+    TEST_CHECK(test_compare_int8((const int8_t *)pOutput16, (const int8_t *)pExpected16, sizeof(pOutput16), pName) == 0);
+}
+
+static void test_rhs_layouts(void)
+{
+    //[depth][cols] and [cols][depth] right operands hold the same values
+    for (int32_t b = 0; b < TEST_BATCHES; b++)
+    {
+        for (int32_t k = 0; k < TEST_DEPTH; k++)
+        {
+            for (int32_t n = 0; n < TEST_COLS; n++)
+            {
+                pRhsT[b*TEST_RHS_STRIDE + n*TEST_DEPTH + k] = pRhs[b*TEST_RHS_STRIDE + k*TEST_COLS + n];
+                pRhsT16[b*TEST_RHS_STRIDE + n*TEST_DEPTH + k] = pRhs16[b*TEST_RHS_STRIDE + k*TEST_COLS + n];
+            }
+        }
+    }
+
+    adi_sharcfx_batch_matmul_int8(pLhs, pRhs, pExpected, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                  0, TEST_LHS_STRIDE, TEST_RHS_STRIDE, 3, -2, 1<<30, -9, 4);
+    memset(pOutput, 0x55, sizeof(pOutput));
+    adi_sharcfx_batch_matmul_int8(pLhs, pRhsT, pOutput, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                  1, TEST_LHS_STRIDE, TEST_RHS_STRIDE, 3, -2, 1<<30, -9, 4);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, TEST_OUT_SIZE, "batch_matmul_int8 rhs layouts") == 0);
+
+    adi_sharcfx_batch_matmul_int16(pLhs16, pRhs16, pExpected16, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                   0, TEST_LHS_STRIDE, TEST_RHS_STRIDE, 1<<30, -14);
+    memset(pOutput16, 0x55, sizeof(pOutput16));
+    adi_sharcfx_batch_matmul_int16(pLhs16, pRhsT16, pOutput16, TEST_BATCHES, TEST_ROWS, TEST_DEPTH, TEST_COLS,
+                                   1, TEST_LHS_STRIDE, TEST_RHS_STRIDE, 1<<30, -14);
+    TEST_CHECK(test_compare_int8((const int8_t *)pOutput16, (const int8_t *)pExpected16, sizeof(pOutput16),
+                                 "batch_matmul_int16 rhs layouts") == 0);
+}
+
+int main(void)
+{
+    ADI_SHARCFX_CONTEXT sContext;
+    memset(&sContext, 0, sizeof(sContext));
+    sContext.pScratch = (int8_t *)pScratch;
+    sContext.nScratchSize = TEST_SCRATCH_SIZE;
+    sContext.pScratchL3 = (int8_t *)pScratchL3;
+    sContext.nScratchL3Size = TEST_SCRATCH_SIZE;
+
+    test_fill_int8(pLhs, sizeof(pLhs), -128, 127);
+    test_fill_int8(pRhs, sizeof(pRhs), -128, 127);
+    for (uint32_t i = 0; i < sizeof(pLhs16)/sizeof(pLhs16[0]); i++)
+    {
+        pLhs16[i] = (int16_t)test_rand(-32768, 32767);
+    }
+    for (uint32_t i = 0; i < sizeof(pRhs16)/sizeof(pRhs16[0]); i++)
+    {
+        pRhs16[i] = (int16_t)test_rand(-32768, 32767);
+    }
+
+    for (int32_t nTransposeRhs = 0; nTransposeRhs <= 1; nTransposeRhs++)
+    {
+        test_batch_matmul(&sContext, nTransposeRhs, TEST_LHS_STRIDE, TEST_RHS_STRIDE);
+        //broadcast right and left operand
+        test_batch_matmul(&sContext, nTransposeRhs, TEST_LHS_STRIDE, 0);
+        test_batch_matmul(&sContext, nTransposeRhs, 0, TEST_RHS_STRIDE);
+    }
+
+    //the _ctx results without context match too
+    test_batch_matmul(NULL, 1, TEST_LHS_STRIDE, TEST_RHS_STRIDE);
+
+    test_rhs_layouts();
+
+    return test_report("test_batch_matmul");
+}
@@ -0,0 +1,96 @@
+/**
+********************************************************************************
+*
+* @file: test_common.h
+*
+* @brief: common helpers of the kernel tests
+*
+* @details: contains the check macro, the pseudo random fill and the buffer compare used by the kernel tests
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+#ifndef __TEST_COMMON_H__
+#define __TEST_COMMON_H__
+
+/*============= I N C L U D E S =============*/
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "adi_sharcfx_nn.h"
+
+/*============= D E F I N E S =============*/
+/*Counts and reports a failed condition, tests return the # of failures from main*/
+#define TEST_CHECK(cond)                                                        \
+    do                                                                          \
+    {                                                                           \
+        if (!(cond))                                                            \
+        {                                                                       \
+            printf("FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);              \
+            nTestFailures++;                                                    \
+        }                                                                       \
+    } while (0)
+
+/*============= D A T A =============*/
+static int32_t nTestFailures = 0;
+static uint32_t nTestSeed = 1;
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Pseudo random value in [nMin, nMax], fixed seed so failures reproduce
+static inline int32_t test_rand(int32_t nMin, int32_t nMax)
+{
+    nTestSeed = nTestSeed*1664525u + 1013904223u;
+    return nMin + (int32_t)((nTestSeed >> 8) % (uint32_t)(nMax - nMin + 1));
+}
+
+static inline void test_fill_int8(int8_t *pBuffer, int32_t nSize, int32_t nMin, int32_t nMax)
+{
+    for (int32_t i = 0; i < nSize; i++)
+    {
+        pBuffer[i] = (int8_t)test_rand(nMin, nMax);
+    }
+}
+
+static inline void test_fill_int32(int32_t *pBuffer, int32_t nSize, int32_t nMin, int32_t nMax)
+{
+    for (int32_t i = 0; i < nSize; i++)
+    {
+        pBuffer[i] = test_rand(nMin, nMax);
+    }
+}
+
+/*UTILITY FUNCTION*/
+//# of differing bytes, the first difference is printed with its position
+static inline int32_t test_compare_int8(const int8_t *pOutput, const int8_t *pExpected, int32_t nSize, const char *pName)
+{
+    int32_t nDiff = 0;
+    for (int32_t i = 0; i < nSize; i++)
+    {
+        if (pOutput[i] != pExpected[i])
+        {
+            if (nDiff == 0)
+            {
+                printf("%s: first mismatch at %d, got %d expected %d\n", pName, (int)i, pOutput[i], pExpected[i]);
+            }
+            nDiff++;
+        }
+    }
+    return nDiff;
+}
+
+/*UTILITY FUNCTION*/
+//Report and return the result of main
+static inline int test_report(const char *pName)
+{
+    printf("%s: %s (%d failures)\n", pName, nTestFailures ? "FAILED" : "PASSED", (int)nTestFailures);
+    return nTestFailures;
+}
+
+#endif /* __TEST_COMMON_H__ */
@@ -0,0 +1,256 @@
+/**
+********************************************************************************
+*
+* @file: test_contexts_threads.cpp
+*
+* @brief: stress test of concurrent execution contexts
+*
+* @details: runs the kernels that use the context scratch and copy engine from two threads at once, each with its own
+* context, many times over and checks every run against the output of a single threaded run without context, and checks
+* that the kernels report a scratch too small for the call and leave their output untouched
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include <thread>
+#include <vector>
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_CONTEXTS           2
+#define TEST_ITERATIONS         200
+#define TEST_SCRATCH_SIZE       4096            /*fast scratch, small enough to send the matmul panel to the large scratch*/
+#define TEST_SCRATCH_L3_SIZE    (64*1024)
+
+#define TEST_WIDTH              16
+#define TEST_HEIGHT             12
+#define TEST_CHANNELS           8
+#define TEST_KERNEL             3
+#define TEST_L1_BUDGET          1024            /*4 input rows per strip buffer of the tiled depthconv*/
+#define TEST_CONV_SIZE          (TEST_WIDTH*TEST_HEIGHT*TEST_CHANNELS)
+
+#define TEST_MM_BATCHES         2
+#define TEST_MM_ROWS            4
+#define TEST_MM_DEPTH           200             /*panel of 200*2*PDX_M 16bit columns does not fit the fast scratch*/
+#define TEST_MM_COLS            20
+#define TEST_MM_OUT_SIZE        (TEST_MM_BATCHES*TEST_MM_ROWS*TEST_MM_COLS)
+
+#define TEST_LOGISTIC_SIZE      100
+
+#define TEST_GRU_INPUT          16
+#define TEST_GRU_HIDDEN         16
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_CONV_SIZE];
+static int8_t pWeights[TEST_KERNEL*TEST_KERNEL*TEST_CHANNELS];
+static int32_t pBias[TEST_CHANNELS];
+static int32_t pMultiplier[TEST_CHANNELS];
+static int32_t pShift[TEST_CHANNELS];
+static int8_t pLhs[TEST_MM_BATCHES*TEST_MM_ROWS*TEST_MM_DEPTH];
+static int8_t pRhs[TEST_MM_BATCHES*TEST_MM_DEPTH*TEST_MM_COLS];
+static int8_t pGruWeightsInput[3*TEST_GRU_HIDDEN*TEST_GRU_INPUT];
+static int8_t pGruWeightsHidden[3*TEST_GRU_HIDDEN*TEST_GRU_HIDDEN];
+static int32_t pGruBias[3*TEST_GRU_HIDDEN];
+static int32_t pGruMultiplier[3];
+static int32_t pGruShift[3];
+static int16_t pGruState[TEST_GRU_HIDDEN];
+
+/*Outputs of the single threaded run without context*/
+typedef struct
+{
+    int8_t pTiled[TEST_CONV_SIZE];
+    int8_t pExpanded[2*TEST_CONV_SIZE];
+    int8_t pMatmul[TEST_MM_OUT_SIZE];
+    int8_t pLogistic[TEST_LOGISTIC_SIZE];
+    int16_t pGru[TEST_GRU_HIDDEN];
+} TEST_OUTPUTS;
+
+static TEST_OUTPUTS sExpected;
+
+/*Copy engine that counts its calls and copies with memcpy*/
+typedef struct
+{
+    int32_t nStarts;
+    int32_t nWaits;
+} TEST_ENGINE_COUNTS;
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Counting engine callbacks
+static void test_engine_start(void *pDst, const void *pSrc, int32_t nBytes, void *pEngineData)
+{
+    ((TEST_ENGINE_COUNTS *)pEngineData)->nStarts++;
+    memcpy(pDst, pSrc, nBytes);
+}
+
+static void test_engine_wait(void *pEngineData)
+{
+    ((TEST_ENGINE_COUNTS *)pEngineData)->nWaits++;
+}
+
+/*UTILITY FUNCTION*/
+//Run every kernel once with context pContext, NULL for the static scratch and library engine, returns 0 if every
+//kernel succeeded
+static int32_t test_run_kernels(const ADI_SHARCFX_CONTEXT *pContext, TEST_OUTPUTS *pOut)
+{
+    int32_t nStatus = 0;
+
+    nStatus |= adi_sharcfx_depthconv2d_tiled_int8_ctx(pInput, pOut->pTiled, pWeights, pBias, TEST_WIDTH, TEST_HEIGHT,
+                                                      1, TEST_CHANNELS, TEST_CHANNELS, TEST_KERNEL, TEST_KERNEL, 2, 2,
+                                                      pMultiplier, pShift, -3, 5, 1, 1, -128, 127, TEST_L1_BUDGET,
+                                                      pContext);
+
+    //depth multiplier 2 on half the channels, the input is repeated in the large scratch
+    nStatus |= adi_sharcfx_depthconv2d_int8_ctx(pInput, pOut->pExpanded, pWeights, pBias, TEST_WIDTH, TEST_HEIGHT,
+                                                2, TEST_CHANNELS/2, TEST_CHANNELS, TEST_KERNEL, TEST_KERNEL, 2, 2,
+                                                pMultiplier, pShift, -3, 5, 1, 1, -128, 127, pContext);
+
+    nStatus |= adi_sharcfx_batch_matmul_int8_ctx(pLhs, pRhs, pOut->pMatmul, TEST_MM_BATCHES, TEST_MM_ROWS,
+                                                 TEST_MM_DEPTH, TEST_MM_COLS, 0, TEST_MM_ROWS*TEST_MM_DEPTH,
+                                                 TEST_MM_DEPTH*TEST_MM_COLS, 3, -2, 1<<30, -9, 4, pContext);
+
+    nStatus |= adi_sharcfx_logistic_int8_ctx(-7, 1<<30, 25, TEST_LOGISTIC_SIZE, pInput, pOut->pLogistic,
+                                             pContext);
+
+    memcpy(pOut->pGru, pGruState, sizeof(pGruState));
+    nStatus |= adi_sharcfx_gru_int8_ctx(pInput, pGruWeightsInput, pGruWeightsHidden, pGruBias, pGruBias, pOut->pGru, 1,
+                                        TEST_GRU_INPUT, TEST_GRU_HIDDEN, 3, pGruMultiplier, pGruShift, pGruMultiplier,
+                                        pGruShift, pContext);
+    return nStatus;
+}
+
+/*UTILITY FUNCTION*/
+//# of runs whose outputs differ from the single threaded run
+static int32_t test_run_context(const ADI_SHARCFX_CONTEXT *pContext)
+{
+    TEST_OUTPUTS sOut;
+    int32_t nFailedRuns = 0;
+
+    for (int32_t i = 0; i < TEST_ITERATIONS; i++)
+    {
+        memset(&sOut, 0x55, sizeof(sOut));
+        if (test_run_kernels(pContext, &sOut) != 0 || memcmp(&sOut, &sExpected, sizeof(sOut)) != 0)
+        {
+            nFailedRuns++;
+        }
+    }
+    return nFailedRuns;
+}
+
+static void test_scratch_too_small(void)
+{
+    int64_t pSmallScratch[8], pSmallScratchL3[8];
+    ADI_SHARCFX_CONTEXT sContext;
+    TEST_OUTPUTS sOut, sUntouched;
+
+    //room for neither the repeated input nor the matmul panel nor the Q3.4 logistic input nor a layer norm row nor the
+    //GRU gate state
+    memset(&sContext, 0, sizeof(sContext));
+    sContext.pScratch = (int8_t *)pSmallScratch;
+    sContext.nScratchSize = sizeof(pSmallScratch);
+    sContext.pScratchL3 = (int8_t *)pSmallScratchL3;
+    sContext.nScratchL3Size = sizeof(pSmallScratchL3);
+    memset(&sOut, 0x55, sizeof(sOut));
+    memset(&sUntouched, 0x55, sizeof(sUntouched));
+
+    TEST_CHECK(adi_sharcfx_depthconv2d_int8_ctx(pInput, sOut.pExpanded, pWeights, pBias, TEST_WIDTH, TEST_HEIGHT, 2,
+                                                TEST_CHANNELS/2, TEST_CHANNELS, TEST_KERNEL, TEST_KERNEL, 2, 2,
+                                                pMultiplier, pShift, -3, 5, 1, 1, -128, 127, &sContext) == -1);
+    TEST_CHECK(adi_sharcfx_batch_matmul_int8_ctx(pLhs, pRhs, sOut.pMatmul, TEST_MM_BATCHES, TEST_MM_ROWS,
+                                                 TEST_MM_DEPTH, TEST_MM_COLS, 0, TEST_MM_ROWS*TEST_MM_DEPTH,
+                                                 TEST_MM_DEPTH*TEST_MM_COLS, 3, -2, 1<<30, -9, 4, &sContext) == -1);
+    TEST_CHECK(adi_sharcfx_logistic_int8_ctx(-7, 1<<30, 25, TEST_LOGISTIC_SIZE, pInput, sOut.pLogistic,
+                                             &sContext) == -1);
+    //rows of 64 elements, staged and normalized in 16bit
+    TEST_CHECK(adi_sharcfx_layer_norm_int8_ctx(pInput, (const int16_t *)pInput, NULL, sOut.pTiled, 2, 64, 0, 1, 3,
+                                               1<<30, -2, 4, &sContext) == -1);
+    TEST_CHECK(adi_sharcfx_layer_norm_int16_ctx((const int16_t *)pInput, (const int16_t *)pInput, NULL,
+                                                (int16_t *)sOut.pExpanded, 2, 64, 0, 1, 1<<30, -2, &sContext) == -1);
+    //the hidden state is updated in place, it keeps its value
+    TEST_CHECK(adi_sharcfx_gru_int8_ctx(pInput, pGruWeightsInput, pGruWeightsHidden, pGruBias, pGruBias, sOut.pGru, 1,
+                                        TEST_GRU_INPUT, TEST_GRU_HIDDEN, 3, pGruMultiplier, pGruShift, pGruMultiplier,
+                                        pGruShift, &sContext) == -1);
+    TEST_CHECK(memcmp(&sOut, &sUntouched, sizeof(sOut)) == 0);
+}
+
+int main(void)
+{
+    TEST_ENGINE_COUNTS sLibraryCounts = {0, 0};
+    ADI_SHARCFX_COPY_ENGINE sLibraryEngine = {test_engine_start, test_engine_wait, &sLibraryCounts};
+    TEST_ENGINE_COUNTS pCounts[TEST_CONTEXTS];
+    ADI_SHARCFX_COPY_ENGINE pEngines[TEST_CONTEXTS];
+    ADI_SHARCFX_CONTEXT pContexts[TEST_CONTEXTS];
+    int32_t pFailedRuns[TEST_CONTEXTS];
+    std::vector<std::vector<int64_t> > scratch(TEST_CONTEXTS, std::vector<int64_t>(TEST_SCRATCH_SIZE/sizeof(int64_t)));
+    std::vector<std::vector<int64_t> > scratchL3(TEST_CONTEXTS, std::vector<int64_t>(TEST_SCRATCH_L3_SIZE/sizeof(int64_t)));
+    std::vector<std::thread> threads;
+
+    test_fill_int8(pInput, TEST_CONV_SIZE, -128, 127);
+    test_fill_int8(pWeights, sizeof(pWeights), -127, 127);
+    test_fill_int32(pBias, TEST_CHANNELS, -2000, 2000);
+    test_fill_int32(pMultiplier, TEST_CHANNELS, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pShift, TEST_CHANNELS, -9, -5);
+    test_fill_int8(pLhs, sizeof(pLhs), -128, 127);
+    test_fill_int8(pRhs, sizeof(pRhs), -128, 127);
+    test_fill_int8(pGruWeightsInput, sizeof(pGruWeightsInput), -127, 127);
+    test_fill_int8(pGruWeightsHidden, sizeof(pGruWeightsHidden), -127, 127);
+    test_fill_int32(pGruBias, 3*TEST_GRU_HIDDEN, -2000, 2000);
+    test_fill_int32(pGruMultiplier, 3, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pGruShift, 3, -6, -3);
+    for (int32_t i = 0; i < TEST_GRU_HIDDEN; i++)
+    {
+        pGruState[i] = (int16_t)test_rand(-32768, 32767);
+    }
+
+    memset(&sExpected, 0x55, sizeof(sExpected));
+    TEST_CHECK(test_run_kernels(NULL, &sExpected) == 0);
+    test_scratch_too_small();
+
+    //the library engine must not be used by contexts with their own engine
+    adi_sharcfx_set_copy_engine(&sLibraryEngine);
+    for (int32_t c = 0; c < TEST_CONTEXTS; c++)
+    {
+        pCounts[c].nStarts = pCounts[c].nWaits = 0;
+        pEngines[c].pfStart = test_engine_start;
+        pEngines[c].pfWait = test_engine_wait;
+        pEngines[c].pEngineData = &pCounts[c];
+        pContexts[c].pScratch = (int8_t *)scratch[c].data();
+        pContexts[c].nScratchSize = TEST_SCRATCH_SIZE;
+        pContexts[c].pScratchL3 = (int8_t *)scratchL3[c].data();
+        pContexts[c].nScratchL3Size = TEST_SCRATCH_L3_SIZE;
+        pContexts[c].pCopyEngine = &pEngines[c];
+    }
+    for (int32_t c = 0; c < TEST_CONTEXTS; c++)
+    {
+        const ADI_SHARCFX_CONTEXT *pContext = &pContexts[c];
+        int32_t *pFailed = &pFailedRuns[c];
+        threads.push_back(std::thread([=]() { *pFailed = test_run_context(pContext); }));
+    }
+    for (uint32_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+    adi_sharcfx_set_copy_engine(NULL);
+
+    for (int32_t c = 0; c < TEST_CONTEXTS; c++)
+    {
+        if (pFailedRuns[c])
+        {
+            printf("context %d: %d of %d runs differ from the single threaded run\n", (int)c, (int)pFailedRuns[c],
+                   TEST_ITERATIONS);
+        }
+        TEST_CHECK(pFailedRuns[c] == 0);
+        TEST_CHECK(pCounts[c].nStarts > 0);
+        TEST_CHECK(pCounts[c].nWaits == pCounts[c].nStarts);
+    }
+    TEST_CHECK(sLibraryCounts.nStarts == 0);
+
+    return test_report("test_contexts_threads");
+}
@@ -0,0 +1,125 @@
+/**
+********************************************************************************
+*
+* @file: test_conv2d_specialized.cpp
+*
+* @brief: tests of the compile time specialized conv2d
+*
+* @details: compares adi_sharcfx_conv2d_specialized_int8 with adi_sharcfx_conv2d_dilation1x1_int8 for the specialized shapes
+* and a shape that falls back, with and without output channel tails and with a nonzero filter zeropoint, and checks that a
+* scratch too small for the transformed weights is reported
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_WIDTH          11
+#define TEST_HEIGHT         9
+#define TEST_MAX_KERNEL     7
+#define TEST_MAX_IN         8
+#define TEST_MAX_OUT        32
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_WIDTH*TEST_HEIGHT*TEST_MAX_IN];
+static int8_t pWeights[TEST_MAX_KERNEL*TEST_MAX_KERNEL*TEST_MAX_IN*TEST_MAX_OUT];
+static int8_t pOffsetWeights[TEST_MAX_KERNEL*TEST_MAX_KERNEL*TEST_MAX_IN*TEST_MAX_OUT];
+static int32_t pBias[TEST_MAX_OUT];
+static int32_t pMultiplier[TEST_MAX_OUT];
+static int32_t pShift[TEST_MAX_OUT];
+static int8_t pExpected[TEST_WIDTH*TEST_HEIGHT*TEST_MAX_OUT];
+static int8_t pOutput[TEST_WIDTH*TEST_HEIGHT*TEST_MAX_OUT];
+
+/*============= C O D E =============*/
+
+static void test_conv2d(int32_t nKernelHeight, int32_t nKernelWidth, int32_t nStride, int32_t nInChannels,
+                        int32_t nOutChannels, int32_t nFilterZeroPoint)
+{
+    char pName[64];
+    int32_t nOutHeight = (TEST_HEIGHT - 1)/nStride + 1, nOutWidth = (TEST_WIDTH - 1)/nStride + 1;
+    int32_t nSize = nOutHeight*nOutWidth*nOutChannels;
+
+    test_fill_int8(pInput, TEST_WIDTH*TEST_HEIGHT*nInChannels, -128, 127);
+    test_fill_int8(pWeights, nKernelHeight*nKernelWidth*nInChannels*nOutChannels, -100, 100);
+    test_fill_int32(pBias, nOutChannels, -2000, 2000);
+    test_fill_int32(pMultiplier, nOutChannels, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pShift, nOutChannels, -10, -6);
+
+    adi_sharcfx_conv2d_dilation1x1_int8(pInput, pWeights, pBias, pExpected, 1, nInChannels, nOutChannels,
+                                        nKernelHeight, nKernelWidth, nOutChannels, TEST_WIDTH, TEST_HEIGHT, nStride,
+                                        nStride, nKernelHeight/2, nKernelWidth/2, nOutHeight, nOutWidth, pMultiplier,
+                                        pShift, -2, 3, nFilterZeroPoint, -120, 127);
+    memset(pOutput, 0x55, nSize);
+    adi_sharcfx_conv2d_specialized_int8(pInput, pWeights, pBias, pOutput, 1, nInChannels, nOutChannels,
+                                        nKernelHeight, nKernelWidth, nOutChannels, TEST_WIDTH, TEST_HEIGHT, nStride,
+                                        nStride, nKernelHeight/2, nKernelWidth/2, nOutHeight, nOutWidth, pMultiplier,
+                                        pShift, -2, 3, nFilterZeroPoint, -120, 127);
+    snprintf(pName, sizeof(pName), "conv2d_specialized_int8 %dx%d/%d %d->%d zp %d", (int)nKernelHeight,
+             (int)nKernelWidth, (int)nStride, (int)nInChannels, (int)nOutChannels, (int)nFilterZeroPoint);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, pName) == 0);
+
+    //the filter zeropoint matches weights with the zeropoint added and no zeropoint
+    if (nFilterZeroPoint != 0)
+    {
+        int32_t nWeights = nKernelHeight*nKernelWidth*nInChannels*nOutChannels;
+        for (int32_t i = 0; i < nWeights; i++)
+        {
+            pOffsetWeights[i] = (int8_t)(pWeights[i] + nFilterZeroPoint);
+        }
+        memset(pOutput, 0x55, nSize);
+        adi_sharcfx_conv2d_dilation1x1_int8(pInput, pOffsetWeights, pBias, pOutput, 1, nInChannels, nOutChannels,
+                                            nKernelHeight, nKernelWidth, nOutChannels, TEST_WIDTH, TEST_HEIGHT, nStride,
+                                            nStride, nKernelHeight/2, nKernelWidth/2, nOutHeight, nOutWidth, pMultiplier,
+                                            pShift, -2, 3, 0, -120, 127);
+        TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "conv2d_dilation1x1_int8 filter zeropoint") == 0);
+    }
+}
+
+static void test_scratch_too_small(void)
+{
+    int64_t pSmallScratch[32];
+    ADI_SHARCFX_CONTEXT sContext;
+    int32_t nSize = TEST_WIDTH*TEST_HEIGHT*32;
+
+    //256 bytes cannot hold the 3x3x8x32 transformed weights after their offset
+    memset(&sContext, 0, sizeof(sContext));
+    sContext.pScratch = (int8_t *)pSmallScratch;
+    sContext.nScratchSize = sizeof(pSmallScratch);
+    memset(pOutput, 0x55, nSize);
+    memset(pExpected, 0x55, nSize);
+    TEST_CHECK(adi_sharcfx_conv2d_specialized_int8_ctx(pInput, pWeights, pBias, pOutput, 1, 8, 32, 3, 3, 32,
+                                                       TEST_WIDTH, TEST_HEIGHT, 1, 1, 1, 1, TEST_HEIGHT, TEST_WIDTH,
+                                                       pMultiplier, pShift, -2, 3, 0, -120, 127, &sContext) == -1);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "conv2d_specialized_int8 scratch too small") == 0);
+}
+
+int main(void)
+{
+    //specialized shapes, full channel blocks and a tail of 4 channels
+    test_conv2d(3, 3, 1, 8, 32, 0);
+    test_conv2d(3, 3, 2, 5, 20, 0);
+    test_conv2d(1, 1, 1, 8, 16, 0);
+    test_conv2d(5, 5, 1, 3, 16, 0);
+    test_conv2d(7, 1, 1, 4, 20, 0);
+    test_conv2d(1, 3, 1, 6, 16, 0);
+
+    //the filter zeropoint is applied by the specialized kernels and by the fallback
+    test_conv2d(3, 3, 1, 8, 32, 3);
+    test_conv2d(7, 7, 1, 2, 20, -5);
+    test_conv2d(3, 1, 1, 4, 16, 7);
+
+    //shape without specialization
+    test_conv2d(2, 2, 1, 4, 16, 0);
+    test_conv2d(2, 2, 1, 4, 20, 2);
+
+    test_scratch_too_small();
+
+    return test_report("test_conv2d_specialized");
+}
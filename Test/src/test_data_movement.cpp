@@ -0,0 +1,134 @@
+/**
+********************************************************************************
+*
+* @file: test_data_movement.cpp
+*
+* @brief: tests of the layout transform kernels
+*
+* @details: compares adi_sharcfx_transpose_int8 and adi_sharcfx_transpose_int16 and the hwc/chw conversions built on them
+* with scalar reference code, for shapes with full tiles only, with partial tiles along one and both axes and narrower
+* than a tile, and adi_sharcfx_channel_shuffle_int8 with a scalar shuffle for several group counts
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_MAX_SIZE       (100*100)
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_MAX_SIZE];
+static int8_t pExpected[TEST_MAX_SIZE];
+static int8_t pOutput[TEST_MAX_SIZE];
+static int16_t pInput16[TEST_MAX_SIZE];
+static int16_t pExpected16[TEST_MAX_SIZE];
+static int16_t pOutput16[TEST_MAX_SIZE];
+
+/*============= C O D E =============*/
+
+static void test_transpose(int32_t nRows, int32_t nCols)
+{
+    char pName[64];
+    int32_t nSize = nRows*nCols;
+
+    test_fill_int8(pInput, nSize, -128, 127);
+    for (int32_t i = 0; i < nSize; i++)
+    {
+        pInput16[i] = (int16_t)test_rand(-32768, 32767);
+    }
+    for (int32_t r = 0; r < nRows; r++)
+    {
+        for (int32_t c = 0; c < nCols; c++)
+        {
+            pExpected[c*nRows + r] = pInput[r*nCols + c];
+            pExpected16[c*nRows + r] = pInput16[r*nCols + c];
+        }
+    }
+
+    //the guard bytes past the output stay untouched
+    memset(pOutput, 0x55, nSize + 1);
+    adi_sharcfx_transpose_int8(pInput, pOutput, nRows, nCols);
+    snprintf(pName, sizeof(pName), "transpose_int8 %dx%d", (int)nRows, (int)nCols);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, pName) == 0);
+    TEST_CHECK(pOutput[nSize] == 0x55);
+
+    memset(pOutput16, 0x55, (nSize + 1)*sizeof(int16_t));
+    adi_sharcfx_transpose_int16(pInput16, pOutput16, nRows, nCols);
+    snprintf(pName, sizeof(pName), "transpose_int16 %dx%d", (int)nRows, (int)nCols);
+    TEST_CHECK(test_compare_int8((const int8_t *)pOutput16, (const int8_t *)pExpected16, nSize*sizeof(int16_t),
+                                 pName) == 0);
+    TEST_CHECK(pOutput16[nSize] == 0x5555);
+
+    //a hwc image of nRows pixels is the same transpose, and chw back restores it
+    memset(pOutput, 0x55, nSize);
+    adi_sharcfx_hwc_to_chw_int8(pInput, pOutput, 1, nRows, nCols);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "hwc_to_chw_int8") == 0);
+    memset(pOutput, 0x55, nSize);
+    adi_sharcfx_chw_to_hwc_int8(pExpected, pOutput, 1, nRows, nCols);
+    TEST_CHECK(test_compare_int8(pOutput, pInput, nSize, "chw_to_hwc_int8") == 0);
+    memset(pOutput16, 0x55, nSize*sizeof(int16_t));
+    adi_sharcfx_chw_to_hwc_int16(pExpected16, pOutput16, 1, nRows, nCols);
+    TEST_CHECK(test_compare_int8((const int8_t *)pOutput16, (const int8_t *)pInput16, nSize*sizeof(int16_t),
+                                 "chw_to_hwc_int16") == 0);
+}
+
+static void test_channel_shuffle(int32_t nPixels, int32_t nChannels, int32_t nGroups)
+{
+    char pName[64];
+    int32_t nGroupSize = nChannels/nGroups, nSize = nPixels*nChannels;
+
+    test_fill_int8(pInput, nSize, -128, 127);
+    for (int32_t p = 0; p < nPixels; p++)
+    {
+        for (int32_t g = 0; g < nGroups; g++)
+        {
+            for (int32_t k = 0; k < nGroupSize; k++)
+            {
+                pExpected[p*nChannels + k*nGroups + g] = pInput[p*nChannels + g*nGroupSize + k];
+            }
+        }
+    }
+
+    memset(pOutput, 0x55, nSize);
+    adi_sharcfx_channel_shuffle_int8(pInput, pOutput, nPixels, nChannels, nGroups);
+    snprintf(pName, sizeof(pName), "channel_shuffle_int8 %dx%d groups %d", (int)nPixels, (int)nChannels, (int)nGroups);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, pName) == 0);
+}
+
+int main(void)
+{
+    //full tiles only
+    test_transpose(16, 16);
+    test_transpose(64, 32);
+
+    //partial tiles along the columns, the rows and both
+    test_transpose(64, 4);
+    test_transpose(100, 3);
+    test_transpose(3, 100);
+    test_transpose(37, 8);
+    test_transpose(40, 40);
+    test_transpose(99, 97);
+
+    //narrower than a tile in both axes
+    test_transpose(5, 19);
+    test_transpose(1, 7);
+    test_transpose(1, 1);
+
+    //the vectorized two group interleave with and without a tail, and other group counts
+    test_channel_shuffle(7, 116, 2);
+    test_channel_shuffle(5, 128, 2);
+    test_channel_shuffle(9, 24, 3);
+    test_channel_shuffle(6, 240, 3);
+    test_channel_shuffle(4, 64, 4);
+    test_channel_shuffle(3, 272, 8);
+    test_channel_shuffle(2, 96, 32);
+
+    return test_report("test_data_movement");
+}
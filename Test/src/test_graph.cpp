@@ -0,0 +1,195 @@
+/**
+********************************************************************************
+*
+* @file: test_graph.cpp
+*
+* @brief: tests of the graph loader and executor
+*
+* @details: serializes a pad followed by a 1x1 conv the way a host tool writes a model, loads it, checks that the pad is
+* fused into the conv and that the graph output matches the padded input convolved by the 1x1 kernel, checks that
+* malformed descriptions and parameter blobs are rejected and that relus are fused into a depthconv and 1x1 conv pair
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_NODES              2
+#define TEST_WORDS              (1 + TEST_NODES*ADI_SHARCFX_GRAPH_NODE_WORDS)
+#define TEST_SIZE               6               /*input height and width, padded by 1 on every side*/
+#define TEST_PADDED_SIZE        (TEST_SIZE + 2)
+#define TEST_IN_CHANNELS        8
+#define TEST_OUT_CHANNELS       16
+#define TEST_INPUT_OFFSET       3
+#define TEST_OUTPUT_OFFSET      -2
+
+/*Parameter blob of the conv*/
+#define TEST_WEIGHTS_OFFSET     0
+#define TEST_BIAS_OFFSET        (TEST_WEIGHTS_OFFSET + TEST_IN_CHANNELS*TEST_OUT_CHANNELS)
+#define TEST_MULTIPLIER_OFFSET  (TEST_BIAS_OFFSET + TEST_OUT_CHANNELS*4)
+#define TEST_SHIFT_OFFSET       (TEST_MULTIPLIER_OFFSET + TEST_OUT_CHANNELS*4)
+#define TEST_PARAMETERS_SIZE    (TEST_SHIFT_OFFSET + TEST_OUT_CHANNELS*4)
+
+/*Word of field nField of node nNode in the description, fields in ADI_SHARCFX_GRAPH_NODE order from nOp*/
+#define TEST_WORD(nNode, nField) (1 + (nNode)*ADI_SHARCFX_GRAPH_NODE_WORDS + (nField))
+#define TEST_FIELD_OP           0
+#define TEST_FIELD_INPUT_NODE   1
+#define TEST_FIELD_IN_CHANNELS  4
+#define TEST_FIELD_WEIGHTS      24
+#define TEST_FIELD_BIAS         25
+
+/*============= D A T A =============*/
+static int32_t pDescription[TEST_WORDS];
+static int32_t pCorrupted[TEST_WORDS];
+static int64_t pParameterWords[TEST_PARAMETERS_SIZE/8 + 1];
+static int8_t pInput[TEST_SIZE*TEST_SIZE*TEST_IN_CHANNELS];
+static int8_t pPadded[TEST_PADDED_SIZE*TEST_PADDED_SIZE*TEST_IN_CHANNELS];
+static int8_t pExpected[TEST_PADDED_SIZE*TEST_PADDED_SIZE*TEST_OUT_CHANNELS];
+static int64_t pArena[16*1024];
+static int64_t pFastArena[4*1024];
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Serializes one node: the 24 int32 fields from nOp to nActMax, then the 4 parameter offsets
+static void test_serialize_node(int32_t nNode, const int32_t *pFields)
+{
+    memcpy(&pDescription[TEST_WORD(nNode, 0)], pFields, ADI_SHARCFX_GRAPH_NODE_WORDS*sizeof(int32_t));
+}
+
+/*UTILITY FUNCTION*/
+//Loads the description with word nWord replaced by nValue
+static int32_t test_load_corrupted(int32_t nWord, int32_t nValue, int32_t nParametersSize)
+{
+    ADI_SHARCFX_GRAPH_NODE pNodes[TEST_NODES];
+    memcpy(pCorrupted, pDescription, sizeof(pDescription));
+    pCorrupted[nWord] = nValue;
+    return adi_sharcfx_graph_load(pNodes, TEST_NODES, pCorrupted, TEST_WORDS, (int8_t *)pParameterWords, nParametersSize);
+}
+
+/*UTILITY FUNCTION*/
+//Node with the shapes and activation range read by the fusion passes
+static ADI_SHARCFX_GRAPH_NODE test_node(int32_t nOp, int32_t nInputNode, int32_t nKernelSize, int32_t nChannels,
+                                        int32_t nActMin, int32_t nActMax)
+{
+    ADI_SHARCFX_GRAPH_NODE sNode;
+    memset(&sNode, 0, sizeof(sNode));
+    sNode.nOp = nOp;
+    sNode.nInputNode = nInputNode;
+    sNode.nInHeight = sNode.nOutHeight = TEST_SIZE;
+    sNode.nInWidth = sNode.nOutWidth = TEST_SIZE;
+    sNode.nInChannels = sNode.nOutChannels = nChannels;
+    sNode.nKernelHeight = sNode.nKernelWidth = nKernelSize;
+    sNode.nActMin = nActMin;
+    sNode.nActMax = nActMax;
+    return sNode;
+}
+
+static void test_fuse_activations(void)
+{
+    ADI_SHARCFX_GRAPH_NODE pNodes[4];
+    ADI_SHARCFX_LAYER pLayers[4];
+    ADI_SHARCFX_LAYER_PLAN pPlans[4];
+    ADI_SHARCFX_GRAPH sGraph;
+
+    //depthconv, relu, 1x1 conv, relu: both relus go into their producer, then the depthconv and 1x1 conv fuse
+    pNodes[0] = test_node(ADI_SHARCFX_OP_DEPTHCONV2D_INT8, -1, 3, TEST_IN_CHANNELS, -128, 127);
+    pNodes[1] = test_node(ADI_SHARCFX_OP_RELU_INT8, 0, 1, TEST_IN_CHANNELS, -5, 127);
+    pNodes[2] = test_node(ADI_SHARCFX_OP_CONV2D_INT8, 1, 1, TEST_IN_CHANNELS, -128, 127);
+    pNodes[3] = test_node(ADI_SHARCFX_OP_RELU_INT8, 2, 1, TEST_IN_CHANNELS, 3, 100);
+
+    TEST_CHECK(adi_sharcfx_graph_prepare(&sGraph, pNodes, 4, pLayers, pPlans) > 0);
+    TEST_CHECK(pNodes[0].nOp == ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8 && pNodes[0].nFusedNode == 2);
+    TEST_CHECK(pNodes[1].nOp == ADI_SHARCFX_OP_NONE && pNodes[2].nOp == ADI_SHARCFX_OP_NONE &&
+               pNodes[3].nOp == ADI_SHARCFX_OP_NONE);
+    TEST_CHECK(pNodes[0].nActMin == -5 && pNodes[0].nActMax == 127);
+    TEST_CHECK(pNodes[2].nActMin == 3 && pNodes[2].nActMax == 100);
+    TEST_CHECK(sGraph.nOutputNode == 0);
+}
+
+int main(void)
+{
+    int8_t *pParameters = (int8_t *)pParameterWords;
+    int32_t *pMultiplier = (int32_t *)(pParameters + TEST_MULTIPLIER_OFFSET);
+    int32_t *pShift = (int32_t *)(pParameters + TEST_SHIFT_OFFSET);
+    ADI_SHARCFX_GRAPH_NODE pNodes[TEST_NODES];
+    ADI_SHARCFX_LAYER pLayers[TEST_NODES];
+    ADI_SHARCFX_LAYER_PLAN pPlans[TEST_NODES];
+    ADI_SHARCFX_GRAPH sGraph;
+
+    //pad with the input zeropoint, then a 1x1 conv over the padded tensor
+    const int32_t pPad[ADI_SHARCFX_GRAPH_NODE_WORDS] =
+        {ADI_SHARCFX_OP_PAD_INT8, -1, TEST_SIZE, TEST_SIZE, TEST_IN_CHANNELS, TEST_PADDED_SIZE, TEST_PADDED_SIZE,
+         TEST_IN_CHANNELS, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, -TEST_INPUT_OFFSET, 0, 0, 0, -128, 127, -1, -1, -1, -1};
+    const int32_t pConv[ADI_SHARCFX_GRAPH_NODE_WORDS] =
+        {ADI_SHARCFX_OP_CONV2D_INT8, 0, TEST_PADDED_SIZE, TEST_PADDED_SIZE, TEST_IN_CHANNELS, TEST_PADDED_SIZE,
+         TEST_PADDED_SIZE, TEST_OUT_CHANNELS, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, TEST_INPUT_OFFSET, 0, TEST_OUTPUT_OFFSET,
+         -128, 127, TEST_WEIGHTS_OFFSET, TEST_BIAS_OFFSET, TEST_MULTIPLIER_OFFSET, TEST_SHIFT_OFFSET};
+    pDescription[0] = TEST_NODES;
+    test_serialize_node(0, pPad);
+    test_serialize_node(1, pConv);
+
+    test_fill_int8(pInput, sizeof(pInput), -128, 127);
+    test_fill_int8(pParameters + TEST_WEIGHTS_OFFSET, TEST_IN_CHANNELS*TEST_OUT_CHANNELS, -127, 127);
+    test_fill_int32((int32_t *)(pParameters + TEST_BIAS_OFFSET), TEST_OUT_CHANNELS, -2000, 2000);
+    test_fill_int32(pMultiplier, TEST_OUT_CHANNELS, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pShift, TEST_OUT_CHANNELS, -9, -5);
+
+    //well formed description
+    TEST_CHECK(adi_sharcfx_graph_load(pNodes, TEST_NODES, pDescription, TEST_WORDS, pParameters,
+                                      TEST_PARAMETERS_SIZE) == TEST_NODES);
+    TEST_CHECK(pNodes[0].pWeights == NULL && pNodes[0].pQuantizedMultiplier == NULL);
+    TEST_CHECK(pNodes[1].pWeights == (const int8_t *)pParameters + TEST_WEIGHTS_OFFSET);
+    TEST_CHECK(pNodes[1].pQuantizedShift == pShift);
+    TEST_CHECK(pNodes[1].nInputNode == 0 && pNodes[1].nOutChannels == TEST_OUT_CHANNELS);
+
+    //pad + 1x1 conv: the pad is fused and the conv runs the padded kernel
+    TEST_CHECK(adi_sharcfx_graph_prepare(&sGraph, pNodes, TEST_NODES, pLayers, pPlans) > 0);
+    TEST_CHECK(pNodes[0].nOp == ADI_SHARCFX_OP_NONE);
+    TEST_CHECK(pNodes[1].nInputNode == -1 && pNodes[1].nInHeight == TEST_SIZE);
+    TEST_CHECK(pNodes[1].nKernel == ADI_SHARCFX_KERNEL_CONV2D_INT8);
+    TEST_CHECK(sGraph.nArenaSize <= (int32_t)sizeof(pArena) && sGraph.nFastArenaSize <= (int32_t)sizeof(pFastArena));
+
+    adi_sharcfx_pad_int8(pInput, pPadded, 1, TEST_SIZE, TEST_SIZE, TEST_IN_CHANNELS, 1, 1, 1, 1, -TEST_INPUT_OFFSET);
+    adi_sharcfx_conv2d_kernel1x1_int8(pPadded, pParameters + TEST_WEIGHTS_OFFSET,
+                                      (const int32_t *)(pParameters + TEST_BIAS_OFFSET), pExpected, 1,
+                                      TEST_IN_CHANNELS, TEST_OUT_CHANNELS, TEST_PADDED_SIZE*TEST_PADDED_SIZE,
+                                      pMultiplier, pShift, TEST_INPUT_OFFSET, TEST_OUTPUT_OFFSET);
+    int8_t *pOutput = adi_sharcfx_graph_run(&sGraph, (int8_t *)pArena, (int8_t *)pFastArena, pInput);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, sizeof(pExpected), "pad + conv1x1 graph") == 0);
+
+    //malformed descriptions
+    TEST_CHECK(adi_sharcfx_graph_load(pNodes, TEST_NODES - 1, pDescription, TEST_WORDS, pParameters,
+                                      TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(adi_sharcfx_graph_load(pNodes, TEST_NODES, pDescription, TEST_WORDS - 1, pParameters,
+                                      TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(0, -1, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_OP), ADI_SHARCFX_OP_DEPTHCONV_POINTWISE_INT8,
+                                   TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_OP), -1, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(0, TEST_FIELD_INPUT_NODE), -2, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_INPUT_NODE), 1, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_IN_CHANNELS), -8, TEST_PARAMETERS_SIZE) == -1);
+
+    //parameters outside the blob, misaligned or missing
+    TEST_CHECK(test_load_corrupted(0, TEST_NODES, TEST_PARAMETERS_SIZE - 1) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_WEIGHTS), TEST_PARAMETERS_SIZE, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_WEIGHTS), -7, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_WEIGHTS), -1, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_BIAS), TEST_BIAS_OFFSET + 2, TEST_PARAMETERS_SIZE) == -1);
+    TEST_CHECK(test_load_corrupted(TEST_WORD(0, TEST_FIELD_BIAS), 0x7FFFFFFF, TEST_PARAMETERS_SIZE) == -1);
+
+    //a conv without bias is valid
+    TEST_CHECK(test_load_corrupted(TEST_WORD(1, TEST_FIELD_BIAS), -1, TEST_PARAMETERS_SIZE) == TEST_NODES);
+
+    test_fuse_activations();
+
+    return test_report("test_graph");
+}
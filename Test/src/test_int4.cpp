@@ -0,0 +1,150 @@
+/**
+********************************************************************************
+*
+* @file: test_int4.cpp
+*
+* @brief: tests of the int4 weight kernels
+*
+* @details: checks the nibble layout of adi_sharcfx_pack_int4, compares adi_sharcfx_fully_connected_int4 with the int8 fully
+* connected kernel on the unpacked weights and adi_sharcfx_conv2d_kernel1x1_int4 with the int4 fully connected kernel, for
+* depths with and without a partial last block and for accumulators beyond the 32bit range
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_MAX_DEPTH      128
+#define TEST_MAX_CHANNELS   24
+#define TEST_MAX_BATCHES    3
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_MAX_BATCHES*TEST_MAX_DEPTH];
+static int8_t pWeights[TEST_MAX_CHANNELS*TEST_MAX_DEPTH];
+static int8_t pPacked[TEST_MAX_CHANNELS*ADI_SHARCFX_INT4_ROW_BYTES(TEST_MAX_DEPTH)];
+static int32_t pBias[TEST_MAX_CHANNELS];
+static int32_t pMultiplier[TEST_MAX_CHANNELS];
+static int32_t pShift[TEST_MAX_CHANNELS];
+static int8_t pExpected[TEST_MAX_BATCHES*TEST_MAX_CHANNELS];
+static int8_t pOutput[TEST_MAX_BATCHES*TEST_MAX_CHANNELS];
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Weight nIndex of a packed row, sign extended from its nibble
+static int32_t test_unpack_int4(const int8_t *pRow, int32_t nIndex)
+{
+    int32_t nHalf = ADI_SHARCFX_INT4_BLOCK/2;
+    int32_t nByte = (nIndex / ADI_SHARCFX_INT4_BLOCK)*nHalf + nIndex % nHalf;
+    int32_t nNibble = (nIndex % ADI_SHARCFX_INT4_BLOCK) < nHalf ? (pRow[nByte] & 0xF) : ((pRow[nByte] >> 4) & 0xF);
+    return nNibble >= 8 ? nNibble - 16 : nNibble;
+}
+
+static void test_pack(int32_t nChannels, int32_t nDepth)
+{
+    int32_t nRowBytes = ADI_SHARCFX_INT4_ROW_BYTES(nDepth);
+    int32_t nErrors = 0;
+
+    test_fill_int8(pWeights, nChannels*nDepth, -8, 7);
+    TEST_CHECK(adi_sharcfx_pack_int4(pWeights, pPacked, nChannels, nDepth) == nRowBytes);
+    for (int32_t c = 0; c < nChannels; c++)
+    {
+        for (int32_t i = 0; i < nRowBytes*2; i++)
+        {
+            //padding weights past the depth are zero
+            int32_t nExpected = i < nDepth ? pWeights[c*nDepth + i] : 0;
+            nErrors += test_unpack_int4(pPacked + c*nRowBytes, i) != nExpected;
+        }
+    }
+    TEST_CHECK(nErrors == 0);
+
+    //weights out of the int4 range are rejected
+    pWeights[nDepth/2] = 8;
+    TEST_CHECK(adi_sharcfx_pack_int4(pWeights, pPacked, nChannels, nDepth) == -1);
+    pWeights[nDepth/2] = -9;
+    TEST_CHECK(adi_sharcfx_pack_int4(pWeights, pPacked, nChannels, nDepth) == -1);
+}
+
+static void test_fully_connected(int32_t nBatches, int32_t nChannels, int32_t nDepth)
+{
+    char pName[64];
+    int32_t nOutSize = nBatches*nChannels;
+
+    test_fill_int8(pInput, nBatches*nDepth, -128, 127);
+    test_fill_int8(pWeights, nChannels*nDepth, -8, 7);
+    test_fill_int32(pBias, nChannels, -5000, 5000);
+    TEST_CHECK(adi_sharcfx_pack_int4(pWeights, pPacked, nChannels, nDepth) > 0);
+
+    //int4 against int8 weights with the same per tensor requantization
+    for (int32_t c = 0; c < nChannels; c++)
+    {
+        pMultiplier[c] = 1518500250;
+        pShift[c] = -7;
+    }
+    adi_sharcfx_fully_connected_int8(pInput, pWeights, pBias, pExpected, nDepth, nChannels, nBatches,
+                                     (uint32_t)pMultiplier[0], pShift[0], 5, 0, -3, -128, 127);
+    memset(pOutput, 0x55, nOutSize);
+    adi_sharcfx_fully_connected_int4(pInput, pPacked, pBias, pOutput, nDepth, nChannels, nBatches,
+                                     pMultiplier, pShift, 5, -3, -128, 127);
+    snprintf(pName, sizeof(pName), "fully_connected_int4 %dx%dx%d", (int)nBatches, (int)nChannels, (int)nDepth);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nOutSize, pName) == 0);
+
+    //1x1 conv over nBatches pixels against the fully connected layer, per channel requantization and activation
+    test_fill_int32(pMultiplier, nChannels, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pShift, nChannels, -9, -4);
+    adi_sharcfx_fully_connected_int4(pInput, pPacked, pBias, pExpected, nDepth, nChannels, nBatches,
+                                     pMultiplier, pShift, 5, -3, -100, 90);
+    memset(pOutput, 0x55, nOutSize);
+    adi_sharcfx_conv2d_kernel1x1_int4(pInput, pPacked, pBias, pOutput, 1, nDepth, nChannels, nBatches,
+                                      pMultiplier, pShift, 5, -3, -100, 90);
+    snprintf(pName, sizeof(pName), "conv2d_kernel1x1_int4 %dx%dx%d", (int)nBatches, (int)nChannels, (int)nDepth);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nOutSize, pName) == 0);
+}
+
+static void test_saturation(void)
+{
+    int32_t nDepth = 64, nChannels = 8;
+
+    //accumulators beyond the 32bit range saturate before the requantization in both kernels
+    memset(pInput, 127, nDepth);
+    memset(pWeights, 7, nChannels*nDepth);
+    TEST_CHECK(adi_sharcfx_pack_int4(pWeights, pPacked, nChannels, nDepth) > 0);
+    for (int32_t c = 0; c < nChannels; c++)
+    {
+        pBias[c] = (c & 1) ? 0x3FFFFFFF : -0x40000000;
+        pMultiplier[c] = 1<<30;
+        pShift[c] = -20;
+    }
+    memset(pInput + nDepth, -128, nDepth);
+    adi_sharcfx_conv2d_kernel1x1_int4(pInput, pPacked, pBias, pExpected, 1, nDepth, nChannels, 2,
+                                      pMultiplier, pShift, 0, 0, -128, 127);
+    adi_sharcfx_fully_connected_int4(pInput, pPacked, pBias, pOutput, nDepth, nChannels, 2,
+                                     pMultiplier, pShift, 0, 0, -128, 127);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, 2*nChannels, "int4 32bit saturation") == 0);
+}
+
+int main(void)
+{
+    test_pack(4, 32);
+    test_pack(5, 45);
+    test_pack(3, 7);
+
+    //full blocks only, and a partial last block of 1, 13, 16, 17 and 7 weights
+    test_fully_connected(1, 16, 64);
+    test_fully_connected(2, 24, 33);
+    test_fully_connected(3, 8, 45);
+    test_fully_connected(1, 5, 16);
+    test_fully_connected(2, 7, 113);
+    test_fully_connected(1, 3, 7);
+
+    test_saturation();
+
+    return test_report("test_int4");
+}
@@ -0,0 +1,138 @@
+/**
+********************************************************************************
+*
+* @file: test_memory_planner.cpp
+*
+* @brief: tests of the memory planner
+*
+* @details: plans a small model and checks that buffers live at the same time do not overlap within the fast and the
+* large arena, that the fast arena holds only the fast scratch and that both arena sizes are the peaks of their buffers
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_LAYERS         6
+#define TEST_BUFFERS        (3*TEST_LAYERS)
+
+/*============= D A T A =============*/
+/*Buffer of the plan with its arena and lifetime in layers*/
+typedef struct
+{
+    int32_t nFast;
+    int32_t nOffset;
+    int32_t nSize;
+    int32_t nStart;
+    int32_t nEnd;
+} TEST_BUFFER;
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Layer with the shapes the planner reads
+static ADI_SHARCFX_LAYER test_layer(int32_t nKernel, int32_t nInput, int32_t nHeight, int32_t nWidth, int32_t nInChannels,
+                                    int32_t nOutChannels, int32_t nKernelSize)
+{
+    ADI_SHARCFX_LAYER sLayer;
+    memset(&sLayer, 0, sizeof(sLayer));
+    sLayer.nKernel = nKernel;
+    sLayer.nInputLayer[0] = nInput;
+    sLayer.nInputLayer[1] = -1;
+    sLayer.nBatches = 1;
+    sLayer.nInHeight = sLayer.nOutHeight = nHeight;
+    sLayer.nInWidth = sLayer.nOutWidth = nWidth;
+    sLayer.nInChannels = nInChannels;
+    sLayer.nOutChannels = nOutChannels;
+    sLayer.nKernelHeight = sLayer.nKernelWidth = nKernelSize;
+    sLayer.nElementSize = 1;
+    return sLayer;
+}
+
+int main(void)
+{
+    ADI_SHARCFX_LAYER pLayers[TEST_LAYERS];
+    ADI_SHARCFX_LAYER_PLAN pPlans[TEST_LAYERS];
+    TEST_BUFFER pBuffers[TEST_BUFFERS];
+    int32_t nBuffers = 0;
+    int32_t nFastArenaSize = -1;
+    int32_t nFastPeak = 0, nLargePeak = 0;
+
+    //conv with fast scratch, depth multiplier 2 depthconv with large scratch, in place relu, logistic with large scratch,
+    //batch matmul with fast scratch and a layer reading two earlier outputs
+    pLayers[0] = test_layer(ADI_SHARCFX_KERNEL_CONV2D_INT8, -1, 8, 8, 8, 16, 3);
+    pLayers[1] = test_layer(ADI_SHARCFX_KERNEL_DEPTHCONV2D_INT8, 0, 8, 8, 16, 32, 3);
+    pLayers[2] = test_layer(ADI_SHARCFX_KERNEL_ELEMENTWISE, 1, 8, 8, 32, 32, 1);
+    pLayers[3] = test_layer(ADI_SHARCFX_KERNEL_LOGISTIC_INT8, 2, 8, 8, 32, 32, 1);
+    pLayers[4] = test_layer(ADI_SHARCFX_KERNEL_BATCH_MATMUL_INT8, 3, 8, 1, 64, 8, 1);
+    pLayers[5] = test_layer(ADI_SHARCFX_KERNEL_GENERIC, 4, 8, 8, 8, 8, 1);
+    pLayers[5].nInputLayer[1] = 0;
+
+    int32_t nArenaSize = adi_sharcfx_plan_memory(pLayers, TEST_LAYERS, pPlans, &nFastArenaSize);
+    TEST_CHECK(nArenaSize > 0);
+    TEST_CHECK(nFastArenaSize > 0);
+
+    //the in place relu reuses the depthconv output
+    TEST_CHECK(pPlans[2].nOutputOffset == pPlans[1].nOutputOffset);
+
+    for (int32_t i = 0; i < TEST_LAYERS; i++)
+    {
+        TEST_BUFFER sOutput = {0, pPlans[i].nOutputOffset, pPlans[i].nOutputSize, i, pPlans[i].nLastUse};
+        TEST_BUFFER sScratch = {1, pPlans[i].nScratchOffset, pPlans[i].nScratchSize, i, i};
+        TEST_BUFFER sScratchL3 = {0, pPlans[i].nScratchL3Offset, pPlans[i].nScratchL3Size, i, i};
+        if (pPlans[i].nAlias == i)
+        {
+            pBuffers[nBuffers++] = sOutput;
+        }
+        pBuffers[nBuffers++] = sScratch;
+        pBuffers[nBuffers++] = sScratchL3;
+        nFastPeak = MAX(nFastPeak, pPlans[i].nScratchSize);
+    }
+
+    //the fast arena only holds the fast scratch, which is live during its layer only, so its peak is the largest one
+    TEST_CHECK(nFastArenaSize == nFastPeak);
+    //the conv scratch is not moved to the large arena and the large scratch is not in the fast arena
+    TEST_CHECK(pPlans[0].nScratchSize > 0 && pPlans[0].nScratchOffset + pPlans[0].nScratchSize <= nFastArenaSize);
+    TEST_CHECK(pPlans[1].nScratchL3Size > 0 && pPlans[3].nScratchL3Size > 0);
+
+    for (int32_t a = 0; a < nBuffers; a++)
+    {
+        if (pBuffers[a].nSize == 0)
+        {
+            continue;
+        }
+        TEST_CHECK(pBuffers[a].nOffset >= 0 && pBuffers[a].nOffset % 8 == 0);
+        TEST_CHECK(pBuffers[a].nOffset + pBuffers[a].nSize <= (pBuffers[a].nFast ? nFastArenaSize : nArenaSize));
+        if (!pBuffers[a].nFast)
+        {
+            nLargePeak = MAX(nLargePeak, pBuffers[a].nOffset + pBuffers[a].nSize);
+        }
+        for (int32_t b = a + 1; b < nBuffers; b++)
+        {
+            const TEST_BUFFER *pA = &pBuffers[a], *pB = &pBuffers[b];
+            if (pB->nSize == 0 || pA->nFast != pB->nFast || pA->nEnd < pB->nStart || pB->nEnd < pA->nStart)
+            {
+                continue;
+            }
+            if (pA->nOffset < pB->nOffset + pB->nSize && pB->nOffset < pA->nOffset + pA->nSize)
+            {
+                printf("buffers %d and %d overlap in the %s arena\n", (int)a, (int)b, pA->nFast ? "fast" : "large");
+                nTestFailures++;
+            }
+        }
+    }
+    TEST_CHECK(nArenaSize == nLargePeak);
+
+    //a layer reading a later layer is rejected
+    pLayers[1].nInputLayer[0] = 3;
+    TEST_CHECK(adi_sharcfx_plan_memory(pLayers, TEST_LAYERS, pPlans, &nFastArenaSize) == -1);
+
+    return test_report("test_memory_planner");
+}
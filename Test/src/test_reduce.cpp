@@ -0,0 +1,80 @@
+/**
+********************************************************************************
+*
+* @file: test_reduce.cpp
+*
+* @brief: tests of the sum reduction kernels
+*
+* @details: reduces the same values once as [1][reduce][channels], which runs the channel vectorized path, and once as
+* [channels][reduce][1], which runs the path vectorized along the reduced axis, and checks that both give the same outputs
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_MAX_REDUCE     100
+#define TEST_MAX_CHANNELS   40
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_MAX_REDUCE*TEST_MAX_CHANNELS];
+static int8_t pTransposed[TEST_MAX_REDUCE*TEST_MAX_CHANNELS];
+static int8_t pExpected[TEST_MAX_CHANNELS];
+static int8_t pOutput[TEST_MAX_CHANNELS];
+static int16_t pInput16[TEST_MAX_REDUCE*TEST_MAX_CHANNELS];
+static int16_t pTransposed16[TEST_MAX_REDUCE*TEST_MAX_CHANNELS];
+static int16_t pExpected16[TEST_MAX_CHANNELS];
+static int16_t pOutput16[TEST_MAX_CHANNELS];
+
+/*============= C O D E =============*/
+
+static void test_reduce_sum(int32_t nReduce, int32_t nChannels, int32_t nMultiplier, int32_t nShift)
+{
+    char pName[64];
+
+    test_fill_int8(pInput, nReduce*nChannels, -128, 127);
+    for (int32_t i = 0; i < nReduce*nChannels; i++)
+    {
+        pInput16[i] = (int16_t)test_rand(-32768, 32767);
+    }
+    for (int32_t r = 0; r < nReduce; r++)
+    {
+        for (int32_t c = 0; c < nChannels; c++)
+        {
+            pTransposed[c*nReduce + r] = pInput[r*nChannels + c];
+            pTransposed16[c*nReduce + r] = pInput16[r*nChannels + c];
+        }
+    }
+
+    adi_sharcfx_reduce_sum_int8(pInput, pExpected, 1, nReduce, nChannels, 7, nMultiplier, nShift, -4);
+    memset(pOutput, 0x55, sizeof(pOutput));
+    adi_sharcfx_reduce_sum_int8(pTransposed, pOutput, nChannels, nReduce, 1, 7, nMultiplier, nShift, -4);
+    snprintf(pName, sizeof(pName), "reduce_sum_int8 %dx%d", (int)nReduce, (int)nChannels);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nChannels, pName) == 0);
+
+    adi_sharcfx_reduce_sum_int16(pInput16, pExpected16, 1, nReduce, nChannels, nMultiplier, nShift);
+    memset(pOutput16, 0x55, sizeof(pOutput16));
+    adi_sharcfx_reduce_sum_int16(pTransposed16, pOutput16, nChannels, nReduce, 1, nMultiplier, nShift);
+    snprintf(pName, sizeof(pName), "reduce_sum_int16 %dx%d", (int)nReduce, (int)nChannels);
+    TEST_CHECK(test_compare_int8((const int8_t *)pOutput16, (const int8_t *)pExpected16, nChannels*sizeof(int16_t),
+                                 pName) == 0);
+}
+
+int main(void)
+{
+    //mean over the reduced axis, multipliers and shifts giving many exact halves to round
+    test_reduce_sum(49, 16, 1<<30, -5);
+    test_reduce_sum(64, 40, 1<<30, -6);
+    test_reduce_sum(100, 3, 1374389535, -7);
+    test_reduce_sum(7, 33, 1<<30, -1);
+    test_reduce_sum(16, 8, 1518500250, -3);
+
+    return test_report("test_reduce");
+}
@@ -0,0 +1,238 @@
+/**
+********************************************************************************
+*
+* @file: test_rows_threads.cpp
+*
+* @brief: tests of the row and channel range kernel entry points
+*
+* @details: runs every range entry point on disjoint ranges from concurrent threads, each with its own scratch, and checks
+* that together they produce the output of the full tensor kernel. The dilated conv2d also runs with a filter offset,
+* which must match weights with the offset added
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include <thread>
+#include <vector>
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_WIDTH          12
+#define TEST_HEIGHT         10
+#define TEST_IN_CHANNELS    8
+#define TEST_OUT_CHANNELS   20
+#define TEST_KERNEL         3
+#define TEST_THREADS        4
+#define TEST_SCRATCH_SIZE   (64*1024)
+#define TEST_TENSOR_SIZE    (TEST_WIDTH*TEST_HEIGHT*TEST_OUT_CHANNELS*2)
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_TENSOR_SIZE];
+static int16_t pInput16[TEST_TENSOR_SIZE];
+static int8_t pWeights[TEST_KERNEL*TEST_KERNEL*TEST_IN_CHANNELS*TEST_OUT_CHANNELS];
+static int8_t pOffsetWeights[TEST_KERNEL*TEST_KERNEL*TEST_IN_CHANNELS*TEST_OUT_CHANNELS];
+static int32_t pBias[TEST_OUT_CHANNELS];
+static int64_t pBias64[TEST_OUT_CHANNELS];
+static int32_t pMultiplier[TEST_OUT_CHANNELS];
+static int32_t pShift[TEST_OUT_CHANNELS];
+static int8_t pExpected[TEST_TENSOR_SIZE];
+static int8_t pOutput[TEST_TENSOR_SIZE];
+static int16_t pExpected16[TEST_TENSOR_SIZE];
+static int16_t pOutput16[TEST_TENSOR_SIZE];
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Split [0, nTotal) into TEST_THREADS ranges and run fRange(start, end, scratch) for each on its own thread
+template <class F>
+static void test_run_split(int32_t nTotal, F fRange)
+{
+    std::vector<std::thread> threads;
+    std::vector<std::vector<int64_t> > scratch(TEST_THREADS, std::vector<int64_t>(TEST_SCRATCH_SIZE/sizeof(int64_t)));
+    for (int32_t t = 0; t < TEST_THREADS; t++)
+    {
+        int32_t nStart = nTotal*t/TEST_THREADS;
+        int32_t nEnd = nTotal*(t + 1)/TEST_THREADS;
+        int8_t *pScratch = (int8_t *)scratch[t].data();
+        threads.push_back(std::thread([=]() { fRange(nStart, nEnd, pScratch); }));
+    }
+    for (uint32_t t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+}
+
+static void test_conv2d_dilated(int32_t nFilterOffset)
+{
+    int32_t nOutHeight = TEST_HEIGHT, nOutWidth = TEST_WIDTH;
+    int32_t nSize = nOutHeight*nOutWidth*TEST_OUT_CHANNELS;
+
+    adi_sharcfx_conv2d_dilated_int8(pInput, pWeights, pBias, pExpected, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                    TEST_KERNEL, TEST_KERNEL, TEST_OUT_CHANNELS, TEST_WIDTH, TEST_HEIGHT, 1, 1, 2, 2,
+                                    nOutHeight, nOutWidth, pMultiplier, pShift, -2, 3, nFilterOffset, -128, 127);
+    memset(pOutput, 0x55, nSize);
+    test_run_split(nOutHeight, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_conv2d_dilated_rows_int8(pInput, pWeights, pBias, pOutput, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                             TEST_KERNEL, TEST_KERNEL, TEST_OUT_CHANNELS, TEST_WIDTH, TEST_HEIGHT, 1, 1, 2, 2,
+                                             nOutHeight, nOutWidth, pMultiplier, pShift, -2, 3, nFilterOffset,
+                                             -128, 127, nStart, nEnd, pScratch);
+    });
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "conv2d_dilated_rows_int8") == 0);
+
+    //the filter offset matches weights with the offset added and no offset
+    if (nFilterOffset != 0)
+    {
+        for (uint32_t i = 0; i < sizeof(pWeights); i++)
+        {
+            pOffsetWeights[i] = (int8_t)(pWeights[i] + nFilterOffset);
+        }
+        memset(pOutput, 0x55, nSize);
+        adi_sharcfx_conv2d_dilated_int8(pInput, pOffsetWeights, pBias, pOutput, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                        TEST_KERNEL, TEST_KERNEL, TEST_OUT_CHANNELS, TEST_WIDTH, TEST_HEIGHT,
+                                        1, 1, 2, 2, nOutHeight, nOutWidth, pMultiplier, pShift, -2, 3, 0, -128, 127);
+        TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "conv2d_dilated_int8 filter offset") == 0);
+    }
+}
+
+static void test_conv2d_dilation1x1(int32_t nStride)
+{
+    int32_t nOutHeight = (TEST_HEIGHT - 1)/nStride + 1, nOutWidth = (TEST_WIDTH - 1)/nStride + 1;
+    int32_t nSize = nOutHeight*nOutWidth*TEST_OUT_CHANNELS;
+
+    adi_sharcfx_conv2d_dilation1x1_int8(pInput, pWeights, pBias, pExpected, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                        TEST_KERNEL, TEST_KERNEL, TEST_OUT_CHANNELS, TEST_WIDTH, TEST_HEIGHT, nStride, nStride,
+                                        1, 1, nOutHeight, nOutWidth, pMultiplier, pShift, -2, 3, 0, -128, 127);
+    memset(pOutput, 0x55, nSize);
+    test_run_split(nOutHeight, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_conv2d_dilation1x1_rows_int8(pInput, pWeights, pBias, pOutput, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                                 TEST_KERNEL, TEST_KERNEL, TEST_OUT_CHANNELS, TEST_WIDTH, TEST_HEIGHT,
+                                                 nStride, nStride, 1, 1, nOutHeight, nOutWidth, pMultiplier, pShift,
+                                                 -2, 3, 0, -128, 127, nStart, nEnd, pScratch);
+    });
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "conv2d_dilation1x1_rows_int8") == 0);
+}
+
+static void test_conv2d_kernel1x1(void)
+{
+    int32_t nPixels = TEST_WIDTH*TEST_HEIGHT;
+    int32_t nSize = nPixels*TEST_OUT_CHANNELS;
+
+    adi_sharcfx_conv2d_kernel1x1_int8(pInput, pWeights, pBias, pExpected, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS, nPixels,
+                                      pMultiplier, pShift, -2, 3);
+    memset(pOutput, 0x55, nSize);
+    test_run_split(nPixels, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_conv2d_kernel1x1_pixels_int8(pInput, pWeights, pBias, pOutput, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                                 pMultiplier, pShift, -2, 3, nStart, nEnd);
+    });
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "conv2d_kernel1x1_pixels_int8") == 0);
+}
+
+static void test_conv2d_int16(void)
+{
+    int32_t nOutHeight = TEST_HEIGHT, nOutWidth = TEST_WIDTH;
+    int32_t nSize = nOutHeight*nOutWidth*TEST_OUT_CHANNELS;
+
+    adi_sharcfx_conv2d_int16(pInput16, pWeights, pBias64, pExpected16, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                             TEST_KERNEL, TEST_KERNEL, TEST_WIDTH, TEST_HEIGHT, 1, 1, 1, 1, 1, 1, nOutHeight, nOutWidth,
+                             pMultiplier, pShift, INT_16BIT_MIN, INT_16BIT_MAX);
+    memset(pOutput16, 0x55, nSize*sizeof(int16_t));
+    test_run_split(nOutHeight, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_conv2d_int16_rows(pInput16, pWeights, pBias64, pOutput16, 1, TEST_IN_CHANNELS, TEST_OUT_CHANNELS,
+                                      TEST_KERNEL, TEST_KERNEL, TEST_WIDTH, TEST_HEIGHT, 1, 1, 1, 1, 1, 1,
+                                      nOutHeight, nOutWidth, pMultiplier, pShift, INT_16BIT_MIN, INT_16BIT_MAX,
+                                      nStart, nEnd, pScratch);
+    });
+    TEST_CHECK(memcmp(pOutput16, pExpected16, nSize*sizeof(int16_t)) == 0);
+}
+
+static void test_depthconv2d(int32_t nDepthMult)
+{
+    int32_t nOutChannels = TEST_IN_CHANNELS*nDepthMult;
+    int32_t nSize = TEST_HEIGHT*TEST_WIDTH*nOutChannels;
+
+    adi_sharcfx_depthconv2d_int8(pInput, pExpected, pWeights, pBias, TEST_WIDTH, TEST_HEIGHT, nDepthMult,
+                                 TEST_IN_CHANNELS, nOutChannels, TEST_KERNEL, TEST_KERNEL, 2, 2, pMultiplier, pShift,
+                                 -2, 3, 1, 1, -128, 127);
+    memset(pOutput, 0x55, nSize);
+    test_run_split(TEST_HEIGHT, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_depthconv2d_rows_int8(pInput, pOutput, pWeights, pBias, TEST_WIDTH, TEST_HEIGHT, nDepthMult,
+                                          TEST_IN_CHANNELS, nOutChannels, TEST_KERNEL, TEST_KERNEL, 2, 2, pMultiplier,
+                                          pShift, -2, 3, 1, 1, -128, 127, nStart, nEnd, pScratch);
+    });
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "depthconv2d_rows_int8") == 0);
+}
+
+static void test_fully_connected(void)
+{
+    int32_t nDepth = TEST_KERNEL*TEST_KERNEL*TEST_IN_CHANNELS;
+    int32_t nBatches = 3;
+
+    adi_sharcfx_fully_connected_int8(pInput, pWeights, pBias, pExpected, nDepth, TEST_OUT_CHANNELS, nBatches,
+                                     (uint32_t)pMultiplier[0], pShift[0], -2, 0, 3, -128, 127);
+    memset(pOutput, 0x55, nBatches*TEST_OUT_CHANNELS);
+    test_run_split(TEST_OUT_CHANNELS, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_fully_connected_channels_int8(pInput, pWeights, pBias, pOutput, nDepth, TEST_OUT_CHANNELS, nBatches,
+                                                  (uint32_t)pMultiplier[0], pShift[0], -2, 0, 3, -128, 127, nStart, nEnd);
+    });
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nBatches*TEST_OUT_CHANNELS, "fully_connected_channels_int8") == 0);
+}
+
+static void test_maxpool(void)
+{
+    int32_t nOutHeight = (TEST_HEIGHT - 3)/2 + 1, nOutWidth = (TEST_WIDTH - 3)/2 + 1;
+    int32_t nSize = nOutHeight*nOutWidth*TEST_IN_CHANNELS;
+
+    adi_sharcfx_maxpool_int8(TEST_HEIGHT, TEST_WIDTH, nOutHeight, nOutWidth, 2, 2, 3, 3, 0, 0, -100, 100,
+                             TEST_IN_CHANNELS, pInput, pExpected);
+    memset(pOutput, 0x55, nSize);
+    test_run_split(nOutHeight, [&](int32_t nStart, int32_t nEnd, int8_t *pScratch)
+    {
+        adi_sharcfx_maxpool_rows_int8(TEST_HEIGHT, TEST_WIDTH, nOutHeight, nOutWidth, 2, 2, 3, 3, 0, 0, -100, 100,
+                                      TEST_IN_CHANNELS, pInput, pOutput, nStart, nEnd);
+    });
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nSize, "maxpool_rows_int8") == 0);
+}
+
+int main(void)
+{
+    test_fill_int8(pInput, TEST_TENSOR_SIZE, -128, 127);
+    //weights stay in int8 with the filter offset added
+    test_fill_int8(pWeights, sizeof(pWeights), -100, 100);
+    test_fill_int32(pBias, TEST_OUT_CHANNELS, -3000, 3000);
+    test_fill_int32(pMultiplier, TEST_OUT_CHANNELS, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pShift, TEST_OUT_CHANNELS, -10, -6);
+    for (int32_t i = 0; i < TEST_TENSOR_SIZE; i++)
+    {
+        pInput16[i] = (int16_t)test_rand(INT_16BIT_MIN, INT_16BIT_MAX);
+    }
+    for (int32_t i = 0; i < TEST_OUT_CHANNELS; i++)
+    {
+        pBias64[i] = (int64_t)test_rand(-(1<<30), 1<<30)*test_rand(1, 64);
+    }
+
+    test_conv2d_dilated(0);
+    test_conv2d_dilated(7);
+    test_conv2d_dilated(-5);
+    test_conv2d_dilation1x1(1);
+    test_conv2d_dilation1x1(2);
+    test_conv2d_kernel1x1();
+    test_conv2d_int16();
+    test_depthconv2d(1);
+    test_depthconv2d(2);
+    test_fully_connected();
+    test_maxpool();
+
+    return test_report("test_rows_threads");
+}
@@ -0,0 +1,197 @@
+/**
+********************************************************************************
+*
+* @file: test_sparse.cpp
+*
+* @brief: tests and density benchmark of the block sparse weight kernels
+*
+* @details: checks the block layout of adi_sharcfx_pack_block_sparse, compares adi_sharcfx_fully_connected_sparse_int8 with
+* the int8 fully connected kernel on the dense weights and adi_sharcfx_conv2d_kernel1x1_sparse_int8 with the sparse fully
+* connected kernel, for depths with and without a partial last block, then prints the cycles of the sparse and the dense
+* fully connected kernel for block densities from 100% down to 12.5%
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#define DISPLAY_CYCLE_COUNTS            /*cycle counting macros of the library header*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_MAX_DEPTH      512
+#define TEST_MAX_CHANNELS   64
+#define TEST_MAX_BATCHES    4
+#define TEST_MAX_BLOCKS     (TEST_MAX_CHANNELS*ADI_SHARCFX_SPARSE_BLOCKS(TEST_MAX_DEPTH))
+
+#define TEST_MULTIPLIER     1518500250
+#define TEST_SHIFT          -8
+#define TEST_INPUT_OFFSET   5
+#define TEST_OUTPUT_OFFSET  -3
+
+#define TEST_BENCH_DEPTH    512
+#define TEST_BENCH_CHANNELS 64
+#define TEST_BENCH_RUNS     8
+#define TEST_DENSITIES      4       /*every 1st, 2nd, 4th and 8th block of a row is kept*/
+
+/*============= D A T A =============*/
+static int8_t pInput[TEST_MAX_BATCHES*TEST_MAX_DEPTH];
+static int8_t pWeights[TEST_MAX_CHANNELS*TEST_MAX_DEPTH];
+static int32_t pBias[TEST_MAX_CHANNELS];
+static int32_t pMultiplier[TEST_MAX_CHANNELS];
+static int32_t pShift[TEST_MAX_CHANNELS];
+static int8_t pExpected[TEST_MAX_BATCHES*TEST_MAX_CHANNELS];
+static int8_t pOutput[TEST_MAX_BATCHES*TEST_MAX_CHANNELS];
+
+static int32_t pBlockPtr[TEST_MAX_CHANNELS + 1];
+static int16_t pBlockIdx[TEST_MAX_BLOCKS];
+static int8_t pValues[TEST_MAX_BLOCKS*ADI_SHARCFX_SPARSE_BLOCK] __attribute__((aligned(8)));
+static ADI_SHARCFX_SPARSE_WEIGHTS sSparse = {pBlockPtr, pBlockIdx, pValues};
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Random weights with every block of a row zeroed unless its index plus the row is a multiple of nStride
+static void test_fill_block_sparse(int32_t nChannels, int32_t nDepth, int32_t nStride)
+{
+    test_fill_int8(pWeights, nChannels*nDepth, -127, 127);
+    for (int32_t c = 0; c < nChannels; c++)
+    {
+        for (int32_t i = 0; i < nDepth; i++)
+        {
+            if ((i/ADI_SHARCFX_SPARSE_BLOCK + c) % nStride)
+            {
+                pWeights[c*nDepth + i] = 0;
+            }
+        }
+    }
+}
+
+static void test_pack(void)
+{
+    int32_t nDepth = 40, nErrors = 0;
+
+    //row 0 keeps blocks 0 and 2, the last one partial, row 1 is all zero and row 2 keeps block 1 for a single weight
+    memset(pWeights, 0, 3*nDepth);
+    test_fill_int8(pWeights, ADI_SHARCFX_SPARSE_BLOCK, 1, 127);
+    test_fill_int8(pWeights + 2*ADI_SHARCFX_SPARSE_BLOCK, nDepth - 2*ADI_SHARCFX_SPARSE_BLOCK, -127, -1);
+    pWeights[2*nDepth + ADI_SHARCFX_SPARSE_BLOCK + 5] = -128;
+    memset(pValues, 0x55, 4*ADI_SHARCFX_SPARSE_BLOCK);
+
+    TEST_CHECK(adi_sharcfx_pack_block_sparse(pWeights, 3, nDepth, &sSparse) == 3);
+    TEST_CHECK(pBlockPtr[0] == 0 && pBlockPtr[1] == 2 && pBlockPtr[2] == 2 && pBlockPtr[3] == 3);
+    TEST_CHECK(pBlockIdx[0] == 0 && pBlockIdx[1] == 2 && pBlockIdx[2] == 1);
+    for (int32_t i = 0; i < ADI_SHARCFX_SPARSE_BLOCK; i++)
+    {
+        int32_t nLast = 2*ADI_SHARCFX_SPARSE_BLOCK + i;
+        nErrors += pValues[i] != pWeights[i];
+        //the partial last block is zero padded past the depth
+        nErrors += pValues[ADI_SHARCFX_SPARSE_BLOCK + i] != (nLast < nDepth ? pWeights[nLast] : 0);
+        nErrors += pValues[2*ADI_SHARCFX_SPARSE_BLOCK + i] != (i == 5 ? -128 : 0);
+    }
+    TEST_CHECK(nErrors == 0);
+
+    //all zero weights keep no block
+    memset(pWeights, 0, 3*nDepth);
+    TEST_CHECK(adi_sharcfx_pack_block_sparse(pWeights, 3, nDepth, &sSparse) == 0);
+    TEST_CHECK(pBlockPtr[0] == 0 && pBlockPtr[3] == 0);
+}
+
+static void test_fully_connected(int32_t nBatches, int32_t nChannels, int32_t nDepth, int32_t nStride)
+{
+    char pName[64];
+    int32_t nOutSize = nBatches*nChannels;
+
+    test_fill_int8(pInput, nBatches*nDepth, -128, 127);
+    test_fill_block_sparse(nChannels, nDepth, nStride);
+    test_fill_int32(pBias, nChannels, -5000, 5000);
+    TEST_CHECK(adi_sharcfx_pack_block_sparse(pWeights, nChannels, nDepth, &sSparse) <= nChannels*ADI_SHARCFX_SPARSE_BLOCKS(nDepth));
+
+    //sparse against the dense weights
+    adi_sharcfx_fully_connected_int8(pInput, pWeights, pBias, pExpected, nDepth, nChannels, nBatches,
+                                     TEST_MULTIPLIER, TEST_SHIFT, TEST_INPUT_OFFSET, 0, TEST_OUTPUT_OFFSET, -128, 127);
+    memset(pOutput, 0x55, nOutSize);
+    adi_sharcfx_fully_connected_sparse_int8(pInput, &sSparse, pBias, pOutput, nDepth, nChannels, nBatches,
+                                            TEST_MULTIPLIER, TEST_SHIFT, TEST_INPUT_OFFSET, TEST_OUTPUT_OFFSET, -128, 127);
+    snprintf(pName, sizeof(pName), "fully_connected_sparse_int8 %dx%dx%d/%d", (int)nBatches, (int)nChannels, (int)nDepth,
+             (int)nStride);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nOutSize, pName) == 0);
+
+    //1x1 conv over nBatches pixels against the fully connected layer with the same requantization for every channel
+    for (int32_t c = 0; c < nChannels; c++)
+    {
+        pMultiplier[c] = TEST_MULTIPLIER;
+        pShift[c] = TEST_SHIFT;
+    }
+    adi_sharcfx_fully_connected_sparse_int8(pInput, &sSparse, pBias, pExpected, nDepth, nChannels, nBatches,
+                                            TEST_MULTIPLIER, TEST_SHIFT, TEST_INPUT_OFFSET, TEST_OUTPUT_OFFSET, -100, 90);
+    memset(pOutput, 0x55, nOutSize);
+    adi_sharcfx_conv2d_kernel1x1_sparse_int8(pInput, &sSparse, pBias, pOutput, 1, nDepth, nChannels, nBatches,
+                                             pMultiplier, pShift, TEST_INPUT_OFFSET, TEST_OUTPUT_OFFSET, -100, 90);
+    snprintf(pName, sizeof(pName), "conv2d_kernel1x1_sparse_int8 %dx%dx%d/%d", (int)nBatches, (int)nChannels,
+             (int)nDepth, (int)nStride);
+    TEST_CHECK(test_compare_int8(pOutput, pExpected, nOutSize, pName) == 0);
+}
+
+static void test_density_benchmark(void)
+{
+    cycle_t nStart, nDenseCycles, pSparseCycles[TEST_DENSITIES];
+
+    printf("block density  sparse cycles  dense cycles  (%dx%d fully connected, %d runs)\n", TEST_BENCH_CHANNELS,
+           TEST_BENCH_DEPTH, TEST_BENCH_RUNS);
+    test_fill_int8(pInput, TEST_BENCH_DEPTH, -128, 127);
+    test_fill_int32(pBias, TEST_BENCH_CHANNELS, -5000, 5000);
+    for (int32_t d = 0; d < TEST_DENSITIES; d++)
+    {
+        int32_t nStride = 1 << d;
+        test_fill_block_sparse(TEST_BENCH_CHANNELS, TEST_BENCH_DEPTH, nStride);
+        adi_sharcfx_pack_block_sparse(pWeights, TEST_BENCH_CHANNELS, TEST_BENCH_DEPTH, &sSparse);
+
+        START_CYCLE_COUNT(nStart);
+        for (int32_t r = 0; r < TEST_BENCH_RUNS; r++)
+        {
+            adi_sharcfx_fully_connected_sparse_int8(pInput, &sSparse, pBias, pOutput, TEST_BENCH_DEPTH,
+                                                    TEST_BENCH_CHANNELS, 1, TEST_MULTIPLIER, TEST_SHIFT,
+                                                    TEST_INPUT_OFFSET, TEST_OUTPUT_OFFSET, -128, 127);
+        }
+        STOP_CYCLE_COUNT(pSparseCycles[d], nStart);
+
+        //the dense kernel does the same work at every density
+        START_CYCLE_COUNT(nStart);
+        for (int32_t r = 0; r < TEST_BENCH_RUNS; r++)
+        {
+            adi_sharcfx_fully_connected_int8(pInput, pWeights, pBias, pExpected, TEST_BENCH_DEPTH,
+                                             TEST_BENCH_CHANNELS, 1, TEST_MULTIPLIER, TEST_SHIFT,
+                                             TEST_INPUT_OFFSET, 0, TEST_OUTPUT_OFFSET, -128, 127);
+        }
+        STOP_CYCLE_COUNT(nDenseCycles, nStart);
+
+        printf("%12.1f%%  %13llu  %12llu\n", 100.0/nStride, (unsigned long long)pSparseCycles[d],
+               (unsigned long long)nDenseCycles);
+        TEST_CHECK(test_compare_int8(pOutput, pExpected, TEST_BENCH_CHANNELS, "sparse benchmark") == 0);
+    }
+
+    //the sparse run time follows the block density
+    TEST_CHECK(pSparseCycles[TEST_DENSITIES - 1] < pSparseCycles[0]);
+}
+
+int main(void)
+{
+    test_pack();
+
+    //full blocks only, and a partial last block of 1, 8 and 15 weights, at several block densities
+    test_fully_connected(1, 16, 64, 1);
+    test_fully_connected(2, 24, 33, 2);
+    test_fully_connected(3, 8, 40, 1);
+    test_fully_connected(4, 5, 127, 4);
+    test_fully_connected(1, 7, 512, 8);
+    test_fully_connected(2, 3, 15, 1);
+
+    test_density_benchmark();
+
+    return test_report("test_sparse");
+}
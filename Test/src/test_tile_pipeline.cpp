@@ -0,0 +1,160 @@
+/**
+********************************************************************************
+*
+* @file: test_tile_pipeline.cpp
+*
+* @brief: tests of the double buffered tile pipeline
+*
+* @details: checks the tiles staged by the pipeline with the memcpy engine and a counting engine, and checks that the
+* row tiled depthwise conv gives the same output as the untiled kernel for a range of L1 budgets
+*
+*******************************************************************************
+ Copyright(c) 2024 Analog Devices, Inc. All Rights Reserved. This software is
+ proprietary & confidential to Analog Devices, Inc. and its licensors. By using
+ this software you agree to the terms of the associated Analog Devices License
+ Agreement.
+*******************************************************************************
+*/
+
+/*============= I N C L U D E S =============*/
+#include "test_common.h"
+
+/*============= D E F I N E S =============*/
+#define TEST_SOURCE_SIZE        4096
+#define TEST_TILE_BUFFER_SIZE   256
+#define TEST_MAX_CHANNELS       16
+#define TEST_MAX_TENSOR         (24*24*TEST_MAX_CHANNELS)
+
+/*============= D A T A =============*/
+static int8_t pSource[TEST_SOURCE_SIZE];
+static int8_t pTileBuffer[TEST_TILE_BUFFER_SIZE] __attribute__((aligned(8)));
+static int8_t pInput[TEST_MAX_TENSOR];
+static int8_t pWeights[5*5*TEST_MAX_CHANNELS];
+static int32_t pBias[TEST_MAX_CHANNELS];
+static int32_t pMultiplier[TEST_MAX_CHANNELS];
+static int32_t pShift[TEST_MAX_CHANNELS];
+static int8_t pExpected[TEST_MAX_TENSOR];
+static int8_t pOutput[TEST_MAX_TENSOR];
+
+/*Copy engine that counts its calls and copies with memcpy*/
+typedef struct
+{
+    int32_t nStarts;
+    int32_t nWaits;
+} TEST_ENGINE_COUNTS;
+
+/*============= C O D E =============*/
+
+/*UTILITY FUNCTION*/
+//Counting engine callbacks
+static void test_engine_start(void *pDst, const void *pSrc, int32_t nBytes, void *pEngineData)
+{
+    ((TEST_ENGINE_COUNTS *)pEngineData)->nStarts++;
+    memcpy(pDst, pSrc, nBytes);
+}
+
+static void test_engine_wait(void *pEngineData)
+{
+    ((TEST_ENGINE_COUNTS *)pEngineData)->nWaits++;
+}
+
+/*UTILITY FUNCTION*/
+//Stream the source through the pipeline in nTileBytes tiles and check every staged tile
+static void test_pipeline_stream(ADI_SHARCFX_COPY_ENGINE *pEngine, int32_t nTileBytes)
+{
+    ADI_SHARCFX_TILE_PIPELINE sPipeline;
+    int32_t nTiles = (TEST_SOURCE_SIZE + nTileBytes - 1)/nTileBytes;
+
+    adi_sharcfx_tile_pipeline_init(&sPipeline, pEngine, pTileBuffer, TEST_TILE_BUFFER_SIZE);
+    TEST_CHECK(sPipeline.nBufferSize >= nTileBytes);
+    TEST_CHECK(adi_sharcfx_tile_pipeline_next(&sPipeline) == NULL);
+
+    TEST_CHECK(adi_sharcfx_tile_pipeline_prefetch(&sPipeline, pSource, MIN(nTileBytes, TEST_SOURCE_SIZE)) == 0);
+    for (int32_t t = 0; t < nTiles; t++)
+    {
+        int32_t nBytes = MIN(nTileBytes, TEST_SOURCE_SIZE - t*nTileBytes);
+        int8_t *pTile = adi_sharcfx_tile_pipeline_next(&sPipeline);
+        TEST_CHECK(pTile != NULL);
+        if (t + 1 < nTiles)
+        {
+            int32_t nNextBytes = MIN(nTileBytes, TEST_SOURCE_SIZE - (t + 1)*nTileBytes);
+            TEST_CHECK(adi_sharcfx_tile_pipeline_prefetch(&sPipeline, pSource + (t + 1)*nTileBytes, nNextBytes) == 0);
+            //only one tile can be in flight
+            TEST_CHECK(adi_sharcfx_tile_pipeline_prefetch(&sPipeline, pSource, nNextBytes) == -1);
+        }
+        TEST_CHECK(pTile == NULL || memcmp(pTile, pSource + t*nTileBytes, nBytes) == 0);
+    }
+    TEST_CHECK(adi_sharcfx_tile_pipeline_next(&sPipeline) == NULL);
+    TEST_CHECK(adi_sharcfx_tile_pipeline_prefetch(&sPipeline, pSource, sPipeline.nBufferSize + 1) == -1);
+}
+
+/*UTILITY FUNCTION*/
+//Run the tiled depthwise conv for several L1 budgets and compare with the untiled kernel
+static void test_depthconv_tiled(int32_t nWidth, int32_t nHeight, int32_t nInChannels, int32_t nDepthMult,
+                                 int32_t nKernel, int32_t nStride, int32_t nPadding)
+{
+    int32_t nOutChannels = nInChannels*nDepthMult;
+    int32_t nOutHeight = (nHeight + nPadding - nKernel)/nStride + 1;
+    int32_t nOutWidth = (nWidth + nPadding - nKernel)/nStride + 1;
+    int32_t nOutSize = nOutHeight*nOutWidth*nOutChannels;
+    int32_t nRowBytes = nWidth*nOutChannels;
+    int32_t pBudgets[] = {64, 2*nKernel*nRowBytes, 2*nKernel*nRowBytes + nRowBytes, 3*nKernel*nRowBytes + 40,
+                          8*nKernel*nRowBytes, TEMP_BUFFER_SIZE};
+    char pName[96];
+
+    test_fill_int8(pInput, nWidth*nHeight*nInChannels, -128, 127);
+    test_fill_int8(pWeights, nKernel*nKernel*nOutChannels, -127, 127);
+    test_fill_int32(pBias, nOutChannels, -2000, 2000);
+    test_fill_int32(pMultiplier, nOutChannels, 1<<30, 0x7FFFFFFF);
+    test_fill_int32(pShift, nOutChannels, -9, -5);
+
+    adi_sharcfx_depthconv2d_int8(pInput, pExpected, pWeights, pBias, nWidth, nHeight, nDepthMult, nInChannels,
+                                 nOutChannels, nKernel, nKernel, nPadding, nPadding, pMultiplier, pShift, -3, 5,
+                                 nStride, nStride, -128, 127);
+
+    for (uint32_t b = 0; b < sizeof(pBudgets)/sizeof(pBudgets[0]); b++)
+    {
+        memset(pOutput, 0x55, nOutSize);
+        adi_sharcfx_depthconv2d_tiled_int8(pInput, pOutput, pWeights, pBias, nWidth, nHeight, nDepthMult, nInChannels,
+                                           nOutChannels, nKernel, nKernel, nPadding, nPadding, pMultiplier, pShift, -3, 5,
+                                           nStride, nStride, -128, 127, pBudgets[b]);
+        snprintf(pName, sizeof(pName), "depthconv tiled %dx%dx%d mult %d k%d s%d budget %d", (int)nWidth, (int)nHeight,
+                 (int)nInChannels, (int)nDepthMult, (int)nKernel, (int)nStride, (int)pBudgets[b]);
+        TEST_CHECK(test_compare_int8(pOutput, pExpected, nOutSize, pName) == 0);
+    }
+}
+
+int main(void)
+{
+    TEST_ENGINE_COUNTS sCounts = {0, 0};
+    ADI_SHARCFX_COPY_ENGINE sCountingEngine = {test_engine_start, test_engine_wait, &sCounts};
+
+    test_fill_int8(pSource, TEST_SOURCE_SIZE, -128, 127);
+
+    //memcpy engine, tile sizes that do and do not divide the source
+    test_pipeline_stream(NULL, 128);
+    test_pipeline_stream(NULL, 100);
+
+    //an explicit engine is used for every copy and every wait
+    test_pipeline_stream(&sCountingEngine, 96);
+    TEST_CHECK(sCounts.nStarts == (TEST_SOURCE_SIZE + 95)/96);
+    TEST_CHECK(sCounts.nWaits == sCounts.nStarts);
+
+    //the engine selected with adi_sharcfx_set_copy_engine is the default of the pipeline and the tiled kernels
+    sCounts.nStarts = sCounts.nWaits = 0;
+    adi_sharcfx_set_copy_engine(&sCountingEngine);
+    TEST_CHECK(adi_sharcfx_get_copy_engine() == &sCountingEngine);
+    test_depthconv_tiled(16, 12, 8, 1, 3, 1, 2);
+    TEST_CHECK(sCounts.nStarts > 0);
+    adi_sharcfx_set_copy_engine(NULL);
+    TEST_CHECK(adi_sharcfx_get_copy_engine() != &sCountingEngine);
+
+    //tiled output against the untiled kernel with the memcpy engine
+    test_depthconv_tiled(16, 12, 8, 1, 3, 1, 2);
+    test_depthconv_tiled(17, 15, 16, 1, 3, 2, 1);
+    test_depthconv_tiled(20, 21, 16, 1, 5, 1, 4);
+    test_depthconv_tiled(13, 11, 4, 2, 3, 1, 2);
+    test_depthconv_tiled(24, 24, 8, 2, 3, 2, 1);
+
+    return test_report("test_tile_pipeline");
+}